@@ -0,0 +1,88 @@
+#pragma once
+
+#include <benchmark/benchmark.h>
+
+#include <HostRoutines/Exceptions.h>
+#include <Types.h>
+
+namespace clb
+{
+	// sizes swept by the benchmarks: number of elements for vectors, number of rows/columns for square matrices
+	static constexpr long minVectorSize = { 1 << 10 };
+	static constexpr long maxVectorSize = { 1 << 22 };
+	static constexpr long minMatrixSize = { 32 };
+	static constexpr long maxMatrixSize = { 512 };
+
+	template<MathDomain md>
+	static constexpr double ElementSize()
+	{
+		return md == MathDomain::Double ? sizeof(double) : (md == MathDomain::Float ? sizeof(float) : sizeof(int));
+	}
+
+	/**
+	 * Reports FLOP/s and bytes/s, given the floating point operations and the bytes moved by a single iteration
+	 */
+	static inline void SetCounters(benchmark::State& state, const double flopsPerIteration, const double bytesPerIteration)
+	{
+		// shown as e.g. FLOPS=15.2G/s and bytes_per_second=10.4G/s, the JSON output has the raw values per second
+		state.counters["FLOPS"] = benchmark::Counter(flopsPerIteration, benchmark::Counter::kIsIterationInvariantRate, benchmark::Counter::OneK::kIs1000);
+		state.SetBytesProcessed(static_cast<int64_t>(static_cast<double>(state.iterations()) * bytesPerIteration));
+	}
+
+	/**
+	 * Runs f in the benchmark loop. Routines which aren't implemented by the provider are reported as errors rather than
+	 * aborting the whole suite.
+	 */
+	template<typename F>
+	static void Run(benchmark::State& state, const F& f)
+	{
+		try
+		{
+			// warm up, and check the routine is available
+			f();
+		}
+		catch (const cl::NotImplementedException&)
+		{
+			state.SkipWithError("Not implemented");
+		}
+
+		for (auto _ : state)
+			f();
+	}
+}	 // namespace clb
+
+/**
+ * Registers function<memorySpace, mathDomain> for every available provider, in single and double precision:
+ * the Test memory space is always available, Mkl/OpenBlas/GenericBlas depend on the provider the library is built with.
+ * Extra arguments (e.g. ->Range(...)) are appended to each registration.
+ */
+#define CL_BENCHMARK_DOMAINS(function, memorySpace, ...)                        \
+	BENCHMARK_TEMPLATE(function, memorySpace, MathDomain::Float) __VA_ARGS__; \
+	BENCHMARK_TEMPLATE(function, memorySpace, MathDomain::Double) __VA_ARGS__;
+
+#ifdef USE_MKL
+	#define CL_BENCHMARK_MKL(function, ...) CL_BENCHMARK_DOMAINS(function, MemorySpace::Mkl, __VA_ARGS__)
+#else
+	#define CL_BENCHMARK_MKL(function, ...)
+#endif
+
+#ifdef USE_OPEN_BLAS
+	#define CL_BENCHMARK_OPEN_BLAS(function, ...) CL_BENCHMARK_DOMAINS(function, MemorySpace::OpenBlas, __VA_ARGS__)
+#else
+	#define CL_BENCHMARK_OPEN_BLAS(function, ...)
+#endif
+
+#ifdef USE_BLAS
+	#define CL_BENCHMARK_GENERIC_BLAS(function, ...) CL_BENCHMARK_DOMAINS(function, MemorySpace::GenericBlas, __VA_ARGS__)
+#else
+	#define CL_BENCHMARK_GENERIC_BLAS(function, ...)
+#endif
+
+#define CL_BENCHMARK(function, ...)                               \
+	CL_BENCHMARK_DOMAINS(function, MemorySpace::Test, __VA_ARGS__) \
+	CL_BENCHMARK_MKL(function, __VA_ARGS__)                        \
+	CL_BENCHMARK_OPEN_BLAS(function, __VA_ARGS__)                  \
+	CL_BENCHMARK_GENERIC_BLAS(function, __VA_ARGS__)
+
+#define CL_VECTOR_BENCHMARK(function) CL_BENCHMARK(function, ->RangeMultiplier(4)->Range(clb::minVectorSize, clb::maxVectorSize))
+#define CL_MATRIX_BENCHMARK(function) CL_BENCHMARK(function, ->RangeMultiplier(2)->Range(clb::minMatrixSize, clb::maxMatrixSize)->Unit(benchmark::kMicrosecond))
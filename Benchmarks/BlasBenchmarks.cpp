@@ -0,0 +1,453 @@
+#include <Benchmarks/BenchmarkHelpers.h>
+
+#include <ColumnWiseMatrix.h>
+#include <Factorization.h>
+#include <Tensor.h>
+#include <Vector.h>
+
+#include <HostRoutines/BlasWrappers.h>
+#include <HostRoutines/MemoryManager.h>
+
+#include <memory>
+
+namespace clb
+{
+	// number of matrices in the batched benchmarks
+	static constexpr unsigned nBatches = { 8 };
+
+	/**
+	 * Diagonally dominant, hence well conditioned: repeated solves/inversions don't blow up
+	 */
+	template<MemorySpace ms, MathDomain md>
+	static cl::ColumnWiseMatrix<ms, md> GetInvertibleMatrix(const unsigned nRows)
+	{
+		auto A = cl::ColumnWiseMatrix<ms, md>::RandomUniform(nRows, nRows, 1234);
+		auto _A = A.Get();
+		for (size_t i = 0; i < nRows; ++i)
+			_A[i + nRows * i] += nRows;
+		A.ReadFrom(_A);
+
+		return A;
+	}
+
+#pragma region Vector
+
+	template<MemorySpace ms, MathDomain md>
+	static void Add(benchmark::State& state)
+	{
+		const auto n = static_cast<unsigned>(state.range(0));
+		const auto x = cl::Vector<ms, md>::RandomUniform(n, 1234);
+		const auto y = cl::Vector<ms, md>::RandomUniform(n, 2345);
+		cl::Vector<ms, md> z(n);
+
+		Run(state, [&]() { cl::routines::Add(z.GetBuffer(), x.GetBuffer(), y.GetBuffer(), 2.0); });
+		SetCounters(state, 2.0 * n, 3.0 * n * ElementSize<md>());
+	}
+
+	template<MemorySpace ms, MathDomain md>
+	static void Subtract(benchmark::State& state)
+	{
+		const auto n = static_cast<unsigned>(state.range(0));
+		const auto x = cl::Vector<ms, md>::RandomUniform(n, 1234);
+		const auto y = cl::Vector<ms, md>::RandomUniform(n, 2345);
+		cl::Vector<ms, md> z(n);
+
+		Run(state, [&]() { cl::routines::Subtract(z.GetBuffer(), x.GetBuffer(), y.GetBuffer()); });
+		SetCounters(state, n, 3.0 * n * ElementSize<md>());
+	}
+
+	template<MemorySpace ms, MathDomain md>
+	static void AddEqual(benchmark::State& state)
+	{
+		const auto n = static_cast<unsigned>(state.range(0));
+		const auto x = cl::Vector<ms, md>::RandomUniform(n, 1234);
+		auto z = cl::Vector<ms, md>::RandomUniform(n, 2345);
+
+		// alternating signs keep the values bounded
+		double alpha = 1.0;
+		Run(state, [&]() {
+			cl::routines::AddEqual(z.GetBuffer(), x.GetBuffer(), alpha);
+			alpha = -alpha;
+		});
+		SetCounters(state, 2.0 * n, 3.0 * n * ElementSize<md>());
+	}
+
+	template<MemorySpace ms, MathDomain md>
+	static void SubtractEqual(benchmark::State& state)
+	{
+		const auto n = static_cast<unsigned>(state.range(0));
+		const auto x = cl::Vector<ms, md>::RandomUniform(n, 1234);
+		auto z = cl::Vector<ms, md>::RandomUniform(n, 2345);
+
+		Run(state, [&]() { cl::routines::SubtractEqual(z.GetBuffer(), x.GetBuffer()); });
+		SetCounters(state, n, 3.0 * n * ElementSize<md>());
+	}
+
+	template<MemorySpace ms, MathDomain md>
+	static void Scale(benchmark::State& state)
+	{
+		const auto n = static_cast<unsigned>(state.range(0));
+		auto z = cl::Vector<ms, md>::RandomUniform(n, 1234);
+
+		double alpha = 2.0;
+		Run(state, [&]() {
+			cl::routines::Scale(z.GetBuffer(), alpha);
+			alpha = 1.0 / alpha;
+		});
+		SetCounters(state, n, 2.0 * n * ElementSize<md>());
+	}
+
+	template<MemorySpace ms, MathDomain md>
+	static void ElementwiseProduct(benchmark::State& state)
+	{
+		const auto n = static_cast<unsigned>(state.range(0));
+		const auto x = cl::Vector<ms, md>::RandomUniform(n, 1234);
+		const auto y = cl::Vector<ms, md>::RandomUniform(n, 2345);
+		cl::Vector<ms, md> z(n);
+
+		Run(state, [&]() { cl::routines::ElementwiseProduct(z.GetBuffer(), x.GetBuffer(), y.GetBuffer(), 2.0); });
+		SetCounters(state, 2.0 * n, 3.0 * n * ElementSize<md>());
+	}
+
+	template<MemorySpace ms, MathDomain md>
+	static void ElementwiseDivision(benchmark::State& state)
+	{
+		const auto n = static_cast<unsigned>(state.range(0));
+		const auto x = cl::Vector<ms, md>::RandomUniform(n, 1234);
+		const cl::Vector<ms, md> y(n, 2);
+		cl::Vector<ms, md> z(n);
+
+		Run(state, [&]() { cl::routines::ElementwiseDivision(z.GetBuffer(), x.GetBuffer(), y.GetBuffer(), 2.0); });
+		SetCounters(state, 2.0 * n, 3.0 * n * ElementSize<md>());
+	}
+
+	template<MemorySpace ms, MathDomain md>
+	static void IsNonZero(benchmark::State& state)
+	{
+		const auto n = static_cast<unsigned>(state.range(0));
+		const auto x = cl::Vector<ms, md>::RandomGaussian(n, 1234);
+		cl::Vector<ms, md> z(n);
+
+		Run(state, [&]() { cl::routines::IsNonZero(z.GetBuffer(), x.GetBuffer()); });
+		SetCounters(state, n, 2.0 * n * ElementSize<md>());
+	}
+
+	template<MemorySpace ms, MathDomain md>
+	static void EuclideanNorm(benchmark::State& state)
+	{
+		const auto n = static_cast<unsigned>(state.range(0));
+		const auto x = cl::Vector<ms, md>::RandomGaussian(n, 1234);
+
+		double norm = 0.0;
+		Run(state, [&]() {
+			cl::routines::EuclideanNorm(norm, x.GetBuffer());
+			benchmark::DoNotOptimize(norm);
+		});
+		SetCounters(state, 2.0 * n, 1.0 * n * ElementSize<md>());
+	}
+
+	template<MemorySpace ms, MathDomain md>
+	static void ArgAbsMin(benchmark::State& state)
+	{
+		const auto n = static_cast<unsigned>(state.range(0));
+		const auto x = cl::Vector<ms, md>::RandomGaussian(n, 1234);
+
+		int argMin = 0;
+		Run(state, [&]() {
+			cl::routines::ArgAbsMin(argMin, x.GetBuffer());
+			benchmark::DoNotOptimize(argMin);
+		});
+		SetCounters(state, n, 1.0 * n * ElementSize<md>());
+	}
+
+	template<MemorySpace ms, MathDomain md>
+	static void ArgAbsMax(benchmark::State& state)
+	{
+		const auto n = static_cast<unsigned>(state.range(0));
+		const auto x = cl::Vector<ms, md>::RandomGaussian(n, 1234);
+
+		int argMax = 0;
+		Run(state, [&]() {
+			cl::routines::ArgAbsMax(argMax, x.GetBuffer());
+			benchmark::DoNotOptimize(argMax);
+		});
+		SetCounters(state, n, 1.0 * n * ElementSize<md>());
+	}
+
+	CL_VECTOR_BENCHMARK(Add)
+	CL_VECTOR_BENCHMARK(Subtract)
+	CL_VECTOR_BENCHMARK(AddEqual)
+	CL_VECTOR_BENCHMARK(SubtractEqual)
+	CL_VECTOR_BENCHMARK(Scale)
+	CL_VECTOR_BENCHMARK(ElementwiseProduct)
+	CL_VECTOR_BENCHMARK(ElementwiseDivision)
+	CL_VECTOR_BENCHMARK(IsNonZero)
+	CL_VECTOR_BENCHMARK(EuclideanNorm)
+	CL_VECTOR_BENCHMARK(ArgAbsMin)
+	CL_VECTOR_BENCHMARK(ArgAbsMax)
+
+#pragma endregion
+
+#pragma region Matrix
+
+	template<MemorySpace ms, MathDomain md>
+	static void AddEqualMatrix(benchmark::State& state)
+	{
+		const auto n = static_cast<unsigned>(state.range(0));
+		const auto B = cl::ColumnWiseMatrix<ms, md>::RandomUniform(n, n, 1234);
+		auto A = cl::ColumnWiseMatrix<ms, md>::RandomUniform(n, n, 2345);
+
+		double alpha = 1.0;
+		Run(state, [&]() {
+			cl::routines::AddEqualMatrix(A.GetTile(), B.GetTile(), MatrixOperation::None, MatrixOperation::None, 1.0, alpha);
+			alpha = -alpha;
+		});
+		SetCounters(state, 3.0 * n * n, 3.0 * n * n * ElementSize<md>());
+	}
+
+	template<MemorySpace ms, MathDomain md>
+	static void ScaleColumns(benchmark::State& state)
+	{
+		const auto n = static_cast<unsigned>(state.range(0));
+		const cl::Vector<ms, md> alpha(n, 1);
+		auto A = cl::ColumnWiseMatrix<ms, md>::RandomUniform(n, n, 1234);
+
+		Run(state, [&]() { cl::routines::ScaleColumns(A.GetTile(), alpha.GetBuffer()); });
+		SetCounters(state, 1.0 * n * n, (2.0 * n * n + n) * ElementSize<md>());
+	}
+
+	template<MemorySpace ms, MathDomain md>
+	static void Multiply(benchmark::State& state)
+	{
+		const auto n = static_cast<unsigned>(state.range(0));
+		const auto B = cl::ColumnWiseMatrix<ms, md>::RandomUniform(n, n, 1234);
+		const auto C = cl::ColumnWiseMatrix<ms, md>::RandomUniform(n, n, 2345);
+		cl::ColumnWiseMatrix<ms, md> A(n, n);
+
+		Run(state, [&]() { cl::routines::Multiply(A.GetTile(), B.GetTile(), C.GetTile()); });
+		SetCounters(state, 2.0 * n * n * n, 3.0 * n * n * ElementSize<md>());
+	}
+
+	/**
+	 * Product of the top-left n/2 x n/2 blocks
+	 */
+	template<MemorySpace ms, MathDomain md>
+	static void SubMultiply(benchmark::State& state)
+	{
+		const auto n = static_cast<unsigned>(state.range(0));
+		const unsigned m = n / 2;
+		const auto B = cl::ColumnWiseMatrix<ms, md>::RandomUniform(n, n, 1234);
+		const auto C = cl::ColumnWiseMatrix<ms, md>::RandomUniform(n, n, 2345);
+		cl::ColumnWiseMatrix<ms, md> A(n, n);
+
+		Run(state, [&]() { cl::routines::SubMultiply(A.GetTile(), B.GetTile(), C.GetTile(), m, m, m); });
+		SetCounters(state, 2.0 * m * m * m, 3.0 * m * m * ElementSize<md>());
+	}
+
+	/**
+	 * state.range(1) products of n x n matrices: many small ones are spread over the threads, few large ones use threaded BLAS
+	 */
+	template<MemorySpace ms, MathDomain md>
+	static void BatchedMultiply(benchmark::State& state)
+	{
+		const auto n = static_cast<unsigned>(state.range(0));
+		const auto nMatrices = static_cast<unsigned>(state.range(1));
+		cl::Tensor<ms, md> B(n, n, nMatrices);
+		B.RandomUniform(1234);
+		cl::Tensor<ms, md> C(n, n, nMatrices);
+		C.RandomUniform(2345);
+		cl::Tensor<ms, md> A(n, n, nMatrices);
+
+		Run(state, [&]() { cl::routines::BatchedMultiply(A.GetCube(), B.GetCube(), C.GetCube(), n * n, n * n); });
+		SetCounters(state, 2.0 * n * n * n * nMatrices, 3.0 * n * n * nMatrices * ElementSize<md>());
+	}
+
+	template<MemorySpace ms, MathDomain md>
+	static void Dot(benchmark::State& state)
+	{
+		const auto n = static_cast<unsigned>(state.range(0));
+		const auto A = cl::ColumnWiseMatrix<ms, md>::RandomUniform(n, n, 1234);
+		const auto x = cl::Vector<ms, md>::RandomUniform(n, 2345);
+		cl::Vector<ms, md> y(n);
+
+		Run(state, [&]() { cl::routines::Dot(y.GetBuffer(), A.GetTile(), x.GetBuffer()); });
+		SetCounters(state, 2.0 * n * n, (1.0 * n * n + 2.0 * n) * ElementSize<md>());
+	}
+
+	template<MemorySpace ms, MathDomain md>
+	static void KroneckerProduct(benchmark::State& state)
+	{
+		const auto n = static_cast<unsigned>(state.range(0));
+		const auto x = cl::Vector<ms, md>::RandomUniform(n, 1234);
+		const auto y = cl::Vector<ms, md>::RandomUniform(n, 2345);
+		cl::ColumnWiseMatrix<ms, md> A(n, n, 0);
+
+		double alpha = 1.0;
+		Run(state, [&]() {
+			cl::routines::KroneckerProduct(A.GetTile(), x.GetBuffer(), y.GetBuffer(), alpha);
+			alpha = -alpha;
+		});
+		SetCounters(state, 2.0 * n * n, (2.0 * n * n + 2.0 * n) * ElementSize<md>());
+	}
+
+	template<MemorySpace ms, MathDomain md>
+	static void BatchedTransposedKroneckerProduct(benchmark::State& state)
+	{
+		const auto n = static_cast<unsigned>(state.range(0));
+		const auto x = cl::ColumnWiseMatrix<ms, md>::RandomUniform(n, nBatches, 1234);
+		const auto y = cl::ColumnWiseMatrix<ms, md>::RandomUniform(n, nBatches, 2345);
+		cl::Tensor<ms, md> T(n, n, nBatches, 0);
+
+		double alpha = 1.0;
+		Run(state, [&]() {
+			cl::routines::BatchedTransposedKroneckerProduct(T.GetCube(), x.GetTile(), y.GetTile(), alpha);
+			alpha = -alpha;
+		});
+		SetCounters(state, 2.0 * n * n * nBatches, (2.0 * n * n + 2.0 * n) * nBatches * ElementSize<md>());
+	}
+
+	template<MemorySpace ms, MathDomain md>
+	static void CumulativeRowSum(benchmark::State& state)
+	{
+		const auto n = static_cast<unsigned>(state.range(0));
+		cl::ColumnWiseMatrix<ms, md> A(n, n, 0);
+
+		Run(state, [&]() { cl::routines::CumulativeRowSum(A.GetTile()); });
+		SetCounters(state, 1.0 * n * n, 2.0 * n * n * ElementSize<md>());
+	}
+
+	template<MemorySpace ms, MathDomain md>
+	static void RowWiseSum(benchmark::State& state)
+	{
+		const auto n = static_cast<unsigned>(state.range(0));
+		const auto A = cl::ColumnWiseMatrix<ms, md>::RandomUniform(n, n, 1234);
+		cl::Vector<ms, md> cache(n, 1);
+		cl::Vector<ms, md> x(n);
+
+		Run(state, [&]() { cl::routines::RowWiseSum(x.GetBuffer(), A.GetTile(), cache.GetBuffer()); });
+		SetCounters(state, 1.0 * n * n, (1.0 * n * n + 2.0 * n) * ElementSize<md>());
+	}
+
+	template<MemorySpace ms, MathDomain md>
+	static void CubeWiseSum(benchmark::State& state)
+	{
+		const auto n = static_cast<unsigned>(state.range(0));
+		const auto T = cl::Tensor<ms, md>::RandomUniform(n, n, nBatches, 1234);
+		cl::ColumnWiseMatrix<ms, md> A(n, n);
+		MemoryCube cacheReshape;
+		MemoryBuffer cacheOnes;
+
+		Run(state, [&]() { cl::routines::CubeWiseSum(A.GetTile(), T.GetCube(), cacheReshape, cacheOnes); });
+		SetCounters(state, 2.0 * n * n * nBatches, (2.0 * n * n * nBatches + n * n) * ElementSize<md>());
+
+		cl::routines::Free(cacheReshape);
+		cl::routines::Free(cacheOnes);
+	}
+
+	/**
+	 * LU factorization and solve with n right hand sides: B is overwritten, and it's used as the next right hand side
+	 */
+	template<MemorySpace ms, MathDomain md>
+	static void Solve(benchmark::State& state)
+	{
+		const auto n = static_cast<unsigned>(state.range(0));
+		const auto A = GetInvertibleMatrix<ms, md>(n);
+		auto B = cl::ColumnWiseMatrix<ms, md>::RandomUniform(n, n, 2345);
+
+		Run(state, [&]() { cl::routines::Solve(A.GetTile(), B.GetTile()); });
+		SetCounters(state, 2.0 / 3.0 * n * n * n + 2.0 * n * n * n, 3.0 * n * n * ElementSize<md>());
+	}
+
+	/**
+	 * LU factorization only: this includes the copy of A into the factorization
+	 */
+	template<MemorySpace ms, MathDomain md>
+	static void Factorize(benchmark::State& state)
+	{
+		const auto n = static_cast<unsigned>(state.range(0));
+		const auto A = GetInvertibleMatrix<ms, md>(n);
+
+		std::unique_ptr<cl::Factorization<ms, md>> factorization {};
+		Run(state, [&]() {
+			if (!factorization)
+				factorization = std::make_unique<cl::Factorization<ms, md>>(A);
+			else
+				factorization->Update(A);
+		});
+		SetCounters(state, 2.0 / 3.0 * n * n * n, 2.0 * n * n * ElementSize<md>());
+	}
+
+	/**
+	 * Solve with n right hand sides given the LU factorization
+	 */
+	template<MemorySpace ms, MathDomain md>
+	static void SolveFactorized(benchmark::State& state)
+	{
+		const auto n = static_cast<unsigned>(state.range(0));
+		const auto A = GetInvertibleMatrix<ms, md>(n);
+		auto B = cl::ColumnWiseMatrix<ms, md>::RandomUniform(n, n, 2345);
+
+		std::unique_ptr<cl::Factorization<ms, md>> factorization {};
+		Run(state, [&]() {
+			if (!factorization)
+				factorization = std::make_unique<cl::Factorization<ms, md>>(A);
+			factorization->Solve(B);
+		});
+		SetCounters(state, 2.0 * n * n * n, 3.0 * n * n * ElementSize<md>());
+	}
+
+	/**
+	 * A is replaced by its inverse, which is inverted again at the next iteration
+	 */
+	template<MemorySpace ms, MathDomain md>
+	static void Invert(benchmark::State& state)
+	{
+		const auto n = static_cast<unsigned>(state.range(0));
+		auto A = GetInvertibleMatrix<ms, md>(n);
+
+		Run(state, [&]() { cl::routines::Invert(A.GetTile()); });
+		SetCounters(state, 2.0 * n * n * n, 2.0 * n * n * ElementSize<md>());
+	}
+
+	template<MemorySpace ms, MathDomain md>
+	static void ColumnWiseArgAbsMin(benchmark::State& state)
+	{
+		const auto n = static_cast<unsigned>(state.range(0));
+		const auto A = cl::ColumnWiseMatrix<ms, md>::RandomGaussian(n, n, 1234);
+		cl::Vector<ms, MathDomain::Int> argMin(n);
+
+		Run(state, [&]() { cl::routines::ColumnWiseArgAbsMin(argMin.GetBuffer(), A.GetTile()); });
+		SetCounters(state, 1.0 * n * n, 1.0 * n * n * ElementSize<md>());
+	}
+
+	template<MemorySpace ms, MathDomain md>
+	static void ColumnWiseArgAbsMax(benchmark::State& state)
+	{
+		const auto n = static_cast<unsigned>(state.range(0));
+		const auto A = cl::ColumnWiseMatrix<ms, md>::RandomGaussian(n, n, 1234);
+		cl::Vector<ms, MathDomain::Int> argMax(n);
+
+		Run(state, [&]() { cl::routines::ColumnWiseArgAbsMax(argMax.GetBuffer(), A.GetTile()); });
+		SetCounters(state, 1.0 * n * n, 1.0 * n * n * ElementSize<md>());
+	}
+
+	CL_MATRIX_BENCHMARK(AddEqualMatrix)
+	CL_MATRIX_BENCHMARK(ScaleColumns)
+	CL_MATRIX_BENCHMARK(Multiply)
+	CL_MATRIX_BENCHMARK(SubMultiply)
+	CL_BENCHMARK(BatchedMultiply, ->Args({ 8, 4096 })->Args({ 16, 1024 })->Args({ 32, 256 })->Args({ 128, 16 })->Args({ 512, 4 })->ArgNames({ "n", "batches" })->Unit(benchmark::kMicrosecond))
+	CL_MATRIX_BENCHMARK(Dot)
+	CL_MATRIX_BENCHMARK(KroneckerProduct)
+	CL_MATRIX_BENCHMARK(BatchedTransposedKroneckerProduct)
+	CL_MATRIX_BENCHMARK(CumulativeRowSum)
+	CL_MATRIX_BENCHMARK(RowWiseSum)
+	CL_MATRIX_BENCHMARK(CubeWiseSum)
+	CL_MATRIX_BENCHMARK(Solve)
+	CL_MATRIX_BENCHMARK(Factorize)
+	CL_MATRIX_BENCHMARK(SolveFactorized)
+	CL_MATRIX_BENCHMARK(Invert)
+	CL_MATRIX_BENCHMARK(ColumnWiseArgAbsMin)
+	CL_MATRIX_BENCHMARK(ColumnWiseArgAbsMax)
+
+#pragma endregion
+}	 // namespace clb
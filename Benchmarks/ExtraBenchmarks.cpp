@@ -0,0 +1,61 @@
+#include <Benchmarks/BenchmarkHelpers.h>
+
+#include <Vector.h>
+
+#include <HostRoutines/Extra.h>
+
+namespace clb
+{
+	/**
+	 * Reductions to a scalar: function is one of the routines in Extra.h
+	 */
+	template<MemorySpace ms, MathDomain md, typename F>
+	static void Reduce(benchmark::State& state, const F& function)
+	{
+		const auto n = static_cast<unsigned>(state.range(0));
+		const auto x = cl::Vector<ms, md>::RandomGaussian(n, 1234);
+
+		double result = 0.0;
+		Run(state, [&]() {
+			function(result, x.GetBuffer());
+			benchmark::DoNotOptimize(result);
+		});
+		SetCounters(state, n, 1.0 * n * ElementSize<md>());
+	}
+
+	template<MemorySpace ms, MathDomain md>
+	static void Sum(benchmark::State& state)
+	{
+		Reduce<ms, md>(state, [](double& result, const MemoryBuffer& x) { cl::routines::Sum(result, x); });
+	}
+
+	template<MemorySpace ms, MathDomain md>
+	static void Min(benchmark::State& state)
+	{
+		Reduce<ms, md>(state, [](double& result, const MemoryBuffer& x) { cl::routines::Min(result, x); });
+	}
+
+	template<MemorySpace ms, MathDomain md>
+	static void Max(benchmark::State& state)
+	{
+		Reduce<ms, md>(state, [](double& result, const MemoryBuffer& x) { cl::routines::Max(result, x); });
+	}
+
+	template<MemorySpace ms, MathDomain md>
+	static void AbsMin(benchmark::State& state)
+	{
+		Reduce<ms, md>(state, [](double& result, const MemoryBuffer& x) { cl::routines::AbsMin(result, x); });
+	}
+
+	template<MemorySpace ms, MathDomain md>
+	static void AbsMax(benchmark::State& state)
+	{
+		Reduce<ms, md>(state, [](double& result, const MemoryBuffer& x) { cl::routines::AbsMax(result, x); });
+	}
+
+	CL_VECTOR_BENCHMARK(Sum)
+	CL_VECTOR_BENCHMARK(Min)
+	CL_VECTOR_BENCHMARK(Max)
+	CL_VECTOR_BENCHMARK(AbsMin)
+	CL_VECTOR_BENCHMARK(AbsMax)
+}	 // namespace clb
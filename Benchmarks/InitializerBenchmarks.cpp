@@ -0,0 +1,91 @@
+#include <Benchmarks/BenchmarkHelpers.h>
+
+#include <ColumnWiseMatrix.h>
+#include <Vector.h>
+
+#include <HostRoutines/BufferInitializer.h>
+
+namespace clb
+{
+	template<MemorySpace ms, MathDomain md>
+	static void Initialize(benchmark::State& state)
+	{
+		const auto n = static_cast<unsigned>(state.range(0));
+		cl::Vector<ms, md> x(n);
+
+		Run(state, [&]() { cl::routines::Initialize(x.GetBuffer(), 1.0); });
+		SetCounters(state, 0.0, 1.0 * n * ElementSize<md>());
+	}
+
+	template<MemorySpace ms, MathDomain md>
+	static void LinSpace(benchmark::State& state)
+	{
+		const auto n = static_cast<unsigned>(state.range(0));
+		cl::Vector<ms, md> x(n);
+
+		Run(state, [&]() { cl::routines::LinSpace(x.GetBuffer(), -1.0, 1.0); });
+		SetCounters(state, 2.0 * n, 1.0 * n * ElementSize<md>());
+	}
+
+	template<MemorySpace ms, MathDomain md>
+	static void RandUniform(benchmark::State& state)
+	{
+		const auto n = static_cast<unsigned>(state.range(0));
+		cl::Vector<ms, md> x(n);
+
+		unsigned seed = 1234;
+		Run(state, [&]() { cl::routines::RandUniform(x.GetBuffer(), seed++); });
+		SetCounters(state, 0.0, 1.0 * n * ElementSize<md>());
+	}
+
+	template<MemorySpace ms, MathDomain md>
+	static void RandNormal(benchmark::State& state)
+	{
+		const auto n = static_cast<unsigned>(state.range(0));
+		cl::Vector<ms, md> x(n);
+
+		unsigned seed = 1234;
+		Run(state, [&]() { cl::routines::RandNormal(x.GetBuffer(), seed++); });
+		SetCounters(state, 0.0, 1.0 * n * ElementSize<md>());
+	}
+
+	template<MemorySpace ms, MathDomain md>
+	static void RandShuffle(benchmark::State& state)
+	{
+		const auto n = static_cast<unsigned>(state.range(0));
+		auto x = cl::Vector<ms, md>::LinSpace(0, 1, n);
+
+		unsigned seed = 1234;
+		Run(state, [&]() { cl::routines::RandShuffle(x.GetBuffer(), seed++); });
+		SetCounters(state, 0.0, 2.0 * n * ElementSize<md>());
+	}
+
+	template<MemorySpace ms, MathDomain md>
+	static void Eye(benchmark::State& state)
+	{
+		const auto n = static_cast<unsigned>(state.range(0));
+		cl::ColumnWiseMatrix<ms, md> A(n, n);
+
+		Run(state, [&]() { cl::routines::Eye(A.GetTile()); });
+		SetCounters(state, 0.0, 1.0 * n * n * ElementSize<md>());
+	}
+
+	template<MemorySpace ms, MathDomain md>
+	static void RandShuffleColumns(benchmark::State& state)
+	{
+		const auto n = static_cast<unsigned>(state.range(0));
+		auto A = cl::ColumnWiseMatrix<ms, md>::RandomUniform(n, n, 1234);
+
+		unsigned seed = 1234;
+		Run(state, [&]() { cl::routines::RandShuffleColumns(A.GetTile(), seed++); });
+		SetCounters(state, 0.0, 2.0 * n * n * ElementSize<md>());
+	}
+
+	CL_VECTOR_BENCHMARK(Initialize)
+	CL_VECTOR_BENCHMARK(LinSpace)
+	CL_VECTOR_BENCHMARK(RandUniform)
+	CL_VECTOR_BENCHMARK(RandNormal)
+	CL_VECTOR_BENCHMARK(RandShuffle)
+	CL_MATRIX_BENCHMARK(Eye)
+	CL_MATRIX_BENCHMARK(RandShuffleColumns)
+}	 // namespace clb
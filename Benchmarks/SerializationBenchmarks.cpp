@@ -0,0 +1,47 @@
+#include <Benchmarks/BenchmarkHelpers.h>
+
+#include <ColumnWiseMatrix.h>
+
+#include <cstdio>
+#include <string>
+
+namespace clb
+{
+	static std::string GetFileName(const benchmark::State& state)
+	{
+		return "clBenchmark" + std::to_string(state.thread_index()) + "_" + std::to_string(state.range(0)) + ".npy";
+	}
+
+	template<MemorySpace ms, MathDomain md>
+	static void ToBinaryFile(benchmark::State& state)
+	{
+		const auto n = static_cast<unsigned>(state.range(0));
+		const auto A = cl::ColumnWiseMatrix<ms, md>::RandomUniform(n, n, 1234);
+		const std::string fileName = GetFileName(state);
+
+		Run(state, [&]() { A.ToBinaryFile(fileName); });
+		SetCounters(state, 0.0, 1.0 * n * n * ElementSize<md>());
+
+		std::remove(fileName.c_str());
+	}
+
+	/**
+	 * Loads the matrix, either copying it or mapping the file in memory
+	 */
+	template<MemorySpace ms, MathDomain md>
+	static void FromBinaryFile(benchmark::State& state)
+	{
+		const auto n = static_cast<unsigned>(state.range(0));
+		const bool useMemoryMapping = state.range(1) != 0;
+		const std::string fileName = GetFileName(state);
+		cl::ColumnWiseMatrix<ms, md>::RandomUniform(n, n, 1234).ToBinaryFile(fileName);
+
+		Run(state, [&]() { benchmark::DoNotOptimize(cl::ColumnWiseMatrix<ms, md>::MatrixFromBinaryFile(fileName, false, false, useMemoryMapping)); });
+		SetCounters(state, 0.0, 1.0 * n * n * ElementSize<md>());
+
+		std::remove(fileName.c_str());
+	}
+
+	CL_MATRIX_BENCHMARK(ToBinaryFile)
+	CL_BENCHMARK(FromBinaryFile, ->ArgsProduct({ benchmark::CreateRange(minMatrixSize, maxMatrixSize, 2), { 0, 1 } })->ArgNames({ "n", "mmap" })->Unit(benchmark::kMicrosecond))
+}	 // namespace clb
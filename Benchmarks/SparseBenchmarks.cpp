@@ -0,0 +1,95 @@
+#include <Benchmarks/BenchmarkHelpers.h>
+
+#include <ColumnWiseMatrix.h>
+#include <CompressedSparseRowMatrix.h>
+#include <SparseVector.h>
+#include <Vector.h>
+
+#include <vector>
+
+namespace clb
+{
+	// non-zeros per row of the sparse matrices, and one every sparsityRatio elements in sparse vectors
+	static constexpr unsigned nBands = { 16 };
+	static constexpr unsigned sparsityRatio = { 16 };
+
+	/**
+	 * n x n matrix with nBands non-zeros per row, scattered across the columns
+	 */
+	template<MemorySpace ms, MathDomain md>
+	static cl::CompressedSparseRowMatrix<ms, md> GetBandedMatrix(const unsigned n)
+	{
+		std::vector<int> _nonZeroColumnIndices(static_cast<size_t>(n) * nBands);
+		std::vector<int> _nNonZeroRows(n + 1);
+		for (unsigned i = 0; i < n; ++i)
+		{
+			_nNonZeroRows[i] = static_cast<int>(i * nBands);
+
+			// columns must be sorted within each row
+			const unsigned bandWidth = n / nBands;
+			for (unsigned k = 0; k < nBands; ++k)
+				_nonZeroColumnIndices[i * nBands + k] = static_cast<int>(k * bandWidth + i % bandWidth);
+		}
+		_nNonZeroRows[n] = static_cast<int>(n * nBands);
+
+		cl::Vector<ms, MathDomain::Int> nonZeroColumnIndices(static_cast<unsigned>(_nonZeroColumnIndices.size()), 0);
+		nonZeroColumnIndices.ReadFrom(_nonZeroColumnIndices);
+		cl::Vector<ms, MathDomain::Int> nNonZeroRows(static_cast<unsigned>(_nNonZeroRows.size()), 0);
+		nNonZeroRows.ReadFrom(_nNonZeroRows);
+
+		return cl::CompressedSparseRowMatrix<ms, md>(n, n, std::move(nonZeroColumnIndices), std::move(nNonZeroRows), 1);
+	}
+
+	/**
+	 * SparseAdd through SparseVector::Add, which allocates the output
+	 */
+	template<MemorySpace ms, MathDomain md>
+	static void SparseAdd(benchmark::State& state)
+	{
+		const auto n = static_cast<unsigned>(state.range(0));
+		std::vector<int> _indices(n / sparsityRatio);
+		for (size_t i = 0; i < _indices.size(); ++i)
+			_indices[i] = static_cast<int>(i * sparsityRatio);
+		cl::Vector<ms, MathDomain::Int> indices(static_cast<unsigned>(_indices.size()), 0);
+		indices.ReadFrom(_indices);
+
+		const cl::SparseVector<ms, md> x(n, indices, 1);
+		const auto y = cl::Vector<ms, md>::RandomUniform(n, 1234);
+
+		Run(state, [&]() { benchmark::DoNotOptimize(x.Add(y, 2.0)); });
+		SetCounters(state, 2.0 * _indices.size(), (2.0 * n + 2.0 * _indices.size()) * ElementSize<md>());
+	}
+
+	template<MemorySpace ms, MathDomain md>
+	static void SparseDot(benchmark::State& state)
+	{
+		const auto n = static_cast<unsigned>(state.range(0));
+		const auto A = GetBandedMatrix<ms, md>(n);
+		const auto x = cl::Vector<ms, md>::RandomUniform(n, 1234);
+		cl::Vector<ms, md> y(n);
+
+		const double nNonZeros = static_cast<double>(n) * nBands;
+		Run(state, [&]() { A.Dot(y, x); });
+		SetCounters(state, 2.0 * nNonZeros, nNonZeros * (ElementSize<md>() + sizeof(int)) + 2.0 * n * ElementSize<md>());
+	}
+
+	/**
+	 * Sparse n x n times dense n x nBands
+	 */
+	template<MemorySpace ms, MathDomain md>
+	static void SparseMultiply(benchmark::State& state)
+	{
+		const auto n = static_cast<unsigned>(state.range(0));
+		const auto A = GetBandedMatrix<ms, md>(n);
+		const auto B = cl::ColumnWiseMatrix<ms, md>::RandomUniform(n, nBands, 1234);
+		cl::ColumnWiseMatrix<ms, md> C(n, nBands);
+
+		const double nNonZeros = static_cast<double>(n) * nBands;
+		Run(state, [&]() { A.Multiply(C, B); });
+		SetCounters(state, 2.0 * nNonZeros * nBands, nNonZeros * (ElementSize<md>() + sizeof(int)) + 2.0 * n * nBands * ElementSize<md>());
+	}
+
+	CL_VECTOR_BENCHMARK(SparseAdd)
+	CL_VECTOR_BENCHMARK(SparseDot)
+	CL_VECTOR_BENCHMARK(SparseMultiply)
+}	 // namespace clb
@@ -0,0 +1,18 @@
+#include <benchmark/benchmark.h>
+
+/**
+ * Results can be saved as JSON for comparing providers/commits, e.g.
+ *   CudaLightBenchmarks --benchmark_out=results.json --benchmark_out_format=json
+ * and filtered by routine, provider or precision, e.g.
+ *   CudaLightBenchmarks --benchmark_filter='Multiply<MemorySpace::OpenBlas'
+ */
+int main(int ac, char* av[])
+{
+	benchmark::Initialize(&ac, av);
+	if (benchmark::ReportUnrecognizedArguments(ac, av))
+		return 1;
+
+	benchmark::RunSpecifiedBenchmarks();
+	benchmark::Shutdown();
+	return 0;
+}
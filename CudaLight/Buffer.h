@@ -1,6 +1,7 @@
 #pragma once
 
 #include <iostream>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -10,6 +11,10 @@
 #include <IBuffer.h>
 #include <Types.h>
 
+#include <HostRoutines/MemoryMappedFile.h>
+#include <HostRoutines/NpyFile.h>
+#include <HostRoutines/NpzFile.h>
+
 namespace cl
 {
 	/*
@@ -69,6 +74,22 @@ namespace cl
 		IBuffer<memorySpace, mathDomain>& Scale(const double alpha) final;
 		IBuffer<memorySpace, mathDomain>& ElementWiseProduct(const IBuffer<memorySpace, mathDomain>& rhs, const double alpha = 1.0) final;
 
+		// element-wise functions, in place: host memory spaces only
+		IBuffer<memorySpace, mathDomain>& Exp() final;
+		IBuffer<memorySpace, mathDomain>& Log() final;
+		IBuffer<memorySpace, mathDomain>& Sqrt() final;
+		IBuffer<memorySpace, mathDomain>& Pow(const double exponent) final;
+		IBuffer<memorySpace, mathDomain>& Tanh() final;
+		IBuffer<memorySpace, mathDomain>& Erf() final;
+
+		// out = f(*this), element by element: out has to have the same size
+		void Exp(BufferImpl& out) const;
+		void Log(BufferImpl& out) const;
+		void Sqrt(BufferImpl& out) const;
+		void Pow(BufferImpl& out, const double exponent) const;
+		void Tanh(BufferImpl& out) const;
+		void Erf(BufferImpl& out) const;
+
 		int AbsoluteMinimumIndex() const final;
 		int AbsoluteMaximumIndex() const final;
 		stdType AbsoluteMinimum() const final;
@@ -83,6 +104,10 @@ namespace cl
 #pragma endregion
 
 		inline bool OwnsMemory() const noexcept { return _isOwner; }
+		inline bool IsMemoryMapped() const noexcept { return _mapping != nullptr; }
+
+		// false for the matrix views that don't span all the rows of the matrix they refer to
+		bool IsContiguous() const noexcept;
 
 	protected:
 		explicit Buffer(const bool isOwner);
@@ -106,13 +131,55 @@ namespace cl
 		void ctor(MemoryBuffer& buffer);
 		void dtor(MemoryBuffer& buffer);
 
+		/**
+		 * Runs f on each contiguous chunk of memory of this buffer (see detail::GetNumberOfChunks), together with the matching chunk of rhs:
+		 * the element-wise routines can't run on a strided matrix view as a whole
+		 */
+		template<typename F>
+		void ForEachChunk(const F& f);
+		template<typename F>
+		void ForEachChunk(const F& f) const;
+		template<typename F>
+		void ForEachChunk(const BufferImpl& rhs, const F& f);
+		/** Copies rhs into this buffer, going through the columns of strided views */
+		void ReadChunksFrom(const BufferImpl& rhs);
+
 		static void Alloc(MemoryBuffer& buffer);
 
+		/**
+		 * Maps an uncompressed .npy file, which is then kept alive by this instance. Returns the pointer to the array data,
+		 * or 0 when the file can't be used in place (different element type, memory order other than fortranOrder for
+		 * multi-dimensional arrays, misaligned data or non-host memory space), in which case the caller has to fall back to
+		 * loading a copy. arrayOffset is where the .npy file starts, for arrays stored in a .npz archive.
+		 */
+		ptr_t MapFile(const std::string& fileName, std::vector<size_t>& shape, const bool fortranOrder = false, const size_t arrayOffset = 0);
+
 		bool _isOwner;
+
+		// file backing the buffer, when it has been memory mapped
+		std::shared_ptr<const routines::MemoryMappedFile> _mapping {};
 	};
 
 	namespace detail
 	{
+		/**
+		 * Vectors and tensors are a single contiguous chunk, as well as matrices unless they are views that don't span all the rows of
+		 * the matrix they refer to (i.e. their leading dimension is larger than their number of rows): those are split into their columns
+		 */
+		inline unsigned GetNumberOfChunks(const MemoryBuffer&) noexcept { return 1; }
+		inline unsigned GetNumberOfChunks(const MemoryTile& tile) noexcept { return tile.leadingDimension == tile.nRows || tile.nCols <= 1 ? 1 : tile.nCols; }
+
+		inline MemoryBuffer GetChunk(const MemoryBuffer& buffer, const unsigned, const unsigned) noexcept { return buffer; }
+		inline MemoryBuffer GetChunk(const MemoryTile& tile, const unsigned chunk, const unsigned nChunks) noexcept
+		{
+			if (nChunks == 1)
+				return static_cast<const MemoryBuffer&>(tile);
+
+			MemoryBuffer column;
+			ExtractColumnBufferFromMatrix(column, tile, chunk);
+			return column;
+		}
+
 		template<MathDomain md>
 		void Fill(std::vector<typename Traits<md>::stdType>& dest, const MemoryBuffer& source)
 		{
@@ -177,6 +244,34 @@ namespace cl
 	template<typename T>
 	static std::vector<T> MatrixFromBinaryFile(unsigned& nRows, unsigned& nCols, const std::string& fileName, const bool compressed = false, const bool useMemoryMapping = false);
 
+	/**
+	 * The matrices of a tensor are saved as a (nRows, nCols, nMatrices) array: uncompressed files are written in fortran order, which is the
+	 * layout of the tensor buffer, whereas compressed ones are reordered to C order. Both orders are read back.
+	 */
+	template<typename T>
+	static void TensorToBinaryFile(const std::vector<T>& t, const unsigned nRows, const unsigned nCols, const unsigned nMatrices, const std::string& fileName, const bool compressed = false, const std::string mode = "w");
+
+	template<typename T>
+	static void TensorFromBinaryFile(std::vector<T>& t, unsigned& nRows, unsigned& nCols, unsigned& nMatrices, const std::string& fileName, const bool compressed = false);
+
+	/**
+	 * Sparse matrices are saved in the .npz layout of scipy.sparse.save_npz for a csr_matrix: its data, indices and indptr arrays, plus
+	 * its format and shape. Uncompressed archives store the arrays as they are, so that they can be memory mapped.
+	 */
+	template<typename T>
+	static void SparseMatrixToBinaryFile(const T* values, const int* nonZeroColumnIndices, const int* nNonZeroRows, const unsigned nNonZeros, const unsigned nRows, const unsigned nCols, const std::string& fileName, const bool compressed = false);
+
+	/**
+	 * Shape of a sparse matrix saved by SparseMatrixToBinaryFile or scipy.sparse.save_npz: it throws if it's not in csr format
+	 */
+	inline void SparseMatrixShapeFromBinaryFile(routines::NpzFileReader& reader, unsigned& nRows, unsigned& nCols);
+
+	/**
+	 * Converts the array data of a .npy file to T, whatever its element type
+	 */
+	template<typename T>
+	static void NpyDataToVector(std::vector<T>& out, const routines::NpyHeader& header, const std::vector<char>& data);
+
 #pragma endregion
 }	 // namespace cl
 
@@ -3,14 +3,20 @@
 #include <iostream>
 #include <iomanip>
 #include <assert.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
 #include <limits>
+#include <type_traits>
 
 #include <Types.h>
 #include <Npy++.h>
 #include <HostRoutines/MemoryManager.h>
 #include <HostRoutines/BufferInitializer.h>
+#include <HostRoutines/Exceptions.h>
 #include <HostRoutines/BlasWrappers.h>
 #include <HostRoutines/Extra.h>
+#include <HostRoutines/Parallel.h>
 
 namespace cl
 {
@@ -22,7 +28,7 @@ namespace cl
 	
 	template<typename bi, MemorySpace ms, MathDomain md>
 	Buffer<bi, ms, md>::Buffer(Buffer&& buf) noexcept
-			: _isOwner(buf._isOwner)
+			: _isOwner(buf._isOwner), _mapping(std::move(buf._mapping))
 	{
 		buf._isOwner = false;  // otherwise the destructor will destroy the memory
 	}
@@ -58,6 +64,30 @@ namespace cl
 		}
 	}
 
+	template<typename bi, MemorySpace ms, MathDomain md>
+	ptr_t Buffer<bi, ms, md>::MapFile(const std::string& fileName, std::vector<size_t>& shape, const bool fortranOrder, const size_t arrayOffset)
+	{
+		// device memory can't point to a file mapping, and pinned host memory has to be allocated by cuda
+		if (ms == MemorySpace::Host || ms == MemorySpace::Device)
+			return 0;
+
+		auto mapping = std::make_shared<const routines::MemoryMappedFile>(fileName, arrayOffset);
+		if (!mapping->HasMathDomain(md) || mapping->GetSize() == 0)
+			return 0;
+		if (mapping->GetShape().size() > 1 && mapping->IsFortranOrder() != fortranOrder)
+			return 0;
+
+		// the mapping is page aligned, but arrays in a .npz archive written by numpy don't need to be
+		if (mapping->GetData() % sizeof(typename Traits<md>::stdType) != 0)
+			return 0;
+
+		shape = mapping->GetShape();
+		_mapping = std::move(mapping);
+		_isOwner = false;  // the memory belongs to the mapping, which is released with this instance
+
+		return _mapping->GetData();
+	}
+
 	template<typename bi, MemorySpace ms, MathDomain md>
 	template<typename biRhs, MemorySpace msRhs, MathDomain mdRhs>
 	void Buffer<bi, ms, md>::ReadFrom(const Buffer<biRhs, msRhs, mdRhs>& rhs)
@@ -79,51 +109,60 @@ namespace cl
 					  (std::is_same<T, float>::value && md == MathDomain::Float)
 						||
 					  (std::is_same<T, int>::value && md == MathDomain::Int), "Invalid type");
-		MemoryBuffer& buffer = static_cast<bi*>(this)->_buffer;
-		assert(buffer.pointer != 0);
-
-		MemoryBuffer rhsBuf;
-		auto pointer = reinterpret_cast<ptr_t>(rhs.data());
-
 		const MemorySpace rhsMemorySpace = ms == MemorySpace::Host || ms == MemorySpace::Device ? MemorySpace::Host : ms;
-		rhsBuf = MemoryBuffer(pointer, static_cast<unsigned>(rhs.size()), rhsMemorySpace, _Traits<T>::clType);
 
-		if (ms == MemorySpace::Host || ms == MemorySpace::Device)
-			dm::detail::AutoCopy(buffer, rhsBuf);
-		else
-			routines::Copy(buffer, rhsBuf);
+		// each chunk is read from where the previous one ends
+		size_t offset = 0;
+		ForEachChunk([&](MemoryBuffer& buffer) {
+			assert(offset <= rhs.size());
+			auto pointer = reinterpret_cast<ptr_t>(rhs.data() + offset);
+			MemoryBuffer rhsBuf(pointer, static_cast<unsigned>(std::min<size_t>(buffer.size, rhs.size() - offset)), rhsMemorySpace, _Traits<T>::clType);
+			offset += buffer.size;
+
+			if (ms == MemorySpace::Host || ms == MemorySpace::Device)
+				dm::detail::AutoCopy(buffer, rhsBuf);
+			else
+				routines::Copy(buffer, rhsBuf);
+		});
 	}
 
 	template<typename bi, MemorySpace ms, MathDomain md>
 	void Buffer<bi, ms, md>::Set(const stdType value)
 	{
-		MemoryBuffer& buffer = static_cast<bi*>(this)->_buffer;
-		assert(buffer.pointer != 0);
-
-		if (ms == MemorySpace::Host || ms == MemorySpace::Device)
-			dm::detail::Initialize(buffer, static_cast<double>(value));
-		else
-			routines::Initialize(buffer, static_cast<double>(value));
+		ForEachChunk([value](MemoryBuffer& buffer) {
+			if (ms == MemorySpace::Host || ms == MemorySpace::Device)
+				dm::detail::Initialize(buffer, static_cast<double>(value));
+			else
+				routines::Initialize(buffer, static_cast<double>(value));
+		});
 	}
 	
 	template<typename bi, MemorySpace ms, MathDomain md>
 	void Buffer<bi, ms, md>::Reciprocal()
 	{
-		MemoryBuffer& buffer = static_cast<bi*>(this)->_buffer;
-		assert(buffer.pointer != 0);
-
-		if (ms == MemorySpace::Host || ms == MemorySpace::Device)
-			dm::detail::Reciprocal(buffer);
-		else
-			routines::Reciprocal(buffer);
+		ForEachChunk([](MemoryBuffer& buffer) {
+			if (ms == MemorySpace::Host || ms == MemorySpace::Device)
+				dm::detail::Reciprocal(buffer);
+			else
+				routines::Reciprocal(buffer);
+		});
 	}
 	
 	template<typename bi, MemorySpace ms, MathDomain md>
 	void Buffer<bi, ms, md>::LinSpace(const stdType x0, const stdType x1)
 	{
-		MemoryBuffer& buffer = static_cast<bi*>(this)->_buffer;
+		auto& buffer = static_cast<bi*>(this)->_buffer;
 		assert(buffer.pointer != 0);
 
+		// the values depend on the position in the whole buffer: a strided view gets them from a contiguous copy
+		if (!IsContiguous())
+		{
+			bi tmp(*static_cast<bi*>(this));
+			tmp.LinSpace(x0, x1);
+			ReadChunksFrom(tmp);
+			return;
+		}
+
 		if (ms == MemorySpace::Host || ms == MemorySpace::Device)
 			dm::detail::LinSpace(buffer, static_cast<double>(x0), static_cast<double>(x1));
 		else
@@ -133,9 +172,18 @@ namespace cl
 	template<typename bi, MemorySpace ms, MathDomain md>
 	void Buffer<bi, ms, md>::RandomUniform(const unsigned seed)
 	{
-		MemoryBuffer& buffer = static_cast<bi*>(this)->_buffer;
+		auto& buffer = static_cast<bi*>(this)->_buffer;
 		assert(buffer.pointer != 0);
 
+		// the values depend on the position in the whole buffer: a strided view gets them from a contiguous copy
+		if (!IsContiguous())
+		{
+			bi tmp(*static_cast<bi*>(this));
+			tmp.RandomUniform(seed);
+			ReadChunksFrom(tmp);
+			return;
+		}
+
 		if (ms == MemorySpace::Host || ms == MemorySpace::Device)
 			dm::detail::RandUniform(buffer, seed);
 		else
@@ -145,9 +193,18 @@ namespace cl
 	template<typename bi, MemorySpace ms, MathDomain md>
 	void Buffer<bi, ms, md>::RandomGaussian(const unsigned seed)
 	{
-		MemoryBuffer& buffer = static_cast<bi*>(this)->_buffer;
+		auto& buffer = static_cast<bi*>(this)->_buffer;
 		assert(buffer.pointer != 0);
 
+		// the values depend on the position in the whole buffer: a strided view gets them from a contiguous copy
+		if (!IsContiguous())
+		{
+			bi tmp(*static_cast<bi*>(this));
+			tmp.RandomGaussian(seed);
+			ReadChunksFrom(tmp);
+			return;
+		}
+
 		if (ms == MemorySpace::Host || ms == MemorySpace::Device)
 			dm::detail::RandNormal(buffer, seed);
 		else
@@ -211,6 +268,71 @@ namespace cl
 		}
 	}
 
+	template<typename bi, MemorySpace ms, MathDomain md>
+	bool Buffer<bi, ms, md>::IsContiguous() const noexcept
+	{
+		return detail::GetNumberOfChunks(static_cast<const bi*>(this)->_buffer) == 1;
+	}
+
+	template<typename bi, MemorySpace ms, MathDomain md>
+	template<typename F>
+	void Buffer<bi, ms, md>::ForEachChunk(const F& f)
+	{
+		const auto& buffer = static_cast<const bi*>(this)->_buffer;
+		assert(buffer.pointer != 0);
+
+		const unsigned nChunks = detail::GetNumberOfChunks(buffer);
+		for (unsigned i = 0; i < nChunks; ++i)
+		{
+			MemoryBuffer chunk = detail::GetChunk(buffer, i, nChunks);
+			f(chunk);
+		}
+	}
+
+	template<typename bi, MemorySpace ms, MathDomain md>
+	template<typename F>
+	void Buffer<bi, ms, md>::ForEachChunk(const F& f) const
+	{
+		const auto& buffer = static_cast<const bi*>(this)->_buffer;
+		assert(buffer.pointer != 0);
+
+		const unsigned nChunks = detail::GetNumberOfChunks(buffer);
+		for (unsigned i = 0; i < nChunks; ++i)
+		{
+			const MemoryBuffer chunk = detail::GetChunk(buffer, i, nChunks);
+			f(chunk);
+		}
+	}
+
+	template<typename bi, MemorySpace ms, MathDomain md>
+	template<typename F>
+	void Buffer<bi, ms, md>::ForEachChunk(const bi& rhs, const F& f)
+	{
+		const auto& buffer = static_cast<const bi*>(this)->_buffer;
+		assert(buffer.pointer != 0);
+		assert(rhs._buffer.pointer != 0);
+
+		// as soon as one of the two is a strided view, both are split into their columns
+		const unsigned nChunks = std::max(detail::GetNumberOfChunks(buffer), detail::GetNumberOfChunks(rhs._buffer));
+		for (unsigned i = 0; i < nChunks; ++i)
+		{
+			MemoryBuffer chunk = detail::GetChunk(buffer, i, nChunks);
+			const MemoryBuffer rhsChunk = detail::GetChunk(rhs._buffer, i, nChunks);
+			f(chunk, rhsChunk);
+		}
+	}
+
+	template<typename bi, MemorySpace ms, MathDomain md>
+	void Buffer<bi, ms, md>::ReadChunksFrom(const bi& rhs)
+	{
+		ForEachChunk(rhs, [](MemoryBuffer& buffer, const MemoryBuffer& rhsBuffer) {
+			if (ms == MemorySpace::Host || ms == MemorySpace::Device)
+				dm::detail::AutoCopy(buffer, rhsBuffer);
+			else
+				routines::Copy(buffer, rhsBuffer);
+		});
+	}
+
 	template<typename bi, MemorySpace ms, MathDomain md>
 	template<typename biRhs, MemorySpace msRhs, MathDomain mdRhs>
 	bool Buffer<bi, ms, md>::operator==(const Buffer<biRhs, msRhs, mdRhs>& rhs) const
@@ -237,15 +359,13 @@ namespace cl
 	IBuffer<ms, md>& Buffer<bi, ms, md>::operator +=(const IBuffer<ms, md>& rhs)
 	{
 		assert(size() == rhs.size());
-		assert(rhs.GetBuffer().pointer != 0);
-
-		MemoryBuffer& buffer = static_cast<bi*>(this)->_buffer;
-		assert(buffer.pointer != 0);
 
-		if (ms == MemorySpace::Host || ms == MemorySpace::Device)
-			dm::detail::AddEqual(buffer, static_cast<const bi*>(&rhs)->_buffer, 1.0);
-		else
-			routines::AddEqual(buffer, static_cast<const bi*>(&rhs)->_buffer, 1.0);
+		ForEachChunk(static_cast<const bi&>(rhs), [](MemoryBuffer& buffer, const MemoryBuffer& rhsBuffer) {
+			if (ms == MemorySpace::Host || ms == MemorySpace::Device)
+				dm::detail::AddEqual(buffer, rhsBuffer, 1.0);
+			else
+				routines::AddEqual(buffer, rhsBuffer, 1.0);
+		});
 
 		return *this;
 	}
@@ -254,15 +374,13 @@ namespace cl
 	IBuffer<ms, md>& Buffer<bi, ms, md>::operator -=(const IBuffer<ms, md>& rhs)
 	{
 		assert(size() == rhs.size());
-		assert(static_cast<const bi*>(&rhs)->_buffer.pointer != 0);
 
-		MemoryBuffer& buffer = static_cast<bi*>(this)->_buffer;
-		assert(buffer.pointer != 0);
-
-		if (ms == MemorySpace::Host || ms == MemorySpace::Device)
-			dm::detail::AddEqual(buffer, static_cast<const bi&>(rhs)._buffer, -1.0);
-		else
-			routines::AddEqual(buffer, static_cast<const bi&>(rhs)._buffer, -1.0);
+		ForEachChunk(static_cast<const bi&>(rhs), [](MemoryBuffer& buffer, const MemoryBuffer& rhsBuffer) {
+			if (ms == MemorySpace::Host || ms == MemorySpace::Device)
+				dm::detail::AddEqual(buffer, rhsBuffer, -1.0);
+			else
+				routines::AddEqual(buffer, rhsBuffer, -1.0);
+		});
 		return *this;
 	}
 
@@ -270,15 +388,13 @@ namespace cl
 	IBuffer<ms, md>& Buffer<bi, ms, md>::operator %=(const IBuffer<ms, md>& rhs)
 	{
 		assert(size() == rhs.size());
-		assert(rhs.GetBuffer().pointer != 0);
 
-		MemoryBuffer& buffer = static_cast<bi*>(this)->_buffer;
-		assert(buffer.pointer != 0);
-
-		if (ms == MemorySpace::Host || ms == MemorySpace::Device)
-			dm::detail::ElementwiseProduct(buffer, buffer, static_cast<const bi*>(&rhs)->_buffer, 1.0);
-		else
-			routines::ElementwiseProduct(buffer, buffer, static_cast<const bi*>(&rhs)->_buffer, 1.0);
+		ForEachChunk(static_cast<const bi&>(rhs), [](MemoryBuffer& buffer, const MemoryBuffer& rhsBuffer) {
+			if (ms == MemorySpace::Host || ms == MemorySpace::Device)
+				dm::detail::ElementwiseProduct(buffer, buffer, rhsBuffer, 1.0);
+			else
+				routines::ElementwiseProduct(buffer, buffer, rhsBuffer, 1.0);
+		});
 
 		return *this;
 	}
@@ -286,13 +402,12 @@ namespace cl
 	template<typename bi, MemorySpace ms, MathDomain md>
 	IBuffer<ms, md>& Buffer<bi, ms, md>::ElementWiseProduct(const IBuffer<ms, md>& rhs, const double alpha)
 	{
-		MemoryBuffer& buffer = static_cast<bi*>(this)->_buffer;
-		assert(buffer.pointer != 0);
-
-		if (ms == MemorySpace::Host || ms == MemorySpace::Device)
-			dm::detail::ElementwiseProduct(buffer, buffer, static_cast<const bi*>(&rhs)->_buffer, alpha);
-		else
-			routines::ElementwiseProduct(buffer, buffer, static_cast<const bi*>(&rhs)->_buffer, alpha);
+		ForEachChunk(static_cast<const bi&>(rhs), [alpha](MemoryBuffer& buffer, const MemoryBuffer& rhsBuffer) {
+			if (ms == MemorySpace::Host || ms == MemorySpace::Device)
+				dm::detail::ElementwiseProduct(buffer, buffer, rhsBuffer, alpha);
+			else
+				routines::ElementwiseProduct(buffer, buffer, rhsBuffer, alpha);
+		});
 
 		return *this;
 	}
@@ -302,38 +417,147 @@ namespace cl
 	IBuffer<ms, md>& Buffer<bi, ms, md>::AddEqual(const IBuffer<ms, md>& rhs, const double alpha)
 	{
 		assert(size() == rhs.size());
-		assert(rhs.GetBuffer().pointer != 0);
 
-		MemoryBuffer& buffer = static_cast<bi*>(this)->_buffer;
-		assert(buffer.pointer != 0);
+		ForEachChunk(static_cast<const bi&>(rhs), [alpha](MemoryBuffer& buffer, const MemoryBuffer& rhsBuffer) {
+			if (ms == MemorySpace::Host || ms == MemorySpace::Device)
+				dm::detail::AddEqual(buffer, rhsBuffer, alpha);
+			else
+				routines::AddEqual(buffer, rhsBuffer, alpha);
+		});
+		return *this;
+	}
+
+	template<typename bi, MemorySpace ms, MathDomain md>
+	IBuffer<ms, md>& Buffer<bi, ms, md>::Scale(const double alpha)
+	{
+		ForEachChunk([alpha](MemoryBuffer& buffer) {
+			if (ms == MemorySpace::Host || ms == MemorySpace::Device)
+				dm::detail::Scale(buffer, alpha);
+			else
+				routines::Scale(buffer, alpha);
+		});
+
+		return *this;
+	}
+
+	template<typename bi, MemorySpace ms, MathDomain md>
+	void Buffer<bi, ms, md>::Exp(bi& out) const
+	{
+		assert(out.size() == size());
 
 		if (ms == MemorySpace::Host || ms == MemorySpace::Device)
-			dm::detail::AddEqual(buffer, static_cast<const bi*>(&rhs)->_buffer, alpha);
-		else
-			routines::AddEqual(buffer, static_cast<const bi*>(&rhs)->_buffer, alpha);
+			throw NotImplementedException();
+
+		out.ForEachChunk(*static_cast<const bi*>(this), [](MemoryBuffer& y, const MemoryBuffer& x) { routines::Exp(y, x); });
+	}
+
+	template<typename bi, MemorySpace ms, MathDomain md>
+	IBuffer<ms, md>& Buffer<bi, ms, md>::Exp()
+	{
+		Exp(*static_cast<bi*>(this));
 		return *this;
 	}
 
 	template<typename bi, MemorySpace ms, MathDomain md>
-	IBuffer<ms, md>& Buffer<bi, ms, md>::Scale(const double alpha)
+	void Buffer<bi, ms, md>::Log(bi& out) const
 	{
-		MemoryBuffer& buffer = static_cast<bi*>(this)->_buffer;
-		assert(buffer.pointer != 0);
+		assert(out.size() == size());
 
 		if (ms == MemorySpace::Host || ms == MemorySpace::Device)
-			dm::detail::Scale(buffer, alpha);
-		else
-			routines::Scale(buffer, alpha);
+			throw NotImplementedException();
+
+		out.ForEachChunk(*static_cast<const bi*>(this), [](MemoryBuffer& y, const MemoryBuffer& x) { routines::Log(y, x); });
+	}
+
+	template<typename bi, MemorySpace ms, MathDomain md>
+	IBuffer<ms, md>& Buffer<bi, ms, md>::Log()
+	{
+		Log(*static_cast<bi*>(this));
+		return *this;
+	}
+
+	template<typename bi, MemorySpace ms, MathDomain md>
+	void Buffer<bi, ms, md>::Sqrt(bi& out) const
+	{
+		assert(out.size() == size());
+
+		if (ms == MemorySpace::Host || ms == MemorySpace::Device)
+			throw NotImplementedException();
+
+		out.ForEachChunk(*static_cast<const bi*>(this), [](MemoryBuffer& y, const MemoryBuffer& x) { routines::Sqrt(y, x); });
+	}
+
+	template<typename bi, MemorySpace ms, MathDomain md>
+	IBuffer<ms, md>& Buffer<bi, ms, md>::Sqrt()
+	{
+		Sqrt(*static_cast<bi*>(this));
+		return *this;
+	}
+
+	template<typename bi, MemorySpace ms, MathDomain md>
+	void Buffer<bi, ms, md>::Pow(bi& out, const double exponent) const
+	{
+		assert(out.size() == size());
+
+		if (ms == MemorySpace::Host || ms == MemorySpace::Device)
+			throw NotImplementedException();
+
+		out.ForEachChunk(*static_cast<const bi*>(this), [exponent](MemoryBuffer& y, const MemoryBuffer& x) { routines::Pow(y, x, exponent); });
+	}
+
+	template<typename bi, MemorySpace ms, MathDomain md>
+	IBuffer<ms, md>& Buffer<bi, ms, md>::Pow(const double exponent)
+	{
+		Pow(*static_cast<bi*>(this), exponent);
+		return *this;
+	}
+
+	template<typename bi, MemorySpace ms, MathDomain md>
+	void Buffer<bi, ms, md>::Tanh(bi& out) const
+	{
+		assert(out.size() == size());
+
+		if (ms == MemorySpace::Host || ms == MemorySpace::Device)
+			throw NotImplementedException();
 
+		out.ForEachChunk(*static_cast<const bi*>(this), [](MemoryBuffer& y, const MemoryBuffer& x) { routines::Tanh(y, x); });
+	}
+
+	template<typename bi, MemorySpace ms, MathDomain md>
+	IBuffer<ms, md>& Buffer<bi, ms, md>::Tanh()
+	{
+		Tanh(*static_cast<bi*>(this));
+		return *this;
+	}
+
+	template<typename bi, MemorySpace ms, MathDomain md>
+	void Buffer<bi, ms, md>::Erf(bi& out) const
+	{
+		assert(out.size() == size());
+
+		if (ms == MemorySpace::Host || ms == MemorySpace::Device)
+			throw NotImplementedException();
+
+		out.ForEachChunk(*static_cast<const bi*>(this), [](MemoryBuffer& y, const MemoryBuffer& x) { routines::Erf(y, x); });
+	}
+
+	template<typename bi, MemorySpace ms, MathDomain md>
+	IBuffer<ms, md>& Buffer<bi, ms, md>::Erf()
+	{
+		Erf(*static_cast<bi*>(this));
 		return *this;
 	}
 
 	template<typename bi, MemorySpace ms, MathDomain md>
 	int Buffer<bi, ms, md>::AbsoluteMinimumIndex() const
 	{
-		const MemoryBuffer& buffer = static_cast<const bi*>(this)->_buffer;
+		const auto& buffer = static_cast<const bi*>(this)->_buffer;
 		assert(buffer.pointer != 0);
 
+		// the index is in the whole buffer: a strided view is searched in a contiguous copy
+		if (!IsContiguous())
+			return bi(*static_cast<const bi*>(this)).AbsoluteMinimumIndex();
+
 		int ret = -1;
 		if (ms == MemorySpace::Host || ms == MemorySpace::Device)
 			dm::detail::ArgAbsMin(ret, buffer);
@@ -346,9 +570,13 @@ namespace cl
 	template<typename bi, MemorySpace ms, MathDomain md>
 	int Buffer<bi, ms, md>::AbsoluteMaximumIndex() const
 	{
-		const MemoryBuffer& buffer = static_cast<const bi*>(this)->_buffer;
+		const auto& buffer = static_cast<const bi*>(this)->_buffer;
 		assert(buffer.pointer != 0);
 
+		// the index is in the whole buffer: a strided view is searched in a contiguous copy
+		if (!IsContiguous())
+			return bi(*static_cast<const bi*>(this)).AbsoluteMaximumIndex();
+
 		int ret = -1;
 		if (ms == MemorySpace::Host || ms == MemorySpace::Device)
 			dm::detail::ArgAbsMax(ret, buffer);
@@ -361,14 +589,17 @@ namespace cl
 	template<typename bi, MemorySpace ms, MathDomain md>
 	typename Traits<md>::stdType Buffer<bi, ms, md>::AbsoluteMinimum() const
 	{
-		const MemoryBuffer& buffer = static_cast<const bi*>(this)->_buffer;
-		assert(buffer.pointer != 0);
-
 		double ret = 0.0;
-		if (ms == MemorySpace::Host || ms == MemorySpace::Device)
-			dm::detail::AbsMin(ret, buffer);
-		else
-			routines::AbsMin(ret, buffer);
+		bool isFirstChunk = true;
+		ForEachChunk([&](const MemoryBuffer& buffer) {
+			double chunkRet = 0.0;
+			if (ms == MemorySpace::Host || ms == MemorySpace::Device)
+				dm::detail::AbsMin(chunkRet, buffer);
+			else
+				routines::AbsMin(chunkRet, buffer);
+			ret = isFirstChunk ? chunkRet : std::min(ret, chunkRet);
+			isFirstChunk = false;
+		});
 
 		return static_cast<typename Traits<md>::stdType>(ret);
 	}
@@ -376,14 +607,17 @@ namespace cl
 	template<typename bi, MemorySpace ms, MathDomain md>
 	typename Traits<md>::stdType Buffer<bi, ms, md>::AbsoluteMaximum() const
 	{
-		const MemoryBuffer& buffer = static_cast<const bi*>(this)->_buffer;
-		assert(buffer.pointer != 0);
-
 		double ret = 0.0;
-		if (ms == MemorySpace::Host || ms == MemorySpace::Device)
-			dm::detail::AbsMax(ret, buffer);
-		else
-			routines::AbsMax(ret, buffer);
+		bool isFirstChunk = true;
+		ForEachChunk([&](const MemoryBuffer& buffer) {
+			double chunkRet = 0.0;
+			if (ms == MemorySpace::Host || ms == MemorySpace::Device)
+				dm::detail::AbsMax(chunkRet, buffer);
+			else
+				routines::AbsMax(chunkRet, buffer);
+			ret = isFirstChunk ? chunkRet : std::max(ret, chunkRet);
+			isFirstChunk = false;
+		});
 
 		return static_cast<typename Traits<md>::stdType>(ret);
 	}
@@ -391,14 +625,17 @@ namespace cl
 	template<typename bi, MemorySpace ms, MathDomain md>
 	typename Traits<md>::stdType Buffer<bi, ms, md>::Minimum() const
 	{
-		const MemoryBuffer& buffer = static_cast<const bi*>(this)->_buffer;
-		assert(buffer.pointer != 0);
-
 		double ret = 0.0;
-		if (ms == MemorySpace::Host || ms == MemorySpace::Device)
-			dm::detail::Min(ret, buffer);
-		else
-			routines::Min(ret, buffer);
+		bool isFirstChunk = true;
+		ForEachChunk([&](const MemoryBuffer& buffer) {
+			double chunkRet = 0.0;
+			if (ms == MemorySpace::Host || ms == MemorySpace::Device)
+				dm::detail::Min(chunkRet, buffer);
+			else
+				routines::Min(chunkRet, buffer);
+			ret = isFirstChunk ? chunkRet : std::min(ret, chunkRet);
+			isFirstChunk = false;
+		});
 
 		return static_cast<typename Traits<md>::stdType>(ret);
 	}
@@ -406,14 +643,17 @@ namespace cl
 	template<typename bi, MemorySpace ms, MathDomain md>
 	typename Traits<md>::stdType Buffer<bi, ms, md>::Maximum() const
 	{
-		const MemoryBuffer& buffer = static_cast<const bi*>(this)->_buffer;
-		assert(buffer.pointer != 0);
-
 		double ret = 0.0;
-		if (ms == MemorySpace::Host || ms == MemorySpace::Device)
-			dm::detail::Max(ret, buffer);
-		else
-			routines::Max(ret, buffer);
+		bool isFirstChunk = true;
+		ForEachChunk([&](const MemoryBuffer& buffer) {
+			double chunkRet = 0.0;
+			if (ms == MemorySpace::Host || ms == MemorySpace::Device)
+				dm::detail::Max(chunkRet, buffer);
+			else
+				routines::Max(chunkRet, buffer);
+			ret = isFirstChunk ? chunkRet : std::max(ret, chunkRet);
+			isFirstChunk = false;
+		});
 
 		return static_cast<typename Traits<md>::stdType>(ret);
 	}
@@ -421,14 +661,15 @@ namespace cl
 	template<typename bi, MemorySpace ms, MathDomain md>
 	typename Traits<md>::stdType Buffer<bi, ms, md>::Sum() const
 	{
-		const MemoryBuffer& buffer = static_cast<const bi*>(this)->_buffer;
-		assert(buffer.pointer != 0);
-
-		double ret = -1;
-		if (ms == MemorySpace::Host || ms == MemorySpace::Device)
-			dm::detail::Sum(ret, buffer);
-		else
-			routines::Sum(ret, buffer);
+		double ret = 0.0;
+		ForEachChunk([&ret](const MemoryBuffer& buffer) {
+			double chunkRet = -1;
+			if (ms == MemorySpace::Host || ms == MemorySpace::Device)
+				dm::detail::Sum(chunkRet, buffer);
+			else
+				routines::Sum(chunkRet, buffer);
+			ret += chunkRet;
+		});
 
 		return static_cast<typename Traits<md>::stdType>(ret);
 	}
@@ -436,14 +677,18 @@ namespace cl
 	template<typename bi, MemorySpace ms, MathDomain md>
 	typename Traits<md>::stdType Buffer<bi, ms, md>::EuclideanNorm() const
 	{
-		const MemoryBuffer& buffer = static_cast<const bi*>(this)->_buffer;
-		assert(buffer.pointer != 0);
-		
-		double ret = -1;
-		if (ms == MemorySpace::Host || ms == MemorySpace::Device)
-			dm::detail::EuclideanNorm(ret, buffer);
-		else
-			routines::EuclideanNorm(ret, buffer);
+		// the squares of the norms of the chunks add up
+		double ret = 0.0;
+		bool isFirstChunk = true;
+		ForEachChunk([&](const MemoryBuffer& buffer) {
+			double chunkRet = -1;
+			if (ms == MemorySpace::Host || ms == MemorySpace::Device)
+				dm::detail::EuclideanNorm(chunkRet, buffer);
+			else
+				routines::EuclideanNorm(chunkRet, buffer);
+			ret = isFirstChunk ? chunkRet : std::hypot(ret, chunkRet);
+			isFirstChunk = false;
+		});
 		
 		return static_cast<typename Traits<md>::stdType>(ret);
 	}
@@ -451,6 +696,10 @@ namespace cl
 	template<typename bi, MemorySpace ms, MathDomain md>
 	int Buffer<bi, ms, md>::CountEquals(const IBuffer<ms, md>& rhs) const
 	{
+		// the caches are contiguous: strided views are compared through contiguous copies
+		if (!IsContiguous() || !static_cast<const bi&>(rhs).IsContiguous())
+			return bi(*static_cast<const bi*>(this)).CountEquals(bi(static_cast<const bi&>(rhs)));
+
 		MemoryBuffer cache {};
 		cache.memorySpace = ms;
 		cache.mathDomain = md;
@@ -512,6 +761,9 @@ namespace cl
 	template<typename bi, MemorySpace ms, MathDomain md>
 	int Buffer<bi, ms, md>::CountEquals(const IBuffer<ms, md>& rhs, MemoryBuffer& cacheCount, MemoryBuffer& cacheSum, MemoryBuffer& oneElementCache) const
 	{
+		if (!IsContiguous() || !static_cast<const bi&>(rhs).IsContiguous())
+			return bi(*static_cast<const bi*>(this)).CountEquals(bi(static_cast<const bi&>(rhs)), cacheCount, cacheSum, oneElementCache);
+
 		const MemoryBuffer& buffer = static_cast<const bi*>(this)->_buffer;
 		assert(rhs.size() == size());
 		assert(buffer.pointer != 0);
@@ -677,62 +929,153 @@ namespace cl
 		return v;
 	}
 
+	// file data is streamed in blocks of about this many elements, so that C ordered files don't have to be read in full before being transposed
+	static constexpr size_t npyStreamingBlockSize = size_t(1) << 20;
+
+	/**
+	 * out(j, i) = in(i, j), where in is a nRows x nCols column-wise matrix with leading dimension ldIn, and out has leading dimension ldOut.
+	 * The matrix is split in square tiles, small enough for both the source and the destination tile to stay in cache, which are transposed on the thread pool.
+	 */
 	template<typename T>
-	void MatrixToBinaryFile(const std::vector<T>& m, unsigned nRows, unsigned nCols, const std::string& fileName, const bool transpose, const bool compressed, const std::string mode)
+	static void TransposeTiled(const T* in, const size_t ldIn, T* out, const size_t ldOut, const size_t nRows, const size_t nCols)
 	{
-		std::vector<T> matTranspose {};
-		if (transpose)
-		{
-			matTranspose.resize(m.size());
-			for (size_t i = 0; i < nRows; ++i)
+		constexpr size_t tileSize = 64;
+		const size_t nRowTiles = (nRows + tileSize - 1) / tileSize;
+		const size_t nColTiles = (nCols + tileSize - 1) / tileSize;
+
+		routines::detail::ParallelFor(nRowTiles * nColTiles, routines::detail::GetSliceGrainSize(tileSize * tileSize), [&](const size_t begin, const size_t end) {
+			for (size_t tile = begin; tile < end; ++tile)
 			{
-				for (size_t j = 0; j < nCols; ++j)
-					matTranspose[i + j * nRows] = m[j + i * nCols];
+				const size_t rowBegin = (tile % nRowTiles) * tileSize;
+				const size_t colBegin = (tile / nRowTiles) * tileSize;
+				const size_t rowEnd = std::min(rowBegin + tileSize, nRows);
+				const size_t colEnd = std::min(colBegin + tileSize, nCols);
+
+				for (size_t j = colBegin; j < colEnd; ++j)
+				{
+					for (size_t i = rowBegin; i < rowEnd; ++i)
+						out[j + i * ldOut] = in[i + j * ldIn];
+				}
 			}
+		});
+	}
 
-			// cannot use std::swap, as this code might be compiled with nvcc
-			auto tmp = nCols;
-			nCols = nRows;
-			nRows = tmp;
+	// reads the rest of the npy data, stored as U, into out
+	template<typename T, typename U>
+	static void ReadNpyData(routines::NpyFileReader& reader, std::vector<T>& out)
+	{
+		out.resize(reader.GetHeader().GetSize());
+		if (std::is_same<T, U>::value)
+		{
+			reader.Read(out.data(), out.size(), _Traits<T>::clType);
+			return;
 		}
+
+		std::vector<U> data(out.size());
+		reader.Read(data.data(), data.size(), _Traits<U>::clType);
+		for (size_t i = 0; i < data.size(); ++i)
+			out[i] = static_cast<T>(data[i]);
+	}
+
+	// reads the rest of the npy data into out: the element type of the file doesn't have to match T
+	template<typename T>
+	static void ReadNpyData(routines::NpyFileReader& reader, std::vector<T>& out)
+	{
+		if (reader.GetHeader().HasMathDomain(MathDomain::Float))
+			ReadNpyData<T, float>(reader, out);
+		else if (reader.GetHeader().HasMathDomain(MathDomain::Double))
+			ReadNpyData<T, double>(reader, out);
+		else if (reader.GetHeader().HasMathDomain(MathDomain::Int))
+			ReadNpyData<T, int>(reader, out);
 		else
+			throw NotImplementedException();
+	}
+
+	template<typename T>
+	void MatrixToBinaryFile(const std::vector<T>& m, unsigned nRows, unsigned nCols, const std::string& fileName, const bool transpose, const bool compressed, const std::string mode)
+	{
+		assert(m.size() == static_cast<size_t>(nRows) * nCols);
+		const std::vector<size_t> shape = { static_cast<size_t>(nRows), static_cast<size_t>(nCols) };
+
+		// without transposition the column-wise data is saved as it is, hence numpy sees it reshaped in C order
+		if (!transpose)
 		{
-			matTranspose = m;
+			if (!compressed)
+				npypp::Save(fileName, m, shape, mode);
+			else
+				npypp::SaveCompressed(fileName, m, shape, mode);
+			return;
 		}
-		
+
+		// the column-wise buffer is already a fortran ordered array: no need to transpose it
+		if (!compressed && mode == "w")
+		{
+			routines::NpyFileWriter writer(fileName, _Traits<T>::clType, shape, true);
+			writer.Write(m.data(), m.size());
+			return;
+		}
+
+		// npy++ only writes C order
+		std::vector<T> rowMajor(m.size());
+		TransposeTiled(m.data(), nRows, rowMajor.data(), nCols, nRows, nCols);
+
 		if (!compressed)
-			npypp::Save(fileName, matTranspose, { static_cast<size_t>(nRows), static_cast<size_t>(nCols) }, mode);
+			npypp::Save(fileName, rowMajor, shape, mode);
 		else
-			npypp::SaveCompressed(fileName, matTranspose, { static_cast<size_t>(nRows), static_cast<size_t>(nCols) }, mode);
+			npypp::SaveCompressed(fileName, rowMajor, shape, mode);
 	}
 
 	template<typename T>
 	void MatrixFromBinaryFile(std::vector<T>& m, unsigned& nRows, unsigned& nCols, const std::string& fileName, const bool transpose, const bool compressed, const bool useMemoryMapping)
 	{
-		const auto& fullExtract = !compressed ? npypp::LoadFull<T>(fileName, useMemoryMapping) : npypp::LoadCompressedFull<T>(fileName).begin()->second;
-		
-		assert(fullExtract.shape.size() == 2);
-		nRows = static_cast<unsigned>(fullExtract.shape[0]);
-		nCols = static_cast<unsigned>(fullExtract.shape[1]);
+		if (!transpose || compressed)
+		{
+			auto fullExtract = !compressed ? npypp::LoadFull<T>(fileName, useMemoryMapping) : npypp::LoadCompressedFull<T>(fileName).begin()->second;
 
-		m.resize(fullExtract.data.size());
+			assert(fullExtract.shape.size() == 2);
+			nRows = static_cast<unsigned>(fullExtract.shape[0]);
+			nCols = static_cast<unsigned>(fullExtract.shape[1]);
 
-		if (transpose)
-		{
-			for (size_t i = 0; i < nRows; ++i)
+			if (!transpose)
 			{
-				for (size_t j = 0; j < nCols; ++j)
-					m[i + j * nRows] = fullExtract.data[j + i * nCols];
+				m = std::move(fullExtract.data);
+				return;
 			}
 
-			// cannot use std::swap, as this code might be compiled with nvcc
-			auto tmp = nCols;
-			nCols = nRows;
-			nRows = tmp;
+			// npy++ only writes C order
+			m.resize(fullExtract.data.size());
+			TransposeTiled(fullExtract.data.data(), static_cast<size_t>(nCols), m.data(), static_cast<size_t>(nRows), static_cast<size_t>(nCols), static_cast<size_t>(nRows));
+			return;
 		}
-		else
+
+		routines::NpyFileReader reader(fileName);
+		const routines::NpyHeader& header = reader.GetHeader();
+		assert(header.shape.size() == 2);
+		nRows = static_cast<unsigned>(header.shape[0]);
+		nCols = static_cast<unsigned>(header.shape[1]);
+
+		// fortran order is the column-wise layout already
+		if (header.fortranOrder || !header.HasMathDomain(_Traits<T>::clType))
 		{
-			m = fullExtract.data;
+			ReadNpyData(reader, m);
+			if (header.fortranOrder)
+				return;
+
+			std::vector<T> rowMajor = std::move(m);
+			m.resize(rowMajor.size());
+			TransposeTiled(rowMajor.data(), static_cast<size_t>(nCols), m.data(), static_cast<size_t>(nRows), static_cast<size_t>(nCols), static_cast<size_t>(nRows));
+			return;
+		}
+
+		// C order: blocks of rows are read and scattered in place, so that only one block at a time is held besides the matrix
+		m.resize(header.GetSize());
+		const size_t nBlockRows = std::max(size_t(1), npyStreamingBlockSize / std::max(1u, nCols));
+		std::vector<T> block(std::min(static_cast<size_t>(nRows), nBlockRows) * nCols);
+		for (size_t rowBegin = 0; rowBegin < nRows; rowBegin += nBlockRows)
+		{
+			const size_t nCurrentRows = std::min(nBlockRows, nRows - rowBegin);
+			reader.Read(block.data(), nCurrentRows * nCols, _Traits<T>::clType);
+			TransposeTiled(block.data(), static_cast<size_t>(nCols), m.data() + rowBegin, static_cast<size_t>(nRows), static_cast<size_t>(nCols), nCurrentRows);
 		}
 	}
 
@@ -745,5 +1088,138 @@ namespace cl
 		return m;
 	}
 
+	template<typename T>
+	void TensorToBinaryFile(const std::vector<T>& t, const unsigned nRows, const unsigned nCols, const unsigned nMatrices, const std::string& fileName, const bool compressed, const std::string mode)
+	{
+		assert(t.size() == static_cast<size_t>(nRows) * nCols * nMatrices);
+		const std::vector<size_t> shape = { static_cast<size_t>(nRows), static_cast<size_t>(nCols), static_cast<size_t>(nMatrices) };
+
+		// the column-wise matrices, one after the other, are already a fortran ordered array
+		if (!compressed && mode == "w")
+		{
+			routines::NpyFileWriter writer(fileName, _Traits<T>::clType, shape, true);
+			writer.Write(t.data(), t.size());
+			return;
+		}
+
+		std::vector<T> rowMajor(t.size());
+		for (size_t i = 0; i < nRows; ++i)
+		{
+			for (size_t j = 0; j < nCols; ++j)
+			{
+				for (size_t k = 0; k < nMatrices; ++k)
+					rowMajor[k + nMatrices * (j + nCols * i)] = t[i + nRows * (j + nCols * k)];
+			}
+		}
+
+		if (!compressed)
+			npypp::Save(fileName, rowMajor, shape, mode);
+		else
+			npypp::SaveCompressed(fileName, rowMajor, shape, mode);
+	}
+
+	template<typename T>
+	void TensorFromBinaryFile(std::vector<T>& t, unsigned& nRows, unsigned& nCols, unsigned& nMatrices, const std::string& fileName, const bool compressed)
+	{
+		std::vector<size_t> shape {};
+		std::vector<T> rowMajor {};
+		if (!compressed)
+		{
+			routines::NpyFileReader reader(fileName);
+			shape = reader.GetHeader().shape;
+			assert(shape.size() == 3);
+
+			ReadNpyData(reader, reader.GetHeader().fortranOrder ? t : rowMajor);
+		}
+		else
+		{
+			// npy++ only writes C order
+			auto fullExtract = npypp::LoadCompressedFull<T>(fileName).begin()->second;
+			shape = fullExtract.shape;
+			rowMajor = std::move(fullExtract.data);
+		}
+
+		assert(shape.size() == 3);
+		nRows = static_cast<unsigned>(shape[0]);
+		nCols = static_cast<unsigned>(shape[1]);
+		nMatrices = static_cast<unsigned>(shape[2]);
+		if (rowMajor.empty())
+			return;
+
+		t.resize(rowMajor.size());
+		for (size_t i = 0; i < nRows; ++i)
+		{
+			for (size_t j = 0; j < nCols; ++j)
+			{
+				for (size_t k = 0; k < nMatrices; ++k)
+					t[i + nRows * (j + nCols * k)] = rowMajor[k + nMatrices * (j + nCols * i)];
+			}
+		}
+	}
+
+	template<typename T>
+	void SparseMatrixToBinaryFile(const T* values, const int* nonZeroColumnIndices, const int* nNonZeroRows, const unsigned nNonZeros, const unsigned nRows, const unsigned nCols, const std::string& fileName, const bool compressed)
+	{
+		// same order as scipy
+		routines::NpzFileWriter writer(fileName, compressed);
+		writer.Write("indices", MathDomain::Int, { static_cast<size_t>(nNonZeros) }, nonZeroColumnIndices, nNonZeros);
+		writer.Write("indptr", MathDomain::Int, { static_cast<size_t>(nRows) + 1 }, nNonZeroRows, nRows + 1);
+
+		const std::string format = "csr";
+		writer.Write("format", "|S" + std::to_string(format.size()), {}, format.data(), format.size());
+
+		const int64_t shape[] = { static_cast<int64_t>(nRows), static_cast<int64_t>(nCols) };
+		writer.Write("shape", "<i8", { 2 }, shape, sizeof(shape));
+
+		writer.Write("data", _Traits<T>::clType, { static_cast<size_t>(nNonZeros) }, values, nNonZeros);
+		writer.Close();
+	}
+
+	inline void SparseMatrixShapeFromBinaryFile(routines::NpzFileReader& reader, unsigned& nRows, unsigned& nCols)
+	{
+		std::vector<char> data {};
+		auto header = reader.Read("format", data);
+		if (std::string(data.data() + header.dataOffset, data.size() - header.dataOffset).compare(0, 3, "csr") != 0)
+			throw NpyFileException("Only csr sparse matrices are supported");
+
+		header = reader.Read("shape", data);
+		std::vector<size_t> shape {};
+		NpyDataToVector(shape, header, data);
+		if (shape.size() != 2)
+			throw NpyFileException("Invalid sparse matrix shape");
+
+		nRows = static_cast<unsigned>(shape[0]);
+		nCols = static_cast<unsigned>(shape[1]);
+	}
+
+	// out[i] <- data[i], which is stored as U and possibly misaligned
+	template<typename T, typename U>
+	static void ConvertNpyData(std::vector<T>& out, const char* data)
+	{
+		for (size_t i = 0; i < out.size(); ++i)
+		{
+			U value;
+			std::memcpy(&value, data + i * sizeof(U), sizeof(U));
+			out[i] = static_cast<T>(value);
+		}
+	}
+
+	template<typename T>
+	void NpyDataToVector(std::vector<T>& out, const routines::NpyHeader& header, const std::vector<char>& data)
+	{
+		out.resize(header.GetSize());
+		const char* begin = data.data() + header.dataOffset;
+		if (header.HasMathDomain(MathDomain::Float))
+			ConvertNpyData<T, float>(out, begin);
+		else if (header.HasMathDomain(MathDomain::Double))
+			ConvertNpyData<T, double>(out, begin);
+		else if (header.HasMathDomain(MathDomain::Int))
+			ConvertNpyData<T, int>(out, begin);
+		else if (header.dataType == "<i8" || header.dataType == "=i8")
+			ConvertNpyData<T, int64_t>(out, begin);
+		else
+			throw NotImplementedException();
+	}
+
     #pragma endregion
 }
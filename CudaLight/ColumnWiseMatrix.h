@@ -8,6 +8,11 @@
 #include <Types.h>
 #include <Vector.h>
 
+#include <HostRoutines/Activation.h>
+#include <HostRoutines/DenseSolverType.h>
+#include <HostRoutines/Extra.h>
+#include <HostRoutines/SolverWorkspace.h>
+
 namespace cl
 {
 	template<MemorySpace memorySpace, MathDomain mathDomain>
@@ -35,6 +40,12 @@ namespace cl
 
 		// initialise a sub matrix
 		ColumnWiseMatrix(const ColumnWiseMatrix& rhs, const size_t colStart, const size_t colEnd);
+		/**
+		 * Non-owning view of the nRows x nCols block of rhs starting at (rowStart, colStart): it keeps the leading dimension of rhs, so that
+		 * the BLAS routines (Multiply, Dot, AddEqualMatrix, Solve, ...) work on it in place. Copies and Get gather it column by column, whereas
+		 * the element-wise Buffer routines need contiguous memory, i.e. a view that spans all the rows of rhs
+		 */
+		ColumnWiseMatrix(const ColumnWiseMatrix& rhs, const size_t rowStart, const size_t nRows, const size_t colStart, const size_t nCols);
 		// reshape a vector into a matrix
 		ColumnWiseMatrix(const Vector<memorySpace, mathDomain>& rhs, const size_t startOffset, const size_t nRows, const size_t nCols);
 
@@ -45,8 +56,10 @@ namespace cl
 
 		using Buffer<ColumnWiseMatrix, memorySpace, mathDomain>::ReadFrom;
 		void ReadFrom(const Vector<memorySpace, mathDomain>& rhs);
+		void ReadFrom(const ColumnWiseMatrix& rhs);
 
 		using Buffer<ColumnWiseMatrix, memorySpace, mathDomain>::Get;
+		std::vector<stdType> Get() const override;
 		std::vector<stdType> Get(const unsigned column) const;
 
 		void MakeIdentity();
@@ -73,6 +86,7 @@ namespace cl
 
 		unsigned nRows() const noexcept { return _buffer.nRows; }
 		unsigned nCols() const noexcept { return _buffer.nCols; }
+		unsigned leadingDimension() const noexcept { return _buffer.leadingDimension; }
 
 		std::vector<std::shared_ptr<Vector<memorySpace, mathDomain>>> columns {};
 
@@ -108,6 +122,17 @@ namespace cl
 		 */
 		void Multiply(ColumnWiseMatrix& out, const ColumnWiseMatrix& rhs, const MatrixOperation lhsOperation = MatrixOperation::None, const MatrixOperation rhsOperation = MatrixOperation::None, const double alpha = 1.0, const double beta = 0.0) const;
 
+		/**
+		 * out = activation(alpha * op(this) * op(rhs) + bias), bias[i] being added to the i-th row of out: this is a dense layer with the batch along the columns.
+		 * Bias and activation are applied while the output is still in cache, with no need of the ones vector of AddEqualBroadcast.
+		 * Device memory only supports ActivationType::None
+		 */
+		ColumnWiseMatrix MultiplyFused(const ColumnWiseMatrix& rhs, const Vector<memorySpace, mathDomain>& bias, const ActivationType activation, const MatrixOperation lhsOperation = MatrixOperation::None, const MatrixOperation rhsOperation = MatrixOperation::None, const double alpha = 1.0) const;
+		/**
+		 * Same version as above, but gives the possibility of reusing the output buffer
+		 */
+		void MultiplyFused(ColumnWiseMatrix& out, const ColumnWiseMatrix& rhs, const Vector<memorySpace, mathDomain>& bias, const ActivationType activation, const MatrixOperation lhsOperation = MatrixOperation::None, const MatrixOperation rhsOperation = MatrixOperation::None, const double alpha = 1.0) const;
+
 		/**
 		 * A = alpha * B * C + beta * A
 		 */
@@ -138,7 +163,7 @@ namespace cl
 		 */
 		void RowWiseSum(Vector<memorySpace, mathDomain>& out) const;
 		/**
-		 * Same version as above, but gives the possibility of reusing the output buffer and the cache needed to do the actual sum
+		 * Same version as above, but gives the possibility of reusing the output buffer and the cache needed to do the actual sum on device: host memory doesn't need it
 		 */
 		void RowWiseSum(Vector<memorySpace, mathDomain>& out, Vector<memorySpace, mathDomain>& cache) const;
 
@@ -151,29 +176,68 @@ namespace cl
 		 */
 		void ColumnWiseSum(Vector<memorySpace, mathDomain>& out) const;
 		/**
-		 * Same version as above, but gives the possibility of reusing the output buffer and the cache needed to do the actual sum
+		 * Same version as above, but gives the possibility of reusing the output buffer and the cache needed to do the actual sum on device: host memory doesn't need it
 		 */
 		void ColumnWiseSum(Vector<memorySpace, mathDomain>& out, Vector<memorySpace, mathDomain>& cache) const;
 
+		/**
+		 * out[i] = reduction of the i-th row, computed without any cache. Device memory only supports the sum
+		 */
+		Vector<memorySpace, mathDomain> RowWiseReduce(const ReductionType reductionType) const;
+		void RowWiseReduce(Vector<memorySpace, mathDomain>& out, const ReductionType reductionType) const;
+
+		/**
+		 * out[j] = reduction of the j-th column, computed without any cache. Device memory only supports the sum
+		 */
+		Vector<memorySpace, mathDomain> ColumnWiseReduce(const ReductionType reductionType) const;
+		void ColumnWiseReduce(Vector<memorySpace, mathDomain>& out, const ReductionType reductionType) const;
+
+		/**
+		 * Prefix sums down each column, in place: A(i, j) = sum(A(0:i, j)), A(i, j) itself being left out when exclusive.
+		 * Device memory only supports the inclusive version
+		 */
+		void ColumnWiseCumulativeSum(const bool exclusive = false);
+
+		/**
+		 * Prefix sums along each row, in place: A(i, j) = sum(A(i, 0:j)), A(i, j) itself being left out when exclusive
+		 */
+		void RowWiseCumulativeSum(const bool exclusive = false);
+
 		/*
 		 * A = alpha * B + beta * A
 		 */
 		ColumnWiseMatrix Add(const ColumnWiseMatrix& rhs, const MatrixOperation lhsOperation = MatrixOperation::None, const MatrixOperation rhsOperation = MatrixOperation::None, const double alpha = 1.0, const double beta = 1.0) const;
 
 		/**
-		 * Invert inplace - WARNING, use Solve for higher performance
+		 * Invert inplace - WARNING, use Solve for higher performance.
+		 * Cholesky/Ldlt assume A symmetric, and are only supported by the host BLAS memory spaces
 		 */
-		void Invert(const MatrixOperation lhsOperation = MatrixOperation::None);
+		void Invert(const MatrixOperation lhsOperation = MatrixOperation::None, DenseSolverType solver = DenseSolverType::Lu);
 
 		/**
-		 * Solve A * X = B, B is overwritten
+		 * Solve A * X = B, B is overwritten.
+		 * MixedPrecisionLu factorizes a float copy of a double A and refines X with double residuals, falling back to Lu if that doesn't converge:
+		 * the refinement is only done by the host BLAS memory spaces, the other ones use Lu straight away
 		 */
-		void Solve(ColumnWiseMatrix& rhs, const MatrixOperation lhsOperation = MatrixOperation::None, LinearSystemSolverType solver = LinearSystemSolverType::Lu) const;
+		void Solve(ColumnWiseMatrix& rhs, const MatrixOperation lhsOperation = MatrixOperation::None, DenseSolverType solver = DenseSolverType::Lu) const;
 
 		/**
 		 * Solve A * x = b, b is overwritten
 		 */
-		void Solve(Vector<memorySpace, mathDomain>& rhs, const MatrixOperation lhsOperation = MatrixOperation::None, LinearSystemSolverType solver = LinearSystemSolverType::Lu) const;
+		void Solve(Vector<memorySpace, mathDomain>& rhs, const MatrixOperation lhsOperation = MatrixOperation::None, DenseSolverType solver = DenseSolverType::Lu) const;
+
+		/**
+		 * Kept for the callers of the sparse solver enumeration, they forward to the DenseSolverType versions
+		 */
+		void Solve(ColumnWiseMatrix& rhs, const MatrixOperation lhsOperation, LinearSystemSolverType solver) const;
+		void Solve(Vector<memorySpace, mathDomain>& rhs, const MatrixOperation lhsOperation, LinearSystemSolverType solver) const;
+
+		/**
+		 * Same versions as above, but the LAPACK temporaries are kept in workspace between calls (Host/Device memory spaces ignore it)
+		 */
+		void Invert(routines::SolverWorkspace& workspace, const MatrixOperation lhsOperation = MatrixOperation::None, DenseSolverType solver = DenseSolverType::Lu);
+		void Solve(ColumnWiseMatrix& rhs, routines::SolverWorkspace& workspace, const MatrixOperation lhsOperation = MatrixOperation::None, DenseSolverType solver = DenseSolverType::Lu) const;
+		void Solve(Vector<memorySpace, mathDomain>& rhs, routines::SolverWorkspace& workspace, const MatrixOperation lhsOperation = MatrixOperation::None, DenseSolverType solver = DenseSolverType::Lu) const;
 
 		Vector<memorySpace, MathDomain::Int> ColumnWiseArgAbsMinimum() const;
 		void ColumnWiseArgAbsMinimum(Vector<memorySpace, MathDomain::Int>& out) const;
@@ -1,6 +1,39 @@
 
 namespace cl
 {
+	namespace detail
+	{
+		/**
+		 * The device kernels only know about Lu and Qr: MixedPrecisionLu has the same solution as Lu, which is what it falls back to anyway
+		 */
+		inline LinearSystemSolverType ToLinearSystemSolverType(const DenseSolverType solver)
+		{
+			switch (solver)
+			{
+				case DenseSolverType::Lu:
+				case DenseSolverType::MixedPrecisionLu:
+					return LinearSystemSolverType::Lu;
+				case DenseSolverType::Qr:
+					return LinearSystemSolverType::Qr;
+				default:
+					throw NotImplementedException();
+			}
+		}
+
+		inline DenseSolverType ToDenseSolverType(const LinearSystemSolverType solver)
+		{
+			switch (solver)
+			{
+				case LinearSystemSolverType::Lu:
+					return DenseSolverType::Lu;
+				case LinearSystemSolverType::Qr:
+					return DenseSolverType::Qr;
+				default:
+					throw NotImplementedException();
+			}
+		}
+	}	 // namespace detail
+
 	template<MemorySpace ms, MathDomain md>
 	ColumnWiseMatrix<ms, md>::ColumnWiseMatrix(const unsigned nRows, const unsigned nCols)
 		: Buffer<ColumnWiseMatrix < ms, md>, ms, md>(true), _buffer(0, nRows, nCols, ms, md)
@@ -22,7 +55,7 @@ namespace cl
 		columns.resize(nCols);
 		for (size_t i = 0; i < nCols; i++)
 		{
-			const size_t colShift = i * nRows() * _buffer.ElementarySize();
+			const size_t colShift = i * _buffer.leadingDimension * _buffer.ElementarySize();
 			MemoryBuffer colBuffer(_buffer.pointer + colShift, _buffer.nRows, ms, md);
 			columns[i] = Vector<ms, md>::make_shared(colBuffer);
 		}
@@ -63,12 +96,25 @@ namespace cl
 		_buffer.nCols = static_cast<unsigned>(nCols);
 		_buffer.size = static_cast<unsigned>(_buffer.nRows * nCols);
 		
-		const size_t colStartShift = colStart * nRows() * _buffer.ElementarySize();
+		const size_t colStartShift = colStart * _buffer.leadingDimension * _buffer.ElementarySize();
 		_buffer.pointer += colStartShift;
 
 		SetUp(nCols);
 	}
 
+	template<MemorySpace ms, MathDomain md>
+	ColumnWiseMatrix<ms, md>::ColumnWiseMatrix(const ColumnWiseMatrix& rhs, const size_t rowStart, const size_t nRows, const size_t colStart, const size_t nCols)
+		: Buffer<ColumnWiseMatrix<ms, md>, ms, md>(false),
+		  _buffer(0, static_cast<unsigned>(nRows), static_cast<unsigned>(nCols), rhs.leadingDimension(), ms, md)
+	{
+		assert(rowStart + nRows <= rhs.nRows());
+		assert(colStart + nCols <= rhs.nCols());
+
+		_buffer.pointer = rhs._buffer.pointer + (rowStart + colStart * rhs.leadingDimension()) * _buffer.ElementarySize();
+
+		SetUp(nCols);
+	}
+
 	template<MemorySpace ms, MathDomain md>
 	ColumnWiseMatrix<ms, md>::ColumnWiseMatrix(const Vector<ms, md>& rhs, const size_t startOffset, const size_t nRows, const size_t nCols)
 		: Buffer<ColumnWiseMatrix<ms, md>, ms, md>(false),
@@ -81,12 +127,32 @@ namespace cl
 	
 	template<MemorySpace ms, MathDomain md>
 	ColumnWiseMatrix<ms, md>::ColumnWiseMatrix(const std::string& fileName, bool useMemoryMapping)
+		: Buffer<ColumnWiseMatrix<ms, md>, ms, md>(true)
 	{
+		if (useMemoryMapping)
+		{
+			// zero-copy: the buffer points directly into the file mapping, with the same layout as MatrixFromBinaryFile without transposition.
+			// A fortran ordered file has that layout as well, and it's also what MatrixFromBinaryFile returns with transposition
+			std::vector<size_t> shape {};
+			const ptr_t pointer = this->MapFile(fileName, shape, routines::NpyFileReader(fileName).GetHeader().fortranOrder);
+			if (pointer != 0)
+			{
+				assert(shape.size() == 2);
+				_buffer = MemoryTile(pointer, static_cast<unsigned>(shape[0]), static_cast<unsigned>(shape[1]), ms, md);
+				SetUp(nCols());
+				return;
+			}
+		}
+
 		std::vector<typename Traits<md>::stdType> m {};
 		unsigned nRows = 0, nCols = 0;
-		cl::MatrixFromBinaryFile(m, nRows, nCols, fileName, useMemoryMapping);
-		
-		ReadFrom(m, nRows, nCols);
+		cl::MatrixFromBinaryFile(m, nRows, nCols, fileName, false, false, useMemoryMapping);
+
+		_buffer = MemoryTile(0, nRows, nCols, ms, md);
+		this->ctor(_buffer);
+		SetUp(nCols);
+
+		ReadFrom(m);
 	}
 
 	template<MemorySpace ms, MathDomain md>
@@ -128,6 +194,21 @@ namespace cl
 	Vector<ms, md> ColumnWiseMatrix<ms, md>::Flatten() const
 	{
 		Vector<ms, md> ret(this->size());
+		if (!this->IsContiguous())
+		{
+			// copy the view column by column, skipping the parent's rows in between
+			for (size_t j = 0; j < nCols(); ++j)
+			{
+				const auto& flat = ret.GetBuffer();
+				MemoryBuffer chunk(flat.pointer + j * nRows() * flat.ElementarySize(), nRows(), ms, md);
+				if (ms == MemorySpace::Host || ms == MemorySpace::Device)
+					dm::detail::AutoCopy(chunk, columns[j]->GetBuffer());
+				else
+					routines::Copy(chunk, columns[j]->GetBuffer());
+			}
+			return ret;
+		}
+
 		if (ms == MemorySpace::Host || ms == MemorySpace::Device)
 			dm::detail::AutoCopy(ret.GetBuffer(), _buffer);
 		else
@@ -148,6 +229,39 @@ namespace cl
 			routines::Copy(columns[0]->buffer, rhs.GetBuffer());
 	}
 
+	template<MemorySpace ms, MathDomain md>
+	void ColumnWiseMatrix<ms, md>::ReadFrom(const ColumnWiseMatrix& rhs)
+	{
+		if (this->IsContiguous() && rhs.IsContiguous())
+		{
+			Buffer<ColumnWiseMatrix<ms, md>, ms, md>::ReadFrom(rhs);
+			return;
+		}
+
+		// at least one of the two is a view with a leading dimension larger than its number of rows
+		assert(nRows() == rhs.nRows());
+		assert(nCols() == rhs.nCols());
+		for (size_t j = 0; j < nCols(); ++j)
+			columns[j]->ReadFrom(*rhs.columns[j]);
+	}
+
+	template<MemorySpace ms, MathDomain md>
+	std::vector<typename Traits<md>::stdType> ColumnWiseMatrix<ms, md>::Get() const
+	{
+		if (this->IsContiguous())
+			return Buffer<ColumnWiseMatrix<ms, md>, ms, md>::Get();
+
+		std::vector<stdType> ret;
+		ret.reserve(static_cast<size_t>(nRows()) * nCols());
+		for (size_t j = 0; j < nCols(); ++j)
+		{
+			const auto column = columns[j]->Get();
+			ret.insert(ret.end(), column.begin(), column.end());
+		}
+
+		return ret;
+	}
+
 	template<MemorySpace ms, MathDomain md>
 	std::vector<typename Traits<md>::stdType> ColumnWiseMatrix<ms, md>::Get(const unsigned column) const
 	{
@@ -290,7 +404,7 @@ namespace cl
 		else
 		{
 			routines::Multiply(ret.buffer, this->buffer, rhs.buffer, MatrixOperation::None, MatrixOperation::None, this->nRows(), rhs.nRows());
-			routines::Copy(_buffer, ret.buffer);
+			ReadFrom(ret);
 		}
 		return *this;
 	}
@@ -397,6 +511,43 @@ namespace cl
 		this->SubMultiply(out, rhs, 0, 0, nRowsEnd, nColsEnd, 0, nColsRhsEnd, lhsOperation, rhsOperation, alpha, beta);
 	}
 	
+	template<MemorySpace ms, MathDomain md>
+	ColumnWiseMatrix<ms, md> ColumnWiseMatrix<ms, md>::MultiplyFused(const ColumnWiseMatrix& rhs, const Vector<ms, md>& bias, const ActivationType activation, const MatrixOperation lhsOperation, const MatrixOperation rhsOperation, const double alpha) const
+	{
+		const unsigned nRows = lhsOperation == MatrixOperation::None ? this->nRows() : this->nCols();
+		const unsigned nCols = rhsOperation == MatrixOperation::None ? rhs.nCols() : rhs.nRows();
+		ColumnWiseMatrix ret(nRows, nCols);
+		MultiplyFused(ret, rhs, bias, activation, lhsOperation, rhsOperation, alpha);
+
+		return ret;
+	}
+
+	template<MemorySpace ms, MathDomain md>
+	void ColumnWiseMatrix<ms, md>::MultiplyFused(ColumnWiseMatrix& out, const ColumnWiseMatrix& rhs, const Vector<ms, md>& bias, const ActivationType activation, const MatrixOperation lhsOperation, const MatrixOperation rhsOperation, const double alpha) const
+	{
+		assert(bias.size() == out.nRows());
+		if (ms == MemorySpace::Host || ms == MemorySpace::Device)
+		{
+			if (activation != ActivationType::None)
+				throw NotImplementedException();
+
+			Multiply(out, rhs, lhsOperation, rhsOperation, alpha);
+			out.AddEqualBroadcast(bias, false);
+		}
+		else
+		{
+			// the routines expect the shapes of op(lhs) and op(rhs)
+			MemoryTile lhsBuffer = _buffer;
+			if (lhsOperation == MatrixOperation::Transpose)
+				std::swap(lhsBuffer.nRows, lhsBuffer.nCols);
+			MemoryTile rhsBuffer = rhs._buffer;
+			if (rhsOperation == MatrixOperation::Transpose)
+				std::swap(rhsBuffer.nRows, rhsBuffer.nCols);
+
+			routines::MultiplyFused(out._buffer, lhsBuffer, rhsBuffer, bias.GetBuffer(), activation, lhsOperation, rhsOperation, alpha);
+		}
+	}
+
 	template<MemorySpace ms, MathDomain md>
 	ColumnWiseMatrix<ms, md> ColumnWiseMatrix<ms, md>::SubMultiply(const ColumnWiseMatrix& rhs, const size_t rowStart, const size_t colStart, const size_t nRows, const size_t nCols, const size_t colRhsStart, const size_t nColsRhs, const MatrixOperation lhsOperation, const MatrixOperation rhsOperation, const double alpha, const double beta) const
 	{
@@ -520,8 +671,13 @@ template<MemorySpace ms, MathDomain md>
 	template<MemorySpace ms, MathDomain md>
 	void ColumnWiseMatrix<ms, md>::RowWiseSum(Vector<ms, md>& out) const
 	{
-		Vector<ms, md> cache(nCols(), 1.0);
-		RowWiseSum(out, cache);
+		if (ms == MemorySpace::Host || ms == MemorySpace::Device)
+		{
+			Vector<ms, md> cache(nCols(), 1.0);
+			RowWiseSum(out, cache);
+		}
+		else
+			routines::RowWiseReduce(out.GetBuffer(), this->_buffer, ReductionType::Sum);
 	}
 	
 	template<MemorySpace ms, MathDomain md>
@@ -530,7 +686,7 @@ template<MemorySpace ms, MathDomain md>
 		if (ms == MemorySpace::Host || ms == MemorySpace::Device)
 			dm::detail::RowWiseSum(out.GetBuffer(), this->_buffer, cache.GetBuffer());
 		else
-			routines::RowWiseSum(out.GetBuffer(), this->_buffer, cache.GetBuffer());
+			routines::RowWiseReduce(out.GetBuffer(), this->_buffer, ReductionType::Sum);
 	}
 
 	template<MemorySpace ms, MathDomain md>
@@ -545,8 +701,13 @@ template<MemorySpace ms, MathDomain md>
 	template<MemorySpace ms, MathDomain md>
 	void ColumnWiseMatrix<ms, md>::ColumnWiseSum(Vector<ms, md>& out) const
 	{
-		Vector<ms, md> cache(nRows(), 1.0);
-		ColumnWiseSum(out, cache);
+		if (ms == MemorySpace::Host || ms == MemorySpace::Device)
+		{
+			Vector<ms, md> cache(nRows(), 1.0);
+			ColumnWiseSum(out, cache);
+		}
+		else
+			routines::ColumnWiseReduce(out.GetBuffer(), this->_buffer, ReductionType::Sum);
 	}
 	
 	template<MemorySpace ms, MathDomain md>
@@ -555,39 +716,160 @@ template<MemorySpace ms, MathDomain md>
 		if (ms == MemorySpace::Host || ms == MemorySpace::Device)
 			dm::detail::RowWiseSum(out.GetBuffer(), this->_buffer, cache.GetBuffer(), MatrixOperation::Transpose);
 		else
-			routines::RowWiseSum(out.GetBuffer(), this->_buffer, cache.GetBuffer(), MatrixOperation::Transpose);
+			routines::ColumnWiseReduce(out.GetBuffer(), this->_buffer, ReductionType::Sum);
+	}
+
+	template<MemorySpace ms, MathDomain md>
+	Vector<ms, md> ColumnWiseMatrix<ms, md>::RowWiseReduce(const ReductionType reductionType) const
+	{
+		Vector<ms, md> out(nRows());
+		RowWiseReduce(out, reductionType);
+
+		return out;
+	}
+
+	template<MemorySpace ms, MathDomain md>
+	void ColumnWiseMatrix<ms, md>::RowWiseReduce(Vector<ms, md>& out, const ReductionType reductionType) const
+	{
+		assert(out.size() == nRows());
+		if (ms == MemorySpace::Host || ms == MemorySpace::Device)
+		{
+			if (reductionType != ReductionType::Sum)
+				throw NotImplementedException();
+			RowWiseSum(out);
+		}
+		else
+			routines::RowWiseReduce(out.GetBuffer(), this->_buffer, reductionType);
+	}
+
+	template<MemorySpace ms, MathDomain md>
+	Vector<ms, md> ColumnWiseMatrix<ms, md>::ColumnWiseReduce(const ReductionType reductionType) const
+	{
+		Vector<ms, md> out(nCols());
+		ColumnWiseReduce(out, reductionType);
+
+		return out;
+	}
+
+	template<MemorySpace ms, MathDomain md>
+	void ColumnWiseMatrix<ms, md>::ColumnWiseReduce(Vector<ms, md>& out, const ReductionType reductionType) const
+	{
+		assert(out.size() == nCols());
+		if (ms == MemorySpace::Host || ms == MemorySpace::Device)
+		{
+			if (reductionType != ReductionType::Sum)
+				throw NotImplementedException();
+			ColumnWiseSum(out);
+		}
+		else
+			routines::ColumnWiseReduce(out.GetBuffer(), this->_buffer, reductionType);
+	}
+
+	template<MemorySpace ms, MathDomain md>
+	void ColumnWiseMatrix<ms, md>::ColumnWiseCumulativeSum(const bool exclusive)
+	{
+		if (ms == MemorySpace::Host || ms == MemorySpace::Device)
+		{
+			if (exclusive)
+				throw NotImplementedException();
+			dm::detail::CumulativeRowSum(_buffer);
+		}
+		else
+			routines::ColumnWiseCumulativeSum(_buffer, exclusive);
+	}
+
+	template<MemorySpace ms, MathDomain md>
+	void ColumnWiseMatrix<ms, md>::RowWiseCumulativeSum(const bool exclusive)
+	{
+		if (ms == MemorySpace::Host || ms == MemorySpace::Device)
+			throw NotImplementedException();
+		else
+			routines::RowWiseCumulativeSum(_buffer, exclusive);
 	}
 
 template<MemorySpace ms, MathDomain md>
-	void ColumnWiseMatrix<ms, md>::Invert(const MatrixOperation lhsOperation)
+	void ColumnWiseMatrix<ms, md>::Invert(const MatrixOperation lhsOperation, DenseSolverType solver)
 	{
 		if (ms == MemorySpace::Host || ms == MemorySpace::Device)
+		{
+			// the device kernels only invert through Lu
+			if (detail::ToLinearSystemSolverType(solver) != LinearSystemSolverType::Lu)
+				throw NotImplementedException();
 			dm::detail::Invert(this->_buffer, lhsOperation);
+		}
 		else
-			routines::Invert(this->_buffer, lhsOperation);
+			routines::Invert(this->_buffer, lhsOperation, solver);
 	}
 
 	template<MemorySpace ms, MathDomain md>
-	void ColumnWiseMatrix<ms, md>::Solve(ColumnWiseMatrix& rhs, const MatrixOperation lhsOperation, LinearSystemSolverType solver) const
+	void ColumnWiseMatrix<ms, md>::Solve(ColumnWiseMatrix& rhs, const MatrixOperation lhsOperation, DenseSolverType solver) const
 	{
 		assert(nRows() == rhs.nRows());
-		assert(nCols() == rhs.nCols());
+		assert(nRows() == nCols());
 		if (ms == MemorySpace::Host || ms == MemorySpace::Device)
-			dm::detail::Solve(this->_buffer, rhs._buffer, lhsOperation, solver);
+			dm::detail::Solve(this->_buffer, rhs._buffer, lhsOperation, detail::ToLinearSystemSolverType(solver));
 		else
 			routines::Solve(this->_buffer, rhs._buffer, lhsOperation, solver);
 	}
 
+	template<MemorySpace ms, MathDomain md>
+	void ColumnWiseMatrix<ms, md>::Solve(Vector<ms, md>& rhs, const MatrixOperation lhsOperation, DenseSolverType solver) const
+	{
+		assert(nRows() == rhs.size());
+
+		MemoryTile tmp(rhs.GetBuffer());
+		if (ms == MemorySpace::Host || ms == MemorySpace::Device)
+			dm::detail::Solve(this->_buffer, tmp, lhsOperation, detail::ToLinearSystemSolverType(solver));
+		else
+			routines::Solve(this->_buffer, tmp, lhsOperation, solver);
+	}
+
+	template<MemorySpace ms, MathDomain md>
+	void ColumnWiseMatrix<ms, md>::Solve(ColumnWiseMatrix& rhs, const MatrixOperation lhsOperation, LinearSystemSolverType solver) const
+	{
+		Solve(rhs, lhsOperation, detail::ToDenseSolverType(solver));
+	}
+
 	template<MemorySpace ms, MathDomain md>
 	void ColumnWiseMatrix<ms, md>::Solve(Vector<ms, md>& rhs, const MatrixOperation lhsOperation, LinearSystemSolverType solver) const
+	{
+		Solve(rhs, lhsOperation, detail::ToDenseSolverType(solver));
+	}
+
+	template<MemorySpace ms, MathDomain md>
+	void ColumnWiseMatrix<ms, md>::Invert(routines::SolverWorkspace& workspace, const MatrixOperation lhsOperation, DenseSolverType solver)
+	{
+		if (ms == MemorySpace::Host || ms == MemorySpace::Device)
+		{
+			// the device kernels only invert through Lu
+			if (detail::ToLinearSystemSolverType(solver) != LinearSystemSolverType::Lu)
+				throw NotImplementedException();
+			dm::detail::Invert(this->_buffer, lhsOperation);
+		}
+		else
+			routines::Invert(this->_buffer, workspace, lhsOperation, solver);
+	}
+
+	template<MemorySpace ms, MathDomain md>
+	void ColumnWiseMatrix<ms, md>::Solve(ColumnWiseMatrix& rhs, routines::SolverWorkspace& workspace, const MatrixOperation lhsOperation, DenseSolverType solver) const
+	{
+		assert(nRows() == rhs.nRows());
+		if (ms == MemorySpace::Host || ms == MemorySpace::Device)
+			dm::detail::Solve(this->_buffer, rhs._buffer, lhsOperation, detail::ToLinearSystemSolverType(solver));
+		else
+			routines::Solve(this->_buffer, rhs._buffer, workspace, lhsOperation, solver);
+	}
+
+	template<MemorySpace ms, MathDomain md>
+	void ColumnWiseMatrix<ms, md>::Solve(Vector<ms, md>& rhs, routines::SolverWorkspace& workspace, const MatrixOperation lhsOperation, DenseSolverType solver) const
 	{
 		assert(nRows() == rhs.size());
 
 		MemoryTile tmp(rhs.GetBuffer());
 		if (ms == MemorySpace::Host || ms == MemorySpace::Device)
-			dm::detail::Solve(this->buffer, tmp, lhsOperation, solver);
+			dm::detail::Solve(this->_buffer, tmp, lhsOperation, detail::ToLinearSystemSolverType(solver));
 		else
-			routines::Solve(this->buffer, tmp, lhsOperation, solver);
+			routines::Solve(this->_buffer, tmp, workspace, lhsOperation, solver);
 	}
 
 	template<MemorySpace ms, MathDomain md>
@@ -723,6 +1005,10 @@ template<MemorySpace ms, MathDomain md>
 	template<MemorySpace ms, MathDomain md>
 	ColumnWiseMatrix<ms, md> ColumnWiseMatrix<ms, md>::MatrixFromBinaryFile(const std::string& fileName, const bool transposed, const bool compressed, const bool useMemoryMapping)
 	{
+		// data can be used in place only if it's already in column-wise order
+		if (!compressed && (!transposed || routines::NpyFileReader(fileName).GetHeader().fortranOrder))
+			return ColumnWiseMatrix<ms, md>(fileName, useMemoryMapping);
+
 		std::vector<typename Vector<ms, md>::stdType> _mat {};
 		unsigned nRows = 0, nCols = 0;
 		cl::MatrixFromBinaryFile(_mat, nRows, nCols, fileName, transposed, compressed, useMemoryMapping);
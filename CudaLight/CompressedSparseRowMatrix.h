@@ -28,6 +28,11 @@ namespace cl
 		// copy denseVector to host, numerically finds the non-zero indices, and then copy back to device
 		explicit CompressedSparseRowMatrix(const ColumnWiseMatrix<memorySpace, mathDomain>& denseMatrix);
 		CompressedSparseRowMatrix(const std::vector<stdType>& denseMatrix, const size_t nRows, const size_t nCols);
+		/**
+		 * Loads a csr_matrix saved by ToBinaryFile or scipy.sparse.save_npz: with useMemoryMapping the arrays stored uncompressed with the
+		 * same element type are used in place, and IsMemoryMapped tells whether the values are
+		 */
+		explicit CompressedSparseRowMatrix(const std::string& fileName, bool useMemoryMapping = false);
 		CompressedSparseRowMatrix(const CompressedSparseRowMatrix& rhs);
 		CompressedSparseRowMatrix(CompressedSparseRowMatrix&& rhs) noexcept;
 
@@ -62,7 +67,10 @@ namespace cl
 		void Print(const std::string& label = "") const final;
 		void PrintNonZeros(const std::string& label = "") const;
 		std::ostream& ToOutputStream(std::ostream&) const final { throw std::logic_error("Not Implemented"); }
-		void ToBinaryFile(const std::string&, const bool, const std::string) const final { throw std::logic_error("Not Implemented"); }
+		/**
+		 * Saves a scipy-compatible csr_matrix .npz archive: mode has to be "w"
+		 */
+		void ToBinaryFile(const std::string& fileName, const bool compressed = false, const std::string mode = "w") const final;
 
 		unsigned denseSize() const noexcept { return nRows() * nCols(); }	 // used only when converting to dense
 		unsigned nRows() const noexcept { return _buffer.nRows; }
@@ -167,6 +175,16 @@ namespace cl
 	using MklFloatSparseMatrix = MklSingleSparseMatrix;
 	using MklDoubleSparseMatrix = CompressedSparseRowMatrix<MemorySpace::Mkl, MathDomain::Double>;
 
+	using OpenBlasIntegerSparseMatrix = CompressedSparseRowMatrix<MemorySpace::OpenBlas, MathDomain::Int>;
+	using OpenBlasSingleSparseMatrix = CompressedSparseRowMatrix<MemorySpace::OpenBlas, MathDomain::Float>;
+	using OpenBlasFloatSparseMatrix = OpenBlasSingleSparseMatrix;
+	using OpenBlasDoubleSparseMatrix = CompressedSparseRowMatrix<MemorySpace::OpenBlas, MathDomain::Double>;
+
+	using GenericBlasIntegerSparseMatrix = CompressedSparseRowMatrix<MemorySpace::GenericBlas, MathDomain::Int>;
+	using GenericBlasSingleSparseMatrix = CompressedSparseRowMatrix<MemorySpace::GenericBlas, MathDomain::Float>;
+	using GenericBlasFloatSparseMatrix = GenericBlasSingleSparseMatrix;
+	using GenericBlasDoubleSparseMatrix = CompressedSparseRowMatrix<MemorySpace::GenericBlas, MathDomain::Double>;
+
 	namespace gpu
 	{
 		using smat = cl::GpuFloatSparseMatrix;
@@ -193,6 +211,20 @@ namespace cl
 		using ismat = cl::MklIntegerSparseMatrix;
 	}	 // namespace mkl
 
+	namespace oblas
+	{
+		using smat = cl::OpenBlasSingleSparseMatrix;
+		using dsmat = cl::OpenBlasDoubleSparseMatrix;
+		using ismat = cl::OpenBlasIntegerSparseMatrix;
+	}	 // namespace oblas
+
+	namespace gblas
+	{
+		using smat = cl::GenericBlasSingleSparseMatrix;
+		using dsmat = cl::GenericBlasDoubleSparseMatrix;
+		using ismat = cl::GenericBlasIntegerSparseMatrix;
+	}	 // namespace gblas
+
 	namespace test
 	{
 		using smat = cl::TestSingleSparseMatrix;
@@ -211,6 +243,20 @@ namespace mkl
 	using ismat = cl::MklIntegerSparseMatrix;
 }	 // namespace mkl
 
+namespace oblas
+{
+	using smat = cl::OpenBlasSingleSparseMatrix;
+	using dsmat = cl::OpenBlasDoubleSparseMatrix;
+	using ismat = cl::OpenBlasIntegerSparseMatrix;
+}	 // namespace oblas
+
+namespace gblas
+{
+	using smat = cl::GenericBlasSingleSparseMatrix;
+	using dsmat = cl::GenericBlasDoubleSparseMatrix;
+	using ismat = cl::GenericBlasIntegerSparseMatrix;
+}	 // namespace gblas
+
 namespace test
 {
 	using smat = cl::TestSingleSparseMatrix;
@@ -99,6 +99,25 @@ namespace cl
 		SyncPointers();
 	}
 
+	template< MemorySpace ms, MathDomain md>
+	CompressedSparseRowMatrix<ms, md>::CompressedSparseRowMatrix(const std::string& fileName, bool useMemoryMapping)
+		: Buffer<CompressedSparseRowMatrix < ms, md>, ms, md>(false), _buffer(0, 0, 0, 0, 0, 0, ms, md)
+	{
+		routines::NpzFileReader reader(fileName);
+		cl::SparseMatrixShapeFromBinaryFile(reader, _buffer.nRows, _buffer.nCols);
+
+		// each array is mapped on its own: the ones that can't be fall back to a copy
+		values.ReadFromArchive(reader, fileName, "data", useMemoryMapping);
+		nonZeroColumnIndices.ReadFromArchive(reader, fileName, "indices", useMemoryMapping);
+		nNonZeroRows.ReadFromArchive(reader, fileName, "indptr", useMemoryMapping);
+		if (nonZeroColumnIndices.size() != values.size() || nNonZeroRows.size() != nRows() + 1)
+			throw NpyFileException("Inconsistent csr arrays");
+
+		this->_mapping = values._mapping;
+		_buffer.size = values.size();
+		SyncPointers();
+	}
+
 	template< MemorySpace ms, MathDomain md>
 	CompressedSparseRowMatrix<ms, md>::CompressedSparseRowMatrix(const CompressedSparseRowMatrix& rhs)
 		: Buffer<CompressedSparseRowMatrix < ms, md>, ms, md>(false), // CompressedSparseRowMatrix doesn't allocate its memory in its _buffer!
@@ -118,6 +137,28 @@ template< MemorySpace ms, MathDomain md>
 		SyncPointers();
 	}
 
+	template< MemorySpace ms, MathDomain md>
+	void CompressedSparseRowMatrix<ms, md>::ToBinaryFile(const std::string& fileName, const bool compressed, const std::string mode) const
+	{
+		if (mode != "w")
+			throw NotImplementedException();
+
+		// host memory is written straight from the buffers, with no intermediate copy
+		if (ms != MemorySpace::Host && ms != MemorySpace::Device)
+		{
+			cl::SparseMatrixToBinaryFile(reinterpret_cast<const stdType*>(_buffer.pointer),
+										 reinterpret_cast<const int*>(_buffer.nonZeroColumnIndices),
+										 reinterpret_cast<const int*>(_buffer.nNonZeroRows),
+										 _buffer.size, nRows(), nCols(), fileName, compressed);
+			return;
+		}
+
+		const auto _values = values.Get();
+		const auto _nonZeroColumnIndices = nonZeroColumnIndices.Get();
+		const auto _nNonZeroRows = nNonZeroRows.Get();
+		cl::SparseMatrixToBinaryFile(_values.data(), _nonZeroColumnIndices.data(), _nNonZeroRows.data(), _buffer.size, nRows(), nCols(), fileName, compressed);
+	}
+
 	template< MemorySpace ms, MathDomain md>
 	void CompressedSparseRowMatrix<ms, md>::SyncPointers()
 	{
@@ -192,9 +233,9 @@ template< MemorySpace ms, MathDomain md>
 	template< MemorySpace ms, MathDomain md>
 	Vector<ms, md> CompressedSparseRowMatrix<ms, md>::operator *(const Vector<ms, md>& rhs) const
 	{
-		assert(nRows() == rhs.size());
+		assert(nCols() == rhs.size());
 
-		Vector<ms, md> ret(rhs.size());
+		Vector<ms, md> ret(nRows());
 		if (ms == MemorySpace::Host || ms == MemorySpace::Device)
 			dm::detail::SparseDot(ret._buffer, const_cast<SparseMemoryTile&>(this->_buffer), rhs._buffer);
 		else
@@ -206,7 +247,7 @@ template< MemorySpace ms, MathDomain md>
 	template< MemorySpace ms, MathDomain md>
 	ColumnWiseMatrix<ms, md> CompressedSparseRowMatrix<ms, md>::Multiply(const ColumnWiseMatrix<ms, md>& rhs, const MatrixOperation lhsOperation, const double alpha) const
 	{
-		ColumnWiseMatrix<ms, md> ret(nRows(), rhs.nCols());
+		ColumnWiseMatrix<ms, md> ret(lhsOperation == MatrixOperation::None ? nRows() : nCols(), rhs.nCols());
 		Multiply(ret, rhs, lhsOperation, alpha);
 
 		return ret;
@@ -215,7 +256,8 @@ template< MemorySpace ms, MathDomain md>
 	template< MemorySpace ms, MathDomain md>
 	void CompressedSparseRowMatrix<ms, md>::Multiply(ColumnWiseMatrix<ms, md>& out, const ColumnWiseMatrix<ms, md>& rhs, const MatrixOperation lhsOperation, const double alpha) const
 	{
-		assert(nCols() == rhs.nRows());
+		assert((lhsOperation == MatrixOperation::None ? nCols() : nRows()) == rhs.nRows());
+		assert((lhsOperation == MatrixOperation::None ? nRows() : nCols()) == out.nRows());
 		if (ms == MemorySpace::Host || ms == MemorySpace::Device)
 			dm::detail::SparseMultiply(out._buffer,
 									   const_cast<SparseMemoryTile&>(this->_buffer),
@@ -229,7 +271,7 @@ template< MemorySpace ms, MathDomain md>
 	template< MemorySpace ms, MathDomain md>
 	Vector<ms, md> CompressedSparseRowMatrix<ms, md>::Dot(const Vector<ms, md>& rhs, const MatrixOperation lhsOperation, const double alpha) const
 	{
-		Vector<ms, md> ret(rhs.size());
+		Vector<ms, md> ret(lhsOperation == MatrixOperation::None ? nRows() : nCols());
 		Dot(ret, rhs, lhsOperation, alpha);
 
 		return ret;
@@ -238,7 +280,8 @@ template< MemorySpace ms, MathDomain md>
 	template< MemorySpace ms, MathDomain md>
 	void CompressedSparseRowMatrix<ms, md>::Dot(Vector<ms, md>& out, const Vector<ms, md>& rhs, const MatrixOperation lhsOperation, const double alpha) const
 	{
-		assert(nRows() == rhs.size());
+		assert((lhsOperation == MatrixOperation::None ? nCols() : nRows()) == rhs.size());
+		assert((lhsOperation == MatrixOperation::None ? nRows() : nCols()) == out.size());
 		if (ms == MemorySpace::Host || ms == MemorySpace::Device)
 			dm::detail::SparseDot(out._buffer, const_cast<SparseMemoryTile&>(this->_buffer), rhs._buffer, lhsOperation, alpha);
 		else
@@ -0,0 +1,171 @@
+#pragma once
+
+#include <assert.h>
+#include <type_traits>
+
+#include <Buffer.h>
+#include <Types.h>
+
+namespace cl
+{
+	/**
+	 * Lazy element-wise arithmetic: an expression like Lazy(a) + b % c - d only records the operations,
+	 * and Assign(out, expression) evaluates them in a single pass over memory, without temporaries.
+	 *
+	 * Only the leftmost operand needs to be wrapped with Lazy, as long as operators are evaluated left to right: in
+	 * Lazy(a) + b % c, b % c is evaluated eagerly, hence Lazy(a) + Lazy(b) % c should be used instead.
+	 *
+	 * Operands must outlive the expression. Host and Device memory spaces don't have a fused kernel, and fall back
+	 * to the eager operators, as well as strided matrix views (see ColumnWiseMatrix), either as operands or as output.
+	 */
+	template<typename ExpressionImpl>
+	class Expression
+	{
+	public:
+		const ExpressionImpl& Derived() const noexcept { return static_cast<const ExpressionImpl&>(*this); }
+	};
+
+	/**
+	 * Leaf of the expression tree, referencing a Vector or a ColumnWiseMatrix
+	 */
+	template<typename BufferImpl, MemorySpace memorySpace, MathDomain mathDomain>
+	class TerminalExpression: public Expression<TerminalExpression<BufferImpl, memorySpace, mathDomain>>
+	{
+	public:
+		using bufferType = BufferImpl;
+		using stdType = typename Traits<mathDomain>::stdType;
+		static constexpr MemorySpace ms = memorySpace;
+		static constexpr MathDomain md = mathDomain;
+
+		explicit TerminalExpression(const Buffer<BufferImpl, memorySpace, mathDomain>& buffer) noexcept
+			: _buffer(static_cast<const BufferImpl&>(buffer)), _pointer(reinterpret_cast<const stdType*>(buffer.GetBuffer().pointer))	  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast,performance-no-int-to-ptr)
+		{
+		}
+
+		unsigned size() const noexcept { return _buffer.size(); }
+		bool IsContiguous() const noexcept { return _buffer.IsContiguous(); }
+		stdType At(const size_t i) const noexcept { return _pointer[i]; }
+		BufferImpl Evaluate() const { return BufferImpl(_buffer); }
+
+	private:
+		const BufferImpl& _buffer;
+		const stdType* _pointer;
+	};
+
+	template<typename Operation, typename Lhs, typename Rhs>
+	class BinaryExpression: public Expression<BinaryExpression<Operation, Lhs, Rhs>>
+	{
+	public:
+		static_assert(std::is_same<typename Lhs::bufferType, typename Rhs::bufferType>::value, "operands must have the same type");
+
+		using bufferType = typename Lhs::bufferType;
+		using stdType = typename Lhs::stdType;
+		static constexpr MemorySpace ms = Lhs::ms;
+		static constexpr MathDomain md = Lhs::md;
+
+		BinaryExpression(const Lhs& lhs, const Rhs& rhs) noexcept : _lhs(lhs), _rhs(rhs) { assert(lhs.size() == rhs.size()); }
+
+		unsigned size() const noexcept { return _lhs.size(); }
+		bool IsContiguous() const noexcept { return _lhs.IsContiguous() && _rhs.IsContiguous(); }
+		stdType At(const size_t i) const noexcept { return Operation::Apply(_lhs.At(i), _rhs.At(i)); }
+		bufferType Evaluate() const { return Operation::Evaluate(_lhs.Evaluate(), _rhs.Evaluate()); }
+
+	private:
+		// sub-expressions are tiny, and are usually temporaries: store them by value
+		const Lhs _lhs;
+		const Rhs _rhs;
+	};
+
+	template<typename Operand>
+	class ScaledExpression: public Expression<ScaledExpression<Operand>>
+	{
+	public:
+		using bufferType = typename Operand::bufferType;
+		using stdType = typename Operand::stdType;
+		static constexpr MemorySpace ms = Operand::ms;
+		static constexpr MathDomain md = Operand::md;
+
+		ScaledExpression(const Operand& operand, const double alpha) noexcept : _operand(operand), _alpha(alpha) {}
+
+		unsigned size() const noexcept { return _operand.size(); }
+		bool IsContiguous() const noexcept { return _operand.IsContiguous(); }
+		stdType At(const size_t i) const noexcept { return static_cast<stdType>(_alpha) * _operand.At(i); }
+		bufferType Evaluate() const;
+
+	private:
+		const Operand _operand;
+		const double _alpha;
+	};
+
+	namespace detail
+	{
+		struct Plus
+		{
+			template<typename T>
+			static T Apply(const T lhs, const T rhs) noexcept { return lhs + rhs; }
+			template<typename BufferImpl>
+			static BufferImpl Evaluate(const BufferImpl& lhs, const BufferImpl& rhs) { return lhs + rhs; }
+		};
+
+		struct Minus
+		{
+			template<typename T>
+			static T Apply(const T lhs, const T rhs) noexcept { return lhs - rhs; }
+			template<typename BufferImpl>
+			static BufferImpl Evaluate(const BufferImpl& lhs, const BufferImpl& rhs) { return lhs - rhs; }
+		};
+
+		struct ElementWiseProduct
+		{
+			template<typename T>
+			static T Apply(const T lhs, const T rhs) noexcept { return lhs * rhs; }
+			template<typename BufferImpl>
+			static BufferImpl Evaluate(const BufferImpl& lhs, const BufferImpl& rhs) { return lhs % rhs; }
+		};
+	}	 // namespace detail
+
+	/**
+	 * Starts an expression from a Vector or a ColumnWiseMatrix
+	 */
+	template<typename BufferImpl, MemorySpace ms, MathDomain md>
+	TerminalExpression<BufferImpl, ms, md> Lazy(const Buffer<BufferImpl, ms, md>& buffer) noexcept;
+
+	/**
+	 * out = expression, evaluated in a single pass. out can be one of the operands.
+	 */
+	template<typename BufferImpl, MemorySpace ms, MathDomain md, typename ExpressionImpl>
+	void Assign(Buffer<BufferImpl, ms, md>& out, const Expression<ExpressionImpl>& expression);
+
+#pragma region Operators
+
+	template<typename Lhs, typename Rhs>
+	BinaryExpression<detail::Plus, Lhs, Rhs> operator+(const Expression<Lhs>& lhs, const Expression<Rhs>& rhs) noexcept;
+	template<typename Lhs, typename BufferImpl, MemorySpace ms, MathDomain md>
+	BinaryExpression<detail::Plus, Lhs, TerminalExpression<BufferImpl, ms, md>> operator+(const Expression<Lhs>& lhs, const Buffer<BufferImpl, ms, md>& rhs) noexcept;
+	template<typename BufferImpl, MemorySpace ms, MathDomain md, typename Rhs>
+	BinaryExpression<detail::Plus, TerminalExpression<BufferImpl, ms, md>, Rhs> operator+(const Buffer<BufferImpl, ms, md>& lhs, const Expression<Rhs>& rhs) noexcept;
+
+	template<typename Lhs, typename Rhs>
+	BinaryExpression<detail::Minus, Lhs, Rhs> operator-(const Expression<Lhs>& lhs, const Expression<Rhs>& rhs) noexcept;
+	template<typename Lhs, typename BufferImpl, MemorySpace ms, MathDomain md>
+	BinaryExpression<detail::Minus, Lhs, TerminalExpression<BufferImpl, ms, md>> operator-(const Expression<Lhs>& lhs, const Buffer<BufferImpl, ms, md>& rhs) noexcept;
+	template<typename BufferImpl, MemorySpace ms, MathDomain md, typename Rhs>
+	BinaryExpression<detail::Minus, TerminalExpression<BufferImpl, ms, md>, Rhs> operator-(const Buffer<BufferImpl, ms, md>& lhs, const Expression<Rhs>& rhs) noexcept;
+
+	// element-wise product
+	template<typename Lhs, typename Rhs>
+	BinaryExpression<detail::ElementWiseProduct, Lhs, Rhs> operator%(const Expression<Lhs>& lhs, const Expression<Rhs>& rhs) noexcept;
+	template<typename Lhs, typename BufferImpl, MemorySpace ms, MathDomain md>
+	BinaryExpression<detail::ElementWiseProduct, Lhs, TerminalExpression<BufferImpl, ms, md>> operator%(const Expression<Lhs>& lhs, const Buffer<BufferImpl, ms, md>& rhs) noexcept;
+	template<typename BufferImpl, MemorySpace ms, MathDomain md, typename Rhs>
+	BinaryExpression<detail::ElementWiseProduct, TerminalExpression<BufferImpl, ms, md>, Rhs> operator%(const Buffer<BufferImpl, ms, md>& lhs, const Expression<Rhs>& rhs) noexcept;
+
+	template<typename Operand>
+	ScaledExpression<Operand> operator*(const double alpha, const Expression<Operand>& operand) noexcept;
+	template<typename Operand>
+	ScaledExpression<Operand> operator*(const Expression<Operand>& operand, const double alpha) noexcept;
+
+#pragma endregion
+}	 // namespace cl
+
+#include <Expression.tpp>
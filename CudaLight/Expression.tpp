@@ -0,0 +1,112 @@
+#pragma once
+
+namespace cl
+{
+	template<typename Operand>
+	typename ScaledExpression<Operand>::bufferType ScaledExpression<Operand>::Evaluate() const
+	{
+		auto ret = _operand.Evaluate();
+		ret.Scale(_alpha);
+
+		return ret;
+	}
+
+	template<typename BufferImpl, MemorySpace ms, MathDomain md>
+	TerminalExpression<BufferImpl, ms, md> Lazy(const Buffer<BufferImpl, ms, md>& buffer) noexcept
+	{
+		return TerminalExpression<BufferImpl, ms, md>(buffer);
+	}
+
+	template<typename BufferImpl, MemorySpace ms, MathDomain md, typename ExpressionImpl>
+	void Assign(Buffer<BufferImpl, ms, md>& out, const Expression<ExpressionImpl>& expression)
+	{
+		static_assert(std::is_same<BufferImpl, typename ExpressionImpl::bufferType>::value, "out must have the same type of the operands");
+
+		const auto& expr = expression.Derived();
+		assert(out.size() == expr.size());
+
+		// the fused loop needs contiguous memory: the eager operators work on copies of strided views, which are then scattered into out
+		if (ms == MemorySpace::Host || ms == MemorySpace::Device || !out.IsContiguous() || !expr.IsContiguous())
+		{
+			const auto tmp = expr.Evaluate();
+			static_cast<BufferImpl&>(out).ReadFrom(tmp);
+			return;
+		}
+
+		// every element only depends on the operands at the same position, hence out can alias any of them
+		auto* outPtr = reinterpret_cast<typename Traits<md>::stdType*>(out.GetBuffer().pointer);	  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast,performance-no-int-to-ptr)
+		const size_t size = out.size();
+		for (size_t i = 0; i < size; ++i)
+			outPtr[i] = expr.At(i);
+	}
+
+#pragma region Operators
+
+	template<typename Lhs, typename Rhs>
+	BinaryExpression<detail::Plus, Lhs, Rhs> operator+(const Expression<Lhs>& lhs, const Expression<Rhs>& rhs) noexcept
+	{
+		return BinaryExpression<detail::Plus, Lhs, Rhs>(lhs.Derived(), rhs.Derived());
+	}
+
+	template<typename Lhs, typename BufferImpl, MemorySpace ms, MathDomain md>
+	BinaryExpression<detail::Plus, Lhs, TerminalExpression<BufferImpl, ms, md>> operator+(const Expression<Lhs>& lhs, const Buffer<BufferImpl, ms, md>& rhs) noexcept
+	{
+		return lhs + Lazy(rhs);
+	}
+
+	template<typename BufferImpl, MemorySpace ms, MathDomain md, typename Rhs>
+	BinaryExpression<detail::Plus, TerminalExpression<BufferImpl, ms, md>, Rhs> operator+(const Buffer<BufferImpl, ms, md>& lhs, const Expression<Rhs>& rhs) noexcept
+	{
+		return Lazy(lhs) + rhs;
+	}
+
+	template<typename Lhs, typename Rhs>
+	BinaryExpression<detail::Minus, Lhs, Rhs> operator-(const Expression<Lhs>& lhs, const Expression<Rhs>& rhs) noexcept
+	{
+		return BinaryExpression<detail::Minus, Lhs, Rhs>(lhs.Derived(), rhs.Derived());
+	}
+
+	template<typename Lhs, typename BufferImpl, MemorySpace ms, MathDomain md>
+	BinaryExpression<detail::Minus, Lhs, TerminalExpression<BufferImpl, ms, md>> operator-(const Expression<Lhs>& lhs, const Buffer<BufferImpl, ms, md>& rhs) noexcept
+	{
+		return lhs - Lazy(rhs);
+	}
+
+	template<typename BufferImpl, MemorySpace ms, MathDomain md, typename Rhs>
+	BinaryExpression<detail::Minus, TerminalExpression<BufferImpl, ms, md>, Rhs> operator-(const Buffer<BufferImpl, ms, md>& lhs, const Expression<Rhs>& rhs) noexcept
+	{
+		return Lazy(lhs) - rhs;
+	}
+
+	template<typename Lhs, typename Rhs>
+	BinaryExpression<detail::ElementWiseProduct, Lhs, Rhs> operator%(const Expression<Lhs>& lhs, const Expression<Rhs>& rhs) noexcept
+	{
+		return BinaryExpression<detail::ElementWiseProduct, Lhs, Rhs>(lhs.Derived(), rhs.Derived());
+	}
+
+	template<typename Lhs, typename BufferImpl, MemorySpace ms, MathDomain md>
+	BinaryExpression<detail::ElementWiseProduct, Lhs, TerminalExpression<BufferImpl, ms, md>> operator%(const Expression<Lhs>& lhs, const Buffer<BufferImpl, ms, md>& rhs) noexcept
+	{
+		return lhs % Lazy(rhs);
+	}
+
+	template<typename BufferImpl, MemorySpace ms, MathDomain md, typename Rhs>
+	BinaryExpression<detail::ElementWiseProduct, TerminalExpression<BufferImpl, ms, md>, Rhs> operator%(const Buffer<BufferImpl, ms, md>& lhs, const Expression<Rhs>& rhs) noexcept
+	{
+		return Lazy(lhs) % rhs;
+	}
+
+	template<typename Operand>
+	ScaledExpression<Operand> operator*(const double alpha, const Expression<Operand>& operand) noexcept
+	{
+		return ScaledExpression<Operand>(operand.Derived(), alpha);
+	}
+
+	template<typename Operand>
+	ScaledExpression<Operand> operator*(const Expression<Operand>& operand, const double alpha) noexcept
+	{
+		return ScaledExpression<Operand>(operand.Derived(), alpha);
+	}
+
+#pragma endregion
+}	 // namespace cl
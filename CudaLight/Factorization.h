@@ -0,0 +1,95 @@
+#pragma once
+
+#include <memory>
+
+#include <ColumnWiseMatrix.h>
+#include <Types.h>
+#include <Vector.h>
+
+namespace cl
+{
+	/**
+	 * Factorization of a square matrix, computed once and reused for solving A * X = B with as many right hand sides as needed:
+	 * each solve is O(n^2), as opposed to ColumnWiseMatrix::Solve which factorizes A every time in O(n^3).
+	 * Cholesky and Ldlt only read the lower triangular part of A, which is assumed symmetric.
+	 *
+	 * Only the host BLAS memory spaces (Mkl, OpenBlas, GenericBlas) are supported. Test has the native Lu only: the other solvers throw NotImplementedException.
+	 */
+	template<MemorySpace memorySpace = MemorySpace::Device, MathDomain mathDomain = MathDomain::Float>
+	class Factorization
+	{
+	public:
+		explicit Factorization(const ColumnWiseMatrix<memorySpace, mathDomain>& A, const DenseSolverType solver = DenseSolverType::Lu);
+
+		Factorization(const Factorization& rhs) = delete;
+		Factorization(Factorization&& rhs) noexcept = default;
+		Factorization& operator=(const Factorization& rhs) = delete;
+		Factorization& operator=(Factorization&& rhs) = delete;
+		~Factorization() = default;
+
+		/**
+		 * Factorizes A, which must have the same size of the original matrix: memory is reused
+		 */
+		void Update(const ColumnWiseMatrix<memorySpace, mathDomain>& A);
+
+		/**
+		 * Solve A * X = B, B is overwritten
+		 */
+		void Solve(ColumnWiseMatrix<memorySpace, mathDomain>& rhs, const MatrixOperation lhsOperation = MatrixOperation::None) const;
+
+		/**
+		 * Solve A * x = b, b is overwritten
+		 */
+		void Solve(Vector<memorySpace, mathDomain>& rhs, const MatrixOperation lhsOperation = MatrixOperation::None) const;
+
+		DenseSolverType GetSolverType() const noexcept { return _solver; }
+		unsigned nRows() const noexcept { return _factors.nRows(); }
+
+		/**
+		 * LAPACK storage of the factors (e.g. L and U for Lu, L in the lower triangular part for Cholesky)
+		 */
+		const ColumnWiseMatrix<memorySpace, mathDomain>& GetFactors() const noexcept { return _factors; }
+
+	private:
+		void Factorize();
+
+		// pivot indices (Lu, Ldlt) or Householder coefficients (Qr); empty for Cholesky
+		MemoryBuffer GetAuxiliaryBuffer() const;
+
+		DenseSolverType _solver;
+		ColumnWiseMatrix<memorySpace, mathDomain> _factors;
+
+		std::unique_ptr<Vector<memorySpace, MathDomain::Int>> _pivot {};
+		std::unique_ptr<Vector<memorySpace, mathDomain>> _tau {};
+	};
+
+#pragma region Type aliases
+
+	namespace mkl
+	{
+		using fact = cl::Factorization<MemorySpace::Mkl, MathDomain::Float>;
+		using dfact = cl::Factorization<MemorySpace::Mkl, MathDomain::Double>;
+	}	 // namespace mkl
+
+	namespace oblas
+	{
+		using fact = cl::Factorization<MemorySpace::OpenBlas, MathDomain::Float>;
+		using dfact = cl::Factorization<MemorySpace::OpenBlas, MathDomain::Double>;
+	}	 // namespace oblas
+
+	namespace gblas
+	{
+		using fact = cl::Factorization<MemorySpace::GenericBlas, MathDomain::Float>;
+		using dfact = cl::Factorization<MemorySpace::GenericBlas, MathDomain::Double>;
+	}	 // namespace gblas
+
+	namespace test
+	{
+		using fact = cl::Factorization<MemorySpace::Test, MathDomain::Float>;
+		using dfact = cl::Factorization<MemorySpace::Test, MathDomain::Double>;
+	}	 // namespace test
+
+#pragma endregion
+}	 // namespace cl
+
+#include <Factorization.tpp>
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <assert.h>
+
+#include <HostRoutines/BlasWrappers.h>
+
+namespace cl
+{
+	template<MemorySpace ms, MathDomain md>
+	Factorization<ms, md>::Factorization(const ColumnWiseMatrix<ms, md>& A, const DenseSolverType solver)
+		: _solver(solver), _factors(A)
+	{
+		assert(A.nRows() == A.nCols());
+
+		switch (_solver)
+		{
+			case DenseSolverType::Lu:
+			case DenseSolverType::Ldlt:
+				_pivot = std::make_unique<Vector<ms, MathDomain::Int>>(A.nRows(), 0);
+				break;
+			case DenseSolverType::Qr:
+				_tau = std::make_unique<Vector<ms, md>>(A.nRows(), static_cast<typename Vector<ms, md>::stdType>(0));
+				break;
+			case DenseSolverType::Cholesky:
+				break;
+			default:
+				throw NotImplementedException();
+		}
+
+		Factorize();
+	}
+
+	template<MemorySpace ms, MathDomain md>
+	void Factorization<ms, md>::Update(const ColumnWiseMatrix<ms, md>& A)
+	{
+		assert(A.nRows() == _factors.nRows());
+		assert(A.nCols() == _factors.nCols());
+
+		_factors.ReadFrom(A);
+		Factorize();
+	}
+
+	template<MemorySpace ms, MathDomain md>
+	void Factorization<ms, md>::Solve(ColumnWiseMatrix<ms, md>& rhs, const MatrixOperation lhsOperation) const
+	{
+		assert(nRows() == rhs.nRows());
+
+		routines::SolveFactorized(_factors.GetTile(), GetAuxiliaryBuffer(), rhs.GetTile(), lhsOperation, _solver);
+	}
+
+	template<MemorySpace ms, MathDomain md>
+	void Factorization<ms, md>::Solve(Vector<ms, md>& rhs, const MatrixOperation lhsOperation) const
+	{
+		assert(nRows() == rhs.size());
+
+		MemoryTile tmp(rhs.GetBuffer());
+		routines::SolveFactorized(_factors.GetTile(), GetAuxiliaryBuffer(), tmp, lhsOperation, _solver);
+	}
+
+	template<MemorySpace ms, MathDomain md>
+	void Factorization<ms, md>::Factorize()
+	{
+		MemoryBuffer auxiliary = GetAuxiliaryBuffer();
+		routines::Factorize(_factors.GetTile(), auxiliary, _solver);
+	}
+
+	template<MemorySpace ms, MathDomain md>
+	MemoryBuffer Factorization<ms, md>::GetAuxiliaryBuffer() const
+	{
+		if (_pivot)
+			return _pivot->GetBuffer();
+		if (_tau)
+			return _tau->GetBuffer();
+
+		return MemoryBuffer();
+	}
+}	 // namespace cl
@@ -50,6 +50,13 @@ namespace cl
 		virtual IBuffer& Scale(const double alpha) = 0;
 		virtual IBuffer& ElementWiseProduct(const IBuffer& rhs, const double alpha = 1.0) = 0;
 
+		virtual IBuffer& Exp() = 0;
+		virtual IBuffer& Log() = 0;
+		virtual IBuffer& Sqrt() = 0;
+		virtual IBuffer& Pow(const double exponent) = 0;
+		virtual IBuffer& Tanh() = 0;
+		virtual IBuffer& Erf() = 0;
+
 		virtual int AbsoluteMinimumIndex() const = 0;
 		virtual int AbsoluteMaximumIndex() const = 0;
 		virtual stdType AbsoluteMinimum() const = 0;
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include <ColumnWiseMatrix.h>
+#include <CompressedSparseRowMatrix.h>
+#include <Types.h>
+#include <Vector.h>
+
+namespace cl
+{
+	enum class IterativeSolverType
+	{
+		ConjugateGradient,	  // A has to be symmetric positive definite
+		BiConjugateGradientStabilized,
+		Gmres
+	};
+
+	enum class PreconditionerType
+	{
+		None,
+		Jacobi,
+		IncompleteLu	// ILU(0): A has to store its whole diagonal, with sorted column indices
+	};
+
+	struct IterativeSolverOptions
+	{
+		// stops as soon as ||b - A * x|| <= tolerance * ||b||
+		double tolerance = 1e-8;
+		unsigned maxIterations = 1000;
+
+		// size of the Krylov subspace after which GMRES restarts
+		unsigned restart = 30;
+	};
+
+	struct IterativeSolverResult
+	{
+		unsigned nIterations = 0;
+
+		// ||b - A * x|| / ||b||: CG and BiCGSTAB report their recurrence, GMRES recomputes it at each restart
+		double relativeResidual = 0.0;
+		bool converged = false;
+	};
+
+	/**
+	 * Preconditioned Krylov solvers for A * x = b, A being a square CSR matrix: each iteration costs one or two sparse products, plus a few O(n) vector operations.
+	 * The preconditioner is computed and all the work buffers are allocated at construction, so that Solve doesn't allocate.
+	 * A is referenced, not copied: it has to outlive the solver.
+	 *
+	 * Only the host BLAS memory spaces (Mkl, OpenBlas, GenericBlas) and Test are supported.
+	 */
+	template<MemorySpace memorySpace = MemorySpace::Device, MathDomain mathDomain = MathDomain::Float>
+	class IterativeSolver
+	{
+	public:
+		IterativeSolver(const CompressedSparseRowMatrix<memorySpace, mathDomain>& A, const IterativeSolverType solver, const PreconditionerType preconditioner = PreconditionerType::None, const IterativeSolverOptions& options = IterativeSolverOptions());
+
+		IterativeSolver(const IterativeSolver& rhs) = delete;
+		IterativeSolver(IterativeSolver&& rhs) noexcept = default;
+		IterativeSolver& operator=(const IterativeSolver& rhs) = delete;
+		IterativeSolver& operator=(IterativeSolver&& rhs) = delete;
+		~IterativeSolver() = default;
+
+		/**
+		 * Solve A * x = b, x being the initial guess: it's overwritten with the solution.
+		 * Not converging within the maximum number of iterations isn't an error: the result tells whether the tolerance has been met
+		 */
+		IterativeSolverResult Solve(Vector<memorySpace, mathDomain>& x, const Vector<memorySpace, mathDomain>& b);
+
+		IterativeSolverType GetSolverType() const noexcept { return _solver; }
+		PreconditionerType GetPreconditionerType() const noexcept { return _preconditioner; }
+
+		const IterativeSolverOptions& GetOptions() const noexcept { return _options; }
+		void SetOptions(const IterativeSolverOptions& options);
+
+	private:
+		// out = M^(-1) * in
+		void ApplyPreconditioner(MemoryBuffer& out, const MemoryBuffer& in);
+
+		// r = b - A * x
+		void Residual(MemoryBuffer& r, const MemoryBuffer& x, const MemoryBuffer& b);
+
+		MemoryBuffer& Work(const size_t i) noexcept { return _work[i]->GetBuffer(); }
+		void AllocateWorkspace();
+
+		IterativeSolverResult ConjugateGradient(MemoryBuffer& x, const MemoryBuffer& b, const double bNorm);
+		IterativeSolverResult BiConjugateGradientStabilized(MemoryBuffer& x, const MemoryBuffer& b, const double bNorm);
+		IterativeSolverResult Gmres(MemoryBuffer& x, const MemoryBuffer& b, const double bNorm);
+
+		const CompressedSparseRowMatrix<memorySpace, mathDomain>& _A;
+
+		IterativeSolverType _solver;
+		PreconditionerType _preconditioner;
+		IterativeSolverOptions _options;
+
+		// Jacobi: inverse of the diagonal of A
+		std::unique_ptr<Vector<memorySpace, mathDomain>> _inverseDiagonal {};
+
+		// IncompleteLu: L and U in place of the values of A, and position of their diagonal
+		std::unique_ptr<CompressedSparseRowMatrix<memorySpace, mathDomain>> _factors {};
+		std::unique_ptr<Vector<memorySpace, MathDomain::Int>> _diagonalPosition {};
+
+		// Krylov vectors, as many as the solver needs
+		std::vector<std::unique_ptr<Vector<memorySpace, mathDomain>>> _work {};
+
+		// GMRES: Arnoldi basis (one vector per column), and least squares problem reduced with Givens rotations
+		std::unique_ptr<ColumnWiseMatrix<memorySpace, mathDomain>> _basis {};
+		std::unique_ptr<Vector<memorySpace, mathDomain>> _coefficients {};
+		std::vector<double> _hessenberg {};
+		std::vector<double> _cosines {};
+		std::vector<double> _sines {};
+		std::vector<double> _g {};
+	};
+
+#pragma region Type aliases
+
+	namespace mkl
+	{
+		using krylov = cl::IterativeSolver<MemorySpace::Mkl, MathDomain::Float>;
+		using dkrylov = cl::IterativeSolver<MemorySpace::Mkl, MathDomain::Double>;
+	}	 // namespace mkl
+
+	namespace oblas
+	{
+		using krylov = cl::IterativeSolver<MemorySpace::OpenBlas, MathDomain::Float>;
+		using dkrylov = cl::IterativeSolver<MemorySpace::OpenBlas, MathDomain::Double>;
+	}	 // namespace oblas
+
+	namespace gblas
+	{
+		using krylov = cl::IterativeSolver<MemorySpace::GenericBlas, MathDomain::Float>;
+		using dkrylov = cl::IterativeSolver<MemorySpace::GenericBlas, MathDomain::Double>;
+	}	 // namespace gblas
+
+	namespace test
+	{
+		using krylov = cl::IterativeSolver<MemorySpace::Test, MathDomain::Float>;
+		using dkrylov = cl::IterativeSolver<MemorySpace::Test, MathDomain::Double>;
+	}	 // namespace test
+
+#pragma endregion
+}	 // namespace cl
+
+#include <IterativeSolver.tpp>
@@ -0,0 +1,406 @@
+#pragma once
+
+#include <assert.h>
+#include <algorithm>
+#include <cmath>
+
+#include <HostRoutines/BlasWrappers.h>
+#include <HostRoutines/BufferInitializer.h>
+#include <HostRoutines/MemoryManager.h>
+#include <HostRoutines/SparseWrappers.h>
+
+namespace cl
+{
+	template<MemorySpace ms, MathDomain md>
+	IterativeSolver<ms, md>::IterativeSolver(const CompressedSparseRowMatrix<ms, md>& A, const IterativeSolverType solver, const PreconditionerType preconditioner, const IterativeSolverOptions& options)
+		: _A(A), _solver(solver), _preconditioner(preconditioner), _options(options)
+	{
+		assert(A.nRows() == A.nCols());
+
+		switch (_preconditioner)
+		{
+			case PreconditionerType::None:
+				break;
+			case PreconditionerType::Jacobi:
+				_inverseDiagonal = std::make_unique<Vector<ms, md>>(A.nRows());
+				routines::SparseDiagonal(_inverseDiagonal->GetBuffer(), A.GetCsrBuffer());
+				routines::Reciprocal(_inverseDiagonal->GetBuffer());
+				break;
+			case PreconditionerType::IncompleteLu:
+				_factors = std::make_unique<CompressedSparseRowMatrix<ms, md>>(A);
+				_diagonalPosition = std::make_unique<Vector<ms, MathDomain::Int>>(A.nRows(), 0);
+				routines::SparseIncompleteLu(_factors->GetCsrBuffer(), _diagonalPosition->GetBuffer());
+				break;
+			default:
+				throw NotImplementedException();
+		}
+
+		AllocateWorkspace();
+	}
+
+	template<MemorySpace ms, MathDomain md>
+	void IterativeSolver<ms, md>::SetOptions(const IterativeSolverOptions& options)
+	{
+		const bool resize = options.restart != _options.restart;
+		_options = options;
+		if (resize)
+			AllocateWorkspace();
+	}
+
+	template<MemorySpace ms, MathDomain md>
+	IterativeSolverResult IterativeSolver<ms, md>::Solve(Vector<ms, md>& x, const Vector<ms, md>& b)
+	{
+		assert(x.size() == _A.nCols());
+		assert(b.size() == _A.nRows());
+
+		double bNorm = 0.0;
+		routines::EuclideanNorm(bNorm, b.GetBuffer());
+		if (bNorm == 0.0)
+		{
+			routines::Zero(x.GetBuffer());
+
+			IterativeSolverResult ret;
+			ret.converged = true;
+			return ret;
+		}
+
+		switch (_solver)
+		{
+			case IterativeSolverType::ConjugateGradient:
+				return ConjugateGradient(x.GetBuffer(), b.GetBuffer(), bNorm);
+			case IterativeSolverType::BiConjugateGradientStabilized:
+				return BiConjugateGradientStabilized(x.GetBuffer(), b.GetBuffer(), bNorm);
+			case IterativeSolverType::Gmres:
+				return Gmres(x.GetBuffer(), b.GetBuffer(), bNorm);
+			default:
+				throw NotImplementedException();
+		}
+	}
+
+	template<MemorySpace ms, MathDomain md>
+	void IterativeSolver<ms, md>::AllocateWorkspace()
+	{
+		const unsigned n = _A.nRows();
+
+		size_t nWorkVectors = 0;
+		switch (_solver)
+		{
+			case IterativeSolverType::ConjugateGradient:
+				nWorkVectors = 4;
+				break;
+			case IterativeSolverType::BiConjugateGradientStabilized:
+				nWorkVectors = 8;
+				break;
+			case IterativeSolverType::Gmres:
+			{
+				nWorkVectors = 2;
+
+				const unsigned m = std::max(1u, std::min(_options.restart, n));
+				_basis = std::make_unique<ColumnWiseMatrix<ms, md>>(n, m + 1);
+				_coefficients = std::make_unique<Vector<ms, md>>(m);
+				_hessenberg.assign(static_cast<size_t>(m + 1) * m, 0.0);
+				_cosines.assign(m, 0.0);
+				_sines.assign(m, 0.0);
+				_g.assign(m + 1, 0.0);
+				break;
+			}
+			default:
+				throw NotImplementedException();
+		}
+
+		_work.clear();
+		for (size_t i = 0; i < nWorkVectors; ++i)
+			_work.push_back(std::make_unique<Vector<ms, md>>(n));
+	}
+
+	template<MemorySpace ms, MathDomain md>
+	void IterativeSolver<ms, md>::ApplyPreconditioner(MemoryBuffer& out, const MemoryBuffer& in)
+	{
+		switch (_preconditioner)
+		{
+			case PreconditionerType::None:
+				routines::Copy(out, in);
+				break;
+			case PreconditionerType::Jacobi:
+				routines::ElementwiseProduct(out, in, _inverseDiagonal->GetBuffer());
+				break;
+			case PreconditionerType::IncompleteLu:
+				routines::Copy(out, in);
+				routines::SparseSolveIncompleteLu(_factors->GetCsrBuffer(), _diagonalPosition->GetBuffer(), out);
+				break;
+			default:
+				throw NotImplementedException();
+		}
+	}
+
+	template<MemorySpace ms, MathDomain md>
+	void IterativeSolver<ms, md>::Residual(MemoryBuffer& r, const MemoryBuffer& x, const MemoryBuffer& b)
+	{
+		routines::Copy(r, b);
+		routines::SparseDot(r, const_cast<SparseMemoryTile&>(_A.GetCsrBuffer()), x, MatrixOperation::None, -1.0, 1.0);
+	}
+
+	template<MemorySpace ms, MathDomain md>
+	IterativeSolverResult IterativeSolver<ms, md>::ConjugateGradient(MemoryBuffer& x, const MemoryBuffer& b, const double bNorm)
+	{
+		auto& A = const_cast<SparseMemoryTile&>(_A.GetCsrBuffer());
+		auto& r = Work(0);
+		auto& z = Work(1);
+		auto& p = Work(2);
+		auto& q = Work(3);
+
+		IterativeSolverResult ret;
+
+		double rNorm = 0.0;
+		Residual(r, x, b);
+		routines::EuclideanNorm(rNorm, r);
+		ret.relativeResidual = rNorm / bNorm;
+		if (ret.relativeResidual <= _options.tolerance)
+		{
+			ret.converged = true;
+			return ret;
+		}
+
+		ApplyPreconditioner(z, r);
+		routines::Copy(p, z);
+		double rz = 0.0;
+		routines::InnerProduct(rz, r, z);
+
+		while (ret.nIterations < _options.maxIterations)
+		{
+			routines::SparseDot(q, A, p);
+			double pq = 0.0;
+			routines::InnerProduct(pq, p, q);
+			if (pq == 0.0)
+				break;
+
+			const double alpha = rz / pq;
+			routines::AddEqual(x, p, alpha);
+			routines::AddEqual(r, q, -alpha);
+			++ret.nIterations;
+
+			routines::EuclideanNorm(rNorm, r);
+			ret.relativeResidual = rNorm / bNorm;
+			if (ret.relativeResidual <= _options.tolerance)
+			{
+				ret.converged = true;
+				break;
+			}
+
+			// p = z + beta * p
+			ApplyPreconditioner(z, r);
+			double rzNew = 0.0;
+			routines::InnerProduct(rzNew, r, z);
+			routines::Scale(p, rzNew / rz);
+			routines::AddEqual(p, z);
+			rz = rzNew;
+		}
+
+		return ret;
+	}
+
+	template<MemorySpace ms, MathDomain md>
+	IterativeSolverResult IterativeSolver<ms, md>::BiConjugateGradientStabilized(MemoryBuffer& x, const MemoryBuffer& b, const double bNorm)
+	{
+		auto& A = const_cast<SparseMemoryTile&>(_A.GetCsrBuffer());
+		auto& r = Work(0);
+		auto& rHat = Work(1);
+		auto& p = Work(2);
+		auto& v = Work(3);
+		auto& s = Work(4);
+		auto& t = Work(5);
+		auto& pHat = Work(6);
+		auto& sHat = Work(7);
+
+		IterativeSolverResult ret;
+
+		double rNorm = 0.0;
+		Residual(r, x, b);
+		routines::EuclideanNorm(rNorm, r);
+		ret.relativeResidual = rNorm / bNorm;
+		if (ret.relativeResidual <= _options.tolerance)
+		{
+			ret.converged = true;
+			return ret;
+		}
+
+		// right preconditioning: the residual is the one of the original system
+		routines::Copy(rHat, r);
+		routines::Zero(p);
+		routines::Zero(v);
+		double rho = 1.0;
+		double alpha = 1.0;
+		double omega = 1.0;
+
+		while (ret.nIterations < _options.maxIterations)
+		{
+			double rhoNew = 0.0;
+			routines::InnerProduct(rhoNew, rHat, r);
+			if (rhoNew == 0.0)
+				break;
+
+			// p = r + beta * (p - omega * v)
+			const double beta = (rhoNew / rho) * (alpha / omega);
+			routines::AddEqual(p, v, -omega);
+			routines::Scale(p, beta);
+			routines::AddEqual(p, r);
+
+			ApplyPreconditioner(pHat, p);
+			routines::SparseDot(v, A, pHat);
+			double rHatV = 0.0;
+			routines::InnerProduct(rHatV, rHat, v);
+			if (rHatV == 0.0)
+				break;
+			alpha = rhoNew / rHatV;
+
+			// s = r - alpha * v
+			routines::Add(s, v, r, -alpha);
+			++ret.nIterations;
+
+			double sNorm = 0.0;
+			routines::EuclideanNorm(sNorm, s);
+			if (sNorm / bNorm <= _options.tolerance)
+			{
+				routines::AddEqual(x, pHat, alpha);
+				ret.relativeResidual = sNorm / bNorm;
+				ret.converged = true;
+				break;
+			}
+
+			ApplyPreconditioner(sHat, s);
+			routines::SparseDot(t, A, sHat);
+			double tt = 0.0;
+			double ts = 0.0;
+			routines::InnerProduct(tt, t, t);
+			routines::InnerProduct(ts, t, s);
+			omega = tt == 0.0 ? 0.0 : ts / tt;
+
+			routines::AddEqual(x, pHat, alpha);
+			routines::AddEqual(x, sHat, omega);
+
+			// r = s - omega * t
+			routines::Add(r, t, s, -omega);
+			rho = rhoNew;
+
+			routines::EuclideanNorm(rNorm, r);
+			ret.relativeResidual = rNorm / bNorm;
+			if (ret.relativeResidual <= _options.tolerance)
+			{
+				ret.converged = true;
+				break;
+			}
+			if (omega == 0.0)
+				break;
+		}
+
+		return ret;
+	}
+
+	template<MemorySpace ms, MathDomain md>
+	IterativeSolverResult IterativeSolver<ms, md>::Gmres(MemoryBuffer& x, const MemoryBuffer& b, const double bNorm)
+	{
+		using stdType = typename Traits<md>::stdType;
+
+		auto& A = const_cast<SparseMemoryTile&>(_A.GetCsrBuffer());
+		auto& r = Work(0);
+		auto& z = Work(1);
+
+		const MemoryTile& basis = _basis->GetTile();
+		const size_t m = _cosines.size();
+		auto H = [this, m](const size_t i, const size_t j) -> double& { return _hessenberg[i + j * (m + 1)]; };
+
+		IterativeSolverResult ret;
+		MemoryBuffer vi {};
+		MemoryBuffer w {};
+
+		while (true)
+		{
+			// the true residual is checked at each restart
+			double rNorm = 0.0;
+			Residual(r, x, b);
+			routines::EuclideanNorm(rNorm, r);
+			ret.relativeResidual = rNorm / bNorm;
+			if (ret.relativeResidual <= _options.tolerance)
+			{
+				ret.converged = true;
+				break;
+			}
+			if (ret.nIterations >= _options.maxIterations)
+				break;
+
+			ExtractColumnBufferFromMatrix(vi, basis, 0);
+			routines::Copy(vi, r);
+			routines::Scale(vi, 1.0 / rNorm);
+
+			std::fill(_g.begin(), _g.end(), 0.0);
+			_g[0] = rNorm;
+
+			// Arnoldi process on A * M^(-1), with modified Gram-Schmidt
+			size_t k = 0;
+			while (k < m && ret.nIterations < _options.maxIterations)
+			{
+				const size_t j = k;
+				ExtractColumnBufferFromMatrix(vi, basis, static_cast<unsigned>(j));
+				ExtractColumnBufferFromMatrix(w, basis, static_cast<unsigned>(j + 1));
+				ApplyPreconditioner(z, vi);
+				routines::SparseDot(w, A, z);
+
+				for (size_t i = 0; i <= j; ++i)
+				{
+					ExtractColumnBufferFromMatrix(vi, basis, static_cast<unsigned>(i));
+					routines::InnerProduct(H(i, j), w, vi);
+					routines::AddEqual(w, vi, -H(i, j));
+				}
+
+				double wNorm = 0.0;
+				routines::EuclideanNorm(wNorm, w);
+				H(j + 1, j) = wNorm;
+
+				// a zero norm means that the Krylov subspace contains the solution
+				if (wNorm > 0.0)
+					routines::Scale(w, 1.0 / wNorm);
+
+				for (size_t i = 0; i < j; ++i)
+				{
+					const double hij = _cosines[i] * H(i, j) + _sines[i] * H(i + 1, j);
+					H(i + 1, j) = -_sines[i] * H(i, j) + _cosines[i] * H(i + 1, j);
+					H(i, j) = hij;
+				}
+
+				const double denominator = std::hypot(H(j, j), H(j + 1, j));
+				_cosines[j] = denominator == 0.0 ? 1.0 : H(j, j) / denominator;
+				_sines[j] = denominator == 0.0 ? 0.0 : H(j + 1, j) / denominator;
+				H(j, j) = denominator;
+				H(j + 1, j) = 0.0;
+
+				_g[j + 1] = -_sines[j] * _g[j];
+				_g[j] *= _cosines[j];
+
+				++k;
+				++ret.nIterations;
+				if (std::fabs(_g[j + 1]) / bNorm <= _options.tolerance || wNorm == 0.0)
+					break;
+			}
+
+			// H * y = g, y overwriting g: x += M^(-1) * V * y
+			auto* coefficients = reinterpret_cast<stdType*>(_coefficients->GetBuffer().pointer);	// NOLINT(cppcoreguidelines-pro-type-reinterpret-cast,performance-no-int-to-ptr)
+			for (size_t i = k; i > 0; --i)
+			{
+				const size_t row = i - 1;
+				double sum = _g[row];
+				for (size_t l = i; l < k; ++l)
+					sum -= H(row, l) * _g[l];
+				_g[row] = H(row, row) == 0.0 ? 0.0 : sum / H(row, row);
+				coefficients[row] = static_cast<stdType>(_g[row]);
+			}
+
+			const MemoryTile usedBasis(basis.pointer, basis.nRows, static_cast<unsigned>(k), basis.leadingDimension, ms, md);
+			const MemoryBuffer usedCoefficients(_coefficients->GetBuffer().pointer, static_cast<unsigned>(k), ms, md);
+			routines::Dot(z, usedBasis, usedCoefficients);
+			ApplyPreconditioner(r, z);
+			routines::AddEqual(x, r);
+		}
+
+		return ret;
+	}
+}	 // namespace cl
@@ -20,6 +20,12 @@ namespace cl
 		// copy denseVector to host, numerically finds the non-zero indices, and then copy back to device
 		explicit SparseVector(const Vector<memorySpace, mathDomain>& denseVector);
 
+		/**
+		 * Loads a 1 x size csr_matrix saved by ToBinaryFile or scipy.sparse.save_npz: with useMemoryMapping the arrays stored uncompressed
+		 * with the same element type are used in place
+		 */
+		explicit SparseVector(const std::string& fileName, bool useMemoryMapping = false);
+
 		SparseVector(const SparseVector& rhs);
 		SparseVector(SparseVector&& rhs) noexcept;
 
@@ -35,7 +41,10 @@ namespace cl
 		std::vector<stdType> Get() const final;
 		void Print(const std::string& label = "") const final;
 		std::ostream& ToOutputStream(std::ostream&) const final { throw std::logic_error("Not Implemented"); }
-		void ToBinaryFile(const std::string&, const bool, const std::string) const final { throw std::logic_error("Not Implemented"); }
+		/**
+		 * Saves the vector as a 1 x size scipy-compatible csr_matrix .npz archive: mode has to be "w"
+		 */
+		void ToBinaryFile(const std::string& fileName, const bool compressed = false, const std::string mode = "w") const final;
 
 #pragma region Dense - Sparse Linear Algebra
 
@@ -100,6 +109,16 @@ namespace cl
 	using MklFloatSparseVector = MklSingleSparseVector;
 	using MklDoubleSparseVector = SparseVector<MemorySpace::Mkl, MathDomain::Double>;
 
+	using OpenBlasIntegerSparseVector = SparseVector<MemorySpace::OpenBlas, MathDomain::Int>;
+	using OpenBlasSingleSparseVector = SparseVector<MemorySpace::OpenBlas, MathDomain::Float>;
+	using OpenBlasFloatSparseVector = OpenBlasSingleSparseVector;
+	using OpenBlasDoubleSparseVector = SparseVector<MemorySpace::OpenBlas, MathDomain::Double>;
+
+	using GenericBlasIntegerSparseVector = SparseVector<MemorySpace::GenericBlas, MathDomain::Int>;
+	using GenericBlasSingleSparseVector = SparseVector<MemorySpace::GenericBlas, MathDomain::Float>;
+	using GenericBlasFloatSparseVector = GenericBlasSingleSparseVector;
+	using GenericBlasDoubleSparseVector = SparseVector<MemorySpace::GenericBlas, MathDomain::Double>;
+
 	namespace gpu
 	{
 		using svec = cl::GpuSingleSparseVector;
@@ -126,6 +145,20 @@ namespace cl
 		using isvec = cl::MklIntegerSparseVector;
 	}	 // namespace mkl
 
+	namespace oblas
+	{
+		using svec = cl::OpenBlasSingleSparseVector;
+		using dsvec = cl::OpenBlasDoubleSparseVector;
+		using isvec = cl::OpenBlasIntegerSparseVector;
+	}	 // namespace oblas
+
+	namespace gblas
+	{
+		using svec = cl::GenericBlasSingleSparseVector;
+		using dsvec = cl::GenericBlasDoubleSparseVector;
+		using isvec = cl::GenericBlasIntegerSparseVector;
+	}	 // namespace gblas
+
 	namespace test
 	{
 		using svec = cl::TestSingleSparseVector;
@@ -144,6 +177,20 @@ namespace mkl
 	using isvec = cl::mkl::isvec;
 }	 // namespace mkl
 
+namespace oblas
+{
+	using svec = cl::oblas::svec;
+	using dsvec = cl::oblas::dsvec;
+	using isvec = cl::oblas::isvec;
+}	 // namespace oblas
+
+namespace gblas
+{
+	using svec = cl::gblas::svec;
+	using dsvec = cl::gblas::dsvec;
+	using isvec = cl::gblas::isvec;
+}	 // namespace gblas
+
 namespace test
 {
 	using svec = cl::test::svec;
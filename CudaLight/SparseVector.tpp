@@ -90,6 +90,47 @@ namespace cl
 		SyncPointers();
 	}
 
+	template< MemorySpace ms, MathDomain md>
+	SparseVector<ms, md>::SparseVector(const std::string& fileName, bool useMemoryMapping)
+		: Buffer<SparseVector < ms, md>, ms, md>(false), denseSize(0)
+	{
+		routines::NpzFileReader reader(fileName);
+		unsigned nRows = 0;
+		cl::SparseMatrixShapeFromBinaryFile(reader, nRows, denseSize);
+		if (nRows != 1)
+			throw NpyFileException("A sparse vector has to be saved as a row");
+
+		values.ReadFromArchive(reader, fileName, "data", useMemoryMapping);
+		nonZeroIndices.ReadFromArchive(reader, fileName, "indices", useMemoryMapping);
+		if (nonZeroIndices.size() != values.size())
+			throw NpyFileException("Inconsistent csr arrays");
+
+		this->_mapping = values._mapping;
+		_buffer = SparseMemoryBuffer(0, values.size(), 0, ms, md);
+		SyncPointers();
+	}
+
+	template< MemorySpace ms, MathDomain md>
+	void SparseVector<ms, md>::ToBinaryFile(const std::string& fileName, const bool compressed, const std::string mode) const
+	{
+		if (mode != "w")
+			throw NotImplementedException();
+
+		// a single row, with all the non-zeros
+		const int nNonZeroRows[] = { 0, static_cast<int>(values.size()) };
+
+		// host memory is written straight from the buffers, with no intermediate copy
+		if (ms != MemorySpace::Host && ms != MemorySpace::Device)
+		{
+			cl::SparseMatrixToBinaryFile(reinterpret_cast<const stdType*>(values._buffer.pointer), reinterpret_cast<const int*>(nonZeroIndices._buffer.pointer), nNonZeroRows, values.size(), 1, denseSize, fileName, compressed);
+			return;
+		}
+
+		const auto _values = values.Get();
+		const auto _nonZeroIndices = nonZeroIndices.Get();
+		cl::SparseMatrixToBinaryFile(_values.data(), _nonZeroIndices.data(), nNonZeroRows, values.size(), 1, denseSize, fileName, compressed);
+	}
+
 	template< MemorySpace ms, MathDomain md>
 	void SparseVector<ms, md>::SyncPointers()
 	{
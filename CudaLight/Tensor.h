@@ -34,6 +34,11 @@ namespace cl
 
 		Tensor(const Vector<memorySpace, mathDomain>& rhs, const size_t startOffset, const size_t nRows, const size_t nCols, const size_t nMatrices) noexcept;
 
+		/**
+		 * Loads a (nRows, nCols, nMatrices) npy array. With useMemoryMapping a fortran ordered file with the same element type is used in place
+		 */
+		explicit Tensor(const std::string& fileName, bool useMemoryMapping = false);
+
 		using Buffer<Tensor, memorySpace, mathDomain>::ReadFrom;
 		void ReadFrom(const ColumnWiseMatrix<memorySpace, mathDomain>& rhs);
 		void ReadFrom(const Vector<memorySpace, mathDomain>& rhs);
@@ -47,8 +52,8 @@ namespace cl
 		void Set(const Vector<memorySpace, mathDomain>& columnVector, const unsigned column, const unsigned matrix);
 
 		void Print(const std::string& label = "") const final;
-		std::ostream& ToOutputStream(std::ostream&) const final { throw std::logic_error("Not Implemented"); }
-		void ToBinaryFile(const std::string&, const bool, const std::string) const final { throw std::logic_error("Not Implemented"); }
+		std::ostream& ToOutputStream(std::ostream& os) const final;
+		void ToBinaryFile(const std::string& fileName, const bool compressed = false, const std::string mode = "w") const final;
 
 		inline ~Tensor() override
 		{
@@ -75,10 +80,16 @@ namespace cl
 
 		Tensor Add(const Tensor& rhs, const double alpha = 1.0) const;
 
+		// out = sum of the matrices: host memory doesn't need the cache
 		ColumnWiseMatrix<memorySpace, mathDomain> CubeWiseSum() const;
 		void CubeWiseSum(ColumnWiseMatrix<memorySpace, mathDomain>& out) const;
 		void CubeWiseSum(ColumnWiseMatrix<memorySpace, mathDomain>& out, const CompressedSparseRowMatrix<memorySpace, mathDomain>& onesCache) const;
 
+		// out(i, j) = reduction of the (i, j) entries of all the matrices. Device memory only supports the sum
+		ColumnWiseMatrix<memorySpace, mathDomain> CubeWiseReduce(const ReductionType reductionType) const;
+		void CubeWiseReduce(ColumnWiseMatrix<memorySpace, mathDomain>& out, const ReductionType reductionType) const;
+
+		// out[:, k] = sum of the columns of the k-th matrix: host memory doesn't need the cache
 		ColumnWiseMatrix<memorySpace, mathDomain> MatrixSum() const;
 		void MatrixSum(ColumnWiseMatrix<memorySpace, mathDomain>& out) const;
 		void MatrixSum(ColumnWiseMatrix<memorySpace, mathDomain>& out, Vector<memorySpace, mathDomain>& cacheOnes) const;
@@ -100,6 +111,10 @@ namespace cl
 
 		static void Print(const Tensor& vect, const std::string& label = "");
 
+		static void TensorToBinaryFile(const Tensor& t, const std::string& fileName, const bool compressed = false, const std::string mode = "w");
+
+		static Tensor TensorFromBinaryFile(const std::string& fileName, const bool compressed = false, const bool useMemoryMapping = false);
+
 		static Tensor Add(const Tensor& lhs, const Tensor& rhs, const double alpha = 1.0);
 
 		static void Scale(Tensor& lhs, const double alpha);
@@ -81,6 +81,51 @@ namespace cl
 	}
 
 
+	template<MemorySpace ms, MathDomain md>
+	Tensor<ms, md>::Tensor(const std::string& fileName, bool useMemoryMapping)
+		: Buffer<Tensor<ms, md>, ms, md>(true)
+	{
+		if (useMemoryMapping)
+		{
+			// zero-copy: the matrices are stored one after the other in fortran order, which is the tensor layout
+			std::vector<size_t> shape {};
+			const ptr_t pointer = this->MapFile(fileName, shape, true);
+			if (pointer != 0)
+			{
+				assert(shape.size() == 3);
+				_buffer = MemoryCube(pointer, static_cast<unsigned>(shape[0]), static_cast<unsigned>(shape[1]), static_cast<unsigned>(shape[2]), ms, md);
+				SetUp(nMatrices());
+				return;
+			}
+		}
+
+		if (ms != MemorySpace::Host && ms != MemorySpace::Device)
+		{
+			// host memory: a fortran ordered file can be read straight into the buffer
+			routines::NpyFileReader reader(fileName);
+			const auto& header = reader.GetHeader();
+			if (header.fortranOrder && header.shape.size() == 3 && header.HasMathDomain(md))
+			{
+				_buffer = MemoryCube(0, static_cast<unsigned>(header.shape[0]), static_cast<unsigned>(header.shape[1]), static_cast<unsigned>(header.shape[2]), ms, md);
+				this->ctor(_buffer);
+				SetUp(nMatrices());
+
+				reader.Read(reinterpret_cast<void*>(_buffer.pointer), _buffer.size, md);
+				return;
+			}
+		}
+
+		std::vector<typename Traits<md>::stdType> t {};
+		unsigned nRows = 0, nCols = 0, nMatrices = 0;
+		cl::TensorFromBinaryFile(t, nRows, nCols, nMatrices, fileName, false);
+
+		_buffer = MemoryCube(0, nRows, nCols, nMatrices, ms, md);
+		this->ctor(_buffer);
+		SetUp(nMatrices);
+
+		ReadFrom(t);
+	}
+
 	template<MemorySpace ms, MathDomain md>
 	Tensor<ms, md>::Tensor(const MemoryCube& buffer)
 		: Buffer<Tensor<ms, md>, ms, md>(false), _buffer(buffer)
@@ -186,6 +231,33 @@ namespace cl
 		std::cout << "**********************" << std::endl;
 	}
 
+	template<MemorySpace ms, MathDomain md>
+	std::ostream& Tensor<ms, md>::ToOutputStream(std::ostream& os) const
+	{
+		// one matrix after the other, separated by an empty line
+		for (size_t k = 0; k < nMatrices(); k++)
+		{
+			cl::MatrixToOutputStream(matrices[k]->Get(), nRows(), nCols(), os);
+			os << std::endl;
+		}
+
+		return os;
+	}
+
+	template<MemorySpace ms, MathDomain md>
+	void Tensor<ms, md>::ToBinaryFile(const std::string& fileName, const bool compressed, const std::string mode) const
+	{
+		// host memory is written straight from the buffer, with no intermediate copy
+		if (ms != MemorySpace::Host && ms != MemorySpace::Device && !compressed && mode == "w")
+		{
+			routines::NpyFileWriter writer(fileName, md, { static_cast<size_t>(nRows()), static_cast<size_t>(nCols()), static_cast<size_t>(nMatrices()) }, true);
+			writer.Write(reinterpret_cast<const void*>(_buffer.pointer), _buffer.size);
+			return;
+		}
+
+		cl::TensorToBinaryFile(Get(), nRows(), nCols(), nMatrices(), fileName, compressed, mode);
+	}
+
 	#pragma region Linear Algebra
 
 	template<MemorySpace ms, MathDomain md>
@@ -236,8 +308,15 @@ namespace cl
 	template<MemorySpace ms, MathDomain md>
 	void Tensor<ms, md>::CubeWiseSum(ColumnWiseMatrix<ms, md>& out) const
 	{
+		if (ms != MemorySpace::Host && ms != MemorySpace::Device)
+		{
+			routines::CubeWiseReduce(out.GetTile(), _buffer, ReductionType::Sum);
+			return;
+		}
+
 		#define RUN_MULTIPLE_ADD
 		#ifdef RUN_MULTIPLE_ADD
+			out.Set(0.0);
 			for (size_t k = 0; k < nMatrices(); ++k)
 				out.AddEqualMatrix(*this->matrices[k]);
 		#else
@@ -260,7 +339,14 @@ namespace cl
 	template<MemorySpace ms, MathDomain md>
 	void Tensor<ms, md>::CubeWiseSum(ColumnWiseMatrix<ms, md>& out, const CompressedSparseRowMatrix<ms, md>&) const
 	{
+		if (ms != MemorySpace::Host && ms != MemorySpace::Device)
+		{
+			routines::CubeWiseReduce(out.GetTile(), _buffer, ReductionType::Sum);
+			return;
+		}
+
 		#ifdef RUN_MULTIPLE_ADD
+			out.Set(0.0);
 			for (size_t k = 0; k < nMatrices(); ++k)
 				out.AddEqualMatrix(*this->matrices[k]);
 		#else
@@ -271,10 +357,33 @@ namespace cl
 		#endif
 	}
 
+	template<MemorySpace ms, MathDomain md>
+	ColumnWiseMatrix<ms, md> Tensor<ms, md>::CubeWiseReduce(const ReductionType reductionType) const
+	{
+		ColumnWiseMatrix<ms, md> out(nRows(), nCols());
+		CubeWiseReduce(out, reductionType);
+
+		return out;
+	}
+
+	template<MemorySpace ms, MathDomain md>
+	void Tensor<ms, md>::CubeWiseReduce(ColumnWiseMatrix<ms, md>& out, const ReductionType reductionType) const
+	{
+		assert(out.nRows() == nRows() && out.nCols() == nCols());
+		if (ms == MemorySpace::Host || ms == MemorySpace::Device)
+		{
+			if (reductionType != ReductionType::Sum)
+				throw NotImplementedException();
+			CubeWiseSum(out);
+		}
+		else
+			routines::CubeWiseReduce(out.GetTile(), _buffer, reductionType);
+	}
+
 	template<MemorySpace ms, MathDomain md>
 	ColumnWiseMatrix<ms, md> Tensor<ms, md>::MatrixSum() const
 	{
-		ColumnWiseMatrix<ms, md> out(nRows(), nCols(), -123456789.0);
+		ColumnWiseMatrix<ms, md> out(nRows(), nMatrices(), -123456789.0);
 		MatrixSum(out);
 
 		return out;
@@ -282,12 +391,31 @@ namespace cl
 	template<MemorySpace ms, MathDomain md>
 	void Tensor<ms, md>::MatrixSum(ColumnWiseMatrix<ms, md>& out) const
 	{
-		Vector<ms, md> cacheOnes(nMatrices(), 1.0);
-		MatrixSum(out, cacheOnes);
+		if (ms == MemorySpace::Host || ms == MemorySpace::Device)
+		{
+			Vector<ms, md> cacheOnes(nCols(), 1.0);
+			MatrixSum(out, cacheOnes);
+		}
+		else
+		{
+			// out[:, k] is the row-wise sum of the k-th matrix
+			MemoryBuffer column;
+			for (size_t k = 0; k < nMatrices(); ++k)
+			{
+				ExtractColumnBufferFromMatrix(column, out.GetTile(), static_cast<unsigned>(k));
+				routines::RowWiseReduce(column, matrices[k]->GetTile(), ReductionType::Sum);
+			}
+		}
 	}
 	template<MemorySpace ms, MathDomain md>
 	void Tensor<ms, md>::MatrixSum(ColumnWiseMatrix<ms, md>& out, Vector<ms, md>& cacheOnes) const
 	{
+		if (ms != MemorySpace::Host && ms != MemorySpace::Device)
+		{
+			MatrixSum(out);
+			return;
+		}
+
 		MemoryCube tmp1(out.GetBuffer().pointer, out.nRows(), 1, nMatrices(), _buffer.memorySpace, _buffer.mathDomain);
 		MemoryCube tmp2(_buffer.pointer, _buffer.nRows, _buffer.nCols, 0, _buffer.memorySpace, _buffer.mathDomain);
 		MemoryCube tmp3(cacheOnes.GetBuffer().pointer, cacheOnes.size(), 0, 0, _buffer.memorySpace, _buffer.mathDomain);
@@ -388,6 +516,25 @@ namespace cl
 		t.Print(label);
 	}
 
+	template<MemorySpace ms, MathDomain md>
+	void Tensor<ms, md>::TensorToBinaryFile(const Tensor<ms, md>& t, const std::string& fileName, const bool compressed, const std::string mode)
+	{
+		t.ToBinaryFile(fileName, compressed, mode);
+	}
+
+	template<MemorySpace ms, MathDomain md>
+	Tensor<ms, md> Tensor<ms, md>::TensorFromBinaryFile(const std::string& fileName, const bool compressed, const bool useMemoryMapping)
+	{
+		if (!compressed)
+			return Tensor<ms, md>(fileName, useMemoryMapping);
+
+		std::vector<typename Traits<md>::stdType> _t {};
+		unsigned nRows = 0, nCols = 0, nMatrices = 0;
+		cl::TensorFromBinaryFile(_t, nRows, nCols, nMatrices, fileName, compressed);
+
+		return Tensor<ms, md>(_t, nRows, nCols, nMatrices);
+	}
+
 	template<MemorySpace ms, MathDomain md>
 	Tensor<ms, md> Tensor<ms, md>::Add(const Tensor<ms, md>& lhs, const Tensor<ms, md>& rhs, const double alpha)
 	{
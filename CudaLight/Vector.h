@@ -70,6 +70,32 @@ namespace cl
 
 		Vector Add(const Vector& rhs, const double alpha = 1.0) const;
 
+		/**
+		 * x = cumsum(x) in place, x[i] itself being left out when exclusive. Device memory only supports the inclusive version
+		 */
+		void CumulativeSum(const bool exclusive = false);
+
+#pragma endregion
+
+#pragma region Sorting
+
+		/**
+		 * Stable sort in place: NaNs go last in ascending order, first in descending order. Like the functions below, it's not available for Host and Device memory
+		 */
+		void Sort(const bool ascending = true);
+
+		/**
+		 * Positions of the elements in sorted order: equal elements keep their relative order
+		 */
+		Vector<memorySpace, MathDomain::Int> ArgSort(const bool ascending = true) const;
+		void ArgSort(Vector<memorySpace, MathDomain::Int>& indices, const bool ascending = true) const;
+
+		/**
+		 * The k largest (or smallest) elements, sorted, and their positions: among equal elements the first ones are picked
+		 */
+		Vector TopK(const unsigned k, const bool largest = true) const;
+		void TopK(Vector& values, Vector<memorySpace, MathDomain::Int>& indices, const bool largest = true) const;
+
 #pragma endregion
 
 #pragma region Enable shared ptr contruction
@@ -94,6 +120,11 @@ namespace cl
 		Vector() : Buffer<Vector<memorySpace, mathDomain>, memorySpace, mathDomain>(true) {}
 		explicit Vector(const MemoryBuffer& buffer);
 
+		/**
+		 * Loads the array arrayName of a .npz archive into an empty vector: with useMemoryMapping a stored array of the same element type is used in place
+		 */
+		void ReadFromArchive(routines::NpzFileReader& reader, const std::string& fileName, const std::string& arrayName, const bool useMemoryMapping);
+
 	private:
 		MemoryBuffer _buffer {};
 
@@ -59,11 +59,57 @@ namespace cl
 
 	template<MemorySpace ms, MathDomain md>
 	Vector<ms, md>::Vector(const std::string& fileName, bool useMemoryMapping)
-	{
+		: Buffer<Vector < ms, md>, ms, md>(true), _buffer(0, 0, ms, md)
+	{
+		if (useMemoryMapping)
+		{
+			// zero-copy: the buffer points directly into the file mapping
+			std::vector<size_t> shape {};
+			_buffer.pointer = this->MapFile(fileName, shape);
+			if (_buffer.pointer != 0)
+			{
+				_buffer.size = static_cast<unsigned>(this->_mapping->GetSize());
+				return;
+			}
+		}
+
 		std::vector<typename Traits<md>::stdType> v;
-		cl::VectorFromBinaryFile(v, fileName, useMemoryMapping);
+		cl::VectorFromBinaryFile(v, fileName, false, useMemoryMapping);
 
-        this->ReadFrom(v);
+		_buffer.size = static_cast<unsigned>(v.size());
+		this->ctor(_buffer);
+		this->ReadFrom(v);
+	}
+
+	template<MemorySpace ms, MathDomain md>
+	void Vector<ms, md>::ReadFromArchive(routines::NpzFileReader& reader, const std::string& fileName, const std::string& arrayName, const bool useMemoryMapping)
+	{
+		assert(_buffer.pointer == 0);
+
+		const auto& entry = reader.GetEntry(arrayName);
+		if (useMemoryMapping && !entry.compressed)
+		{
+			// zero-copy: the buffer points directly into the archive mapping
+			std::vector<size_t> shape {};
+			const ptr_t pointer = this->MapFile(fileName, shape, false, entry.dataOffset);
+			if (pointer != 0)
+			{
+				_buffer = MemoryBuffer(pointer, static_cast<unsigned>(this->_mapping->GetSize()), ms, md);
+				return;
+			}
+		}
+
+		std::vector<char> data {};
+		const auto header = reader.Read(arrayName, data);
+		std::vector<typename Traits<md>::stdType> v {};
+		cl::NpyDataToVector(v, header, data);
+
+		_buffer = MemoryBuffer(0, static_cast<unsigned>(v.size()), ms, md);
+		if (v.empty())
+			return;
+
+		this->ctor(_buffer);
+		this->ReadFrom(v);
 	}
 
 	template<MemorySpace ms, MathDomain md>
@@ -154,6 +200,73 @@ namespace cl
 		return ret;
 	}
 
+	template<MemorySpace ms, MathDomain md>
+	void Vector<ms, md>::CumulativeSum(const bool exclusive)
+	{
+		if (ms == MemorySpace::Host || ms == MemorySpace::Device)
+		{
+			if (exclusive)
+				throw NotImplementedException();
+			MemoryTile tile(_buffer);
+			dm::detail::CumulativeRowSum(tile);
+		}
+		else
+			routines::CumulativeSum(_buffer, exclusive);
+	}
+
+	#pragma endregion
+
+	#pragma region Sorting
+
+	template<MemorySpace ms, MathDomain md>
+	void Vector<ms, md>::Sort(const bool ascending)
+	{
+		if (ms == MemorySpace::Host || ms == MemorySpace::Device)
+			throw NotImplementedException();
+
+		routines::Sort(_buffer, ascending);
+	}
+
+	template<MemorySpace ms, MathDomain md>
+	Vector<ms, MathDomain::Int> Vector<ms, md>::ArgSort(const bool ascending) const
+	{
+		Vector<ms, MathDomain::Int> indices(this->size());
+		ArgSort(indices, ascending);
+
+		return indices;
+	}
+
+	template<MemorySpace ms, MathDomain md>
+	void Vector<ms, md>::ArgSort(Vector<ms, MathDomain::Int>& indices, const bool ascending) const
+	{
+		assert(indices.size() == this->size());
+		if (ms == MemorySpace::Host || ms == MemorySpace::Device)
+			throw NotImplementedException();
+
+		routines::ArgSort(indices.GetBuffer(), _buffer, ascending);
+	}
+
+	template<MemorySpace ms, MathDomain md>
+	Vector<ms, md> Vector<ms, md>::TopK(const unsigned k, const bool largest) const
+	{
+		Vector<ms, md> values(k);
+		Vector<ms, MathDomain::Int> indices(k);
+		TopK(values, indices, largest);
+
+		return values;
+	}
+
+	template<MemorySpace ms, MathDomain md>
+	void Vector<ms, md>::TopK(Vector<ms, md>& values, Vector<ms, MathDomain::Int>& indices, const bool largest) const
+	{
+		assert(values.size() == indices.size());
+		assert(values.size() <= this->size());
+		if (ms == MemorySpace::Host || ms == MemorySpace::Device)
+			throw NotImplementedException();
+
+		routines::TopK(values._buffer, indices.GetBuffer(), _buffer, largest);
+	}
+
 	#pragma endregion
 
 	template<MemorySpace ms, MathDomain md>
@@ -240,6 +353,9 @@ namespace cl
 	template<MemorySpace ms, MathDomain md>
 	Vector<ms, md> Vector<ms, md>::VectorFromBinaryFile(const std::string& fileName, const bool compressed, const bool useMemoryMapping)
 	{
+		if (!compressed)
+			return Vector<ms, md>(fileName, useMemoryMapping);
+
 		std::vector<typename Vector<ms, md>::stdType> _vec {};
 		cl::VectorFromBinaryFile(_vec, fileName, compressed, useMemoryMapping);
 
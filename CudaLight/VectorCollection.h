@@ -1,7 +1,9 @@
 #pragma once
 
 #include <memory>
+#include <numeric>
 #include <string>
+#include <vector>
 
 #include <Buffer.h>
 #include <Types.h>
@@ -32,6 +34,19 @@ namespace cl
 		Vector<memorySpace, mathDomain>& front() noexcept { return vectors.front(); }
 		Vector<memorySpace, mathDomain>& back() noexcept { return vectors.back(); }
 
+		const std::vector<size_t>& GetSizes() const noexcept { return sizes; }
+
+		/**
+		 * Sorts each vector of the collection independently, all of them in one go
+		 */
+		void Sort(const bool ascending = true)
+		{
+			if (memorySpace == MemorySpace::Host || memorySpace == MemorySpace::Device)
+				throw NotImplementedException();
+
+			routines::SegmentedSort(data.GetBuffer(), sizes, ascending);
+		}
+
 	private:
 		Vector<memorySpace, mathDomain> data;
 		const std::vector<size_t> sizes;
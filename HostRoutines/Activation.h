@@ -0,0 +1,89 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+namespace cl
+{
+	/**
+	 * Element-wise activations applied by MultiplyFused after the bias. Gelu is the exact one, x * Phi(x), rather than its tanh approximation
+	 */
+	enum class ActivationType
+	{
+		None,
+		Relu,
+		Tanh,
+		Sigmoid,
+		Gelu
+	};
+
+	namespace routines
+	{
+		namespace detail
+		{
+			template<ActivationType activation, typename T>
+			inline T Activate(const T x) noexcept
+			{
+				switch (activation)
+				{
+					case ActivationType::Relu:
+						return std::max(x, T(0));
+					case ActivationType::Tanh:
+						return std::tanh(x);
+					case ActivationType::Sigmoid:
+						return T(1) / (T(1) + std::exp(-x));
+					case ActivationType::Gelu:
+						return T(0.5) * x * (T(1) + std::erf(x * T(0.7071067811865476)));
+					default:
+						return x;
+				}
+			}
+
+			template<ActivationType activation, typename T>
+			void BiasActivation(T* C, const size_t ldc, const size_t m, const size_t n, const T* bias) noexcept
+			{
+				for (size_t j = 0; j < n; ++j)
+				{
+					T* cj = C + j * ldc;
+					if (bias)
+					{
+						for (size_t i = 0; i < m; ++i)
+							cj[i] = Activate<activation>(cj[i] + bias[i]);
+					}
+					else
+					{
+						for (size_t i = 0; i < m; ++i)
+							cj[i] = Activate<activation>(cj[i]);
+					}
+				}
+			}
+
+			/**
+			 * C(i, j) = activation(C(i, j) + bias[i]) on the column-major m x n matrix C: bias can be null
+			 */
+			template<typename T>
+			void BiasActivation(T* C, const size_t ldc, const size_t m, const size_t n, const T* bias, const ActivationType activation) noexcept
+			{
+				switch (activation)
+				{
+					case ActivationType::Relu:
+						BiasActivation<ActivationType::Relu>(C, ldc, m, n, bias);
+						break;
+					case ActivationType::Tanh:
+						BiasActivation<ActivationType::Tanh>(C, ldc, m, n, bias);
+						break;
+					case ActivationType::Sigmoid:
+						BiasActivation<ActivationType::Sigmoid>(C, ldc, m, n, bias);
+						break;
+					case ActivationType::Gelu:
+						BiasActivation<ActivationType::Gelu>(C, ldc, m, n, bias);
+						break;
+					default:
+						BiasActivation<ActivationType::None>(C, ldc, m, n, bias);
+						break;
+				}
+			}
+		}	 // namespace detail
+	}		 // namespace routines
+}	 // namespace cl
@@ -2,19 +2,394 @@
 #include <Common.h>
 #include <Exceptions.h>
 #include <MemoryManager.h>
+#include <Profiling.h>
 #include <Types.h>
 
 #include <BlasWrappers.h>
+#include <ElementWiseMath.h>
 #include <GenericBlasAllWrappers.h>
 #include <MklAllWrappers.h>
+#include <NativeBlas.h>
 #include <OpenBlasAllWrappers.h>
+#include <Parallel.h>
 
+#include <algorithm>
 #include <cmath>
+#include <limits>
+#include <vector>
 
 namespace cl
 {
 	namespace routines
 	{
+		namespace
+		{
+			/**
+			 * Index of the first element with the smallest (or biggest) absolute value: chunks have a fixed size, and their results are compared in order
+			 */
+			template<bool minimum, typename T>
+			int ArgAbsExtremum(const T* x, const size_t size)
+			{
+				const size_t nChunks = std::max(size_t(1), (size + detail::elementWiseGrainSize - 1) / detail::elementWiseGrainSize);
+				std::vector<size_t> partials(nChunks);
+				detail::ParallelFor(nChunks, [&](const size_t c) {
+					const size_t begin = c * detail::elementWiseGrainSize;
+					const size_t end = std::min(size, begin + detail::elementWiseGrainSize);
+
+					size_t best = begin;
+					auto bestValue = std::fabs(x[begin]);
+					for (size_t i = begin + 1; i < end; ++i)
+					{
+						const auto value = std::fabs(x[i]);
+						if (minimum ? value < bestValue : value > bestValue)
+						{
+							bestValue = value;
+							best = i;
+						}
+					}
+					partials[c] = best;
+				});
+
+				size_t ret = partials[0];
+				for (size_t c = 1; c < nChunks; ++c)
+				{
+					const auto value = std::fabs(x[partials[c]]);
+					if (minimum ? value < std::fabs(x[ret]) : value > std::fabs(x[ret]))
+						ret = partials[c];
+				}
+
+				return static_cast<int>(ret);
+			}
+
+			/**
+			 * sum(f(i)) over [0, size), with chunks of fixed size added up in order: the result doesn't depend on the number of threads
+			 */
+			template<typename F>
+			double Sum(const size_t size, const F& f)
+			{
+				const size_t nChunks = (size + detail::elementWiseGrainSize - 1) / detail::elementWiseGrainSize;
+				std::vector<double> partials(nChunks, 0.0);
+				detail::ParallelFor(nChunks, [&](const size_t c) {
+					const size_t end = std::min(size, (c + 1) * detail::elementWiseGrainSize);
+					for (size_t i = c * detail::elementWiseGrainSize; i < end; ++i)
+						partials[c] += f(i);
+				});
+
+				double ret = 0.0;
+				for (const double partial : partials)
+					ret += partial;
+
+				return ret;
+			}
+
+			/**
+			 * dest = source, converting between float and double
+			 */
+			template<typename T, typename U>
+			void Convert(T* dest, const U* source, const size_t size)
+			{
+				detail::ParallelFor(size, detail::elementWiseGrainSize, [&](const size_t begin, const size_t end) {
+					for (size_t i = begin; i < end; ++i)
+						dest[i] = static_cast<T>(source[i]);
+				});
+			}
+
+			void Convert(MemoryBuffer& dest, const MemoryBuffer& source)
+			{
+				assert(dest.size == source.size);
+
+				if (dest.mathDomain == MathDomain::Float && source.mathDomain == MathDomain::Double)
+					Convert(reinterpret_cast<float*>(dest.pointer), reinterpret_cast<const double*>(source.pointer), dest.size);	   // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+				else if (dest.mathDomain == MathDomain::Double && source.mathDomain == MathDomain::Float)
+					Convert(reinterpret_cast<double*>(dest.pointer), reinterpret_cast<const float*>(source.pointer), dest.size);	   // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+				else
+					throw NotImplementedException();
+			}
+
+			/**
+			 * x[i] = offset + sum(x[0:i]), excluding x[i] itself when exclusive
+			 */
+			template<typename T>
+			void Scan(T* x, const size_t size, const bool exclusive, T offset = T(0))
+			{
+				if (exclusive)
+				{
+					for (size_t i = 0; i < size; ++i)
+					{
+						const T value = x[i];
+						x[i] = offset;
+						offset += value;
+					}
+				}
+				else
+				{
+					for (size_t i = 0; i < size; ++i)
+					{
+						offset += x[i];
+						x[i] = offset;
+					}
+				}
+			}
+
+			/**
+			 * Same as Scan, for a single long array: the chunk totals are computed concurrently first, then each chunk is scanned from the sum of the ones before it
+			 */
+			template<typename T>
+			void ParallelScan(T* x, const size_t size, const bool exclusive)
+			{
+				const size_t nChunks = std::min((size + detail::elementWiseGrainSize - 1) / detail::elementWiseGrainSize, detail::GetNumberOfThreads() * detail::nChunksPerThread);
+				if (nChunks <= 1)
+				{
+					Scan(x, size, exclusive);
+					return;
+				}
+
+				std::vector<T> offsets(nChunks, T(0));
+				detail::ParallelFor(nChunks, [&](const size_t c) {
+					const size_t end = (c + 1) * size / nChunks;
+					for (size_t i = c * size / nChunks; i < end; ++i)
+						offsets[c] += x[i];
+				});
+				Scan(offsets.data(), nChunks, true);
+
+				detail::ParallelFor(nChunks, [&](const size_t c) {
+					const size_t begin = c * size / nChunks;
+					Scan(x + begin, (c + 1) * size / nChunks - begin, exclusive, offsets[c]);
+				});
+			}
+
+			/**
+			 * Prefix sums down the columns of the nRows x nCols matrix a, in place
+			 */
+			template<typename T>
+			void ColumnWiseScan(T* a, const size_t nRows, const size_t nCols, const size_t leadingDimension, const bool exclusive)
+			{
+				// a column per task if there are enough of them to keep all the threads busy, otherwise each column is split in chunks
+				if (nCols < detail::GetNumberOfThreads())
+				{
+					for (size_t j = 0; j < nCols; ++j)
+						ParallelScan(a + j * leadingDimension, nRows, exclusive);
+					return;
+				}
+
+				detail::ParallelFor(nCols, detail::GetSliceGrainSize(nRows), [&](const size_t begin, const size_t end) {
+					for (size_t j = begin; j < end; ++j)
+						Scan(a + j * leadingDimension, nRows, exclusive);
+				});
+			}
+
+			/**
+			 * Prefix sums along the rows of the nRows x nCols matrix a, in place: each column is added to the next one, so that the inner loop
+			 * runs over contiguous rows and is vectorized, and blocks of rows are spread over the threads
+			 */
+			template<typename T>
+			void RowWiseScan(T* a, const size_t nRows, const size_t nCols, const size_t leadingDimension, const bool exclusive)
+			{
+				detail::ParallelFor(nRows, detail::GetSliceGrainSize(nCols), [&](const size_t begin, const size_t end) {
+					if (!exclusive)
+					{
+						for (size_t j = 1; j < nCols; ++j)
+						{
+							const T* previous = a + (j - 1) * leadingDimension;
+							T* current = a + j * leadingDimension;
+							for (size_t i = begin; i < end; ++i)
+								current[i] += previous[i];
+						}
+						return;
+					}
+
+					// running sums of the block of rows
+					std::vector<T> sums(end - begin, T(0));
+					for (size_t j = 0; j < nCols; ++j)
+					{
+						T* current = a + j * leadingDimension + begin;
+						for (size_t i = 0; i < end - begin; ++i)
+						{
+							const T value = current[i];
+							current[i] = sums[i];
+							sums[i] += value;
+						}
+					}
+				});
+			}
+
+			// same as LAPACK dsgesv
+			constexpr size_t maxRefinementIterations = 30;
+
+			/**
+			 * Solves A * X = B, A and B being double, with a float LU factorization of A refined with double residuals (as LAPACK dsgesv does).
+			 * Returns false, leaving B untouched, when the float factorization fails, the refinement doesn't converge or B isn't contiguous.
+			 * The float copy of A, the pivots and the refinement buffers come from workspace, so repeated solves don't allocate
+			 */
+			bool MixedPrecisionSolve(const MemoryTile& A, MemoryTile& B, SolverWorkspace& workspace, const MatrixOperation aOperation)
+			{
+				assert(A.mathDomain == MathDomain::Double);
+				assert(A.nRows == A.nCols);
+
+				// the refinement needs contiguous right-hand sides: sub-matrix views are left to Lu
+				if (B.leadingDimension != B.nRows)
+					return false;
+
+				const unsigned n = A.nRows;
+				const auto* a = reinterpret_cast<const double*>(A.pointer);	   // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+
+				// ||A||_inf: the infinity norm of A^T is the 1-norm of A
+				auto* rowSums = reinterpret_cast<double*>(workspace.GetWork(n, A.memorySpace, MathDomain::Double).pointer);	   // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+				std::fill(rowSums, rowSums + n, 0.0);
+				double aNorm = 0.0;
+				for (unsigned j = 0; j < n; ++j)
+				{
+					double columnSum = 0.0;
+					for (unsigned i = 0; i < n; ++i)
+					{
+						rowSums[i] += std::fabs(a[i + j * A.leadingDimension]);
+						columnSum += std::fabs(a[i + j * A.leadingDimension]);
+					}
+					if (aOperation != MatrixOperation::None)
+						aNorm = std::max(aNorm, columnSum);
+				}
+				if (aOperation == MatrixOperation::None)
+					aNorm = *std::max_element(rowSums, rowSums + n);
+
+				// A doesn't fit in single precision
+				if (!(aNorm <= static_cast<double>(std::numeric_limits<float>::max())))
+					return false;
+				const double threshold = aNorm * std::numeric_limits<double>::epsilon() * std::sqrt(static_cast<double>(n));
+
+				MemoryTile singleA = workspace.GetMatrix(MemoryTile(0, n, n, A.memorySpace, MathDomain::Float));
+				MemoryBuffer pivot = workspace.GetPivot(n, A.memorySpace);
+				MemoryTile singleCorrection = workspace.GetRightHandSide(n, B.nCols, B.memorySpace, MathDomain::Float);
+				MemoryTile x = workspace.GetSolution(n, B.nCols, B.memorySpace, MathDomain::Double);
+				MemoryTile residual = workspace.GetResidual(n, B.nCols, B.memorySpace, MathDomain::Double);
+
+				if (A.leadingDimension == A.nRows)
+					Convert(singleA, A);
+				else
+				{
+					for (unsigned j = 0; j < n; ++j)
+					{
+						MemoryBuffer column;
+						MemoryBuffer singleColumn;
+						ExtractColumnBufferFromMatrix(column, A, j);
+						ExtractColumnBufferFromMatrix(singleColumn, singleA, j);
+						Convert(singleColumn, column);
+					}
+				}
+
+				try
+				{
+					Factorize(singleA, pivot, DenseSolverType::Lu);
+				}
+				catch (const FactorizationException&)
+				{
+					return false;
+				}
+
+				// X = A^(-1) * B in single precision
+				Convert(singleCorrection, B);
+				SolveFactorized(singleA, pivot, singleCorrection, aOperation, DenseSolverType::Lu);
+				Convert(x, singleCorrection);
+
+				const auto* _x = reinterpret_cast<const double*>(x.pointer);			   // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+				const auto* _r = reinterpret_cast<const double*>(residual.pointer);	   // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+				for (size_t iteration = 0; iteration <= maxRefinementIterations; ++iteration)
+				{
+					// R = B - A * X
+					Copy(residual, B);
+					Multiply(residual, A, x, aOperation, MatrixOperation::None, -1.0, 1.0);
+
+					// converged when ||r||_inf <= ||x||_inf * threshold for each column (NaNs never converge)
+					bool converged = true;
+					for (size_t j = 0; j < B.nCols && converged; ++j)
+					{
+						double xNorm = 0.0;
+						double rNorm = 0.0;
+						for (size_t i = 0; i < n; ++i)
+						{
+							xNorm = std::max(xNorm, std::fabs(_x[i + j * n]));
+							rNorm = std::max(rNorm, std::fabs(_r[i + j * n]));
+						}
+						converged = rNorm <= xNorm * threshold;
+					}
+					if (converged)
+					{
+						Copy(B, x);
+						return true;
+					}
+					if (iteration == maxRefinementIterations)
+						break;
+
+					// X += A^(-1) * R, the correction being computed in single precision
+					Convert(singleCorrection, residual);
+					SolveFactorized(singleA, pivot, singleCorrection, aOperation, DenseSolverType::Lu);
+					Convert(residual, singleCorrection);
+					AddEqual(x, residual);
+				}
+
+				return false;
+			}
+
+			/**
+			 * y = function(x): exponent is used by Pow only
+			 */
+			void ApplyElementWiseFunction(MemoryBuffer& y, const MemoryBuffer& x, const ElementWiseFunction function, const double exponent = 1.0)
+			{
+				assert(y.memorySpace == x.memorySpace);
+				assert(y.mathDomain == x.mathDomain);
+				assert(y.size == x.size);
+
+				switch (y.mathDomain)
+				{
+					case MathDomain::Float:
+					{
+						switch (y.memorySpace)
+						{
+							case MemorySpace::Mkl:
+								mkr::ApplyElementWiseFunction<MathDomain::Float>(y, x, function, exponent);
+								break;
+
+							case MemorySpace::Test:
+							case MemorySpace::OpenBlas:
+							case MemorySpace::GenericBlas:
+							{
+								auto* yPtr = GetPointer<MathDomain::Float>(y);
+								auto* xPtr = GetPointer<MathDomain::Float>(x);
+								elementwise::Apply(yPtr, xPtr, y.size, function, exponent);
+								break;
+							}
+							default:
+								throw NotImplementedException();
+						}
+						break;
+					}
+					case MathDomain::Double:
+					{
+						switch (y.memorySpace)
+						{
+							case MemorySpace::Mkl:
+								mkr::ApplyElementWiseFunction<MathDomain::Double>(y, x, function, exponent);
+								break;
+
+							case MemorySpace::Test:
+							case MemorySpace::OpenBlas:
+							case MemorySpace::GenericBlas:
+							{
+								auto* yPtr = GetPointer<MathDomain::Double>(y);
+								auto* xPtr = GetPointer<MathDomain::Double>(x);
+								elementwise::Apply(yPtr, xPtr, y.size, function, exponent);
+								break;
+							}
+							default:
+								throw NotImplementedException();
+						}
+						break;
+					}
+					default:
+						throw NotImplementedException();
+				}
+			}
+		}	 // namespace
+
 		/**
 		 * z = alpha * x + y
 		 */
@@ -27,6 +402,8 @@ namespace cl
 			assert(z.size == x.size);
 			assert(z.size == y.size);
 
+			CL_PROFILE(z, 2.0 * z.size, 3.0 * z.TotalSize());
+
 			switch (z.mathDomain)
 			{
 				case MathDomain::Float:
@@ -49,8 +426,10 @@ namespace cl
 							auto* xPtr = GetPointer<MathDomain::Float>(x);
 							auto* yPtr = GetPointer<MathDomain::Float>(y);
 
-							for (size_t i = 0; i < z.size; ++i)
-								zPtr[i] = static_cast<float>(alpha) * xPtr[i] + yPtr[i];
+							detail::ParallelFor(z.size, detail::elementWiseGrainSize, [&](const size_t begin, const size_t end) {
+								for (size_t i = begin; i < end; ++i)
+									zPtr[i] = static_cast<float>(alpha) * xPtr[i] + yPtr[i];
+							});
 							break;
 						}
 						default:
@@ -78,8 +457,10 @@ namespace cl
 							auto* xPtr = GetPointer<MathDomain::Double>(x);
 							auto* yPtr = GetPointer<MathDomain::Double>(y);
 
-							for (size_t i = 0; i < z.size; ++i)
-								zPtr[i] = alpha * xPtr[i] + yPtr[i];
+							detail::ParallelFor(z.size, detail::elementWiseGrainSize, [&](const size_t begin, const size_t end) {
+								for (size_t i = begin; i < end; ++i)
+									zPtr[i] = alpha * xPtr[i] + yPtr[i];
+							});
 							break;
 						}
 						default:
@@ -100,8 +481,10 @@ namespace cl
 							auto* xPtr = GetPointer<MathDomain::Int>(x);
 							auto* yPtr = GetPointer<MathDomain::Int>(y);
 
-							for (size_t i = 0; i < z.size; ++i)
-								zPtr[i] = static_cast<int>(alpha) * xPtr[i] + yPtr[i];
+							detail::ParallelFor(z.size, detail::elementWiseGrainSize, [&](const size_t begin, const size_t end) {
+								for (size_t i = begin; i < end; ++i)
+									zPtr[i] = static_cast<int>(alpha) * xPtr[i] + yPtr[i];
+							});
 							break;
 						}
 						default:
@@ -128,6 +511,8 @@ namespace cl
 			assert(z.mathDomain == x.mathDomain);
 			assert(z.size == x.size);
 
+			CL_PROFILE(z, 2.0 * z.size, 3.0 * z.TotalSize());
+
 			switch (z.mathDomain)
 			{
 				case MathDomain::Float:
@@ -149,8 +534,10 @@ namespace cl
 							auto* zPtr = GetPointer<MathDomain::Float>(z);
 							auto* xPtr = GetPointer<MathDomain::Float>(x);
 
-							for (size_t i = 0; i < z.size; ++i)
-								zPtr[i] += xPtr[i] * static_cast<float>(alpha);
+							detail::ParallelFor(z.size, detail::elementWiseGrainSize, [&](const size_t begin, const size_t end) {
+								for (size_t i = begin; i < end; ++i)
+									zPtr[i] += xPtr[i] * static_cast<float>(alpha);
+							});
 							break;
 						}
 						default:
@@ -177,8 +564,10 @@ namespace cl
 							auto* zPtr = GetPointer<MathDomain::Double>(z);
 							auto* xPtr = GetPointer<MathDomain::Double>(x);
 
-							for (size_t i = 0; i < z.size; ++i)
-								zPtr[i] += xPtr[i] * alpha;
+							detail::ParallelFor(z.size, detail::elementWiseGrainSize, [&](const size_t begin, const size_t end) {
+								for (size_t i = begin; i < end; ++i)
+									zPtr[i] += xPtr[i] * alpha;
+							});
 							break;
 						}
 						default:
@@ -198,8 +587,10 @@ namespace cl
 							auto* zPtr = GetPointer<MathDomain::Int>(z);
 							auto* xPtr = GetPointer<MathDomain::Int>(x);
 
-							for (size_t i = 0; i < z.size; ++i)
-								zPtr[i] += xPtr[i] * static_cast<int>(alpha);
+							detail::ParallelFor(z.size, detail::elementWiseGrainSize, [&](const size_t begin, const size_t end) {
+								for (size_t i = begin; i < end; ++i)
+									zPtr[i] += xPtr[i] * static_cast<int>(alpha);
+							});
 							break;
 						}
 						default:
@@ -220,6 +611,8 @@ namespace cl
 			assert(A.memorySpace == B.memorySpace);
 			assert(B.mathDomain == B.mathDomain);
 
+			CL_PROFILE(A, 3.0 * A.nRows * A.nCols, 3.0 * A.nRows * A.nCols * A.ElementarySize());
+
 			switch (A.mathDomain)
 			{
 				case MathDomain::Float:
@@ -275,6 +668,8 @@ namespace cl
 		 */
 		void Scale(MemoryBuffer& z, const double alpha)
 		{
+			CL_PROFILE(z, 1.0 * z.size, 2.0 * z.TotalSize());
+
 			switch (z.mathDomain)
 			{
 				case MathDomain::Float:
@@ -294,8 +689,10 @@ namespace cl
 						case MemorySpace::Test:
 						{
 							auto* zPtr = GetPointer<MathDomain::Float>(z);
-							for (size_t i = 0; i < z.size; ++i)
-								zPtr[i] *= static_cast<float>(alpha);
+							detail::ParallelFor(z.size, detail::elementWiseGrainSize, [&](const size_t begin, const size_t end) {
+								for (size_t i = begin; i < end; ++i)
+									zPtr[i] *= static_cast<float>(alpha);
+							});
 							break;
 						}
 						default:
@@ -321,8 +718,10 @@ namespace cl
 						{
 							auto* zPtr = GetPointer<MathDomain::Double>(z);
 
-							for (size_t i = 0; i < z.size; ++i)
-								zPtr[i] *= alpha;
+							detail::ParallelFor(z.size, detail::elementWiseGrainSize, [&](const size_t begin, const size_t end) {
+								for (size_t i = begin; i < end; ++i)
+									zPtr[i] *= alpha;
+							});
 							break;
 						}
 						default:
@@ -341,8 +740,10 @@ namespace cl
 						{
 							auto* zPtr = GetPointer<MathDomain::Int>(z);
 
-							for (size_t i = 0; i < z.size; ++i)
-								zPtr[i] *= static_cast<int>(alpha);
+							detail::ParallelFor(z.size, detail::elementWiseGrainSize, [&](const size_t begin, const size_t end) {
+								for (size_t i = begin; i < end; ++i)
+									zPtr[i] *= static_cast<int>(alpha);
+							});
 							break;
 						}
 						default:
@@ -360,6 +761,8 @@ namespace cl
 		 */
 		void ScaleColumns(MemoryTile& z, const MemoryBuffer& alpha)
 		{
+			CL_PROFILE(z, 1.0 * z.nRows * z.nCols, (2.0 * z.nRows * z.nCols + z.nCols) * z.ElementarySize());
+
 			switch (z.mathDomain)
 			{
 				case MathDomain::Float:
@@ -381,9 +784,11 @@ namespace cl
 							auto* zPtr = GetPointer<MathDomain::Float>(z);
 							auto* aPtr = GetPointer<MathDomain::Float>(alpha);
 
-							for (size_t j = 0; j < z.nCols; ++j)
-								for (size_t i = 0; i < z.nRows; ++i)
-									zPtr[i + j * z.nRows] *= aPtr[j];
+							detail::ParallelFor(z.nCols, detail::GetSliceGrainSize(z.nRows), [&](const size_t begin, const size_t end) {
+								for (size_t j = begin; j < end; ++j)
+									for (size_t i = 0; i < z.nRows; ++i)
+										zPtr[i + j * z.nRows] *= aPtr[j];
+							});
 							break;
 						}
 						default:
@@ -410,9 +815,11 @@ namespace cl
 							auto* zPtr = GetPointer<MathDomain::Double>(z);
 							auto* aPtr = GetPointer<MathDomain::Double>(alpha);
 
-							for (size_t j = 0; j < z.nCols; ++j)
-								for (size_t i = 0; i < z.nRows; ++i)
-									zPtr[i + j * z.nRows] *= aPtr[j];
+							detail::ParallelFor(z.nCols, detail::GetSliceGrainSize(z.nRows), [&](const size_t begin, const size_t end) {
+								for (size_t j = begin; j < end; ++j)
+									for (size_t i = 0; i < z.nRows; ++i)
+										zPtr[i + j * z.nRows] *= aPtr[j];
+							});
 							break;
 						}
 						default:
@@ -432,9 +839,11 @@ namespace cl
 							auto* zPtr = GetPointer<MathDomain::Int>(z);
 							auto* aPtr = GetPointer<MathDomain::Int>(alpha);
 
-							for (size_t j = 0; j < z.nCols; ++j)
-								for (size_t i = 0; i < z.nRows; ++i)
-									zPtr[i + j * z.nRows] *= aPtr[j];
+							detail::ParallelFor(z.nCols, detail::GetSliceGrainSize(z.nRows), [&](const size_t begin, const size_t end) {
+								for (size_t j = begin; j < end; ++j)
+									for (size_t i = 0; i < z.nRows; ++i)
+										zPtr[i + j * z.nRows] *= aPtr[j];
+							});
 							break;
 						}
 						default:
@@ -459,6 +868,8 @@ namespace cl
 			assert(z.size == x.size);
 			assert(z.size == y.size);
 
+			CL_PROFILE(z, 2.0 * z.size, 3.0 * z.TotalSize());
+
 			switch (z.mathDomain)
 			{
 				case MathDomain::Float:
@@ -477,8 +888,10 @@ namespace cl
 							auto* xPtr = GetPointer<MathDomain::Float>(x);
 							auto* yPtr = GetPointer<MathDomain::Float>(y);
 
-							for (size_t i = 0; i < z.size; ++i)
-								zPtr[i] = xPtr[i] * yPtr[i] * static_cast<float>(alpha);
+							detail::ParallelFor(z.size, detail::elementWiseGrainSize, [&](const size_t begin, const size_t end) {
+								for (size_t i = begin; i < end; ++i)
+									zPtr[i] = xPtr[i] * yPtr[i] * static_cast<float>(alpha);
+							});
 							break;
 						}
 						default:
@@ -502,8 +915,10 @@ namespace cl
 							auto* xPtr = GetPointer<MathDomain::Double>(x);
 							auto* yPtr = GetPointer<MathDomain::Double>(y);
 
-							for (size_t i = 0; i < z.size; ++i)
-								zPtr[i] = xPtr[i] * yPtr[i] * alpha;
+							detail::ParallelFor(z.size, detail::elementWiseGrainSize, [&](const size_t begin, const size_t end) {
+								for (size_t i = begin; i < end; ++i)
+									zPtr[i] = xPtr[i] * yPtr[i] * alpha;
+							});
 							break;
 						}
 						default:
@@ -524,8 +939,10 @@ namespace cl
 							auto* xPtr = GetPointer<MathDomain::Int>(x);
 							auto* yPtr = GetPointer<MathDomain::Int>(y);
 
-							for (size_t i = 0; i < z.size; ++i)
-								zPtr[i] = xPtr[i] * yPtr[i] * static_cast<int>(alpha);
+							detail::ParallelFor(z.size, detail::elementWiseGrainSize, [&](const size_t begin, const size_t end) {
+								for (size_t i = begin; i < end; ++i)
+									zPtr[i] = xPtr[i] * yPtr[i] * static_cast<int>(alpha);
+							});
 							break;
 						}
 						default:
@@ -550,6 +967,8 @@ namespace cl
 			assert(z.size == x.size);
 			assert(z.size == y.size);
 
+			CL_PROFILE(z, 2.0 * z.size, 3.0 * z.TotalSize());
+
 			switch (z.mathDomain)
 			{
 				case MathDomain::Float:
@@ -565,8 +984,10 @@ namespace cl
 							auto* xPtr = GetPointer<MathDomain::Float>(x);
 							auto* yPtr = GetPointer<MathDomain::Float>(y);
 
-							for (size_t i = 0; i < z.size; ++i)
-								zPtr[i] = xPtr[i] / yPtr[i] * static_cast<float>(alpha);
+							detail::ParallelFor(z.size, detail::elementWiseGrainSize, [&](const size_t begin, const size_t end) {
+								for (size_t i = begin; i < end; ++i)
+									zPtr[i] = xPtr[i] / yPtr[i] * static_cast<float>(alpha);
+							});
 							break;
 						}
 						default:
@@ -587,8 +1008,10 @@ namespace cl
 							auto* xPtr = GetPointer<MathDomain::Double>(x);
 							auto* yPtr = GetPointer<MathDomain::Double>(y);
 
-							for (size_t i = 0; i < z.size; ++i)
-								zPtr[i] = xPtr[i] / yPtr[i] * alpha;
+							detail::ParallelFor(z.size, detail::elementWiseGrainSize, [&](const size_t begin, const size_t end) {
+								for (size_t i = begin; i < end; ++i)
+									zPtr[i] = xPtr[i] / yPtr[i] * alpha;
+							});
 							break;
 						}
 						default:
@@ -609,8 +1032,10 @@ namespace cl
 							auto* xPtr = GetPointer<MathDomain::Int>(x);
 							auto* yPtr = GetPointer<MathDomain::Int>(y);
 
-							for (size_t i = 0; i < z.size; ++i)
-								zPtr[i] = xPtr[i] / yPtr[i] * static_cast<int>(alpha);
+							detail::ParallelFor(z.size, detail::elementWiseGrainSize, [&](const size_t begin, const size_t end) {
+								for (size_t i = begin; i < end; ++i)
+									zPtr[i] = xPtr[i] / yPtr[i] * static_cast<int>(alpha);
+							});
 							break;
 						}
 						default:
@@ -623,6 +1048,42 @@ namespace cl
 			}
 		}
 
+		void Exp(MemoryBuffer& y, const MemoryBuffer& x)
+		{
+			CL_PROFILE(y, 1.0 * y.size, 2.0 * y.TotalSize());
+			ApplyElementWiseFunction(y, x, ElementWiseFunction::Exp);
+		}
+
+		void Log(MemoryBuffer& y, const MemoryBuffer& x)
+		{
+			CL_PROFILE(y, 1.0 * y.size, 2.0 * y.TotalSize());
+			ApplyElementWiseFunction(y, x, ElementWiseFunction::Log);
+		}
+
+		void Sqrt(MemoryBuffer& y, const MemoryBuffer& x)
+		{
+			CL_PROFILE(y, 1.0 * y.size, 2.0 * y.TotalSize());
+			ApplyElementWiseFunction(y, x, ElementWiseFunction::Sqrt);
+		}
+
+		void Pow(MemoryBuffer& y, const MemoryBuffer& x, const double exponent)
+		{
+			CL_PROFILE(y, 1.0 * y.size, 2.0 * y.TotalSize());
+			ApplyElementWiseFunction(y, x, ElementWiseFunction::Pow, exponent);
+		}
+
+		void Tanh(MemoryBuffer& y, const MemoryBuffer& x)
+		{
+			CL_PROFILE(y, 1.0 * y.size, 2.0 * y.TotalSize());
+			ApplyElementWiseFunction(y, x, ElementWiseFunction::Tanh);
+		}
+
+		void Erf(MemoryBuffer& y, const MemoryBuffer& x)
+		{
+			CL_PROFILE(y, 1.0 * y.size, 2.0 * y.TotalSize());
+			ApplyElementWiseFunction(y, x, ElementWiseFunction::Erf);
+		}
+
 		/*
 		 *	A = alpha * B * C + beta * A
 		 */
@@ -638,6 +1099,8 @@ namespace cl
 			assert(A.mathDomain == A.mathDomain);
 			assert(A.mathDomain == C.mathDomain);
 
+			CL_PROFILE(A, 2.0 * A.nRows * A.nCols * (bOperation == MatrixOperation::None ? nColsB : nRowsB), (1.0 * nRowsB * nColsB + 1.0 * (bOperation == MatrixOperation::None ? nColsB : nRowsB) * A.nCols + 2.0 * A.nRows * A.nCols) * A.ElementarySize());
+
 			switch (A.mathDomain)
 			{
 				case MathDomain::Float:
@@ -655,20 +1118,8 @@ namespace cl
 							break;
 
 						case MemorySpace::Test:
-						{
-							auto* aPtr = GetPointer<MathDomain::Float>(A);
-							auto* bPtr = GetPointer<MathDomain::Float>(B);
-							auto* cPtr = GetPointer<MathDomain::Float>(C);
-							const auto _alpha = static_cast<float>(alpha);
-							const auto _beta = static_cast<float>(beta);
-
-							// TODO transpositions!
-							for (size_t i = 0; i < nRowsB; ++i)
-								for (size_t k = 0; k < nColsC; ++k)
-									for (size_t j = 0; j < nColsB; ++j)
-										aPtr[i + k * A.leadingDimension] = _beta * aPtr[i + k * A.leadingDimension] + _alpha * bPtr[i + j * B.leadingDimension] * cPtr[j + k * C.leadingDimension];
+							nbr::Gemm(bOperation, cOperation, nRowsB, nColsC, nColsB, static_cast<float>(alpha), GetPointer<MathDomain::Float>(B), B.leadingDimension, GetPointer<MathDomain::Float>(C), C.leadingDimension, static_cast<float>(beta), GetPointer<MathDomain::Float>(A), A.leadingDimension);
 							break;
-						}
 						default:
 							throw NotImplementedException();
 					}
@@ -689,18 +1140,8 @@ namespace cl
 							break;
 
 						case MemorySpace::Test:
-						{
-							auto* aPtr = GetPointer<MathDomain::Double>(A);
-							auto* bPtr = GetPointer<MathDomain::Double>(B);
-							auto* cPtr = GetPointer<MathDomain::Double>(C);
-
-							// TODO transpositions!
-							for (size_t i = 0; i < B.nRows; ++i)
-								for (size_t k = 0; k < C.nCols; ++k)
-									for (size_t j = 0; j < B.nCols; ++j)
-										aPtr[i + k * A.leadingDimension] = beta * aPtr[i + k * A.leadingDimension] + alpha * bPtr[i + j * B.leadingDimension] * cPtr[j + k * C.leadingDimension];
+							nbr::Gemm(bOperation, cOperation, nRowsB, nColsC, nColsB, alpha, GetPointer<MathDomain::Double>(B), B.leadingDimension, GetPointer<MathDomain::Double>(C), C.leadingDimension, beta, GetPointer<MathDomain::Double>(A), A.leadingDimension);
 							break;
-						}
 						default:
 							throw NotImplementedException();
 					}
@@ -723,10 +1164,21 @@ namespace cl
 							const auto _beta = static_cast<int>(beta);
 
 							// TODO transpositions!
-							for (size_t i = 0; i < B.nRows; ++i)
-								for (size_t k = 0; k < C.nCols; ++k)
-									for (size_t j = 0; j < B.nCols; ++j)
-										aPtr[i + k * A.leadingDimension] = _beta * aPtr[i + k * A.leadingDimension] + _alpha * bPtr[i + j * B.leadingDimension] * cPtr[j + k * C.leadingDimension];
+							detail::ParallelFor(nColsC, detail::GetSliceGrainSize(nRowsB * nColsB), [&](const size_t begin, const size_t end) {
+								for (size_t k = begin; k < end; ++k)
+								{
+									for (size_t i = 0; i < nRowsB; ++i)
+									{
+										int bc = 0;
+										for (size_t j = 0; j < nColsB; ++j)
+											bc += bPtr[i + j * B.leadingDimension] * cPtr[j + k * C.leadingDimension];
+
+										// beta = 0 overwrites A, as in BLAS
+										auto& a = aPtr[i + k * A.leadingDimension];
+										a = (beta == 0.0 ? 0 : _beta * a) + _alpha * bc;
+									}
+								}
+							});
 							break;
 						}
 						default:
@@ -739,17 +1191,92 @@ namespace cl
 			}
 		}
 
+		void MultiplyFused(MemoryTile& A, const MemoryTile& B, const MemoryTile& C, const MemoryBuffer& bias, const ActivationType activation, const MatrixOperation bOperation, const MatrixOperation cOperation, const double alpha, const double beta)
+		{
+			assert(A.memorySpace == B.memorySpace);
+			assert(A.memorySpace == C.memorySpace);
+			assert(A.mathDomain == B.mathDomain);
+			assert(A.mathDomain == C.mathDomain);
+			assert(bias.pointer == 0 || (bias.size == A.nRows && bias.mathDomain == A.mathDomain));
+
+			// the provider paths also record the inner Multiply
+			CL_PROFILE(A, 2.0 * A.nRows * A.nCols * (bOperation == MatrixOperation::None ? B.nCols : B.nRows) + 2.0 * A.nRows * A.nCols, (1.0 * B.nRows * B.nCols + 1.0 * C.nRows * C.nCols + 2.0 * A.nRows * A.nCols + (bias.pointer != 0 ? bias.size : 0)) * A.ElementarySize());
+
+			// provider GEMMs are followed by one pass over A, split by columns so that each thread works on its own slice
+			auto biasActivation = [&](auto* aPtr, const auto* biasPtr) {
+				detail::ParallelFor(A.nCols, detail::GetSliceGrainSize(A.nRows), [&](const size_t begin, const size_t end) {
+					detail::BiasActivation(aPtr + begin * A.leadingDimension, A.leadingDimension, A.nRows, end - begin, biasPtr, activation);
+				});
+			};
+
+			switch (A.mathDomain)
+			{
+				case MathDomain::Float:
+				{
+					switch (A.memorySpace)
+					{
+						case MemorySpace::Test:
+							nbr::GemmFused(bOperation, cOperation, B.nRows, A.nCols, B.nCols, static_cast<float>(alpha), GetPointer<MathDomain::Float>(B), B.leadingDimension, GetPointer<MathDomain::Float>(C), C.leadingDimension, static_cast<float>(beta), GetPointer<MathDomain::Float>(A), A.leadingDimension, bias.pointer != 0 ? GetPointer<MathDomain::Float>(bias) : nullptr, activation);
+							break;
+						case MemorySpace::Mkl:
+						case MemorySpace::OpenBlas:
+						case MemorySpace::GenericBlas:
+							Multiply(A, B, C, bOperation, cOperation, alpha, beta);
+							biasActivation(GetPointer<MathDomain::Float>(A), bias.pointer != 0 ? GetPointer<MathDomain::Float>(bias) : nullptr);
+							break;
+						default:
+							throw NotImplementedException();
+					}
+					break;
+				}
+				case MathDomain::Double:
+				{
+					switch (A.memorySpace)
+					{
+						case MemorySpace::Test:
+							nbr::GemmFused(bOperation, cOperation, B.nRows, A.nCols, B.nCols, static_cast<double>(alpha), GetPointer<MathDomain::Double>(B), B.leadingDimension, GetPointer<MathDomain::Double>(C), C.leadingDimension, static_cast<double>(beta), GetPointer<MathDomain::Double>(A), A.leadingDimension, bias.pointer != 0 ? GetPointer<MathDomain::Double>(bias) : nullptr, activation);
+							break;
+						case MemorySpace::Mkl:
+						case MemorySpace::OpenBlas:
+						case MemorySpace::GenericBlas:
+							Multiply(A, B, C, bOperation, cOperation, alpha, beta);
+							biasActivation(GetPointer<MathDomain::Double>(A), bias.pointer != 0 ? GetPointer<MathDomain::Double>(bias) : nullptr);
+							break;
+						default:
+							throw NotImplementedException();
+					}
+					break;
+				}
+				default:
+					throw NotImplementedException();
+			}
+		}
+
 		/*
-		 *	A[i] = alpha * B[i] * C[i] + beta * A[i]
+		 *	A[i] = alpha * B[i * strideB] * C[i * strideC] + beta * A[i]
 		 */
 		void BatchedMultiply(MemoryCube& A, const MemoryCube& B, const MemoryCube& C, const unsigned strideB, const unsigned strideC, const MatrixOperation bOperation, const MatrixOperation cOperation, const double alpha, const double beta)
 		{
 			assert(A.memorySpace == B.memorySpace);
 			assert(A.memorySpace == C.memorySpace);
-			assert(A.mathDomain == A.mathDomain);
+			assert(A.mathDomain == B.mathDomain);
 			assert(A.mathDomain == C.mathDomain);
-			assert(A.nCubes == B.nCubes);
-			assert(A.nCubes == C.nCubes);
+
+			CL_PROFILE(A, 2.0 * A.nCubes * A.nRows * A.nCols * (bOperation == MatrixOperation::None ? B.nCols : B.nRows), (1.0 * B.size + 1.0 * C.size + 2.0 * A.size) * A.ElementarySize());
+
+			// B and C can be broadcast (zero stride), so their number of cubes is not reliable: the shapes are deduced from A
+			auto multiplyEach = [&]() {
+				const unsigned nInner = bOperation == MatrixOperation::None ? B.nCols : B.nRows;
+				detail::ParallelFor(A.nCubes, detail::GetSliceGrainSize(static_cast<size_t>(A.nRows) * A.nCols * nInner), [&](const size_t begin, const size_t end) {
+					for (size_t n = begin; n < end; ++n)
+					{
+						MemoryTile a(A.pointer + static_cast<ptr_t>(n) * A.nRows * A.nCols * A.ElementarySize(), A.nRows, A.nCols, A.memorySpace, A.mathDomain);
+						MemoryTile b(B.pointer + static_cast<ptr_t>(n) * strideB * B.ElementarySize(), bOperation == MatrixOperation::None ? A.nRows : nInner, bOperation == MatrixOperation::None ? nInner : A.nRows, B.leadingDimension, B.memorySpace, B.mathDomain);
+						MemoryTile c(C.pointer + static_cast<ptr_t>(n) * strideC * C.ElementarySize(), cOperation == MatrixOperation::None ? nInner : A.nCols, cOperation == MatrixOperation::None ? A.nCols : nInner, C.leadingDimension, C.memorySpace, C.mathDomain);
+						Multiply(a, b, c, bOperation, cOperation, alpha, beta);
+					}
+				});
+			};
 
 			switch (A.mathDomain)
 			{
@@ -760,23 +1287,16 @@ namespace cl
 						case MemorySpace::Mkl:
 							mkr::BatchedMultiply<MathDomain::Float>(A, B, C, strideB, strideC, bOperation, cOperation, alpha, beta);
 							break;
+						case MemorySpace::OpenBlas:
+							obr::BatchedMultiply<MathDomain::Float>(A, B, C, strideB, strideC, bOperation, cOperation, alpha, beta);
+							break;
+						case MemorySpace::GenericBlas:
+							gbr::BatchedMultiply<MathDomain::Float>(A, B, C, strideB, strideC, bOperation, cOperation, alpha, beta);
+							break;
 
 						case MemorySpace::Test:
-						case MemorySpace::OpenBlas:		  // TODO
-						case MemorySpace::GenericBlas:	  // TODO
-						{
-							for (unsigned n = 0; n < A.nCubes; ++n)
-							{
-								MemoryTile a;
-								MemoryTile b;
-								MemoryTile c;
-								ExtractMatrixBufferFromCube(a, A, n);
-								ExtractMatrixBufferFromCube(b, B, n);
-								ExtractMatrixBufferFromCube(c, C, n);
-								Multiply(A, B, C, bOperation, cOperation, alpha, beta);
-							}
+							multiplyEach();
 							break;
-						}
 						default:
 							throw NotImplementedException();
 					}
@@ -789,23 +1309,16 @@ namespace cl
 						case MemorySpace::Mkl:
 							mkr::BatchedMultiply<MathDomain::Double>(A, B, C, strideB, strideC, bOperation, cOperation, alpha, beta);
 							break;
+						case MemorySpace::OpenBlas:
+							obr::BatchedMultiply<MathDomain::Double>(A, B, C, strideB, strideC, bOperation, cOperation, alpha, beta);
+							break;
+						case MemorySpace::GenericBlas:
+							gbr::BatchedMultiply<MathDomain::Double>(A, B, C, strideB, strideC, bOperation, cOperation, alpha, beta);
+							break;
 
 						case MemorySpace::Test:
-						case MemorySpace::OpenBlas:		  // TODO
-						case MemorySpace::GenericBlas:	  // TODO
-						{
-							for (unsigned n = 0; n < A.nCubes; ++n)
-							{
-								MemoryTile a;
-								MemoryTile b;
-								MemoryTile c;
-								ExtractMatrixBufferFromCube(a, A, n);
-								ExtractMatrixBufferFromCube(b, B, n);
-								ExtractMatrixBufferFromCube(c, C, n);
-								Multiply(A, B, C, bOperation, cOperation, alpha, beta);
-							}
+							multiplyEach();
 							break;
-						}
 						default:
 							throw NotImplementedException();
 					}
@@ -819,19 +1332,8 @@ namespace cl
 						case MemorySpace::Mkl:			  // TODO
 						case MemorySpace::OpenBlas:		  // TODO
 						case MemorySpace::GenericBlas:	  // TODO
-						{
-							for (unsigned n = 0; n < A.nCubes; ++n)
-							{
-								MemoryTile a;
-								MemoryTile b;
-								MemoryTile c;
-								ExtractMatrixBufferFromCube(a, A, n);
-								ExtractMatrixBufferFromCube(b, B, n);
-								ExtractMatrixBufferFromCube(c, C, n);
-								Multiply(A, B, C, bOperation, cOperation, alpha, beta);
-							}
+							multiplyEach();
 							break;
-						}
 						default:
 							throw NotImplementedException();
 					}
@@ -852,6 +1354,8 @@ namespace cl
 			assert(y.mathDomain == A.mathDomain);
 			assert(y.mathDomain == x.mathDomain);
 
+			CL_PROFILE(y, 2.0 * A.nRows * A.nCols, (1.0 * A.nRows * A.nCols + x.size + 2.0 * y.size) * y.ElementarySize());
+
 			switch (y.mathDomain)
 			{
 				case MathDomain::Float:
@@ -869,24 +1373,8 @@ namespace cl
 							break;
 
 						case MemorySpace::Test:
-						{
-							auto* aPtr = GetPointer<MathDomain::Float>(x);
-							auto* xPtr = GetPointer<MathDomain::Float>(x);
-							auto* yPtr = GetPointer<MathDomain::Float>(y);
-
-							for (size_t i = 0; i < A.nRows; ++i)
-							{
-								yPtr[i] = yPtr[i] * static_cast<float>(beta);
-								for (size_t j = 0; j < A.nCols; ++j)
-								{
-									if (aOperation == MatrixOperation::None)
-										yPtr[i] += aPtr[i + j * A.nRows] * xPtr[j] * static_cast<float>(alpha);
-									else if (aOperation == MatrixOperation::Transpose)
-										yPtr[i] += aPtr[j + i * A.nCols] * xPtr[j] * static_cast<float>(alpha);
-								}
-							}
+							nbr::Gemv(aOperation, A.nRows, A.nCols, static_cast<float>(alpha), GetPointer<MathDomain::Float>(A), A.leadingDimension, GetPointer<MathDomain::Float>(x), static_cast<float>(beta), GetPointer<MathDomain::Float>(y));
 							break;
-						}
 						default:
 							throw NotImplementedException();
 					}
@@ -907,24 +1395,8 @@ namespace cl
 							break;
 
 						case MemorySpace::Test:
-						{
-							auto* aPtr = GetPointer<MathDomain::Double>(x);
-							auto* xPtr = GetPointer<MathDomain::Double>(x);
-							auto* yPtr = GetPointer<MathDomain::Double>(y);
-
-							for (size_t i = 0; i < A.nRows; ++i)
-							{
-								yPtr[i] = yPtr[i] * beta;
-								for (size_t j = 0; j < A.nCols; ++j)
-								{
-									if (aOperation == MatrixOperation::None)
-										yPtr[i] += aPtr[i + j * A.nRows] * xPtr[j] * alpha;
-									else if (aOperation == MatrixOperation::Transpose)
-										yPtr[i] += aPtr[j + i * A.nCols] * xPtr[j] * alpha;
-								}
-							}
+							nbr::Gemv(aOperation, A.nRows, A.nCols, alpha, GetPointer<MathDomain::Double>(A), A.leadingDimension, GetPointer<MathDomain::Double>(x), beta, GetPointer<MathDomain::Double>(y));
 							break;
-						}
 						default:
 							throw NotImplementedException();
 					}
@@ -939,16 +1411,18 @@ namespace cl
 						case MemorySpace::OpenBlas:		  // TODO
 						case MemorySpace::GenericBlas:	  // TODO
 						{
-							auto* aPtr = GetPointer<MathDomain::Int>(x);
+							auto* aPtr = GetPointer<MathDomain::Int>(A);
 							auto* xPtr = GetPointer<MathDomain::Int>(x);
 							auto* yPtr = GetPointer<MathDomain::Int>(y);
 
-							for (size_t i = 0; i < A.nRows; ++i)
-							{
-								yPtr[i] = yPtr[i] * static_cast<int>(beta);
-								for (size_t j = 0; j < A.nCols; ++j)
-									yPtr[i] += aPtr[i + j * A.nRows] * xPtr[j] * static_cast<int>(alpha);
-							}
+							detail::ParallelFor(A.nRows, detail::GetSliceGrainSize(A.nCols), [&](const size_t begin, const size_t end) {
+								for (size_t i = begin; i < end; ++i)
+								{
+									yPtr[i] = yPtr[i] * static_cast<int>(beta);
+									for (size_t j = 0; j < A.nCols; ++j)
+										yPtr[i] += aPtr[i + j * A.nRows] * xPtr[j] * static_cast<int>(alpha);
+								}
+							});
 							break;
 						}
 						default:
@@ -971,6 +1445,8 @@ namespace cl
 			assert(y.mathDomain == A.mathDomain);
 			assert(y.mathDomain == x.mathDomain);
 
+			CL_PROFILE(A, 2.0 * A.nRows * A.nCols, (2.0 * A.nRows * A.nCols + x.size + y.size) * A.ElementarySize());
+
 			switch (y.mathDomain)
 			{
 				case MathDomain::Float:
@@ -989,13 +1465,15 @@ namespace cl
 
 						case MemorySpace::Test:
 						{
-							auto* aPtr = GetPointer<MathDomain::Float>(x);
+							auto* aPtr = GetPointer<MathDomain::Float>(A);
 							auto* xPtr = GetPointer<MathDomain::Float>(x);
 							auto* yPtr = GetPointer<MathDomain::Float>(y);
 
-							for (size_t j = 0; j < A.nCols; ++j)
-								for (size_t i = 0; i < A.nRows; ++i)
-									aPtr[i + j * A.nRows] += static_cast<float>(alpha) * xPtr[i] * yPtr[j];
+							detail::ParallelFor(A.nCols, detail::GetSliceGrainSize(A.nRows), [&](const size_t begin, const size_t end) {
+								for (size_t j = begin; j < end; ++j)
+									for (size_t i = 0; i < A.nRows; ++i)
+										aPtr[i + j * A.nRows] += static_cast<float>(alpha) * xPtr[i] * yPtr[j];
+							});
 							break;
 						}
 						default:
@@ -1019,13 +1497,15 @@ namespace cl
 
 						case MemorySpace::Test:
 						{
-							auto* aPtr = GetPointer<MathDomain::Double>(x);
+							auto* aPtr = GetPointer<MathDomain::Double>(A);
 							auto* xPtr = GetPointer<MathDomain::Double>(x);
 							auto* yPtr = GetPointer<MathDomain::Double>(y);
 
-							for (size_t j = 0; j < A.nCols; ++j)
-								for (size_t i = 0; i < A.nRows; ++i)
-									aPtr[i + j * A.nRows] += alpha * xPtr[i] * yPtr[j];
+							detail::ParallelFor(A.nCols, detail::GetSliceGrainSize(A.nRows), [&](const size_t begin, const size_t end) {
+								for (size_t j = begin; j < end; ++j)
+									for (size_t i = 0; i < A.nRows; ++i)
+										aPtr[i + j * A.nRows] += alpha * xPtr[i] * yPtr[j];
+							});
 							break;
 						}
 						default:
@@ -1042,13 +1522,15 @@ namespace cl
 						case MemorySpace::OpenBlas:		  // TODO
 						case MemorySpace::GenericBlas:	  // TODO
 						{
-							auto* aPtr = GetPointer<MathDomain::Int>(x);
+							auto* aPtr = GetPointer<MathDomain::Int>(A);
 							auto* xPtr = GetPointer<MathDomain::Int>(x);
 							auto* yPtr = GetPointer<MathDomain::Int>(y);
 
-							for (size_t j = 0; j < A.nCols; ++j)
-								for (size_t i = 0; i < A.nRows; ++i)
-									aPtr[i + j * A.nRows] += static_cast<int>(alpha) * xPtr[i] * yPtr[j];
+							detail::ParallelFor(A.nCols, detail::GetSliceGrainSize(A.nRows), [&](const size_t begin, const size_t end) {
+								for (size_t j = begin; j < end; ++j)
+									for (size_t i = 0; i < A.nRows; ++i)
+										aPtr[i + j * A.nRows] += static_cast<int>(alpha) * xPtr[i] * yPtr[j];
+							});
 							break;
 						}
 						default:
@@ -1075,6 +1557,8 @@ namespace cl
 			assert(T.nCubes == x.nCols);
 			assert(T.nCubes == y.nCols);
 
+			CL_PROFILE(T, 2.0 * T.size, (2.0 * T.size + x.size + y.size) * T.ElementarySize());
+
 			switch (T.mathDomain)
 			{
 				case MathDomain::Float:
@@ -1086,17 +1570,19 @@ namespace cl
 						case MemorySpace::OpenBlas:		  // TODO
 						case MemorySpace::GenericBlas:	  // TODO
 						{
-							MemoryTile t {};
-							MemoryBuffer _x {};
-							MemoryBuffer _y {};
+							detail::ParallelFor(T.nCubes, detail::GetSliceGrainSize(T.nRows * T.nCols), [&](const size_t begin, const size_t end) {
+								MemoryTile t {};
+								MemoryBuffer _x {};
+								MemoryBuffer _y {};
 
-							for (unsigned n = 0; n < T.nCubes; ++n)
-							{
-								ExtractMatrixBufferFromCube(t, T, n);
-								ExtractColumnBufferFromMatrix(_x, x, n);
-								ExtractColumnBufferFromMatrix(_y, y, n);
-								KroneckerProduct(t, _x, _y, alpha);
-							}
+								for (size_t n = begin; n < end; ++n)
+								{
+									ExtractMatrixBufferFromCube(t, T, static_cast<unsigned>(n));
+									ExtractColumnBufferFromMatrix(_x, x, static_cast<unsigned>(n));
+									ExtractColumnBufferFromMatrix(_y, y, static_cast<unsigned>(n));
+									KroneckerProduct(t, _x, _y, alpha);
+								}
+							});
 							break;
 						}
 						default:
@@ -1113,17 +1599,19 @@ namespace cl
 						case MemorySpace::OpenBlas:		  // TODO
 						case MemorySpace::GenericBlas:	  // TODO
 						{
-							MemoryTile t {};
-							MemoryBuffer _x {};
-							MemoryBuffer _y {};
+							detail::ParallelFor(T.nCubes, detail::GetSliceGrainSize(T.nRows * T.nCols), [&](const size_t begin, const size_t end) {
+								MemoryTile t {};
+								MemoryBuffer _x {};
+								MemoryBuffer _y {};
 
-							for (unsigned n = 0; n < T.nCubes; ++n)
-							{
-								ExtractMatrixBufferFromCube(t, T, n);
-								ExtractColumnBufferFromMatrix(_x, x, n);
-								ExtractColumnBufferFromMatrix(_y, y, n);
-								KroneckerProduct(t, _x, _y, alpha);
-							}
+								for (size_t n = begin; n < end; ++n)
+								{
+									ExtractMatrixBufferFromCube(t, T, static_cast<unsigned>(n));
+									ExtractColumnBufferFromMatrix(_x, x, static_cast<unsigned>(n));
+									ExtractColumnBufferFromMatrix(_y, y, static_cast<unsigned>(n));
+									KroneckerProduct(t, _x, _y, alpha);
+								}
+							});
 							break;
 						}
 						default:
@@ -1140,17 +1628,19 @@ namespace cl
 						case MemorySpace::OpenBlas:		  // TODO
 						case MemorySpace::GenericBlas:	  // TODO
 						{
-							MemoryTile t {};
-							MemoryBuffer _x {};
-							MemoryBuffer _y {};
+							detail::ParallelFor(T.nCubes, detail::GetSliceGrainSize(T.nRows * T.nCols), [&](const size_t begin, const size_t end) {
+								MemoryTile t {};
+								MemoryBuffer _x {};
+								MemoryBuffer _y {};
 
-							for (unsigned n = 0; n < T.nCubes; ++n)
-							{
-								ExtractMatrixBufferFromCube(t, T, n);
-								ExtractColumnBufferFromMatrix(_x, x, n);
-								ExtractColumnBufferFromMatrix(_y, y, n);
-								KroneckerProduct(t, _x, _y, alpha);
-							}
+								for (size_t n = begin; n < end; ++n)
+								{
+									ExtractMatrixBufferFromCube(t, T, static_cast<unsigned>(n));
+									ExtractColumnBufferFromMatrix(_x, x, static_cast<unsigned>(n));
+									ExtractColumnBufferFromMatrix(_y, y, static_cast<unsigned>(n));
+									KroneckerProduct(t, _x, _y, alpha);
+								}
+							});
 							break;
 						}
 						default:
@@ -1166,21 +1656,124 @@ namespace cl
 		/**
 		 * A = cumsum(A)
 		 */
-		void CumulativeRowSum(MemoryTile& A)
+		void CumulativeRowSum(MemoryTile& A) { ColumnWiseCumulativeSum(A); }
+
+		void ColumnWiseCumulativeSum(MemoryTile& A, const bool exclusive)
 		{
-			MemoryTile ones(0, A.nRows, A.nCols, A.memorySpace, A.mathDomain);
-			Alloc(ones);
-			OnesUpperTriangular(ones);
+			CL_PROFILE(A, 1.0 * A.nRows * A.nCols, 2.0 * A.nRows * A.nCols * A.ElementarySize());
 
-			MemoryTile buffer(0, A.nRows, A.nCols, A.memorySpace, A.mathDomain);
-			Alloc(buffer);
+			switch (A.mathDomain)
+			{
+				case MathDomain::Float:
+				{
+					switch (A.memorySpace)
+					{
+						case MemorySpace::Test:
+						case MemorySpace::Mkl:
+						case MemorySpace::OpenBlas:
+						case MemorySpace::GenericBlas:
+							ColumnWiseScan(GetPointer<MathDomain::Float>(A), A.nRows, A.nCols, A.leadingDimension, exclusive);
+							break;
+						default:
+							throw NotImplementedException();
+					}
+					break;
+				}
+				case MathDomain::Double:
+				{
+					switch (A.memorySpace)
+					{
+						case MemorySpace::Test:
+						case MemorySpace::Mkl:
+						case MemorySpace::OpenBlas:
+						case MemorySpace::GenericBlas:
+							ColumnWiseScan(GetPointer<MathDomain::Double>(A), A.nRows, A.nCols, A.leadingDimension, exclusive);
+							break;
+						default:
+							throw NotImplementedException();
+					}
+					break;
+				}
+				case MathDomain::Int:
+				{
+					switch (A.memorySpace)
+					{
+						case MemorySpace::Test:
+						case MemorySpace::Mkl:
+						case MemorySpace::OpenBlas:
+						case MemorySpace::GenericBlas:
+							ColumnWiseScan(GetPointer<MathDomain::Int>(A), A.nRows, A.nCols, A.leadingDimension, exclusive);
+							break;
+						default:
+							throw NotImplementedException();
+					}
+					break;
+				}
+				default:
+					throw NotImplementedException();
+			}
+		}
 
-			Copy(buffer, A);
+		void RowWiseCumulativeSum(MemoryTile& A, const bool exclusive)
+		{
+			CL_PROFILE(A, 1.0 * A.nRows * A.nCols, 2.0 * A.nRows * A.nCols * A.ElementarySize());
 
-			Multiply(A, ones, buffer);
+			switch (A.mathDomain)
+			{
+				case MathDomain::Float:
+				{
+					switch (A.memorySpace)
+					{
+						case MemorySpace::Test:
+						case MemorySpace::Mkl:
+						case MemorySpace::OpenBlas:
+						case MemorySpace::GenericBlas:
+							RowWiseScan(GetPointer<MathDomain::Float>(A), A.nRows, A.nCols, A.leadingDimension, exclusive);
+							break;
+						default:
+							throw NotImplementedException();
+					}
+					break;
+				}
+				case MathDomain::Double:
+				{
+					switch (A.memorySpace)
+					{
+						case MemorySpace::Test:
+						case MemorySpace::Mkl:
+						case MemorySpace::OpenBlas:
+						case MemorySpace::GenericBlas:
+							RowWiseScan(GetPointer<MathDomain::Double>(A), A.nRows, A.nCols, A.leadingDimension, exclusive);
+							break;
+						default:
+							throw NotImplementedException();
+					}
+					break;
+				}
+				case MathDomain::Int:
+				{
+					switch (A.memorySpace)
+					{
+						case MemorySpace::Test:
+						case MemorySpace::Mkl:
+						case MemorySpace::OpenBlas:
+						case MemorySpace::GenericBlas:
+							RowWiseScan(GetPointer<MathDomain::Int>(A), A.nRows, A.nCols, A.leadingDimension, exclusive);
+							break;
+						default:
+							throw NotImplementedException();
+					}
+					break;
+				}
+				default:
+					throw NotImplementedException();
+			}
+		}
 
-			Free(ones);
-			Free(buffer);
+		void CumulativeSum(MemoryBuffer& x, const bool exclusive)
+		{
+			MemoryTile tile(x);
+			ColumnWiseCumulativeSum(tile, exclusive);
 		}
 
 		/**
@@ -1189,6 +1782,8 @@ namespace cl
 		void RowWiseSum(MemoryBuffer& x, const MemoryTile& A, MemoryBuffer& cache, const MatrixOperation aOperation)
 		{
 			auto dim = aOperation == MatrixOperation::None ? A.nCols : A.nRows;
+			CL_PROFILE(A, 1.0 * A.nRows * A.nCols, (1.0 * A.nRows * A.nCols + dim + x.size) * A.ElementarySize());
+
 			if (cache.size != dim)
 			{
 				if (cache.pointer != 0)
@@ -1211,6 +1806,9 @@ namespace cl
 		 */
 		void CubeWiseSum(MemoryTile& A, const MemoryCube& T, MemoryCube& cacheReshape, MemoryBuffer& cacheOnes)
 		{
+			// T is read twice, once by the reshape and once by the reduction
+			CL_PROFILE(A, 1.0 * T.size, (3.0 * T.size + A.nRows * A.nCols) * A.ElementarySize());
+
 			if (cacheOnes.size != T.nCubes)
 			{
 				if (cacheOnes.pointer != 0)
@@ -1242,16 +1840,19 @@ namespace cl
 			auto reshapeWorker = [](auto* RESTRICT out, const auto* RESTRICT in, const size_t nRows, const size_t nCols, const size_t nCubes) {
 				const size_t inMatrixSize = nRows * nCols;
 				const size_t outMatrixSize = nRows * nCubes;
-				for (size_t i = 0; i < nRows; ++i)
-				{
-					for (size_t j = 0; j < nCols; ++j)
+				// each column of T goes to its own block of the output
+				detail::ParallelFor(nCols, detail::GetSliceGrainSize(nRows * nCubes), [&](const size_t begin, const size_t end) {
+					for (size_t j = begin; j < end; ++j)
 					{
-						const size_t inStride = i + j * nRows;
-						const size_t outOffset = i + j * outMatrixSize;
-						for (size_t k = 0; k < nCubes; ++k)
-							out[outOffset + k * nRows] = in[inStride + k * inMatrixSize];
+						for (size_t i = 0; i < nRows; ++i)
+						{
+							const size_t inStride = i + j * nRows;
+							const size_t outOffset = i + j * outMatrixSize;
+							for (size_t k = 0; k < nCubes; ++k)
+								out[outOffset + k * nRows] = in[inStride + k * inMatrixSize];
+						}
 					}
-				}
+				});
 			};
 
 			switch (T.mathDomain)
@@ -1269,17 +1870,92 @@ namespace cl
 					throw NotImplementedException();
 			}
 
-			MemoryCube tmp1(A.pointer, A.nRows, 1, T.nCubes, A.memorySpace, A.mathDomain);
+			// column j of A is the j-th block times a vector of ones
+			MemoryCube tmp1(A.pointer, A.nRows, 1, T.nCols, A.memorySpace, A.mathDomain);
 			MemoryCube tmp2(cacheReshape.pointer, cacheReshape.nRows, cacheReshape.nCols, 0, A.memorySpace, A.mathDomain);
 			MemoryCube tmp3(cacheOnes.pointer, cacheOnes.size, 0, 0, A.memorySpace, A.mathDomain);
 			BatchedMultiply(tmp1, tmp2, tmp3, cacheReshape.nRows * cacheReshape.nCols, 0);
 		}
 
 		/**
-		 * X such that A * X = B by means of LU factorization
+		 * X such that A * X = B by means of LU/QR factorization, or Cholesky/LDL^T for symmetric A.
+		 * MixedPrecisionLu refines the solution of a float LU in double precision, and falls back to a double LU when A is too ill-conditioned for it
 		 */
-		void Solve(const MemoryTile& A, MemoryTile& B, const MatrixOperation aOperation, const LinearSystemSolverType solver)
+		void Solve(const MemoryTile& A, MemoryTile& B, const MatrixOperation aOperation, const DenseSolverType solver)
+		{
+			Solve(A, B, SolverWorkspace::Default(), aOperation, solver);
+		}
+
+		void Solve(const MemoryTile& A, MemoryTile& B, SolverWorkspace& workspace, const MatrixOperation aOperation, const DenseSolverType solver)
+		{
+			if (solver == DenseSolverType::MixedPrecisionLu)
+			{
+				// float matrices have nothing to refine: same as Lu, which is also the fallback when the refinement fails
+				if (A.mathDomain != MathDomain::Double || !MixedPrecisionSolve(A, B, workspace, aOperation))
+					Solve(A, B, workspace, aOperation, DenseSolverType::Lu);
+				return;
+			}
+
+			CL_PROFILE(A, 2.0 / 3.0 * A.nRows * A.nRows * A.nRows + 2.0 * A.nRows * A.nRows * B.nCols, (1.0 * A.nRows * A.nCols + 2.0 * B.nRows * B.nCols) * A.ElementarySize());
+
+			switch (A.mathDomain)
+			{
+				case MathDomain::Float:
+				{
+					switch (A.memorySpace)
+					{
+						case MemorySpace::Mkl:
+							mkr::Solve<MathDomain::Float>(A, B, aOperation, solver, workspace);
+							break;
+						case MemorySpace::OpenBlas:
+							obr::Solve<MathDomain::Float>(A, B, aOperation, solver, workspace);
+							break;
+						case MemorySpace::GenericBlas:
+							gbr::Solve<MathDomain::Float>(A, B, aOperation, solver, workspace);
+							break;
+
+						case MemorySpace::Test:
+							nbr::Solve<MathDomain::Float>(A, B, aOperation, solver, workspace);
+							break;
+
+						default:
+							throw NotImplementedException();
+					}
+					break;
+				}
+				case MathDomain::Double:
+				{
+					switch (A.memorySpace)
+					{
+						case MemorySpace::Mkl:
+							mkr::Solve<MathDomain::Double>(A, B, aOperation, solver, workspace);
+							break;
+						case MemorySpace::OpenBlas:
+							obr::Solve<MathDomain::Double>(A, B, aOperation, solver, workspace);
+							break;
+						case MemorySpace::GenericBlas:
+							gbr::Solve<MathDomain::Double>(A, B, aOperation, solver, workspace);
+							break;
+
+						case MemorySpace::Test:
+							nbr::Solve<MathDomain::Double>(A, B, aOperation, solver, workspace);
+							break;
+
+						default:
+							throw NotImplementedException();
+					}
+					break;
+				}
+				case MathDomain::Int:
+				default:
+					throw NotImplementedException();
+			}
+		}
+
+		void Factorize(MemoryTile& A, MemoryBuffer& auxiliary, const DenseSolverType solver)
 		{
+			CL_PROFILE(A, 2.0 / 3.0 * A.nRows * A.nRows * A.nRows, 2.0 * A.nRows * A.nCols * A.ElementarySize());
+
 			switch (A.mathDomain)
 			{
 				case MathDomain::Float:
@@ -1287,13 +1963,17 @@ namespace cl
 					switch (A.memorySpace)
 					{
 						case MemorySpace::Mkl:
-							mkr::Solve<MathDomain::Float>(A, B, aOperation, solver);
+							mkr::Factorize<MathDomain::Float>(A, auxiliary, solver, SolverWorkspace::Default());
 							break;
 						case MemorySpace::OpenBlas:
-							obr::Solve<MathDomain::Float>(A, B, aOperation, solver);
+							obr::Factorize<MathDomain::Float>(A, auxiliary, solver, SolverWorkspace::Default());
 							break;
 						case MemorySpace::GenericBlas:
-							gbr::Solve<MathDomain::Float>(A, B, aOperation, solver);
+							gbr::Factorize<MathDomain::Float>(A, auxiliary, solver, SolverWorkspace::Default());
+							break;
+
+						case MemorySpace::Test:
+							nbr::Factorize<MathDomain::Float>(A, auxiliary, solver);
 							break;
 
 						default:
@@ -1306,13 +1986,75 @@ namespace cl
 					switch (A.memorySpace)
 					{
 						case MemorySpace::Mkl:
-							mkr::Solve<MathDomain::Double>(A, B, aOperation, solver);
+							mkr::Factorize<MathDomain::Double>(A, auxiliary, solver, SolverWorkspace::Default());
 							break;
 						case MemorySpace::OpenBlas:
-							obr::Solve<MathDomain::Double>(A, B, aOperation, solver);
+							obr::Factorize<MathDomain::Double>(A, auxiliary, solver, SolverWorkspace::Default());
 							break;
 						case MemorySpace::GenericBlas:
-							gbr::Solve<MathDomain::Double>(A, B, aOperation, solver);
+							gbr::Factorize<MathDomain::Double>(A, auxiliary, solver, SolverWorkspace::Default());
+							break;
+
+						case MemorySpace::Test:
+							nbr::Factorize<MathDomain::Double>(A, auxiliary, solver);
+							break;
+
+						default:
+							throw NotImplementedException();
+					}
+					break;
+				}
+				case MathDomain::Int:
+				default:
+					throw NotImplementedException();
+			}
+		}
+
+		void SolveFactorized(const MemoryTile& A, const MemoryBuffer& auxiliary, MemoryTile& B, const MatrixOperation aOperation, const DenseSolverType solver)
+		{
+			CL_PROFILE(A, 2.0 * A.nRows * A.nRows * B.nCols, (1.0 * A.nRows * A.nCols + 2.0 * B.nRows * B.nCols) * A.ElementarySize());
+
+			switch (A.mathDomain)
+			{
+				case MathDomain::Float:
+				{
+					switch (A.memorySpace)
+					{
+						case MemorySpace::Mkl:
+							mkr::SolveFactorized<MathDomain::Float>(A, auxiliary, B, aOperation, solver, SolverWorkspace::Default());
+							break;
+						case MemorySpace::OpenBlas:
+							obr::SolveFactorized<MathDomain::Float>(A, auxiliary, B, aOperation, solver, SolverWorkspace::Default());
+							break;
+						case MemorySpace::GenericBlas:
+							gbr::SolveFactorized<MathDomain::Float>(A, auxiliary, B, aOperation, solver, SolverWorkspace::Default());
+							break;
+
+						case MemorySpace::Test:
+							nbr::SolveFactorized<MathDomain::Float>(A, auxiliary, B, aOperation, solver);
+							break;
+
+						default:
+							throw NotImplementedException();
+					}
+					break;
+				}
+				case MathDomain::Double:
+				{
+					switch (A.memorySpace)
+					{
+						case MemorySpace::Mkl:
+							mkr::SolveFactorized<MathDomain::Double>(A, auxiliary, B, aOperation, solver, SolverWorkspace::Default());
+							break;
+						case MemorySpace::OpenBlas:
+							obr::SolveFactorized<MathDomain::Double>(A, auxiliary, B, aOperation, solver, SolverWorkspace::Default());
+							break;
+						case MemorySpace::GenericBlas:
+							gbr::SolveFactorized<MathDomain::Double>(A, auxiliary, B, aOperation, solver, SolverWorkspace::Default());
+							break;
+
+						case MemorySpace::Test:
+							nbr::SolveFactorized<MathDomain::Double>(A, auxiliary, B, aOperation, solver);
 							break;
 
 						default:
@@ -1327,25 +2069,87 @@ namespace cl
 		}
 
 		/**
-		 * A = A^(-1) by means of LU factorization
+		 * A = A^(-1) by means of LU factorization, or in place with potri/sytri for Cholesky/Ldlt
 		 */
-		void Invert(MemoryTile& A, const MatrixOperation aOperation)
+		void Invert(MemoryTile& A, const MatrixOperation aOperation, const DenseSolverType solver)
 		{
-			MemoryTile eye(0, A.nRows, A.nRows, A.memorySpace, A.mathDomain);
-			Alloc(eye);
+			Invert(A, SolverWorkspace::Default(), aOperation, solver);
+		}
+
+		void Invert(MemoryTile& A, SolverWorkspace& workspace, const MatrixOperation aOperation, const DenseSolverType solver)
+		{
+			CL_PROFILE(A, 2.0 * A.nRows * A.nRows * A.nRows, 2.0 * A.nRows * A.nCols * A.ElementarySize());
+
+			switch (solver)
+			{
+				case DenseSolverType::Cholesky:
+				case DenseSolverType::Ldlt:
+				{
+					// A is symmetric, so is its inverse: aOperation is irrelevant
+					switch (A.mathDomain)
+					{
+						case MathDomain::Float:
+						{
+							switch (A.memorySpace)
+							{
+								case MemorySpace::Mkl:
+									mkr::InvertSymmetric<MathDomain::Float>(A, solver, workspace);
+									break;
+								case MemorySpace::OpenBlas:
+									obr::InvertSymmetric<MathDomain::Float>(A, solver, workspace);
+									break;
+								case MemorySpace::GenericBlas:
+									gbr::InvertSymmetric<MathDomain::Float>(A, solver, workspace);
+									break;
+
+								default:
+									throw NotImplementedException();
+							}
+							break;
+						}
+						case MathDomain::Double:
+						{
+							switch (A.memorySpace)
+							{
+								case MemorySpace::Mkl:
+									mkr::InvertSymmetric<MathDomain::Double>(A, solver, workspace);
+									break;
+								case MemorySpace::OpenBlas:
+									obr::InvertSymmetric<MathDomain::Double>(A, solver, workspace);
+									break;
+								case MemorySpace::GenericBlas:
+									gbr::InvertSymmetric<MathDomain::Double>(A, solver, workspace);
+									break;
+
+								default:
+									throw NotImplementedException();
+							}
+							break;
+						}
+						case MathDomain::Int:
+						default:
+							throw NotImplementedException();
+					}
+					return;
+				}
+				default:
+					break;
+			}
+
+			MemoryTile eye = workspace.GetRightHandSide(A.nRows, A.nRows, A.memorySpace, A.mathDomain);
 			Eye(eye);
 
 			// A^{-1} -> eye
-			Solve(A, eye, aOperation);
+			Solve(A, eye, workspace, aOperation, solver);
 
 			// eye -> A
 			Copy(A, eye);
-
-			Free(eye);
 		}
 
 		void ArgAbsMin(int& argMin, const MemoryBuffer& x)
 		{
+			CL_PROFILE(x, 1.0 * x.size, 1.0 * x.TotalSize());
+
 			switch (x.mathDomain)
 			{
 				case MathDomain::Float:
@@ -1362,16 +2166,7 @@ namespace cl
 						{
 							auto* xPtr = GetPointer<MathDomain::Float>(x);
 
-							auto min = std::fabs(xPtr[0]);
-							argMin = 0;
-							for (size_t i = 1; i < x.size; ++i)
-							{
-								if (std::fabs(xPtr[i]) < min)
-								{
-									min = std::fabs(xPtr[i]);
-									argMin = static_cast<int>(i);
-								}
-							}
+							argMin = ArgAbsExtremum<true>(xPtr, x.size);
 							break;
 						}
 						default:
@@ -1393,16 +2188,7 @@ namespace cl
 						{
 							auto* xPtr = GetPointer<MathDomain::Double>(x);
 
-							auto min = std::fabs(xPtr[0]);
-							argMin = 0;
-							for (size_t i = 1; i < x.size; ++i)
-							{
-								if (std::fabs(xPtr[i]) < min)
-								{
-									min = std::fabs(xPtr[i]);
-									argMin = static_cast<int>(i);
-								}
-							}
+							argMin = ArgAbsExtremum<true>(xPtr, x.size);
 							break;
 						}
 						default:
@@ -1421,16 +2207,7 @@ namespace cl
 						{
 							auto* xPtr = GetPointer<MathDomain::Int>(x);
 
-							auto min = std::fabs(xPtr[0]);
-							argMin = 0;
-							for (size_t i = 1; i < x.size; ++i)
-							{
-								if (std::fabs(xPtr[i]) < min)
-								{
-									min = std::fabs(xPtr[i]);
-									argMin = static_cast<int>(i);
-								}
-							}
+							argMin = ArgAbsExtremum<true>(xPtr, x.size);
 							break;
 						}
 						default:
@@ -1450,6 +2227,8 @@ namespace cl
 			assert(A.memorySpace == argMin.memorySpace);
 			assert(argMin.mathDomain == MathDomain::Int);
 
+			CL_PROFILE(A, 1.0 * A.nRows * A.nCols, 1.0 * A.nRows * A.nCols * A.ElementarySize());
+
 			switch (A.mathDomain)
 			{
 				case MathDomain::Float:
@@ -1466,13 +2245,15 @@ namespace cl
 						{
 							auto* argMinPtr = GetPointer<MathDomain::Int>(argMin);
 
-							MemoryBuffer tmp;
-							for (size_t j = 0; j < A.nCols; ++j)
-							{
-								ExtractColumnBufferFromMatrix(tmp, A, static_cast<unsigned>(j));
-								ArgAbsMin(argMinPtr[j], tmp);
-								++argMinPtr[j];	   // NB: for compatibility we have to return 1-based indices
-							}
+							detail::ParallelFor(A.nCols, detail::GetSliceGrainSize(A.nRows), [&](const size_t begin, const size_t end) {
+								MemoryBuffer tmp;
+								for (size_t j = begin; j < end; ++j)
+								{
+									ExtractColumnBufferFromMatrix(tmp, A, static_cast<unsigned>(j));
+									ArgAbsMin(argMinPtr[j], tmp);
+									++argMinPtr[j];	   // NB: for compatibility we have to return 1-based indices
+								}
+							});
 							break;
 						}
 						default:
@@ -1494,13 +2275,15 @@ namespace cl
 						{
 							auto* argMinPtr = GetPointer<MathDomain::Int>(argMin);
 
-							MemoryBuffer tmp;
-							for (size_t j = 0; j < A.nCols; ++j)
-							{
-								ExtractColumnBufferFromMatrix(tmp, A, static_cast<unsigned>(j));
-								ArgAbsMin(argMinPtr[j], tmp);
-								++argMinPtr[j];	   // NB: for compatibility we have to return 1-based indices
-							}
+							detail::ParallelFor(A.nCols, detail::GetSliceGrainSize(A.nRows), [&](const size_t begin, const size_t end) {
+								MemoryBuffer tmp;
+								for (size_t j = begin; j < end; ++j)
+								{
+									ExtractColumnBufferFromMatrix(tmp, A, static_cast<unsigned>(j));
+									ArgAbsMin(argMinPtr[j], tmp);
+									++argMinPtr[j];	   // NB: for compatibility we have to return 1-based indices
+								}
+							});
 							break;
 						}
 						default:
@@ -1519,13 +2302,15 @@ namespace cl
 						{
 							auto* argMinPtr = GetPointer<MathDomain::Int>(argMin);
 
-							MemoryBuffer tmp;
-							for (size_t j = 0; j < A.nCols; ++j)
-							{
-								ExtractColumnBufferFromMatrix(tmp, A, static_cast<unsigned>(j));
-								ArgAbsMin(argMinPtr[j], tmp);
-								++argMinPtr[j];	   // NB: for compatibility we have to return 1-based indices
-							}
+							detail::ParallelFor(A.nCols, detail::GetSliceGrainSize(A.nRows), [&](const size_t begin, const size_t end) {
+								MemoryBuffer tmp;
+								for (size_t j = begin; j < end; ++j)
+								{
+									ExtractColumnBufferFromMatrix(tmp, A, static_cast<unsigned>(j));
+									ArgAbsMin(argMinPtr[j], tmp);
+									++argMinPtr[j];	   // NB: for compatibility we have to return 1-based indices
+								}
+							});
 							break;
 						}
 						default:
@@ -1540,6 +2325,8 @@ namespace cl
 
 		void ArgAbsMax(int& argMax, const MemoryBuffer& x)
 		{
+			CL_PROFILE(x, 1.0 * x.size, 1.0 * x.TotalSize());
+
 			switch (x.mathDomain)
 			{
 				case MathDomain::Float:
@@ -1560,16 +2347,7 @@ namespace cl
 						{
 							auto* xPtr = GetPointer<MathDomain::Float>(x);
 
-							auto max = std::fabs(xPtr[0]);
-							argMax = 0;
-							for (size_t i = 1; i < x.size; ++i)
-							{
-								if (std::fabs(xPtr[i]) > max)
-								{
-									max = std::fabs(xPtr[i]);
-									argMax = static_cast<int>(i);
-								}
-							}
+							argMax = ArgAbsExtremum<false>(xPtr, x.size);
 							break;
 						}
 						default:
@@ -1595,16 +2373,7 @@ namespace cl
 						{
 							auto* xPtr = GetPointer<MathDomain::Double>(x);
 
-							auto max = std::fabs(xPtr[0]);
-							argMax = 0;
-							for (size_t i = 1; i < x.size; ++i)
-							{
-								if (std::fabs(xPtr[i]) > max)
-								{
-									max = std::fabs(xPtr[i]);
-									argMax = static_cast<int>(i);
-								}
-							}
+							argMax = ArgAbsExtremum<false>(xPtr, x.size);
 							break;
 						}
 						default:
@@ -1623,16 +2392,7 @@ namespace cl
 						{
 							auto* xPtr = GetPointer<MathDomain::Int>(x);
 
-							auto max = std::fabs(xPtr[0]);
-							argMax = 0;
-							for (size_t i = 1; i < x.size; ++i)
-							{
-								if (std::fabs(xPtr[i]) > max)
-								{
-									max = std::fabs(xPtr[i]);
-									argMax = static_cast<int>(i);
-								}
-							}
+							argMax = ArgAbsExtremum<false>(xPtr, x.size);
 							break;
 						}
 						default:
@@ -1652,6 +2412,8 @@ namespace cl
 			assert(A.memorySpace == argMax.memorySpace);
 			assert(argMax.mathDomain == MathDomain::Int);
 
+			CL_PROFILE(A, 1.0 * A.nRows * A.nCols, 1.0 * A.nRows * A.nCols * A.ElementarySize());
+
 			switch (A.mathDomain)
 			{
 				case MathDomain::Float:
@@ -1672,13 +2434,15 @@ namespace cl
 						{
 							auto* argMinPtr = GetPointer<MathDomain::Int>(argMax);
 
-							MemoryBuffer tmp;
-							for (size_t j = 0; j < A.nCols; ++j)
-							{
-								ExtractColumnBufferFromMatrix(tmp, A, static_cast<unsigned>(j));
-								ArgAbsMax(argMinPtr[j], tmp);
-								++argMinPtr[j];	   // NB: for compatibility we have to return 1-based indices
-							}
+							detail::ParallelFor(A.nCols, detail::GetSliceGrainSize(A.nRows), [&](const size_t begin, const size_t end) {
+								MemoryBuffer tmp;
+								for (size_t j = begin; j < end; ++j)
+								{
+									ExtractColumnBufferFromMatrix(tmp, A, static_cast<unsigned>(j));
+									ArgAbsMax(argMinPtr[j], tmp);
+									++argMinPtr[j];	   // NB: for compatibility we have to return 1-based indices
+								}
+							});
 							break;
 						}
 						default:
@@ -1704,13 +2468,15 @@ namespace cl
 						{
 							auto* argMinPtr = GetPointer<MathDomain::Int>(argMax);
 
-							MemoryBuffer tmp;
-							for (size_t j = 0; j < A.nCols; ++j)
-							{
-								ExtractColumnBufferFromMatrix(tmp, A, static_cast<unsigned>(j));
-								ArgAbsMax(argMinPtr[j], tmp);
-								++argMinPtr[j];	   // NB: for compatibility we have to return 1-based indices
-							}
+							detail::ParallelFor(A.nCols, detail::GetSliceGrainSize(A.nRows), [&](const size_t begin, const size_t end) {
+								MemoryBuffer tmp;
+								for (size_t j = begin; j < end; ++j)
+								{
+									ExtractColumnBufferFromMatrix(tmp, A, static_cast<unsigned>(j));
+									ArgAbsMax(argMinPtr[j], tmp);
+									++argMinPtr[j];	   // NB: for compatibility we have to return 1-based indices
+								}
+							});
 							break;
 						}
 						default:
@@ -1729,13 +2495,15 @@ namespace cl
 						{
 							auto* argMinPtr = GetPointer<MathDomain::Int>(argMax);
 
-							MemoryBuffer tmp;
-							for (size_t j = 0; j < A.nCols; ++j)
-							{
-								ExtractColumnBufferFromMatrix(tmp, A, static_cast<unsigned>(j));
-								ArgAbsMax(argMinPtr[j], tmp);
-								++argMinPtr[j];	   // NB: for compatibility we have to return 1-based indices
-							}
+							detail::ParallelFor(A.nCols, detail::GetSliceGrainSize(A.nRows), [&](const size_t begin, const size_t end) {
+								MemoryBuffer tmp;
+								for (size_t j = begin; j < end; ++j)
+								{
+									ExtractColumnBufferFromMatrix(tmp, A, static_cast<unsigned>(j));
+									ArgAbsMax(argMinPtr[j], tmp);
+									++argMinPtr[j];	   // NB: for compatibility we have to return 1-based indices
+								}
+							});
 							break;
 						}
 						default:
@@ -1755,6 +2523,8 @@ namespace cl
 			assert(z.mathDomain == x.mathDomain);
 			assert(z.size == x.size);
 
+			CL_PROFILE(z, 1.0 * z.size, 2.0 * z.TotalSize());
+
 			switch (z.mathDomain)
 			{
 				case MathDomain::Float:
@@ -1770,8 +2540,10 @@ namespace cl
 							auto* xPtr = GetPointer<MathDomain::Float>(x);
 
 							static constexpr float tolerance = 1e-7f;
-							for (size_t i = 0; i < z.size; ++i)
-								zPtr[i] = std::fabs(xPtr[i]) < tolerance ? 0.0f : 1.0f;
+							detail::ParallelFor(z.size, detail::elementWiseGrainSize, [&](const size_t begin, const size_t end) {
+								for (size_t i = begin; i < end; ++i)
+									zPtr[i] = std::fabs(xPtr[i]) < tolerance ? 0.0f : 1.0f;
+							});
 							break;
 						}
 						default:
@@ -1792,8 +2564,10 @@ namespace cl
 							auto* xPtr = GetPointer<MathDomain::Double>(x);
 
 							static constexpr double tolerance = 1e-7;
-							for (size_t i = 0; i < z.size; ++i)
-								zPtr[i] = std::fabs(xPtr[i]) < tolerance ? 0 : 1;
+							detail::ParallelFor(z.size, detail::elementWiseGrainSize, [&](const size_t begin, const size_t end) {
+								for (size_t i = begin; i < end; ++i)
+									zPtr[i] = std::fabs(xPtr[i]) < tolerance ? 0 : 1;
+							});
 							break;
 						}
 						default:
@@ -1813,8 +2587,10 @@ namespace cl
 							auto* zPtr = GetPointer<MathDomain::Int>(z);
 							auto* xPtr = GetPointer<MathDomain::Int>(x);
 
-							for (size_t i = 0; i < z.size; ++i)
-								zPtr[i] = xPtr[i] == 0 ? 0 : 1;
+							detail::ParallelFor(z.size, detail::elementWiseGrainSize, [&](const size_t begin, const size_t end) {
+								for (size_t i = begin; i < end; ++i)
+									zPtr[i] = xPtr[i] == 0 ? 0 : 1;
+							});
 							break;
 						}
 						default:
@@ -1830,6 +2606,8 @@ namespace cl
 		// norm = ||x||_2
 		void EuclideanNorm(double& norm, const MemoryBuffer& x)
 		{
+			CL_PROFILE(x, 2.0 * x.size, 1.0 * x.TotalSize());
+
 			switch (x.mathDomain)
 			{
 				case MathDomain::Float:
@@ -1850,10 +2628,7 @@ namespace cl
 						{
 							auto* xPtr = GetPointer<MathDomain::Float>(x);
 
-							norm = 0.0;
-							for (size_t i = 0; i < x.size; ++i)
-								norm += static_cast<double>(xPtr[i] * xPtr[i]);
-							norm = std::sqrt(norm);
+							norm = std::sqrt(Sum(x.size, [xPtr](const size_t i) { return static_cast<double>(xPtr[i] * xPtr[i]); }));
 							break;
 						}
 						default:
@@ -1878,11 +2653,94 @@ namespace cl
 							break;
 
 						case MemorySpace::Test:
-							norm = 0.0;
-							for (size_t i = 0; i < x.size; ++i)
-								norm += xPtr[i] * xPtr[i];
-							norm = std::sqrt(norm);
+							norm = std::sqrt(Sum(x.size, [xPtr](const size_t i) { return xPtr[i] * xPtr[i]; }));
+							break;
+						default:
+							throw NotImplementedException();
+					}
+					break;
+				}
+				case MathDomain::Int:
+				{
+					switch (x.memorySpace)
+					{
+						case MemorySpace::Test:
+						case MemorySpace::Mkl:			  // TODO
+						case MemorySpace::OpenBlas:		  // TODO
+						case MemorySpace::GenericBlas:	  // TODO
+						{
+							auto* xPtr = GetPointer<MathDomain::Int>(x);
+							norm = std::sqrt(Sum(x.size, [xPtr](const size_t i) { return static_cast<double>(xPtr[i] * xPtr[i]); }));
+							break;
+						}
+						default:
+							throw NotImplementedException();
+					}
+					break;
+				}
+				default:
+					throw NotImplementedException();
+			}
+		}
+
+		// result = x^T * y
+		void InnerProduct(double& result, const MemoryBuffer& x, const MemoryBuffer& y)
+		{
+			assert(x.memorySpace == y.memorySpace);
+			assert(x.mathDomain == y.mathDomain);
+			assert(x.size == y.size);
+
+			CL_PROFILE(x, 2.0 * x.size, 2.0 * x.TotalSize());
+
+			switch (x.mathDomain)
+			{
+				case MathDomain::Float:
+				{
+					switch (x.memorySpace)
+					{
+						case MemorySpace::Mkl:
+							mkr::InnerProduct<MathDomain::Float>(result, x, y);
+							break;
+						case MemorySpace::OpenBlas:
+							obr::InnerProduct<MathDomain::Float>(result, x, y);
+							break;
+						case MemorySpace::GenericBlas:
+							gbr::InnerProduct<MathDomain::Float>(result, x, y);
+							break;
+
+						case MemorySpace::Test:
+						{
+							auto* xPtr = GetPointer<MathDomain::Float>(x);
+							auto* yPtr = GetPointer<MathDomain::Float>(y);
+							result = Sum(x.size, [xPtr, yPtr](const size_t i) { return static_cast<double>(xPtr[i] * yPtr[i]); });
 							break;
+						}
+						default:
+							throw NotImplementedException();
+					}
+					break;
+				}
+				case MathDomain::Double:
+				{
+					switch (x.memorySpace)
+					{
+						case MemorySpace::Mkl:
+							mkr::InnerProduct<MathDomain::Double>(result, x, y);
+							break;
+						case MemorySpace::OpenBlas:
+							obr::InnerProduct<MathDomain::Double>(result, x, y);
+							break;
+						case MemorySpace::GenericBlas:
+							gbr::InnerProduct<MathDomain::Double>(result, x, y);
+							break;
+
+						case MemorySpace::Test:
+						{
+							auto* xPtr = GetPointer<MathDomain::Double>(x);
+							auto* yPtr = GetPointer<MathDomain::Double>(y);
+							result = Sum(x.size, [xPtr, yPtr](const size_t i) { return xPtr[i] * yPtr[i]; });
+							break;
+						}
 						default:
 							throw NotImplementedException();
 					}
@@ -1898,10 +2756,8 @@ namespace cl
 						case MemorySpace::GenericBlas:	  // TODO
 						{
 							auto* xPtr = GetPointer<MathDomain::Int>(x);
-							norm = 0.0;
-							for (size_t i = 0; i < x.size; ++i)
-								norm += static_cast<double>(xPtr[i] * xPtr[i]);
-							norm = std::sqrt(norm);
+							auto* yPtr = GetPointer<MathDomain::Int>(y);
+							result = Sum(x.size, [xPtr, yPtr](const size_t i) { return static_cast<double>(xPtr[i]) * static_cast<double>(yPtr[i]); });
 							break;
 						}
 						default:
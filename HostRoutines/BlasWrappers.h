@@ -1,5 +1,8 @@
 #pragma once
 
+#include <Activation.h>
+#include <DenseSolverType.h>
+#include <SolverWorkspace.h>
 #include <Types.h>
 
 namespace cl
@@ -51,6 +54,36 @@ namespace cl
 		 */
 		extern void ElementwiseDivision(MemoryBuffer& z, const MemoryBuffer& x, const MemoryBuffer& y, const double alpha = 1.0);
 
+		/**
+		 * y = exp(x), element by element: y and x can be the same buffer, as for the functions below
+		 */
+		extern void Exp(MemoryBuffer& y, const MemoryBuffer& x);
+
+		/**
+		 * y = log(x), element by element
+		 */
+		extern void Log(MemoryBuffer& y, const MemoryBuffer& x);
+
+		/**
+		 * y = sqrt(x), element by element
+		 */
+		extern void Sqrt(MemoryBuffer& y, const MemoryBuffer& x);
+
+		/**
+		 * y = x ^ exponent, element by element
+		 */
+		extern void Pow(MemoryBuffer& y, const MemoryBuffer& x, const double exponent);
+
+		/**
+		 * y = tanh(x), element by element
+		 */
+		extern void Tanh(MemoryBuffer& y, const MemoryBuffer& x);
+
+		/**
+		 * y = erf(x), element by element
+		 */
+		extern void Erf(MemoryBuffer& y, const MemoryBuffer& x);
+
 		/*
 		 *	A = alpha * B * C + beta * A
 		 */
@@ -61,6 +94,13 @@ namespace cl
 		 */
 		extern void SubMultiply(MemoryTile& A, const MemoryTile& B, const MemoryTile& C, const unsigned nRowsB, const unsigned nColsB, const unsigned nColsC, const MatrixOperation bOperation = MatrixOperation::None, const MatrixOperation cOperation = MatrixOperation::None, const double alpha = 1.0, const double beta = 0.0);
 
+		/**
+		 *	A = activation(alpha * B * C + beta * A + bias), bias being added to every column of A, unless it's null.
+		 *	The Test memory space applies bias and activation in the GEMM epilogue, the other ones in a single pass over A right after the GEMM.
+		 *	As in Multiply, the sizes of B and C are the ones of op(B) and op(C)
+		 */
+		extern void MultiplyFused(MemoryTile& A, const MemoryTile& B, const MemoryTile& C, const MemoryBuffer& bias, const ActivationType activation, const MatrixOperation bOperation = MatrixOperation::None, const MatrixOperation cOperation = MatrixOperation::None, const double alpha = 1.0, const double beta = 0.0);
+
 		/*
 		 *	A[i] = alpha * B[i] * C[i] + beta * A[i]
 		 */
@@ -84,10 +124,26 @@ namespace cl
 		extern void BatchedTransposedKroneckerProduct(MemoryCube& T, const MemoryTile& x, const MemoryTile& y, const double alpha = 1.0);
 
 		/**
-		 * A = cumsum(A)
+		 * A = cumsum(A), down each column: same as ColumnWiseCumulativeSum
 		 */
 		extern void CumulativeRowSum(MemoryTile& A);
 
+		/**
+		 * Prefix sums down each column, in place: A(i, j) = sum(A(0:i, j)), A(i, j) itself being left out when exclusive.
+		 * Linear time, with no temporaries: the columns are scanned concurrently, or split in chunks when there are fewer columns than threads
+		 */
+		extern void ColumnWiseCumulativeSum(MemoryTile& A, const bool exclusive = false);
+
+		/**
+		 * Prefix sums along each row, in place: A(i, j) = sum(A(i, 0:j)), A(i, j) itself being left out when exclusive
+		 */
+		extern void RowWiseCumulativeSum(MemoryTile& A, const bool exclusive = false);
+
+		/**
+		 * x = cumsum(x), x[i] itself being left out when exclusive
+		 */
+		extern void CumulativeSum(MemoryBuffer& x, const bool exclusive = false);
+
 		/**
 		 * x = sum(A[:, ])
 		 */
@@ -99,14 +155,37 @@ namespace cl
 		extern void CubeWiseSum(MemoryTile& A, const MemoryCube& T, MemoryCube& cacheReshape, MemoryBuffer& cacheOnes);
 
 		/**
-		 * X such that A * X = B by means of LU factorization
+		 * X such that A * X = B by means of LU/QR factorization, or Cholesky/LDL^T for symmetric A.
+		 * MixedPrecisionLu refines the solution of a float LU in double precision, and falls back to a double LU when A is too ill-conditioned for it
+		 */
+		extern void Solve(const MemoryTile& A, MemoryTile& B, const MatrixOperation aOperation = MatrixOperation::None, const DenseSolverType solver = DenseSolverType::Lu);
+
+		/**
+		 * Same as above, but the LAPACK temporaries are taken from the given workspace
 		 */
-		extern void Solve(const MemoryTile& A, MemoryTile& B, const MatrixOperation aOperation = MatrixOperation::None, const LinearSystemSolverType solver = LinearSystemSolverType::Lu);
+		extern void Solve(const MemoryTile& A, MemoryTile& B, SolverWorkspace& workspace, const MatrixOperation aOperation = MatrixOperation::None, const DenseSolverType solver = DenseSolverType::Lu);
 
 		/**
-		 * A = A^(-1) by means of LU factorization
+		 * Overwrites the square matrix A with its factorization, for solving many systems with the same A via SolveFactorized.
+		 * auxiliary holds the pivot indices for Lu/Ldlt (Int buffer of size A.nRows) or the Householder coefficients for Qr (size A.nRows, same math domain of A),
+		 * and it's not used by Cholesky. Throws FactorizationException if A is singular (or not positive definite for Cholesky)
 		 */
-		extern void Invert(MemoryTile& A, const MatrixOperation aOperation = MatrixOperation::None);
+		extern void Factorize(MemoryTile& A, MemoryBuffer& auxiliary, const DenseSolverType solver = DenseSolverType::Lu);
+
+		/**
+		 * X such that A * X = B, A and auxiliary being the output of Factorize: B is overwritten
+		 */
+		extern void SolveFactorized(const MemoryTile& A, const MemoryBuffer& auxiliary, MemoryTile& B, const MatrixOperation aOperation = MatrixOperation::None, const DenseSolverType solver = DenseSolverType::Lu);
+
+		/**
+		 * A = A^(-1) by means of LU factorization, or in place with potri/sytri for Cholesky/Ldlt
+		 */
+		extern void Invert(MemoryTile& A, const MatrixOperation aOperation = MatrixOperation::None, const DenseSolverType solver = DenseSolverType::Lu);
+
+		/**
+		 * Same as above, but the LAPACK temporaries are taken from the given workspace
+		 */
+		extern void Invert(MemoryTile& A, SolverWorkspace& workspace, const MatrixOperation aOperation = MatrixOperation::None, const DenseSolverType solver = DenseSolverType::Lu);
 
 		extern void ArgAbsMin(int& argMin, const MemoryBuffer& x);
 
@@ -123,5 +202,8 @@ namespace cl
 
 		// norm = ||x||_2
 		extern void EuclideanNorm(double& norm, const MemoryBuffer& x);
+
+		// result = x^T * y
+		extern void InnerProduct(double& result, const MemoryBuffer& x, const MemoryBuffer& y);
 	}	 // namespace routines
 }	 // namespace cl
@@ -4,6 +4,8 @@
 #include <Exceptions.h>
 
 #include "MklAllWrappers.h"
+#include <Parallel.h>
+#include <Philox.h>
 #include <algorithm>
 #include <cstring>
 #include <functional>
@@ -94,7 +96,7 @@ namespace cl
 						{
 							auto* ptr = GetPointer<MathDomain::Float>(buf);
 
-							std::fill(ptr, ptr + buf.size, value);
+							detail::ParallelFor(buf.size, detail::elementWiseGrainSize, [&](const size_t begin, const size_t end) { std::fill(ptr + begin, ptr + end, value); });
 							break;
 						}
 						default:
@@ -113,7 +115,7 @@ namespace cl
 						{
 							auto* ptr = GetPointer<MathDomain::Double>(buf);
 
-							std::fill(ptr, ptr + buf.size, value);
+							detail::ParallelFor(buf.size, detail::elementWiseGrainSize, [&](const size_t begin, const size_t end) { std::fill(ptr + begin, ptr + end, value); });
 							break;
 						}
 						default:
@@ -132,7 +134,7 @@ namespace cl
 						{
 							auto* ptr = GetPointer<MathDomain::Int>(buf);
 
-							std::fill(ptr, ptr + buf.size, value);
+							detail::ParallelFor(buf.size, detail::elementWiseGrainSize, [&](const size_t begin, const size_t end) { std::fill(ptr + begin, ptr + end, value); });
 							break;
 						}
 						default:
@@ -160,7 +162,7 @@ namespace cl
 						{
 							auto* ptr = GetPointer<MathDomain::Float>(buf);
 
-							std::transform(ptr, ptr + buf.size, ptr, std::bind1st(std::divides<float>(), 1.0f));
+							detail::ParallelFor(buf.size, detail::elementWiseGrainSize, [&](const size_t begin, const size_t end) { std::transform(ptr + begin, ptr + end, ptr + begin, std::bind1st(std::divides<float>(), 1.0f)); });
 							break;
 						}
 						default:
@@ -179,7 +181,7 @@ namespace cl
 						{
 							auto* ptr = GetPointer<MathDomain::Double>(buf);
 
-							std::transform(ptr, ptr + buf.size, ptr, std::bind1st(std::divides<double>(), 1.0));
+							detail::ParallelFor(buf.size, detail::elementWiseGrainSize, [&](const size_t begin, const size_t end) { std::transform(ptr + begin, ptr + end, ptr + begin, std::bind1st(std::divides<double>(), 1.0)); });
 							break;
 						}
 						default:
@@ -198,7 +200,7 @@ namespace cl
 						{
 							auto* ptr = GetPointer<MathDomain::Int>(buf);
 
-							std::transform(ptr, ptr + buf.size, ptr, std::bind1st(std::divides<int>(), 1));
+							detail::ParallelFor(buf.size, detail::elementWiseGrainSize, [&](const size_t begin, const size_t end) { std::transform(ptr + begin, ptr + end, ptr + begin, std::bind1st(std::divides<int>(), 1)); });
 							break;
 						}
 						default:
@@ -215,9 +217,10 @@ namespace cl
 		{
 			const auto linspaceWorker = [&](auto* begin, auto* end, auto val) {
 				auto dx = (x1 - x0) / static_cast<double>(buf.size - 1);
-				size_t i = 0;
-				for (auto* iter = begin; iter != end; ++iter, ++i)
-					*iter = static_cast<decltype(val)>(x0 + static_cast<double>(i) * dx);
+				detail::ParallelFor(static_cast<size_t>(end - begin), detail::elementWiseGrainSize, [&](const size_t chunkBegin, const size_t chunkEnd) {
+					for (size_t i = chunkBegin; i < chunkEnd; ++i)
+						begin[i] = static_cast<decltype(val)>(x0 + static_cast<double>(i) * dx);
+				});
 			};
 			switch (buf.mathDomain)
 			{
@@ -296,18 +299,11 @@ namespace cl
 							break;
 
 						case MemorySpace::Test:
-						case MemorySpace::OpenBlas:	   // TODO
+						case MemorySpace::OpenBlas:
 						case MemorySpace::GenericBlas:
 						{
 							auto* ptr = GetPointer<MathDomain::Float>(buf);
-							std::random_device randomDevice;
-							std::mt19937 mersenneEngine { randomDevice() };
-							mersenneEngine.seed(seed);
-
-							std::uniform_real_distribution<float> uniformDistribution { 0.0f, 1.0f };
-							auto generator = [&uniformDistribution, &mersenneEngine]() { return uniformDistribution(mersenneEngine); };
-
-							std::generate(ptr, ptr + buf.size, generator);
+							philox::FillUniform(ptr, buf.size, seed);
 							break;
 						}
 						default:
@@ -324,19 +320,11 @@ namespace cl
 							break;
 
 						case MemorySpace::Test:
-						case MemorySpace::OpenBlas:	   // TODO
+						case MemorySpace::OpenBlas:
 						case MemorySpace::GenericBlas:
 						{
 							auto* ptr = GetPointer<MathDomain::Double>(buf);
-
-							std::random_device randomDevice;
-							std::mt19937 mersenneEngine { randomDevice() };
-							mersenneEngine.seed(seed);
-
-							std::uniform_real_distribution<double> uniformDistribution { 0.0, 1.0 };
-							auto generator = [&uniformDistribution, &mersenneEngine]() { return uniformDistribution(mersenneEngine); };
-
-							std::generate(ptr, ptr + buf.size, generator);
+							philox::FillUniform(ptr, buf.size, seed);
 							break;
 						}
 						default:
@@ -363,19 +351,11 @@ namespace cl
 							break;
 
 						case MemorySpace::Test:
-						case MemorySpace::OpenBlas:	   // TODO
+						case MemorySpace::OpenBlas:
 						case MemorySpace::GenericBlas:
 						{
 							auto* ptr = GetPointer<MathDomain::Float>(buf);
-
-							std::random_device randomDevice;
-							std::mt19937 mersenneEngine { randomDevice() };
-							mersenneEngine.seed(seed);
-
-							std::normal_distribution<float> normalDistribution { 0.0f, 1.0f };
-							auto generator = [&normalDistribution, &mersenneEngine]() { return normalDistribution(mersenneEngine); };
-
-							std::generate(ptr, ptr + buf.size, generator);
+							philox::FillNormal(ptr, buf.size, seed);
 							break;
 						}
 						default:
@@ -392,19 +372,11 @@ namespace cl
 							break;
 
 						case MemorySpace::Test:
-						case MemorySpace::OpenBlas:	   // TODO
+						case MemorySpace::OpenBlas:
 						case MemorySpace::GenericBlas:
 						{
 							auto* ptr = GetPointer<MathDomain::Double>(buf);
-
-							std::random_device randomDevice;
-							std::mt19937 mersenneEngine { randomDevice() };
-							mersenneEngine.seed(seed);
-
-							std::normal_distribution<double> normalDistribution { 0.0, 1.0 };
-							auto generator = [&normalDistribution, &mersenneEngine]() { return normalDistribution(mersenneEngine); };
-
-							std::generate(ptr, ptr + buf.size, generator);
+							philox::FillNormal(ptr, buf.size, seed);
 							break;
 						}
 						default:
@@ -510,11 +482,13 @@ namespace cl
 							auto* ptr = GetPointer<MathDomain::Float>(buf);
 
 							Zero(buf);
-							for (size_t i = 0; i < buf.nRows; ++i)
-							{
-								for (size_t j = i; j < buf.nCols; ++j)
-									ptr[i + j * buf.nRows] = 1.0f;
-							}
+							detail::ParallelFor(buf.nRows, detail::GetSliceGrainSize(buf.nCols), [&](const size_t begin, const size_t end) {
+								for (size_t i = begin; i < end; ++i)
+								{
+									for (size_t j = i; j < buf.nCols; ++j)
+										ptr[i + j * buf.nRows] = 1.0f;
+								}
+							});
 							break;
 						}
 						default:
@@ -534,11 +508,13 @@ namespace cl
 							auto* ptr = GetPointer<MathDomain::Double>(buf);
 
 							Zero(buf);
-							for (size_t i = 0; i < buf.nRows; ++i)
-							{
-								for (size_t j = i; j < buf.nCols; ++j)
-									ptr[j + i * buf.nRows] = 1.0;
-							}
+							detail::ParallelFor(buf.nRows, detail::GetSliceGrainSize(buf.nCols), [&](const size_t begin, const size_t end) {
+								for (size_t i = begin; i < end; ++i)
+								{
+									for (size_t j = i; j < buf.nCols; ++j)
+										ptr[j + i * buf.nRows] = 1.0;
+								}
+							});
 							break;
 						}
 						default:
@@ -558,11 +534,13 @@ namespace cl
 							auto* ptr = GetPointer<MathDomain::Int>(buf);
 
 							Zero(buf);
-							for (size_t i = 0; i < buf.nRows; ++i)
-							{
-								for (size_t j = i; j < buf.nCols; ++j)
-									ptr[j + i * buf.nRows] = 1;
-							}
+							detail::ParallelFor(buf.nRows, detail::GetSliceGrainSize(buf.nCols), [&](const size_t begin, const size_t end) {
+								for (size_t i = begin; i < end; ++i)
+								{
+									for (size_t j = i; j < buf.nCols; ++j)
+										ptr[j + i * buf.nRows] = 1;
+								}
+							});
 							break;
 						}
 						default:
@@ -590,9 +568,7 @@ namespace cl
 						{
 							auto* ptr = GetPointer<MathDomain::Float>(buf);
 
-							std::random_device randomDevice;
-							std::mt19937 mersenneEngine { randomDevice() };
-							mersenneEngine.seed(seed);
+							std::mt19937 mersenneEngine { seed };
 
 							std::shuffle(ptr, ptr + buf.size, mersenneEngine);
 							break;
@@ -613,9 +589,7 @@ namespace cl
 						{
 							auto* ptr = GetPointer<MathDomain::Double>(buf);
 
-							std::random_device randomDevice;
-							std::mt19937 mersenneEngine { randomDevice() };
-							mersenneEngine.seed(seed);
+							std::mt19937 mersenneEngine { seed };
 
 							std::shuffle(ptr, ptr + buf.size, mersenneEngine);
 							break;
@@ -636,9 +610,7 @@ namespace cl
 						{
 							auto* ptr = GetPointer<MathDomain::Int>(buf);
 
-							std::random_device randomDevice;
-							std::mt19937 mersenneEngine { randomDevice() };
-							mersenneEngine.seed(seed);
+							std::mt19937 mersenneEngine { seed };
 
 							std::shuffle(ptr, ptr + buf.size, mersenneEngine);
 							break;
@@ -686,15 +658,13 @@ namespace cl
 						{
 							auto* ptr = GetPointer<MathDomain::Float>(buf);
 
-							std::random_device randomDevice;
-							std::mt19937 mersenneEngine { randomDevice() };
-							mersenneEngine.seed(seed);
+							std::mt19937 mersenneEngine { seed };
 
 							// Fisher-Yates
 							for (int j = static_cast<int>(buf.nCols) - 1; j > 0; j--)
 							{
-								// Pick a random index from 0 to i
-								std::uniform_int_distribution<int> uniformDistribution { 0, j + 1 };
+								// Pick a random index from 0 to j
+								std::uniform_int_distribution<int> uniformDistribution { 0, j };
 
 								const auto k = uniformDistribution(mersenneEngine);
 
@@ -721,15 +691,13 @@ namespace cl
 						{
 							auto* ptr = GetPointer<MathDomain::Double>(buf);
 
-							std::random_device randomDevice;
-							std::mt19937 mersenneEngine { randomDevice() };
-							mersenneEngine.seed(seed);
+							std::mt19937 mersenneEngine { seed };
 
 							// Fisher-Yates
 							for (int j = static_cast<int>(buf.nCols) - 1; j > 0; j--)
 							{
-								// Pick a random index from 0 to i
-								std::uniform_int_distribution<int> uniformDistribution { 0, j + 1 };
+								// Pick a random index from 0 to j
+								std::uniform_int_distribution<int> uniformDistribution { 0, j };
 
 								const auto k = uniformDistribution(mersenneEngine);
 
@@ -756,15 +724,13 @@ namespace cl
 						{
 							auto* ptr = GetPointer<MathDomain::Int>(buf);
 
-							std::random_device randomDevice;
-							std::mt19937 mersenneEngine { randomDevice() };
-							mersenneEngine.seed(seed);
+							std::mt19937 mersenneEngine { seed };
 
 							// Fisher-Yates
 							for (int j = static_cast<int>(buf.nCols) - 1; j > 0; j--)
 							{
-								// Pick a random index from 0 to i
-								std::uniform_int_distribution<int> uniformDistribution { 0, j + 1 };
+								// Pick a random index from 0 to j
+								std::uniform_int_distribution<int> uniformDistribution { 0, j };
 
 								const auto k = uniformDistribution(mersenneEngine);
 
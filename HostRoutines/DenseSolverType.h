@@ -0,0 +1,19 @@
+#pragma once
+
+namespace cl
+{
+	/**
+	 * Factorizations used for solving dense linear systems. Lu and Qr are the ones LinearSystemSolverType has for the device kernels,
+	 * the others are only supported by the host BLAS memory spaces:
+	 *  - Cholesky and Ldlt assume A symmetric, and only read its lower triangular part
+	 *  - MixedPrecisionLu factorizes a float copy of a double A and refines the solution in double precision
+	 */
+	enum class DenseSolverType
+	{
+		Lu,
+		Qr,
+		Cholesky,
+		Ldlt,
+		MixedPrecisionLu
+	};
+}	 // namespace cl
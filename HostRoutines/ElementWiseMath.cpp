@@ -0,0 +1,402 @@
+#include <ElementWiseMath.h>
+
+#include <Parallel.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+	// kernels are compiled for every instruction set, and picked at runtime: no need for -mavx2/-mfma
+	#define CL_X86_DISPATCH
+	#define CL_TARGET_AVX2 __attribute__((target("avx2,fma")))
+	#include <immintrin.h>
+#endif
+
+namespace cl
+{
+	namespace routines
+	{
+		namespace elementwise
+		{
+			namespace
+			{
+				// integer exponents up to this are computed by repeated squaring, which is more accurate than exp(exponent * log(x))
+				constexpr double maxSquaringExponent = { 64.0 };
+
+				enum class InstructionSet
+				{
+					Scalar,
+					Avx2
+				};
+
+				InstructionSet DetectInstructionSet() noexcept
+				{
+#ifdef CL_X86_DISPATCH
+					__builtin_cpu_init();
+					if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+						return InstructionSet::Avx2;
+#endif
+					return InstructionSet::Scalar;
+				}
+
+				InstructionSet GetInstructionSetType() noexcept
+				{
+					static const InstructionSet instructionSet = DetectInstructionSet();
+					return instructionSet;
+				}
+
+				inline bool IsInteger(const double x) noexcept { return std::floor(x) == x; }
+
+#pragma region Scalar
+
+				template<typename T>
+				void ApplyScalar(T* y, const T* x, const size_t size, const ElementWiseFunction function, const double exponent) noexcept
+				{
+					switch (function)
+					{
+						case ElementWiseFunction::Exp:
+							for (size_t i = 0; i < size; ++i)
+								y[i] = std::exp(x[i]);
+							break;
+						case ElementWiseFunction::Log:
+							for (size_t i = 0; i < size; ++i)
+								y[i] = std::log(x[i]);
+							break;
+						case ElementWiseFunction::Sqrt:
+							for (size_t i = 0; i < size; ++i)
+								y[i] = std::sqrt(x[i]);
+							break;
+						case ElementWiseFunction::Pow:
+							for (size_t i = 0; i < size; ++i)
+								y[i] = std::pow(x[i], static_cast<T>(exponent));
+							break;
+						case ElementWiseFunction::Tanh:
+							for (size_t i = 0; i < size; ++i)
+								y[i] = std::tanh(x[i]);
+							break;
+						case ElementWiseFunction::Erf:
+							for (size_t i = 0; i < size; ++i)
+								y[i] = std::erf(x[i]);
+							break;
+						default:
+							break;
+					}
+				}
+
+#pragma endregion
+
+#ifdef CL_X86_DISPATCH
+
+#pragma region Avx2
+
+				/**
+				 * Cephes' expf: x = n * log(2) + r, with |r| <= log(2) / 2, and exp(r) is a degree 7 polynomial
+				 */
+				CL_TARGET_AVX2 inline __m256 ExpAvx2(const __m256 x) noexcept
+				{
+					// exp overflows above log(FLT_MAX), and underflows below log of the smallest denormal
+					const __m256 maxX = _mm256_set1_ps(88.72283935546875f);
+					const __m256 minX = _mm256_set1_ps(-103.97208404541015625f);
+					const __m256 overflow = _mm256_cmp_ps(x, maxX, _CMP_GT_OQ);
+					const __m256 underflow = _mm256_cmp_ps(x, minX, _CMP_LT_OQ);
+
+					// min/max return their second operand when either is NaN, so NaNs propagate
+					const __m256 xc = _mm256_max_ps(minX, _mm256_min_ps(maxX, x));
+
+					// log(2) is split in two, so that r is exact
+					const __m256 n = _mm256_round_ps(_mm256_mul_ps(xc, _mm256_set1_ps(1.44269504088896341f)), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+					__m256 r = _mm256_fnmadd_ps(n, _mm256_set1_ps(0.693359375f), xc);
+					r = _mm256_fnmadd_ps(n, _mm256_set1_ps(-2.12194440e-4f), r);
+
+					__m256 p = _mm256_set1_ps(1.9875691500e-4f);
+					p = _mm256_fmadd_ps(p, r, _mm256_set1_ps(1.3981999507e-3f));
+					p = _mm256_fmadd_ps(p, r, _mm256_set1_ps(8.3334519073e-3f));
+					p = _mm256_fmadd_ps(p, r, _mm256_set1_ps(4.1665795894e-2f));
+					p = _mm256_fmadd_ps(p, r, _mm256_set1_ps(1.6666665459e-1f));
+					p = _mm256_fmadd_ps(p, r, _mm256_set1_ps(5.0000001201e-1f));
+					p = _mm256_fmadd_ps(p, _mm256_mul_ps(r, r), r);
+					p = _mm256_add_ps(p, _mm256_set1_ps(1.0f));
+
+					// 2^n is applied as 2^(n / 2) * 2^(n - n / 2), as n can be outside of the range of normal exponents
+					const __m256i ni = _mm256_cvtps_epi32(n);
+					const __m256i n1 = _mm256_srai_epi32(ni, 1);
+					const __m256i n2 = _mm256_sub_epi32(ni, n1);
+					const __m256i bias = _mm256_set1_epi32(127);
+					const __m256 scale1 = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_add_epi32(n1, bias), 23));
+					const __m256 scale2 = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_add_epi32(n2, bias), 23));
+
+					__m256 ret = _mm256_mul_ps(_mm256_mul_ps(p, scale1), scale2);
+					ret = _mm256_blendv_ps(ret, _mm256_set1_ps(std::numeric_limits<float>::infinity()), overflow);
+					return _mm256_blendv_ps(ret, _mm256_setzero_ps(), underflow);
+				}
+
+				/**
+				 * Cephes' logf: x = 2^e * m, with m in [sqrt(2) / 2, sqrt(2)), and log(m) is a degree 10 polynomial in m - 1
+				 */
+				CL_TARGET_AVX2 inline __m256 LogAvx2(const __m256 x) noexcept
+				{
+					const __m256 one = _mm256_set1_ps(1.0f);
+
+					// denormals are normalized first
+					const __m256 denormal = _mm256_cmp_ps(x, _mm256_set1_ps(std::numeric_limits<float>::min()), _CMP_LT_OQ);
+					const __m256i xi = _mm256_castps_si256(_mm256_blendv_ps(x, _mm256_mul_ps(x, _mm256_set1_ps(8388608.0f)), denormal));
+
+					__m256 e = _mm256_cvtepi32_ps(_mm256_sub_epi32(_mm256_srli_epi32(xi, 23), _mm256_set1_epi32(126)));
+					e = _mm256_sub_ps(e, _mm256_and_ps(denormal, _mm256_set1_ps(23.0f)));
+
+					// m in [0.5, 1)
+					__m256 m = _mm256_castsi256_ps(_mm256_or_si256(_mm256_and_si256(xi, _mm256_set1_epi32(0x007FFFFF)), _mm256_set1_epi32(0x3F000000)));
+					const __m256 small = _mm256_cmp_ps(m, _mm256_set1_ps(0.707106781186547524f), _CMP_LT_OQ);
+					e = _mm256_sub_ps(e, _mm256_and_ps(small, one));
+					m = _mm256_add_ps(_mm256_sub_ps(m, one), _mm256_and_ps(small, m));
+
+					const __m256 z = _mm256_mul_ps(m, m);
+					__m256 p = _mm256_set1_ps(7.0376836292e-2f);
+					p = _mm256_fmadd_ps(p, m, _mm256_set1_ps(-1.1514610310e-1f));
+					p = _mm256_fmadd_ps(p, m, _mm256_set1_ps(1.1676998740e-1f));
+					p = _mm256_fmadd_ps(p, m, _mm256_set1_ps(-1.2420140846e-1f));
+					p = _mm256_fmadd_ps(p, m, _mm256_set1_ps(1.4249322787e-1f));
+					p = _mm256_fmadd_ps(p, m, _mm256_set1_ps(-1.6668057665e-1f));
+					p = _mm256_fmadd_ps(p, m, _mm256_set1_ps(2.0000714765e-1f));
+					p = _mm256_fmadd_ps(p, m, _mm256_set1_ps(-2.4999993993e-1f));
+					p = _mm256_fmadd_ps(p, m, _mm256_set1_ps(3.3333331174e-1f));
+
+					__m256 ret = _mm256_mul_ps(_mm256_mul_ps(p, m), z);
+					ret = _mm256_fmadd_ps(e, _mm256_set1_ps(-2.12194440e-4f), ret);
+					ret = _mm256_fnmadd_ps(z, _mm256_set1_ps(0.5f), ret);
+					ret = _mm256_add_ps(m, ret);
+					ret = _mm256_fmadd_ps(e, _mm256_set1_ps(0.693359375f), ret);
+
+					const __m256 infinity = _mm256_set1_ps(std::numeric_limits<float>::infinity());
+					ret = _mm256_blendv_ps(ret, _mm256_sub_ps(_mm256_setzero_ps(), infinity), _mm256_cmp_ps(x, _mm256_setzero_ps(), _CMP_EQ_OQ));
+					ret = _mm256_blendv_ps(ret, infinity, _mm256_cmp_ps(x, infinity, _CMP_EQ_OQ));
+
+					// negative numbers and NaNs
+					return _mm256_blendv_ps(ret, _mm256_set1_ps(std::numeric_limits<float>::quiet_NaN()), _mm256_cmp_ps(x, _mm256_setzero_ps(), _CMP_NGE_UQ));
+				}
+
+				/**
+				 * Cephes' tanhf: an odd polynomial for |x| < 0.625, where 1 - 2 / (exp(2|x|) + 1) would lose digits to cancellation
+				 */
+				CL_TARGET_AVX2 inline __m256 TanhAvx2(const __m256 x) noexcept
+				{
+					const __m256 one = _mm256_set1_ps(1.0f);
+					const __m256 signMask = _mm256_set1_ps(-0.0f);
+					const __m256 absX = _mm256_andnot_ps(signMask, x);
+
+					const __m256 z = _mm256_mul_ps(x, x);
+					__m256 p = _mm256_set1_ps(-5.70498872745e-3f);
+					p = _mm256_fmadd_ps(p, z, _mm256_set1_ps(2.06390887954e-2f));
+					p = _mm256_fmadd_ps(p, z, _mm256_set1_ps(-5.37397155531e-2f));
+					p = _mm256_fmadd_ps(p, z, _mm256_set1_ps(1.33314422036e-1f));
+					p = _mm256_fmadd_ps(p, z, _mm256_set1_ps(-3.33332819422e-1f));
+					const __m256 small = _mm256_fmadd_ps(_mm256_mul_ps(p, z), x, x);
+
+					__m256 large = _mm256_sub_ps(one, _mm256_div_ps(_mm256_set1_ps(2.0f), _mm256_add_ps(ExpAvx2(_mm256_add_ps(absX, absX)), one)));
+					large = _mm256_or_ps(large, _mm256_and_ps(x, signMask));
+
+					return _mm256_blendv_ps(large, small, _mm256_cmp_ps(absX, _mm256_set1_ps(0.625f), _CMP_LT_OQ));
+				}
+
+				/**
+				 * Maclaurin series for |x| < 0.5, elsewhere Abramowitz and Stegun 7.1.26, whose absolute error is below 1.5e-7
+				 */
+				CL_TARGET_AVX2 inline __m256 ErfAvx2(const __m256 x) noexcept
+				{
+					const __m256 one = _mm256_set1_ps(1.0f);
+					const __m256 signMask = _mm256_set1_ps(-0.0f);
+					const __m256 absX = _mm256_andnot_ps(signMask, x);
+					const __m256 z = _mm256_mul_ps(x, x);
+
+					// 2 / sqrt(pi) * (-1)^n / (n! * (2n + 1))
+					__m256 p = _mm256_set1_ps(1.2055332981789664e-4f);
+					p = _mm256_fmadd_ps(p, z, _mm256_set1_ps(-8.548327023450853e-4f));
+					p = _mm256_fmadd_ps(p, z, _mm256_set1_ps(5.223977625442188e-3f));
+					p = _mm256_fmadd_ps(p, z, _mm256_set1_ps(-2.6866170645131252e-2f));
+					p = _mm256_fmadd_ps(p, z, _mm256_set1_ps(1.1283791670955126e-1f));
+					p = _mm256_fmadd_ps(p, z, _mm256_set1_ps(-3.7612638903183754e-1f));
+					p = _mm256_fmadd_ps(p, z, _mm256_set1_ps(1.1283791670955126f));
+					const __m256 small = _mm256_mul_ps(p, x);
+
+					const __m256 t = _mm256_div_ps(one, _mm256_fmadd_ps(_mm256_set1_ps(0.3275911f), absX, one));
+					__m256 q = _mm256_set1_ps(1.061405429f);
+					q = _mm256_fmadd_ps(q, t, _mm256_set1_ps(-1.453152027f));
+					q = _mm256_fmadd_ps(q, t, _mm256_set1_ps(1.421413741f));
+					q = _mm256_fmadd_ps(q, t, _mm256_set1_ps(-0.284496736f));
+					q = _mm256_fmadd_ps(q, t, _mm256_set1_ps(0.254829592f));
+					q = _mm256_mul_ps(q, t);
+
+					__m256 large = _mm256_fnmadd_ps(q, ExpAvx2(_mm256_sub_ps(_mm256_setzero_ps(), z)), one);
+					large = _mm256_or_ps(large, _mm256_and_ps(x, signMask));
+
+					return _mm256_blendv_ps(large, small, _mm256_cmp_ps(absX, _mm256_set1_ps(0.5f), _CMP_LT_OQ));
+				}
+
+				/**
+				 * Small integer exponents by repeated squaring, the others as exp(exponent * log|x|): negative numbers have a real power
+				 * only for integer exponents, whose parity gives the sign
+				 */
+				CL_TARGET_AVX2 inline __m256 PowAvx2(const __m256 x, const double exponent) noexcept
+				{
+					const bool isInteger = IsInteger(exponent);
+					if (isInteger && std::fabs(exponent) <= maxSquaringExponent)
+					{
+						__m256 ret = _mm256_set1_ps(1.0f);
+						__m256 base = x;
+						for (auto n = static_cast<unsigned>(std::fabs(exponent)); n > 0; n >>= 1)
+						{
+							if (n & 1)
+								ret = _mm256_mul_ps(ret, base);
+							base = _mm256_mul_ps(base, base);
+						}
+
+						return exponent < 0.0 ? _mm256_div_ps(_mm256_set1_ps(1.0f), ret) : ret;
+					}
+
+					const __m256 signMask = _mm256_set1_ps(-0.0f);
+					const __m256 ret = ExpAvx2(_mm256_mul_ps(_mm256_set1_ps(static_cast<float>(exponent)), LogAvx2(_mm256_andnot_ps(signMask, x))));
+					if (!isInteger)
+						return _mm256_blendv_ps(ret, _mm256_set1_ps(std::numeric_limits<float>::quiet_NaN()), _mm256_cmp_ps(x, _mm256_setzero_ps(), _CMP_LT_OQ));
+					if (std::fmod(exponent, 2.0) != 0.0)
+						return _mm256_or_ps(ret, _mm256_and_ps(x, signMask));
+
+					return ret;
+				}
+
+				template<ElementWiseFunction function>
+				CL_TARGET_AVX2 inline __m256 EvaluateAvx2(const __m256 x, const double exponent) noexcept
+				{
+					switch (function)
+					{
+						case ElementWiseFunction::Exp:
+							return ExpAvx2(x);
+						case ElementWiseFunction::Log:
+							return LogAvx2(x);
+						case ElementWiseFunction::Pow:
+							return PowAvx2(x, exponent);
+						case ElementWiseFunction::Tanh:
+							return TanhAvx2(x);
+						case ElementWiseFunction::Erf:
+							return ErfAvx2(x);
+						default:
+							return _mm256_sqrt_ps(x);
+					}
+				}
+
+				template<ElementWiseFunction function>
+				CL_TARGET_AVX2 void ApplyAvx2(float* y, const float* x, const size_t size, const double exponent) noexcept
+				{
+					size_t i = 0;
+					for (; i + 8 <= size; i += 8)
+						_mm256_storeu_ps(y + i, EvaluateAvx2<function>(_mm256_loadu_ps(x + i), exponent));
+
+					// the tail goes through the same approximation, so that results don't depend on where the chunks start
+					if (i < size)
+					{
+						alignas(32) float tail[8] = { 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f };
+						std::copy(x + i, x + size, tail);
+						_mm256_store_ps(tail, EvaluateAvx2<function>(_mm256_load_ps(tail), exponent));
+						std::copy(tail, tail + (size - i), y + i);
+					}
+				}
+
+				CL_TARGET_AVX2 void ApplyAvx2(float* y, const float* x, const size_t size, const ElementWiseFunction function, const double exponent) noexcept
+				{
+					switch (function)
+					{
+						case ElementWiseFunction::Exp:
+							ApplyAvx2<ElementWiseFunction::Exp>(y, x, size, exponent);
+							break;
+						case ElementWiseFunction::Log:
+							ApplyAvx2<ElementWiseFunction::Log>(y, x, size, exponent);
+							break;
+						case ElementWiseFunction::Sqrt:
+							ApplyAvx2<ElementWiseFunction::Sqrt>(y, x, size, exponent);
+							break;
+						case ElementWiseFunction::Pow:
+							ApplyAvx2<ElementWiseFunction::Pow>(y, x, size, exponent);
+							break;
+						case ElementWiseFunction::Tanh:
+							ApplyAvx2<ElementWiseFunction::Tanh>(y, x, size, exponent);
+							break;
+						case ElementWiseFunction::Erf:
+							ApplyAvx2<ElementWiseFunction::Erf>(y, x, size, exponent);
+							break;
+						default:
+							break;
+					}
+				}
+
+				CL_TARGET_AVX2 void SqrtAvx2(double* y, const double* x, const size_t size) noexcept
+				{
+					size_t i = 0;
+					for (; i + 4 <= size; i += 4)
+						_mm256_storeu_pd(y + i, _mm256_sqrt_pd(_mm256_loadu_pd(x + i)));
+					for (; i < size; ++i)
+						y[i] = std::sqrt(x[i]);
+				}
+
+#pragma endregion
+
+#endif
+
+#pragma region Dispatch
+
+				void ApplyKernel(float* y, const float* x, const size_t size, const ElementWiseFunction function, const double exponent) noexcept
+				{
+					switch (GetInstructionSetType())
+					{
+#ifdef CL_X86_DISPATCH
+						case InstructionSet::Avx2:
+							ApplyAvx2(y, x, size, function, exponent);
+							break;
+#endif
+						default:
+							ApplyScalar(y, x, size, function, exponent);
+							break;
+					}
+				}
+
+				void ApplyKernel(double* y, const double* x, const size_t size, const ElementWiseFunction function, const double exponent) noexcept
+				{
+#ifdef CL_X86_DISPATCH
+					if (function == ElementWiseFunction::Sqrt && GetInstructionSetType() == InstructionSet::Avx2)
+					{
+						SqrtAvx2(y, x, size);
+						return;
+					}
+#endif
+					ApplyScalar(y, x, size, function, exponent);
+				}
+
+#pragma endregion
+			}	 // namespace
+
+			const char* GetInstructionSet() noexcept
+			{
+				switch (GetInstructionSetType())
+				{
+					case InstructionSet::Avx2:
+						return "AVX2";
+					default:
+						return "Scalar";
+				}
+			}
+
+			template<typename T>
+			void Apply(T* y, const T* x, const size_t size, const ElementWiseFunction function, const double exponent)
+			{
+				detail::ParallelFor(size, detail::elementWiseGrainSize, [&](const size_t begin, const size_t end) { ApplyKernel(y + begin, x + begin, end - begin, function, exponent); });
+			}
+
+#pragma region Explicit instantiations
+
+			template void Apply<float>(float* y, const float* x, const size_t size, const ElementWiseFunction function, const double exponent);
+			template void Apply<double>(double* y, const double* x, const size_t size, const ElementWiseFunction function, const double exponent);
+
+#pragma endregion
+		}	 // namespace elementwise
+	}		 // namespace routines
+}	 // namespace cl
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+
+namespace cl
+{
+	namespace routines
+	{
+		enum class ElementWiseFunction
+		{
+			Exp,
+			Log,
+			Sqrt,
+			Pow,
+			Tanh,
+			Erf
+		};
+
+		/**
+		 * Vectorized, multithreaded element-wise functions used by the host memory spaces other than Mkl, which has VML.
+		 * In single precision they're polynomial approximations, accurate to a few ulps, evaluated with AVX2 when the CPU supports it;
+		 * in double precision, where the polynomials would be much longer, only Sqrt is vectorized and the rest comes from the standard library.
+		 */
+		namespace elementwise
+		{
+			// name of the instruction set used by the kernels, for diagnostics
+			extern const char* GetInstructionSet() noexcept;
+
+			/**
+			 * y[i] = function(x[i]): y and x can be the same array, and exponent is used by Pow only
+			 */
+			template<typename T>
+			void Apply(T* y, const T* x, const size_t size, const ElementWiseFunction function, const double exponent = 1.0);
+		}	 // namespace elementwise
+	}		 // namespace routines
+}	 // namespace cl
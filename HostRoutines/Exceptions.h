@@ -1,5 +1,8 @@
 #pragma once
 
+#include <DenseSolverType.h>
+#include <Types.h>
+
 #include <exception>
 
 namespace cl
@@ -25,6 +28,39 @@ namespace cl
 		const char* _callerFunction;
 	};
 
+	/**
+	 * The matrix can't be factorized with the requested solver (e.g. singular for Lu, not positive definite for Cholesky).
+	 * info is the (1-based) LAPACK index of the failing pivot/leading minor
+	 */
+	class FactorizationException: public Exception
+	{
+	public:
+		FactorizationException(const DenseSolverType solver, const int info) : _solver(solver), _info(info) {}
+		FactorizationException(const FactorizationException& rhs) = default;
+		FactorizationException& operator=(const FactorizationException& rhs) = default;
+		inline const char* what() const noexcept final
+		{
+			switch (_solver)
+			{
+				case DenseSolverType::Lu:
+					return "Lu factorization failed: the matrix is singular";
+				case DenseSolverType::Cholesky:
+					return "Cholesky factorization failed: the matrix is not positive definite";
+				case DenseSolverType::Ldlt:
+					return "Ldlt factorization failed: the matrix is singular";
+				default:
+					return "Factorization failed";
+			}
+		}
+
+		DenseSolverType GetSolverType() const noexcept { return _solver; }
+		int GetInfo() const noexcept { return _info; }
+
+	private:
+		DenseSolverType _solver;
+		int _info;
+	};
+
 	class OpenBlasException: public Exception
 	{
 	public:
@@ -36,4 +72,34 @@ namespace cl
 	private:
 		const char* _callerFunction;
 	};
+
+	/**
+	 * A .npy file couldn't be memory mapped: reason is a static string describing the failing step
+	 */
+	class MemoryMappingException: public Exception
+	{
+	public:
+		explicit MemoryMappingException(const char* reason) : _reason(reason) {}
+		MemoryMappingException(const MemoryMappingException& rhs) = default;
+		MemoryMappingException& operator=(const MemoryMappingException& rhs) = default;
+		inline const char* what() const noexcept final { return _reason; }
+
+	private:
+		const char* _reason;
+	};
+
+	/**
+	 * A .npy file, or a .npz archive of them, couldn't be read or written: reason is a static string describing the failing step
+	 */
+	class NpyFileException: public Exception
+	{
+	public:
+		explicit NpyFileException(const char* reason) : _reason(reason) {}
+		NpyFileException(const NpyFileException& rhs) = default;
+		NpyFileException& operator=(const NpyFileException& rhs) = default;
+		inline const char* what() const noexcept final { return _reason; }
+
+	private:
+		const char* _reason;
+	};
 }	 // namespace cl
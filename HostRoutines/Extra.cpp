@@ -2,20 +2,133 @@
 #include <Common.h>
 #include <Exceptions.h>
 #include <Extra.h>
+#include <Profiling.h>
+#include <Reductions.h>
+#include <Sorting.h>
 
-#include <BlasWrappers.h>
-
-#include <algorithm>
-#include <cmath>
+#include <cassert>
 #include <numeric>
 
-
 namespace cl
 {
 	namespace routines
 	{
+		namespace
+		{
+			/**
+			 * out = reduction of the columns (or of the rows) of the column-major nRows x nCols matrix A
+			 */
+			template<typename T>
+			void AxisReduce(T* out, const T* A, const size_t nRows, const size_t nCols, const size_t leadingDimension, const bool columnWise, const ReductionType reductionType)
+			{
+				switch (reductionType)
+				{
+					case ReductionType::Sum:
+					case ReductionType::Mean:
+					{
+						if (columnWise)
+							reductions::ColumnWiseSum(out, A, nRows, nCols, leadingDimension);
+						else
+							reductions::RowWiseSum(out, A, nRows, nCols, leadingDimension);
+
+						if (reductionType == ReductionType::Mean)
+						{
+							const size_t nReducedElements = columnWise ? nRows : nCols;
+							const size_t nOut = columnWise ? nCols : nRows;
+							for (size_t i = 0; i < nOut; ++i)
+								out[i] = static_cast<T>(out[i] / static_cast<double>(nReducedElements));
+						}
+						break;
+					}
+					case ReductionType::Min:
+						if (columnWise)
+							reductions::ColumnWiseMin(out, A, nRows, nCols, leadingDimension);
+						else
+							reductions::RowWiseMin(out, A, nRows, nCols, leadingDimension);
+						break;
+					case ReductionType::Max:
+						if (columnWise)
+							reductions::ColumnWiseMax(out, A, nRows, nCols, leadingDimension);
+						else
+							reductions::RowWiseMax(out, A, nRows, nCols, leadingDimension);
+						break;
+					case ReductionType::Norm:
+						if (columnWise)
+							reductions::ColumnWiseNorm(out, A, nRows, nCols, leadingDimension);
+						else
+							reductions::RowWiseNorm(out, A, nRows, nCols, leadingDimension);
+						break;
+					default:
+						throw NotImplementedException();
+				}
+			}
+
+			template<MathDomain md>
+			void AxisReduce(MemoryBuffer& x, const MemoryTile& A, const bool columnWise, const ReductionType reductionType)
+			{
+				auto* xPtr = GetPointer<md>(x);
+				const auto* aPtr = GetPointer<md>(A);
+				AxisReduce(xPtr, aPtr, A.nRows, A.nCols, A.leadingDimension, columnWise, reductionType);
+			}
+
+			template<MathDomain md>
+			void CubeReduce(MemoryTile& A, const MemoryCube& T, const ReductionType reductionType)
+			{
+				auto* aPtr = GetPointer<md>(A);
+				const auto* tPtr = GetPointer<md>(T);
+				const size_t matrixSize = static_cast<size_t>(T.nRows) * T.nCols;
+
+				// the cube is a (nRows * nCols) x nCubes matrix, whose rows are reduced
+				if (A.leadingDimension == A.nRows)
+				{
+					AxisReduce(aPtr, tPtr, matrixSize, T.nCubes, matrixSize, false, reductionType);
+					return;
+				}
+
+				for (size_t j = 0; j < T.nCols; ++j)
+					AxisReduce(aPtr + j * A.leadingDimension, tPtr + j * T.nRows, T.nRows, T.nCubes, matrixSize, false, reductionType);
+			}
+
+			template<MathDomain md>
+			void SortBuffer(MemoryBuffer& x, const bool ascending)
+			{
+				auto* xPtr = GetPointer<md>(x);
+				sorting::Sort(xPtr, x.size, ascending);
+			}
+
+			template<MathDomain md>
+			void ArgSortBuffer(MemoryBuffer& indices, const MemoryBuffer& x, const bool ascending)
+			{
+				auto* indicesPtr = GetPointer<MathDomain::Int>(indices);
+				const auto* xPtr = GetPointer<md>(x);
+				sorting::ArgSort(indicesPtr, xPtr, x.size, ascending);
+			}
+
+			template<MathDomain md>
+			void TopKBuffer(MemoryBuffer& values, MemoryBuffer& indices, const MemoryBuffer& x, const bool largest)
+			{
+				auto* valuesPtr = GetPointer<md>(values);
+				auto* indicesPtr = GetPointer<MathDomain::Int>(indices);
+				const auto* xPtr = GetPointer<md>(x);
+				sorting::TopK(valuesPtr, indicesPtr, xPtr, x.size, values.size, largest);
+			}
+
+			template<MathDomain md>
+			void SegmentedSortBuffer(MemoryBuffer& x, const std::vector<size_t>& segmentSizes, const bool ascending)
+			{
+				std::vector<size_t> offsets(segmentSizes.size() + 1, 0);
+				std::partial_sum(segmentSizes.begin(), segmentSizes.end(), offsets.begin() + 1);
+				assert(offsets.back() == x.size);
+
+				auto* xPtr = GetPointer<md>(x);
+				sorting::SegmentedSort(xPtr, offsets.data(), segmentSizes.size(), ascending);
+			}
+		}	 // namespace
+
 		void Sum(double& sum, const MemoryBuffer& v)
 		{
+			CL_PROFILE(v, 1.0 * v.size, 1.0 * v.TotalSize());
+
 			switch (v.mathDomain)
 			{
 				case MathDomain::Float:
@@ -23,13 +136,12 @@ namespace cl
 					switch (v.memorySpace)
 					{
 						case MemorySpace::Test:
-						case MemorySpace::Mkl:		   // TODO
-						case MemorySpace::OpenBlas:	   // TODO
+						case MemorySpace::Mkl:
+						case MemorySpace::OpenBlas:
 						case MemorySpace::GenericBlas:
 						{
 							auto* vPtr = GetPointer<MathDomain::Float>(v);
-
-							sum = std::accumulate(vPtr, vPtr + v.size, 0.0);
+							sum = reductions::Sum(vPtr, v.size);
 							break;
 						}
 						default:
@@ -42,13 +154,12 @@ namespace cl
 					switch (v.memorySpace)
 					{
 						case MemorySpace::Test:
-						case MemorySpace::Mkl:		   // TODO
-						case MemorySpace::OpenBlas:	   // TODO
+						case MemorySpace::Mkl:
+						case MemorySpace::OpenBlas:
 						case MemorySpace::GenericBlas:
 						{
 							auto* vPtr = GetPointer<MathDomain::Double>(v);
-
-							sum = std::accumulate(vPtr, vPtr + v.size, 0.0);
+							sum = reductions::Sum(vPtr, v.size);
 							break;
 						}
 						default:
@@ -61,13 +172,12 @@ namespace cl
 					switch (v.memorySpace)
 					{
 						case MemorySpace::Test:
-						case MemorySpace::Mkl:		   // TODO
-						case MemorySpace::OpenBlas:	   // TODO
+						case MemorySpace::Mkl:
+						case MemorySpace::OpenBlas:
 						case MemorySpace::GenericBlas:
 						{
 							auto* vPtr = GetPointer<MathDomain::Int>(v);
-
-							sum = std::accumulate(vPtr, vPtr + v.size, 0);
+							sum = reductions::Sum(vPtr, v.size);
 							break;
 						}
 						default:
@@ -82,6 +192,8 @@ namespace cl
 
 		void Min(double& min, const MemoryBuffer& x)
 		{
+			CL_PROFILE(x, 1.0 * x.size, 1.0 * x.TotalSize());
+
 			switch (x.mathDomain)
 			{
 				case MathDomain::Float:
@@ -89,12 +201,12 @@ namespace cl
 					switch (x.memorySpace)
 					{
 						case MemorySpace::Test:
-						case MemorySpace::Mkl:		   // TODO
-						case MemorySpace::OpenBlas:	   // TODO
+						case MemorySpace::Mkl:
+						case MemorySpace::OpenBlas:
 						case MemorySpace::GenericBlas:
 						{
 							auto* xPtr = GetPointer<MathDomain::Float>(x);
-							min = static_cast<double>(*std::min_element(xPtr, xPtr + x.size));
+							min = reductions::Min(xPtr, x.size);
 							break;
 						}
 						default:
@@ -107,12 +219,12 @@ namespace cl
 					switch (x.memorySpace)
 					{
 						case MemorySpace::Test:
-						case MemorySpace::Mkl:		   // TODO
-						case MemorySpace::OpenBlas:	   // TODO
+						case MemorySpace::Mkl:
+						case MemorySpace::OpenBlas:
 						case MemorySpace::GenericBlas:
 						{
 							auto* xPtr = GetPointer<MathDomain::Double>(x);
-							min = *std::min_element(xPtr, xPtr + x.size);
+							min = reductions::Min(xPtr, x.size);
 							break;
 						}
 						default:
@@ -125,12 +237,12 @@ namespace cl
 					switch (x.memorySpace)
 					{
 						case MemorySpace::Test:
-						case MemorySpace::Mkl:		   // TODO
-						case MemorySpace::OpenBlas:	   // TODO
+						case MemorySpace::Mkl:
+						case MemorySpace::OpenBlas:
 						case MemorySpace::GenericBlas:
 						{
 							auto* xPtr = GetPointer<MathDomain::Int>(x);
-							min = static_cast<double>(*std::min_element(xPtr, xPtr + x.size));
+							min = reductions::Min(xPtr, x.size);
 							break;
 						}
 						default:
@@ -145,6 +257,8 @@ namespace cl
 
 		void Max(double& max, const MemoryBuffer& x)
 		{
+			CL_PROFILE(x, 1.0 * x.size, 1.0 * x.TotalSize());
+
 			{
 				switch (x.mathDomain)
 				{
@@ -153,12 +267,12 @@ namespace cl
 						switch (x.memorySpace)
 						{
 							case MemorySpace::Test:
-							case MemorySpace::Mkl:		   // TODO
-							case MemorySpace::OpenBlas:	   // TODO
+							case MemorySpace::Mkl:
+							case MemorySpace::OpenBlas:
 							case MemorySpace::GenericBlas:
 							{
 								auto* xPtr = GetPointer<MathDomain::Float>(x);
-								max = static_cast<double>(*std::max_element(xPtr, xPtr + x.size));
+								max = reductions::Max(xPtr, x.size);
 								break;
 							}
 							default:
@@ -171,12 +285,12 @@ namespace cl
 						switch (x.memorySpace)
 						{
 							case MemorySpace::Test:
-							case MemorySpace::Mkl:		   // TODO
-							case MemorySpace::OpenBlas:	   // TODO
+							case MemorySpace::Mkl:
+							case MemorySpace::OpenBlas:
 							case MemorySpace::GenericBlas:
 							{
 								auto* xPtr = GetPointer<MathDomain::Double>(x);
-								max = *std::max_element(xPtr, xPtr + x.size);
+								max = reductions::Max(xPtr, x.size);
 								break;
 							}
 							default:
@@ -189,12 +303,12 @@ namespace cl
 						switch (x.memorySpace)
 						{
 							case MemorySpace::Test:
-							case MemorySpace::Mkl:		   // TODO
-							case MemorySpace::OpenBlas:	   // TODO
+							case MemorySpace::Mkl:
+							case MemorySpace::OpenBlas:
 							case MemorySpace::GenericBlas:
 							{
 								auto* xPtr = GetPointer<MathDomain::Int>(x);
-								max = static_cast<double>(*std::max_element(xPtr, xPtr + x.size));
+								max = reductions::Max(xPtr, x.size);
 								break;
 							}
 							default:
@@ -210,6 +324,8 @@ namespace cl
 
 		void AbsMin(double& min, const MemoryBuffer& x)
 		{
+			CL_PROFILE(x, 1.0 * x.size, 1.0 * x.TotalSize());
+
 			switch (x.mathDomain)
 			{
 				case MathDomain::Float:
@@ -217,15 +333,12 @@ namespace cl
 					switch (x.memorySpace)
 					{
 						case MemorySpace::Test:
-						case MemorySpace::Mkl:		   // TODO
-						case MemorySpace::OpenBlas:	   // TODO
+						case MemorySpace::Mkl:
+						case MemorySpace::OpenBlas:
 						case MemorySpace::GenericBlas:
 						{
 							auto* xPtr = GetPointer<MathDomain::Float>(x);
-
-							int argMin = -1;
-							ArgAbsMin(argMin, x);
-							min = static_cast<double>(std::fabs(xPtr[static_cast<size_t>(argMin)]));
+							min = reductions::AbsMin(xPtr, x.size);
 							break;
 						}
 						default:
@@ -238,15 +351,12 @@ namespace cl
 					switch (x.memorySpace)
 					{
 						case MemorySpace::Test:
-						case MemorySpace::Mkl:		   // TODO
-						case MemorySpace::OpenBlas:	   // TODO
+						case MemorySpace::Mkl:
+						case MemorySpace::OpenBlas:
 						case MemorySpace::GenericBlas:
 						{
 							auto* xPtr = GetPointer<MathDomain::Double>(x);
-
-							int argMin = -1;
-							ArgAbsMin(argMin, x);
-							min = std::fabs(xPtr[static_cast<size_t>(argMin)]);
+							min = reductions::AbsMin(xPtr, x.size);
 							break;
 						}
 						default:
@@ -259,15 +369,12 @@ namespace cl
 					switch (x.memorySpace)
 					{
 						case MemorySpace::Test:
-						case MemorySpace::Mkl:		   // TODO
-						case MemorySpace::OpenBlas:	   // TODO
+						case MemorySpace::Mkl:
+						case MemorySpace::OpenBlas:
 						case MemorySpace::GenericBlas:
 						{
 							auto* xPtr = GetPointer<MathDomain::Int>(x);
-
-							int argMin = -1;
-							ArgAbsMin(argMin, x);
-							min = std::fabs(xPtr[static_cast<size_t>(argMin)]);
+							min = reductions::AbsMin(xPtr, x.size);
 							break;
 						}
 						default:
@@ -282,6 +389,8 @@ namespace cl
 
 		void AbsMax(double& max, const MemoryBuffer& x)
 		{
+			CL_PROFILE(x, 1.0 * x.size, 1.0 * x.TotalSize());
+
 			switch (x.mathDomain)
 			{
 				case MathDomain::Float:
@@ -289,15 +398,12 @@ namespace cl
 					switch (x.memorySpace)
 					{
 						case MemorySpace::Test:
-						case MemorySpace::Mkl:		   // TODO
-						case MemorySpace::OpenBlas:	   // TODO
+						case MemorySpace::Mkl:
+						case MemorySpace::OpenBlas:
 						case MemorySpace::GenericBlas:
 						{
 							auto* xPtr = GetPointer<MathDomain::Float>(x);
-
-							int argMax = -1;
-							ArgAbsMax(argMax, x);
-							max = static_cast<double>(std::fabs(xPtr[static_cast<size_t>(argMax)]));
+							max = reductions::AbsMax(xPtr, x.size);
 							break;
 						}
 						default:
@@ -310,15 +416,12 @@ namespace cl
 					switch (x.memorySpace)
 					{
 						case MemorySpace::Test:
-						case MemorySpace::Mkl:			  // TODO
-						case MemorySpace::OpenBlas:		  // TODO
-						case MemorySpace::GenericBlas:	  // TODO
+						case MemorySpace::Mkl:
+						case MemorySpace::OpenBlas:
+						case MemorySpace::GenericBlas:
 						{
 							auto* xPtr = GetPointer<MathDomain::Double>(x);
-
-							int argMax = -1;
-							ArgAbsMax(argMax, x);
-							max = std::fabs(xPtr[static_cast<size_t>(argMax)]);
+							max = reductions::AbsMax(xPtr, x.size);
 							break;
 						}
 						default:
@@ -331,15 +434,12 @@ namespace cl
 					switch (x.memorySpace)
 					{
 						case MemorySpace::Test:
-						case MemorySpace::Mkl:			  // TODO
-						case MemorySpace::OpenBlas:		  // TODO
-						case MemorySpace::GenericBlas:	  // TODO
+						case MemorySpace::Mkl:
+						case MemorySpace::OpenBlas:
+						case MemorySpace::GenericBlas:
 						{
 							auto* xPtr = GetPointer<MathDomain::Int>(x);
-
-							int argMin = -1;
-							ArgAbsMax(argMin, x);
-							max = std::fabs(xPtr[static_cast<size_t>(argMin)]);
+							max = reductions::AbsMax(xPtr, x.size);
 							break;
 						}
 						default:
@@ -352,5 +452,399 @@ namespace cl
 			}
 		}
 
+	
+
+		void ColumnWiseReduce(MemoryBuffer& x, const MemoryTile& A, const ReductionType reductionType)
+		{
+			CL_PROFILE(A, 1.0 * A.size, 1.0 * A.TotalSize());
+
+			switch (A.mathDomain)
+			{
+				case MathDomain::Float:
+				{
+					switch (A.memorySpace)
+					{
+						case MemorySpace::Test:
+						case MemorySpace::Mkl:
+						case MemorySpace::OpenBlas:
+						case MemorySpace::GenericBlas:
+							AxisReduce<MathDomain::Float>(x, A, true, reductionType);
+							break;
+						default:
+							throw NotImplementedException();
+					}
+					break;
+				}
+				case MathDomain::Double:
+				{
+					switch (A.memorySpace)
+					{
+						case MemorySpace::Test:
+						case MemorySpace::Mkl:
+						case MemorySpace::OpenBlas:
+						case MemorySpace::GenericBlas:
+							AxisReduce<MathDomain::Double>(x, A, true, reductionType);
+							break;
+						default:
+							throw NotImplementedException();
+					}
+					break;
+				}
+				case MathDomain::Int:
+				{
+					switch (A.memorySpace)
+					{
+						case MemorySpace::Test:
+						case MemorySpace::Mkl:
+						case MemorySpace::OpenBlas:
+						case MemorySpace::GenericBlas:
+							AxisReduce<MathDomain::Int>(x, A, true, reductionType);
+							break;
+						default:
+							throw NotImplementedException();
+					}
+					break;
+				}
+				default:
+					throw NotImplementedException();
+			}
+		}
+
+		void RowWiseReduce(MemoryBuffer& x, const MemoryTile& A, const ReductionType reductionType)
+		{
+			CL_PROFILE(A, 1.0 * A.size, 1.0 * A.TotalSize());
+
+			switch (A.mathDomain)
+			{
+				case MathDomain::Float:
+				{
+					switch (A.memorySpace)
+					{
+						case MemorySpace::Test:
+						case MemorySpace::Mkl:
+						case MemorySpace::OpenBlas:
+						case MemorySpace::GenericBlas:
+							AxisReduce<MathDomain::Float>(x, A, false, reductionType);
+							break;
+						default:
+							throw NotImplementedException();
+					}
+					break;
+				}
+				case MathDomain::Double:
+				{
+					switch (A.memorySpace)
+					{
+						case MemorySpace::Test:
+						case MemorySpace::Mkl:
+						case MemorySpace::OpenBlas:
+						case MemorySpace::GenericBlas:
+							AxisReduce<MathDomain::Double>(x, A, false, reductionType);
+							break;
+						default:
+							throw NotImplementedException();
+					}
+					break;
+				}
+				case MathDomain::Int:
+				{
+					switch (A.memorySpace)
+					{
+						case MemorySpace::Test:
+						case MemorySpace::Mkl:
+						case MemorySpace::OpenBlas:
+						case MemorySpace::GenericBlas:
+							AxisReduce<MathDomain::Int>(x, A, false, reductionType);
+							break;
+						default:
+							throw NotImplementedException();
+					}
+					break;
+				}
+				default:
+					throw NotImplementedException();
+			}
+		}
+
+		void CubeWiseReduce(MemoryTile& A, const MemoryCube& T, const ReductionType reductionType)
+		{
+			CL_PROFILE(T, 1.0 * T.size, 1.0 * T.TotalSize());
+
+			switch (T.mathDomain)
+			{
+				case MathDomain::Float:
+				{
+					switch (T.memorySpace)
+					{
+						case MemorySpace::Test:
+						case MemorySpace::Mkl:
+						case MemorySpace::OpenBlas:
+						case MemorySpace::GenericBlas:
+							CubeReduce<MathDomain::Float>(A, T, reductionType);
+							break;
+						default:
+							throw NotImplementedException();
+					}
+					break;
+				}
+				case MathDomain::Double:
+				{
+					switch (T.memorySpace)
+					{
+						case MemorySpace::Test:
+						case MemorySpace::Mkl:
+						case MemorySpace::OpenBlas:
+						case MemorySpace::GenericBlas:
+							CubeReduce<MathDomain::Double>(A, T, reductionType);
+							break;
+						default:
+							throw NotImplementedException();
+					}
+					break;
+				}
+				case MathDomain::Int:
+				{
+					switch (T.memorySpace)
+					{
+						case MemorySpace::Test:
+						case MemorySpace::Mkl:
+						case MemorySpace::OpenBlas:
+						case MemorySpace::GenericBlas:
+							CubeReduce<MathDomain::Int>(A, T, reductionType);
+							break;
+						default:
+							throw NotImplementedException();
+					}
+					break;
+				}
+				default:
+					throw NotImplementedException();
+			}
+		}
+
+		void Sort(MemoryBuffer& x, const bool ascending)
+		{
+			CL_PROFILE(x, 1.0 * x.size, 2.0 * x.TotalSize());
+
+			switch (x.mathDomain)
+			{
+				case MathDomain::Float:
+				{
+					switch (x.memorySpace)
+					{
+						case MemorySpace::Test:
+						case MemorySpace::Mkl:
+						case MemorySpace::OpenBlas:
+						case MemorySpace::GenericBlas:
+							SortBuffer<MathDomain::Float>(x, ascending);
+							break;
+						default:
+							throw NotImplementedException();
+					}
+					break;
+				}
+				case MathDomain::Double:
+				{
+					switch (x.memorySpace)
+					{
+						case MemorySpace::Test:
+						case MemorySpace::Mkl:
+						case MemorySpace::OpenBlas:
+						case MemorySpace::GenericBlas:
+							SortBuffer<MathDomain::Double>(x, ascending);
+							break;
+						default:
+							throw NotImplementedException();
+					}
+					break;
+				}
+				case MathDomain::Int:
+				{
+					switch (x.memorySpace)
+					{
+						case MemorySpace::Test:
+						case MemorySpace::Mkl:
+						case MemorySpace::OpenBlas:
+						case MemorySpace::GenericBlas:
+							SortBuffer<MathDomain::Int>(x, ascending);
+							break;
+						default:
+							throw NotImplementedException();
+					}
+					break;
+				}
+				default:
+					throw NotImplementedException();
+			}
+		}
+
+		void ArgSort(MemoryBuffer& indices, const MemoryBuffer& x, const bool ascending)
+		{
+			CL_PROFILE(x, 1.0 * x.size, 1.0 * x.TotalSize() + 1.0 * indices.TotalSize());
+
+			switch (x.mathDomain)
+			{
+				case MathDomain::Float:
+				{
+					switch (x.memorySpace)
+					{
+						case MemorySpace::Test:
+						case MemorySpace::Mkl:
+						case MemorySpace::OpenBlas:
+						case MemorySpace::GenericBlas:
+							ArgSortBuffer<MathDomain::Float>(indices, x, ascending);
+							break;
+						default:
+							throw NotImplementedException();
+					}
+					break;
+				}
+				case MathDomain::Double:
+				{
+					switch (x.memorySpace)
+					{
+						case MemorySpace::Test:
+						case MemorySpace::Mkl:
+						case MemorySpace::OpenBlas:
+						case MemorySpace::GenericBlas:
+							ArgSortBuffer<MathDomain::Double>(indices, x, ascending);
+							break;
+						default:
+							throw NotImplementedException();
+					}
+					break;
+				}
+				case MathDomain::Int:
+				{
+					switch (x.memorySpace)
+					{
+						case MemorySpace::Test:
+						case MemorySpace::Mkl:
+						case MemorySpace::OpenBlas:
+						case MemorySpace::GenericBlas:
+							ArgSortBuffer<MathDomain::Int>(indices, x, ascending);
+							break;
+						default:
+							throw NotImplementedException();
+					}
+					break;
+				}
+				default:
+					throw NotImplementedException();
+			}
+		}
+
+		void TopK(MemoryBuffer& values, MemoryBuffer& indices, const MemoryBuffer& x, const bool largest)
+		{
+			CL_PROFILE(x, 1.0 * x.size, 1.0 * x.TotalSize());
+
+			switch (x.mathDomain)
+			{
+				case MathDomain::Float:
+				{
+					switch (x.memorySpace)
+					{
+						case MemorySpace::Test:
+						case MemorySpace::Mkl:
+						case MemorySpace::OpenBlas:
+						case MemorySpace::GenericBlas:
+							TopKBuffer<MathDomain::Float>(values, indices, x, largest);
+							break;
+						default:
+							throw NotImplementedException();
+					}
+					break;
+				}
+				case MathDomain::Double:
+				{
+					switch (x.memorySpace)
+					{
+						case MemorySpace::Test:
+						case MemorySpace::Mkl:
+						case MemorySpace::OpenBlas:
+						case MemorySpace::GenericBlas:
+							TopKBuffer<MathDomain::Double>(values, indices, x, largest);
+							break;
+						default:
+							throw NotImplementedException();
+					}
+					break;
+				}
+				case MathDomain::Int:
+				{
+					switch (x.memorySpace)
+					{
+						case MemorySpace::Test:
+						case MemorySpace::Mkl:
+						case MemorySpace::OpenBlas:
+						case MemorySpace::GenericBlas:
+							TopKBuffer<MathDomain::Int>(values, indices, x, largest);
+							break;
+						default:
+							throw NotImplementedException();
+					}
+					break;
+				}
+				default:
+					throw NotImplementedException();
+			}
+		}
+
+		void SegmentedSort(MemoryBuffer& x, const std::vector<size_t>& segmentSizes, const bool ascending)
+		{
+			CL_PROFILE(x, 1.0 * x.size, 2.0 * x.TotalSize());
+
+			switch (x.mathDomain)
+			{
+				case MathDomain::Float:
+				{
+					switch (x.memorySpace)
+					{
+						case MemorySpace::Test:
+						case MemorySpace::Mkl:
+						case MemorySpace::OpenBlas:
+						case MemorySpace::GenericBlas:
+							SegmentedSortBuffer<MathDomain::Float>(x, segmentSizes, ascending);
+							break;
+						default:
+							throw NotImplementedException();
+					}
+					break;
+				}
+				case MathDomain::Double:
+				{
+					switch (x.memorySpace)
+					{
+						case MemorySpace::Test:
+						case MemorySpace::Mkl:
+						case MemorySpace::OpenBlas:
+						case MemorySpace::GenericBlas:
+							SegmentedSortBuffer<MathDomain::Double>(x, segmentSizes, ascending);
+							break;
+						default:
+							throw NotImplementedException();
+					}
+					break;
+				}
+				case MathDomain::Int:
+				{
+					switch (x.memorySpace)
+					{
+						case MemorySpace::Test:
+						case MemorySpace::Mkl:
+						case MemorySpace::OpenBlas:
+						case MemorySpace::GenericBlas:
+							SegmentedSortBuffer<MathDomain::Int>(x, segmentSizes, ascending);
+							break;
+						default:
+							throw NotImplementedException();
+					}
+					break;
+				}
+				default:
+					throw NotImplementedException();
+			}
+		}
+
 	}	 // namespace routines
 }	 // namespace cl
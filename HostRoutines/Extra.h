@@ -2,8 +2,23 @@
 
 #include <Types.h>
 
+#include <cstddef>
+#include <vector>
+
 namespace cl
 {
+	/**
+	 * Reductions along the rows, the columns or the matrices of a buffer. Norm is the Euclidean norm.
+	 */
+	enum class ReductionType
+	{
+		Sum,
+		Mean,
+		Min,
+		Max,
+		Norm
+	};
+
 	namespace routines
 	{
 		extern void Sum(double& sum, const MemoryBuffer& v);
@@ -15,5 +30,40 @@ namespace cl
 		extern void AbsMin(double& min, const MemoryBuffer& x);
 
 		extern void AbsMax(double& max, const MemoryBuffer& x);
+
+		/**
+		 * x[j] = reduction of the j-th column of A
+		 */
+		extern void ColumnWiseReduce(MemoryBuffer& x, const MemoryTile& A, const ReductionType reductionType);
+
+		/**
+		 * x[i] = reduction of the i-th row of A
+		 */
+		extern void RowWiseReduce(MemoryBuffer& x, const MemoryTile& A, const ReductionType reductionType);
+
+		/**
+		 * A(i, j) = reduction of T(i, j, k) over the matrices k
+		 */
+		extern void CubeWiseReduce(MemoryTile& A, const MemoryCube& T, const ReductionType reductionType);
+
+		/**
+		 * Stable sort of x, in place: NaNs go last in ascending order, first in descending order
+		 */
+		extern void Sort(MemoryBuffer& x, const bool ascending = true);
+
+		/**
+		 * indices = the permutation that sorts x, i.e. x[indices[0]], x[indices[1]], ... is sorted: indices is an Int buffer
+		 */
+		extern void ArgSort(MemoryBuffer& indices, const MemoryBuffer& x, const bool ascending = true);
+
+		/**
+		 * values, indices = the values.size largest (or smallest) elements of x, sorted, and their positions in x
+		 */
+		extern void TopK(MemoryBuffer& values, MemoryBuffer& indices, const MemoryBuffer& x, const bool largest = true);
+
+		/**
+		 * Sorts each of the consecutive segments of x, whose sizes add up to x.size
+		 */
+		extern void SegmentedSort(MemoryBuffer& x, const std::vector<size_t>& segmentSizes, const bool ascending = true);
 	}	 // namespace routines
 }	 // namespace cl
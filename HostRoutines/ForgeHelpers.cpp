@@ -1,6 +1,7 @@
 #include <Common.h>
 #include <Exceptions.h>
 #include <ForgeHelpers.h>
+#include <Parallel.h>
 
 #include <algorithm>
 
@@ -36,8 +37,10 @@ namespace cl
 							auto* xPtr = GetPointer<MathDomain::Float>(x);
 							auto* yPtr = GetPointer<MathDomain::Float>(y);
 
-							for (size_t i = 0; i < z.size; ++i)
-								makePair(zPtr, i, xPtr, yPtr);
+							detail::ParallelFor(x.size, detail::elementWiseGrainSize, [&](const size_t begin, const size_t end) {
+								for (size_t i = begin; i < end; ++i)
+									makePair(zPtr, i, xPtr, yPtr);
+							});
 							break;
 						}
 						default:
@@ -57,8 +60,10 @@ namespace cl
 							auto* xPtr = GetPointer<MathDomain::Double>(x);
 							auto* yPtr = GetPointer<MathDomain::Double>(y);
 
-							for (size_t i = 0; i < z.size; ++i)
-								makePair(zPtr, i, xPtr, yPtr);
+							detail::ParallelFor(x.size, detail::elementWiseGrainSize, [&](const size_t begin, const size_t end) {
+								for (size_t i = begin; i < end; ++i)
+									makePair(zPtr, i, xPtr, yPtr);
+							});
 							break;
 						}
 						default:
@@ -78,8 +83,10 @@ namespace cl
 							auto* xPtr = GetPointer<MathDomain::Int>(x);
 							auto* yPtr = GetPointer<MathDomain::Int>(y);
 
-							for (size_t i = 0; i < z.size; ++i)
-								makePair(zPtr, i, xPtr, yPtr);
+							detail::ParallelFor(x.size, detail::elementWiseGrainSize, [&](const size_t begin, const size_t end) {
+								for (size_t i = begin; i < end; ++i)
+									makePair(zPtr, i, xPtr, yPtr);
+							});
 							break;
 						}
 						default:
@@ -99,16 +106,18 @@ namespace cl
 			assert(v.size == 3 * z.size);
 
 			const auto makeTriple = [&](auto* v_, const auto* x_, const auto* y_, const auto* z_) {
-				for (size_t i = 0; i < x.size; ++i)
-				{
-					for (size_t j = 0; j < y.size; ++j)
+				detail::ParallelFor(x.size, detail::GetSliceGrainSize(y.size), [&](const size_t begin, const size_t end) {
+					for (size_t i = begin; i < end; ++i)
 					{
-						const size_t offset = j + i * y.size;
-						v_[3 * offset] = static_cast<float>(x_[i]);
-						v_[3 * offset + 1] = static_cast<float>(y_[j]);
-						v_[3 * offset + 2] = static_cast<float>(z_[i + j * x.size]);
+						for (size_t j = 0; j < y.size; ++j)
+						{
+							const size_t offset = j + i * y.size;
+							v_[3 * offset] = static_cast<float>(x_[i]);
+							v_[3 * offset + 1] = static_cast<float>(y_[j]);
+							v_[3 * offset + 2] = static_cast<float>(z_[i + j * x.size]);
+						}
 					}
-				}
+				});
 			};
 
 			auto* vPtr = GetPointer<MathDomain::Float>(v);
@@ -126,7 +135,7 @@ namespace cl
 						{
 							auto* xPtr = GetPointer<MathDomain::Float>(x);
 							auto* yPtr = GetPointer<MathDomain::Float>(y);
-							auto* zPtr = GetPointer<MathDomain::Float>(y);
+							auto* zPtr = GetPointer<MathDomain::Float>(z);
 
 							makeTriple(vPtr, xPtr, yPtr, zPtr);
 							break;
@@ -147,7 +156,7 @@ namespace cl
 						{
 							auto* xPtr = GetPointer<MathDomain::Double>(x);
 							auto* yPtr = GetPointer<MathDomain::Double>(y);
-							auto* zPtr = GetPointer<MathDomain::Double>(y);
+							auto* zPtr = GetPointer<MathDomain::Double>(z);
 
 							makeTriple(vPtr, xPtr, yPtr, zPtr);
 							break;
@@ -168,7 +177,7 @@ namespace cl
 						{
 							auto* xPtr = GetPointer<MathDomain::Int>(x);
 							auto* yPtr = GetPointer<MathDomain::Int>(y);
-							auto* zPtr = GetPointer<MathDomain::Int>(y);
+							auto* zPtr = GetPointer<MathDomain::Int>(z);
 
 							makeTriple(vPtr, xPtr, yPtr, zPtr);
 							break;
@@ -1,7 +1,9 @@
 #pragma once
 
 #include <BufferInitializer.h>
+#include <Common.h>
 #include <MemoryManager.h>
+#include <SolverWorkspace.h>
 #include <Types.h>
 
 #include <array>
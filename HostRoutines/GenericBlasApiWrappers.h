@@ -18,6 +18,8 @@ namespace cl
 	{
 		ROUTINES_NAMESPACE
 		{
+			static inline void SetNumThreads(const size_t) {}
+
 			template<MathDomain md>
 			static void Add(MemoryBuffer&, const MemoryBuffer&, const MemoryBuffer&, const double)
 			{
@@ -79,7 +81,25 @@ namespace cl
 			}
 
 			template<MathDomain md>
-			static void Solve(const MemoryTile&, MemoryTile&, const MatrixOperation, const LinearSystemSolverType)
+			static void Factorize(MemoryTile&, MemoryBuffer&, const DenseSolverType, SolverWorkspace&)
+			{
+				throw NotImplementedException();
+			}
+
+			template<MathDomain md>
+			static void SolveFactorized(const MemoryTile&, const MemoryBuffer&, MemoryTile&, const MatrixOperation, const DenseSolverType, SolverWorkspace&)
+			{
+				throw NotImplementedException();
+			}
+
+			template<MathDomain md>
+			static void Solve(const MemoryTile&, MemoryTile&, const MatrixOperation, const DenseSolverType, SolverWorkspace&)
+			{
+				throw NotImplementedException();
+			}
+
+			template<MathDomain md>
+			static void InvertSymmetric(MemoryTile&, const DenseSolverType, SolverWorkspace&)
 			{
 				throw NotImplementedException();
 			}
@@ -114,12 +134,21 @@ namespace cl
 			{
 				throw NotImplementedException();
 			}
+
+			// result = x^T * y
+			template<MathDomain md>
+			static void InnerProduct(double&, const MemoryBuffer&, const MemoryBuffer&)
+			{
+				throw NotImplementedException();
+			}
 		}
 	}	 // namespace routines
 }	 // namespace cl
 
 #else
 
+	#include <Parallel.h>
+
 	#include <cmath>
 	#include <complex>
 
@@ -137,6 +166,16 @@ namespace cl
 		{
 			static constexpr GENERIC_API_NAMESPACE::CBLAS_ORDER columnMajorLayout = { GENERIC_API_NAMESPACE::CBLAS_ORDER::CblasColMajor };
 			static constexpr std::array<GENERIC_API_NAMESPACE::CBLAS_TRANSPOSE, 2> operationsEnum = { GENERIC_API_NAMESPACE::CBLAS_TRANSPOSE::CblasNoTrans, GENERIC_API_NAMESPACE::CBLAS_TRANSPOSE::CblasTrans };
+			static constexpr std::array<char, 2> openBlasOperation = { 'N', 'T' };
+
+			static inline void SetNumThreads(const size_t nThreads)
+			{
+	#ifdef GENERIC_API_SET_NUM_THREADS
+				GENERIC_API_NAMESPACE::GENERIC_API_SET_NUM_THREADS(static_cast<int>(nThreads));
+	#else
+				(void)nThreads;
+	#endif
+			}
 
 			template<MathDomain md>
 			static void Add(MemoryBuffer & z, const MemoryBuffer& x, const MemoryBuffer& y, const double alpha);
@@ -237,6 +276,78 @@ namespace cl
 				GENERIC_API_NAMESPACE::cblas_dgemm(columnMajorLayout, operationsEnum[static_cast<unsigned>(bOperation)], operationsEnum[static_cast<unsigned>(cOperation)], static_cast<int>(nRowsB), static_cast<int>(nColsC), static_cast<int>(nColsB), alpha, reinterpret_cast<double*>(B.pointer), static_cast<int>(B.leadingDimension), reinterpret_cast<double*>(C.pointer), static_cast<int>(C.leadingDimension), beta, reinterpret_cast<double*>(A.pointer), static_cast<int>(A.leadingDimension));
 			}
 
+			/**
+			 * Runs multiply(first, last) on ranges of the nBatches products.
+			 * Products big enough for a threaded GEMM run one after the other, letting BLAS use all the threads; otherwise the batch is split
+			 * across threads, each running single threaded GEMMs
+			 */
+			template<typename F>
+			static void ScheduleBatches(const unsigned nBatches, const double flopsPerBatch, const F& multiply)
+			{
+				// roughly a 128x128x128 GEMM
+				constexpr double minThreadedBlasFlops = 4e6;
+				constexpr size_t minFlopsPerThread = size_t(1) << 18;
+
+				const size_t nPartitions = flopsPerBatch >= minThreadedBlasFlops ? 1 : std::min(static_cast<size_t>(nBatches), detail::GetNumberOfPartitions(static_cast<size_t>(flopsPerBatch * nBatches), minFlopsPerThread));
+				if (nPartitions <= 1)
+				{
+					multiply(0u, nBatches);
+					return;
+				}
+
+	#ifdef GENERIC_API_SET_NUM_THREADS
+				const int nBlasThreads = GENERIC_API_NAMESPACE::GENERIC_API_GET_NUM_THREADS();
+				GENERIC_API_NAMESPACE::GENERIC_API_SET_NUM_THREADS(1);
+	#endif
+
+				detail::ParallelFor(nPartitions, [&](const size_t p) {
+					multiply(static_cast<unsigned>(p * nBatches / nPartitions), static_cast<unsigned>((p + 1) * nBatches / nPartitions));
+				});
+
+	#ifdef GENERIC_API_SET_NUM_THREADS
+				GENERIC_API_NAMESPACE::GENERIC_API_SET_NUM_THREADS(nBlasThreads);
+	#endif
+			}
+
+			/**
+			 * A[i] = alpha * B[i * strideB] * C[i * strideC] + beta * A[i]: a zero stride broadcasts the same matrix to the whole batch.
+			 * Matrices are addressed by their offset in the cube, so no pointer arrays are needed
+			 */
+			template<MathDomain md>
+			static void BatchedMultiply(MemoryCube & A, const MemoryCube& B, const MemoryCube& C, const unsigned strideB, const unsigned strideC, const MatrixOperation bOperation, const MatrixOperation cOperation, const double alpha, const double beta);
+
+			template<>
+			inline void BatchedMultiply<MathDomain::Float>(MemoryCube & A, const MemoryCube& B, const MemoryCube& C, const unsigned strideB, const unsigned strideC, const MatrixOperation bOperation, const MatrixOperation cOperation, const double alpha, const double beta)
+			{
+				const unsigned nInner = bOperation == MatrixOperation::None ? B.nCols : B.nRows;
+				const size_t strideA = static_cast<size_t>(A.nRows) * A.nCols;
+
+				const auto* bPtr = reinterpret_cast<const float*>(B.pointer);
+				const auto* cPtr = reinterpret_cast<const float*>(C.pointer);
+				auto* aPtr = reinterpret_cast<float*>(A.pointer);
+
+				ScheduleBatches(A.nCubes, 2.0 * A.nRows * A.nCols * nInner, [&](const unsigned first, const unsigned last) {
+					for (unsigned i = first; i < last; ++i)
+						GENERIC_API_NAMESPACE::cblas_sgemm(columnMajorLayout, operationsEnum[static_cast<unsigned>(bOperation)], operationsEnum[static_cast<unsigned>(cOperation)], static_cast<int>(A.nRows), static_cast<int>(A.nCols), static_cast<int>(nInner), static_cast<float>(alpha), bPtr + static_cast<size_t>(i) * strideB, static_cast<int>(B.leadingDimension), cPtr + static_cast<size_t>(i) * strideC, static_cast<int>(C.leadingDimension), static_cast<float>(beta), aPtr + i * strideA, static_cast<int>(A.leadingDimension));
+				});
+			}
+
+			template<>
+			inline void BatchedMultiply<MathDomain::Double>(MemoryCube & A, const MemoryCube& B, const MemoryCube& C, const unsigned strideB, const unsigned strideC, const MatrixOperation bOperation, const MatrixOperation cOperation, const double alpha, const double beta)
+			{
+				const unsigned nInner = bOperation == MatrixOperation::None ? B.nCols : B.nRows;
+				const size_t strideA = static_cast<size_t>(A.nRows) * A.nCols;
+
+				const auto* bPtr = reinterpret_cast<const double*>(B.pointer);
+				const auto* cPtr = reinterpret_cast<const double*>(C.pointer);
+				auto* aPtr = reinterpret_cast<double*>(A.pointer);
+
+				ScheduleBatches(A.nCubes, 2.0 * A.nRows * A.nCols * nInner, [&](const unsigned first, const unsigned last) {
+					for (unsigned i = first; i < last; ++i)
+						GENERIC_API_NAMESPACE::cblas_dgemm(columnMajorLayout, operationsEnum[static_cast<unsigned>(bOperation)], operationsEnum[static_cast<unsigned>(cOperation)], static_cast<int>(A.nRows), static_cast<int>(A.nCols), static_cast<int>(nInner), alpha, bPtr + static_cast<size_t>(i) * strideB, static_cast<int>(B.leadingDimension), cPtr + static_cast<size_t>(i) * strideC, static_cast<int>(C.leadingDimension), beta, aPtr + i * strideA, static_cast<int>(A.leadingDimension));
+				});
+			}
+
 			template<MathDomain md>
 			static void Dot(MemoryBuffer & y, const MemoryTile& A, const MemoryBuffer& x, const MatrixOperation aOperation, const double alpha = 1.0, const double beta = 0.0);
 
@@ -265,161 +376,306 @@ namespace cl
 				GENERIC_API_NAMESPACE::cblas_dger(columnMajorLayout, static_cast<int>(x.size), static_cast<int>(y.size), alpha, reinterpret_cast<double*>(x.pointer), 1, reinterpret_cast<double*>(y.pointer), 1, reinterpret_cast<double*>(A.pointer), static_cast<int>(A.nRows));
 			}
 
+			/**
+			 * Overwrites A with its factorization: auxiliary holds the pivot indices (Lu) or the Householder coefficients (Qr)
+			 */
 			template<MathDomain md>
-			static void Solve(const MemoryTile& A, MemoryTile& B, const MatrixOperation aOperation, const LinearSystemSolverType solver);
+			static void Factorize(MemoryTile& A, MemoryBuffer& auxiliary, const DenseSolverType solver, SolverWorkspace& workspace);
+
+			/**
+			 * B = A^(-1) * B, A and auxiliary being the output of Factorize
+			 */
+			template<MathDomain md>
+			static void SolveFactorized(const MemoryTile& A, const MemoryBuffer& auxiliary, MemoryTile& B, const MatrixOperation aOperation, const DenseSolverType solver, SolverWorkspace& workspace);
 
 			template<>
-			inline void Solve<MathDomain::Float>(const MemoryTile& A, MemoryTile& B, const MatrixOperation aOperation, const LinearSystemSolverType solver)
+			inline void Factorize<MathDomain::Float>(MemoryTile& A, MemoryBuffer& auxiliary, const DenseSolverType solver, SolverWorkspace&)
 			{
-				// Need to copy A, as it will be overwritten by its factorization
-				MemoryTile aCopy(A);
-				Alloc(aCopy);
-				Copy<MathDomain::Float>(aCopy, A);
+				const auto nra = static_cast<int>(A.nRows);
+				const auto lda = static_cast<int>(A.leadingDimension);
 
+				int info = 0;
+				switch (solver)
+				{
+					case DenseSolverType::Lu:
+						// A = P * L * U, overwrites A with L and U
+						info = GENERIC_API_NAMESPACE::LAPACKE_sgetrf(static_cast<int>(columnMajorLayout), nra, nra, reinterpret_cast<float*>(A.pointer), lda, reinterpret_cast<int*>(auxiliary.pointer));
+						break;
+					case DenseSolverType::Qr:
+						// A = Q * R, overwrites A with R and the Householder reflectors
+						info = GENERIC_API_NAMESPACE::LAPACKE_sgeqrf(static_cast<int>(columnMajorLayout), nra, nra, reinterpret_cast<float*>(A.pointer), lda, reinterpret_cast<float*>(auxiliary.pointer));
+						break;
+					case DenseSolverType::Cholesky:
+						// A = L * L^T, overwrites the lower triangular part of A with L
+						info = GENERIC_API_NAMESPACE::LAPACKE_spotrf(static_cast<int>(columnMajorLayout), 'L', nra, reinterpret_cast<float*>(A.pointer), lda);
+						break;
+					case DenseSolverType::Ldlt:
+						// A = L * D * L^T with Bunch-Kaufman pivoting, overwrites the lower triangular part of A with D and L
+						info = GENERIC_API_NAMESPACE::LAPACKE_ssytrf(static_cast<int>(columnMajorLayout), 'L', nra, reinterpret_cast<float*>(A.pointer), lda, reinterpret_cast<int*>(auxiliary.pointer));
+						break;
+					default:
+						throw NotImplementedException();
+				}
+
+				if (info > 0)
+					throw FactorizationException(solver, info);
+				if (info != 0)
+					throw OpenBlasException(__func__);
+			}
+
+			template<>
+			inline void SolveFactorized<MathDomain::Float>(const MemoryTile& A, const MemoryBuffer& auxiliary, MemoryTile& B, const MatrixOperation aOperation, const DenseSolverType solver, SolverWorkspace&)
+			{
 				const auto nra = static_cast<int>(A.nRows);
 				const auto lda = static_cast<int>(A.leadingDimension);
 				const auto ncb = static_cast<int>(B.nCols);
 				const auto ldb = static_cast<int>(B.leadingDimension);
 
-				// Initializes auxliary value for solver
 				int info = 0;
-
 				switch (solver)
 				{
-					case LinearSystemSolverType::Lu:
-					{
-						// allocate memory for pivoting
-						MemoryBuffer pivot(0, A.nRows, A.memorySpace, MathDomain::Int);
-						Alloc(pivot);
-
-						// Factorize A (and overwrite it with L)
-						info = GENERIC_API_NAMESPACE::LAPACKE_sgetrf(static_cast<int>(columnMajorLayout), nra, nra, reinterpret_cast<float*>(aCopy.pointer), lda, reinterpret_cast<int*>(pivot.pointer));
-						if (info != 0)
-							throw OpenBlasException(__func__);
+					case DenseSolverType::Lu:
+						info = GENERIC_API_NAMESPACE::LAPACKE_sgetrs(static_cast<int>(columnMajorLayout), openBlasOperation[static_cast<unsigned>(aOperation)], nra, ncb, reinterpret_cast<float*>(A.pointer), lda, reinterpret_cast<int*>(auxiliary.pointer), reinterpret_cast<float*>(B.pointer), ldb);
+						break;
+					case DenseSolverType::Qr:
+						if (aOperation == MatrixOperation::None)
+						{
+							// B = Q^T * B
+							info = GENERIC_API_NAMESPACE::LAPACKE_sormqr(static_cast<int>(columnMajorLayout), 'L', 'T', nra, ncb, nra, reinterpret_cast<float*>(A.pointer), lda, reinterpret_cast<float*>(auxiliary.pointer), reinterpret_cast<float*>(B.pointer), ldb);
+							if (info != 0)
+								break;
+
+							// X = R \ (Q^T * B)
+							GENERIC_API_NAMESPACE::cblas_strsm(columnMajorLayout, GENERIC_API_NAMESPACE::CBLAS_SIDE::CblasLeft, GENERIC_API_NAMESPACE::CBLAS_UPLO::CblasUpper, GENERIC_API_NAMESPACE::CBLAS_TRANSPOSE::CblasNoTrans, GENERIC_API_NAMESPACE::CBLAS_DIAG::CblasNonUnit, nra, ncb, 1.0, reinterpret_cast<float*>(A.pointer), lda, reinterpret_cast<float*>(B.pointer), ldb);
+						}
+						else
+						{
+							// A^T = R^T * Q^T: B = R^T \ B
+							GENERIC_API_NAMESPACE::cblas_strsm(columnMajorLayout, GENERIC_API_NAMESPACE::CBLAS_SIDE::CblasLeft, GENERIC_API_NAMESPACE::CBLAS_UPLO::CblasUpper, GENERIC_API_NAMESPACE::CBLAS_TRANSPOSE::CblasTrans, GENERIC_API_NAMESPACE::CBLAS_DIAG::CblasNonUnit, nra, ncb, 1.0, reinterpret_cast<float*>(A.pointer), lda, reinterpret_cast<float*>(B.pointer), ldb);
+
+							// X = Q * B
+							info = GENERIC_API_NAMESPACE::LAPACKE_sormqr(static_cast<int>(columnMajorLayout), 'L', 'N', nra, ncb, nra, reinterpret_cast<float*>(A.pointer), lda, reinterpret_cast<float*>(auxiliary.pointer), reinterpret_cast<float*>(B.pointer), ldb);
+						}
+						break;
+					case DenseSolverType::Cholesky:
+						// A is symmetric: aOperation is irrelevant
+						info = GENERIC_API_NAMESPACE::LAPACKE_spotrs(static_cast<int>(columnMajorLayout), 'L', nra, ncb, reinterpret_cast<float*>(A.pointer), lda, reinterpret_cast<float*>(B.pointer), ldb);
+						break;
+					case DenseSolverType::Ldlt:
+						info = GENERIC_API_NAMESPACE::LAPACKE_ssytrs(static_cast<int>(columnMajorLayout), 'L', nra, ncb, reinterpret_cast<float*>(A.pointer), lda, reinterpret_cast<int*>(auxiliary.pointer), reinterpret_cast<float*>(B.pointer), ldb);
+						break;
+					default:
+						throw NotImplementedException();
+				}
 
-						// Solve factorized system
-						info = GENERIC_API_NAMESPACE::LAPACKE_sgetrs(static_cast<int>(columnMajorLayout), openBlasOperation[static_cast<unsigned>(aOperation)], nra, ncb, reinterpret_cast<float*>(aCopy.pointer), lda, reinterpret_cast<int*>(pivot.pointer), reinterpret_cast<float*>(B.pointer), ldb);
-						if (info != 0)
-							throw OpenBlasException(__func__);
+				if (info != 0)
+					throw OpenBlasException(__func__);
+			}
 
-						// free memory
-						Free(pivot);
+			template<>
+			inline void Factorize<MathDomain::Double>(MemoryTile& A, MemoryBuffer& auxiliary, const DenseSolverType solver, SolverWorkspace&)
+			{
+				const auto nra = static_cast<int>(A.nRows);
+				const auto lda = static_cast<int>(A.leadingDimension);
 
+				int info = 0;
+				switch (solver)
+				{
+					case DenseSolverType::Lu:
+						// A = P * L * U, overwrites A with L and U
+						info = GENERIC_API_NAMESPACE::LAPACKE_dgetrf(static_cast<int>(columnMajorLayout), nra, nra, reinterpret_cast<double*>(A.pointer), lda, reinterpret_cast<int*>(auxiliary.pointer));
 						break;
-					}
-					case LinearSystemSolverType::Qr:
-					{
-						// allocate memory for tau
-						MemoryBuffer tau(0, A.nRows, A.memorySpace, MathDomain::Float);
-						Alloc(tau);
-
-						// A = Q * R
-						/* int matrix_layout, lapack_int m, lapack_int n,
-								   float* a, lapack_int lda, float* tau */
-						info = GENERIC_API_NAMESPACE::LAPACKE_sgeqrf(static_cast<int>(columnMajorLayout), nra, nra, reinterpret_cast<float*>(aCopy.pointer), lda, reinterpret_cast<float*>(tau.pointer));
-						if (info != 0)
-							throw OpenBlasException(__func__);
-
-						// B = Q^T * B
-						/*
-						 *  int matrix_layout, char side, char trans,
-								   lapack_int m, lapack_int n, lapack_int k,
-								   const float* a, lapack_int lda, const float* tau,
-								   float* c, lapack_int ldc */
-						info = GENERIC_API_NAMESPACE::LAPACKE_sormqr(static_cast<int>(columnMajorLayout), 'L', 'T', nra, nra, ncb, reinterpret_cast<float*>(aCopy.pointer), lda, reinterpret_cast<float*>(tau.pointer), reinterpret_cast<float*>(B.pointer), ldb);
-						if (info != 0)
-							throw OpenBlasException(__func__);
-
-						// Solve (x = R \ (Q^T * B))
-						GENERIC_API_NAMESPACE::cblas_strsm(columnMajorLayout, GENERIC_API_NAMESPACE::CBLAS_SIDE::CblasLeft, GENERIC_API_NAMESPACE::CBLAS_UPLO::CblasUpper, operationsEnum[static_cast<unsigned>(aOperation)], GENERIC_API_NAMESPACE::CBLAS_DIAG::CblasNonUnit, nra, nra, 1.0, reinterpret_cast<float*>(aCopy.pointer), lda, reinterpret_cast<float*>(B.pointer), ldb);
-
-						// free memory
-						Free(tau);
-
+					case DenseSolverType::Qr:
+						// A = Q * R, overwrites A with R and the Householder reflectors
+						info = GENERIC_API_NAMESPACE::LAPACKE_dgeqrf(static_cast<int>(columnMajorLayout), nra, nra, reinterpret_cast<double*>(A.pointer), lda, reinterpret_cast<double*>(auxiliary.pointer));
+						break;
+					case DenseSolverType::Cholesky:
+						// A = L * L^T, overwrites the lower triangular part of A with L
+						info = GENERIC_API_NAMESPACE::LAPACKE_dpotrf(static_cast<int>(columnMajorLayout), 'L', nra, reinterpret_cast<double*>(A.pointer), lda);
+						break;
+					case DenseSolverType::Ldlt:
+						// A = L * D * L^T with Bunch-Kaufman pivoting, overwrites the lower triangular part of A with D and L
+						info = GENERIC_API_NAMESPACE::LAPACKE_dsytrf(static_cast<int>(columnMajorLayout), 'L', nra, reinterpret_cast<double*>(A.pointer), lda, reinterpret_cast<int*>(auxiliary.pointer));
 						break;
-					}
 					default:
 						throw NotImplementedException();
 				}
 
-				Free(aCopy);
+				if (info > 0)
+					throw FactorizationException(solver, info);
+				if (info != 0)
+					throw OpenBlasException(__func__);
 			}
 
 			template<>
-			inline void Solve<MathDomain::Double>(const MemoryTile& A, MemoryTile& B, const MatrixOperation aOperation, const LinearSystemSolverType solver)
+			inline void SolveFactorized<MathDomain::Double>(const MemoryTile& A, const MemoryBuffer& auxiliary, MemoryTile& B, const MatrixOperation aOperation, const DenseSolverType solver, SolverWorkspace&)
 			{
-				// Need to copy A, as it will be overwritten by its factorization
-				MemoryTile aCopy(A);
-				Alloc(aCopy);
-				Copy<MathDomain::Double>(aCopy, A);
-
 				const auto nra = static_cast<int>(A.nRows);
 				const auto lda = static_cast<int>(A.leadingDimension);
 				const auto ncb = static_cast<int>(B.nCols);
 				const auto ldb = static_cast<int>(B.leadingDimension);
 
-				// Initializes auxliary value for solver
 				int info = 0;
+				switch (solver)
+				{
+					case DenseSolverType::Lu:
+						info = GENERIC_API_NAMESPACE::LAPACKE_dgetrs(static_cast<int>(columnMajorLayout), openBlasOperation[static_cast<unsigned>(aOperation)], nra, ncb, reinterpret_cast<double*>(A.pointer), lda, reinterpret_cast<int*>(auxiliary.pointer), reinterpret_cast<double*>(B.pointer), ldb);
+						break;
+					case DenseSolverType::Qr:
+						if (aOperation == MatrixOperation::None)
+						{
+							// B = Q^T * B
+							info = GENERIC_API_NAMESPACE::LAPACKE_dormqr(static_cast<int>(columnMajorLayout), 'L', 'T', nra, ncb, nra, reinterpret_cast<double*>(A.pointer), lda, reinterpret_cast<double*>(auxiliary.pointer), reinterpret_cast<double*>(B.pointer), ldb);
+							if (info != 0)
+								break;
+
+							// X = R \ (Q^T * B)
+							GENERIC_API_NAMESPACE::cblas_dtrsm(columnMajorLayout, GENERIC_API_NAMESPACE::CBLAS_SIDE::CblasLeft, GENERIC_API_NAMESPACE::CBLAS_UPLO::CblasUpper, GENERIC_API_NAMESPACE::CBLAS_TRANSPOSE::CblasNoTrans, GENERIC_API_NAMESPACE::CBLAS_DIAG::CblasNonUnit, nra, ncb, 1.0, reinterpret_cast<double*>(A.pointer), lda, reinterpret_cast<double*>(B.pointer), ldb);
+						}
+						else
+						{
+							// A^T = R^T * Q^T: B = R^T \ B
+							GENERIC_API_NAMESPACE::cblas_dtrsm(columnMajorLayout, GENERIC_API_NAMESPACE::CBLAS_SIDE::CblasLeft, GENERIC_API_NAMESPACE::CBLAS_UPLO::CblasUpper, GENERIC_API_NAMESPACE::CBLAS_TRANSPOSE::CblasTrans, GENERIC_API_NAMESPACE::CBLAS_DIAG::CblasNonUnit, nra, ncb, 1.0, reinterpret_cast<double*>(A.pointer), lda, reinterpret_cast<double*>(B.pointer), ldb);
+
+							// X = Q * B
+							info = GENERIC_API_NAMESPACE::LAPACKE_dormqr(static_cast<int>(columnMajorLayout), 'L', 'N', nra, ncb, nra, reinterpret_cast<double*>(A.pointer), lda, reinterpret_cast<double*>(auxiliary.pointer), reinterpret_cast<double*>(B.pointer), ldb);
+						}
+						break;
+					case DenseSolverType::Cholesky:
+						// A is symmetric: aOperation is irrelevant
+						info = GENERIC_API_NAMESPACE::LAPACKE_dpotrs(static_cast<int>(columnMajorLayout), 'L', nra, ncb, reinterpret_cast<double*>(A.pointer), lda, reinterpret_cast<double*>(B.pointer), ldb);
+						break;
+					case DenseSolverType::Ldlt:
+						info = GENERIC_API_NAMESPACE::LAPACKE_dsytrs(static_cast<int>(columnMajorLayout), 'L', nra, ncb, reinterpret_cast<double*>(A.pointer), lda, reinterpret_cast<int*>(auxiliary.pointer), reinterpret_cast<double*>(B.pointer), ldb);
+						break;
+					default:
+						throw NotImplementedException();
+				}
 
+				if (info != 0)
+					throw OpenBlasException(__func__);
+			}
+
+			/**
+			 * Pivot indices (Lu, Ldlt), Householder coefficients (Qr) or nothing (Cholesky)
+			 */
+			template<MathDomain md>
+			static MemoryBuffer GetAuxiliaryBuffer(const MemoryTile& A, const DenseSolverType solver, SolverWorkspace& workspace)
+			{
 				switch (solver)
 				{
-					case LinearSystemSolverType::Lu:
-					{
-						// allocate memory for pivoting
-						MemoryBuffer pivot(0, A.nRows, A.memorySpace, MathDomain::Int);
-						Alloc(pivot);
+					case DenseSolverType::Qr:
+						return workspace.GetTau(A.nRows, A.memorySpace, md);
+					case DenseSolverType::Cholesky:
+						return MemoryBuffer(0, 0, A.memorySpace, md);
+					default:
+						return workspace.GetPivot(A.nRows, A.memorySpace);
+				}
+			}
+
+			/**
+			 * Copies the lower triangular part of A into the upper one
+			 */
+			template<MathDomain md>
+			static void SymmetrizeLower(MemoryTile& A)
+			{
+				auto* a = GetPointer<md>(A);
+				for (size_t j = 1; j < A.nCols; ++j)
+				{
+					for (size_t i = 0; i < j; ++i)
+						a[i + j * A.leadingDimension] = a[j + i * A.leadingDimension];
+				}
+			}
 
-						// Factorize A (and overwrite it with L)
-						info = GENERIC_API_NAMESPACE::LAPACKE_dgetrf(static_cast<int>(columnMajorLayout), nra, nra, reinterpret_cast<double*>(aCopy.pointer), lda, reinterpret_cast<int*>(pivot.pointer));
-						if (info != 0)
-							throw OpenBlasException(__func__);
+			/**
+			 * A = A^(-1) for symmetric A, overwritten in place (Cholesky with potri, Ldlt with sytri)
+			 */
+			template<MathDomain md>
+			static void InvertSymmetric(MemoryTile& A, const DenseSolverType solver, SolverWorkspace& workspace);
 
-						// Solve factorized system
-						info = GENERIC_API_NAMESPACE::LAPACKE_dgetrs(static_cast<int>(columnMajorLayout), openBlasOperation[static_cast<unsigned>(aOperation)], nra, ncb, reinterpret_cast<double*>(aCopy.pointer), lda, reinterpret_cast<int*>(pivot.pointer), reinterpret_cast<double*>(B.pointer), ldb);
-						if (info != 0)
-							throw OpenBlasException(__func__);
+			template<>
+			inline void InvertSymmetric<MathDomain::Float>(MemoryTile& A, const DenseSolverType solver, SolverWorkspace& workspace)
+			{
+				MemoryBuffer auxiliary = GetAuxiliaryBuffer<MathDomain::Float>(A, solver, workspace);
+				Factorize<MathDomain::Float>(A, auxiliary, solver, workspace);
 
-						// free memory
-						Free(pivot);
+				const auto nra = static_cast<int>(A.nRows);
+				const auto lda = static_cast<int>(A.leadingDimension);
 
+				int info = 0;
+				switch (solver)
+				{
+					case DenseSolverType::Cholesky:
+						info = GENERIC_API_NAMESPACE::LAPACKE_spotri(static_cast<int>(columnMajorLayout), 'L', nra, reinterpret_cast<float*>(A.pointer), lda);
 						break;
-					}
-					case LinearSystemSolverType::Qr:
-					{
-						// allocate memory for tau
-						MemoryBuffer tau(0, A.nRows, A.memorySpace, MathDomain::Double);
-						Alloc(tau);
-
-						// A = Q * R
-						/* int matrix_layout, lapack_int m, lapack_int n,
-								   double* a, lapack_int lda, double* tau */
-						info = GENERIC_API_NAMESPACE::LAPACKE_dgeqrf(static_cast<int>(columnMajorLayout), nra, nra, reinterpret_cast<double*>(aCopy.pointer), lda, reinterpret_cast<double*>(tau.pointer));
-						if (info != 0)
-							throw OpenBlasException(__func__);
-
-						// B = Q^T * B
-						/*
-						 *  int matrix_layout, char side, char trans,
-								   lapack_int m, lapack_int n, lapack_int k,
-								   const double* a, lapack_int lda, const double* tau,
-								   double* c, lapack_int ldc */
-						info = GENERIC_API_NAMESPACE::LAPACKE_dormqr(static_cast<int>(columnMajorLayout), 'L', 'T', nra, nra, ncb, reinterpret_cast<double*>(aCopy.pointer), lda, reinterpret_cast<double*>(tau.pointer), reinterpret_cast<double*>(B.pointer), ldb);
-						if (info != 0)
-							throw OpenBlasException(__func__);
-
-						// Solve (x = R \ (Q^T * B))
-						cblas_dtrsm(columnMajorLayout, GENERIC_API_NAMESPACE::CBLAS_SIDE::CblasLeft, GENERIC_API_NAMESPACE::CBLAS_UPLO::CblasUpper, operationsEnum[static_cast<unsigned>(aOperation)], GENERIC_API_NAMESPACE::CBLAS_DIAG::CblasNonUnit, nra, nra, 1.0, reinterpret_cast<double*>(aCopy.pointer), lda, reinterpret_cast<double*>(B.pointer), ldb);
-
-						// free memory
-						Free(tau);
+					case DenseSolverType::Ldlt:
+						info = GENERIC_API_NAMESPACE::LAPACKE_ssytri(static_cast<int>(columnMajorLayout), 'L', nra, reinterpret_cast<float*>(A.pointer), lda, reinterpret_cast<int*>(auxiliary.pointer));
+						break;
+					default:
+						throw NotImplementedException();
+				}
+
+				if (info > 0)
+					throw FactorizationException(solver, info);
+				if (info != 0)
+					throw OpenBlasException(__func__);
 
+				SymmetrizeLower<MathDomain::Float>(A);
+			}
+
+			template<>
+			inline void InvertSymmetric<MathDomain::Double>(MemoryTile& A, const DenseSolverType solver, SolverWorkspace& workspace)
+			{
+				MemoryBuffer auxiliary = GetAuxiliaryBuffer<MathDomain::Double>(A, solver, workspace);
+				Factorize<MathDomain::Double>(A, auxiliary, solver, workspace);
+
+				const auto nra = static_cast<int>(A.nRows);
+				const auto lda = static_cast<int>(A.leadingDimension);
+
+				int info = 0;
+				switch (solver)
+				{
+					case DenseSolverType::Cholesky:
+						info = GENERIC_API_NAMESPACE::LAPACKE_dpotri(static_cast<int>(columnMajorLayout), 'L', nra, reinterpret_cast<double*>(A.pointer), lda);
+						break;
+					case DenseSolverType::Ldlt:
+						info = GENERIC_API_NAMESPACE::LAPACKE_dsytri(static_cast<int>(columnMajorLayout), 'L', nra, reinterpret_cast<double*>(A.pointer), lda, reinterpret_cast<int*>(auxiliary.pointer));
 						break;
-					}
 					default:
 						throw NotImplementedException();
 				}
 
-				Free(aCopy);
+				if (info > 0)
+					throw FactorizationException(solver, info);
+				if (info != 0)
+					throw OpenBlasException(__func__);
+
+				SymmetrizeLower<MathDomain::Double>(A);
+			}
+
+			template<MathDomain md>
+			static void Solve(const MemoryTile& A, MemoryTile& B, const MatrixOperation aOperation, const DenseSolverType solver, SolverWorkspace& workspace)
+			{
+				// Need to copy A, as it will be overwritten by its factorization
+				MemoryTile aCopy = workspace.GetMatrix(A);
+				if (A.leadingDimension == A.nRows)
+					Copy<md>(aCopy, A);
+				else
+				{
+					// sub-matrix view: its columns aren't contiguous
+					for (unsigned j = 0; j < A.nCols; ++j)
+					{
+						MemoryBuffer column;
+						MemoryBuffer columnCopy;
+						ExtractColumnBufferFromMatrix(column, A, j);
+						ExtractColumnBufferFromMatrix(columnCopy, aCopy, j);
+						Copy<md>(columnCopy, column);
+					}
+				}
+
+				MemoryBuffer auxiliary = GetAuxiliaryBuffer<md>(A, solver, workspace);
+				Factorize<md>(aCopy, auxiliary, solver, workspace);
+				SolveFactorized<md>(aCopy, auxiliary, B, aOperation, solver, workspace);
 			}
 
 			template<MathDomain md>
@@ -508,6 +764,21 @@ namespace cl
 			{
 				norm = GENERIC_API_NAMESPACE::cblas_dnrm2(static_cast<int>(z.size), reinterpret_cast<double*>(z.pointer), 1);
 			}
+
+			// result = x^T * y
+			template<MathDomain md>
+			static void InnerProduct(double& result, const MemoryBuffer& x, const MemoryBuffer& y);
+
+			template<>
+			inline void InnerProduct<MathDomain::Float>(double& result, const MemoryBuffer& x, const MemoryBuffer& y)
+			{
+				result = static_cast<double>(GENERIC_API_NAMESPACE::cblas_sdot(static_cast<int>(x.size), reinterpret_cast<float*>(x.pointer), 1, reinterpret_cast<float*>(y.pointer), 1));
+			}
+			template<>
+			inline void InnerProduct<MathDomain::Double>(double& result, const MemoryBuffer& x, const MemoryBuffer& y)
+			{
+				result = GENERIC_API_NAMESPACE::cblas_ddot(static_cast<int>(x.size), reinterpret_cast<double*>(x.pointer), 1, reinterpret_cast<double*>(y.pointer), 1);
+			}
 		}
 	}	 // namespace routines
 }	 // namespace cl
@@ -515,6 +786,8 @@ namespace cl
 #endif
 
 #undef GENERIC_API_DEFINE
+#undef GENERIC_API_SET_NUM_THREADS
+#undef GENERIC_API_GET_NUM_THREADS
 #undef GENERIC_API_NAMESPACE
 #undef GENERIC_API_ROUTINES_NAMESPACE
 #undef ROUTINES_NAMESPACE
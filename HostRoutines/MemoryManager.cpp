@@ -5,8 +5,10 @@
 #include <Exceptions.h>
 #include <Flags.h>
 #include <GenericBlasAllWrappers.h>
+#include <MemoryPool.h>
 #include <MklAllWrappers.h>
 #include <OpenBlasAllWrappers.h>
+#include <Parallel.h>
 #include <Types.h>
 
 #include <cstdlib>
@@ -42,7 +44,7 @@ namespace cl
 							auto* destPtr = GetPointer<MathDomain::Float>(dest);
 							const auto* sourcePtr = GetPointer<MathDomain::Float>(source);
 
-							std::copy(sourcePtr, sourcePtr + source.size, destPtr);
+							detail::ParallelFor(source.size, detail::elementWiseGrainSize, [&](const size_t begin, const size_t end) { std::copy(sourcePtr + begin, sourcePtr + end, destPtr + begin); });
 							break;
 						}
 						default:
@@ -69,7 +71,7 @@ namespace cl
 							auto* destPtr = GetPointer<MathDomain::Double>(dest);
 							const auto* sourcePtr = GetPointer<MathDomain::Double>(source);
 
-							std::copy(sourcePtr, sourcePtr + source.size, destPtr);
+							detail::ParallelFor(source.size, detail::elementWiseGrainSize, [&](const size_t begin, const size_t end) { std::copy(sourcePtr + begin, sourcePtr + end, destPtr + begin); });
 							break;
 						}
 						default:
@@ -89,7 +91,7 @@ namespace cl
 							auto* destPtr = GetPointer<MathDomain::Int>(dest);
 							const auto* sourcePtr = GetPointer<MathDomain::Int>(source);
 
-							std::copy(sourcePtr, sourcePtr + source.size, destPtr);
+							detail::ParallelFor(source.size, detail::elementWiseGrainSize, [&](const size_t begin, const size_t end) { std::copy(sourcePtr + begin, sourcePtr + end, destPtr + begin); });
 							break;
 						}
 						default:
@@ -104,6 +106,9 @@ namespace cl
 
 		void Alloc(MemoryBuffer& buf)
 		{
+			if (pool::Acquire(buf))
+				return;
+
 			switch (buf.mathDomain)
 			{
 				case MathDomain::Float:
@@ -190,6 +195,12 @@ namespace cl
 
 		void Free(MemoryBuffer& buf)
 		{
+			if (pool::Release(buf))
+			{
+				buf.pointer = 0;
+				return;
+			}
+
 			switch (buf.mathDomain)
 			{
 				case MathDomain::Float:
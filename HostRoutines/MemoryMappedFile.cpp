@@ -0,0 +1,77 @@
+#include <MemoryMappedFile.h>
+
+#include <Exceptions.h>
+
+#ifndef _MSC_VER
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+namespace cl
+{
+	namespace routines
+	{
+		MemoryMappedFile::MemoryMappedFile(const std::string& fileName, const size_t arrayOffset)
+		{
+#ifndef _MSC_VER
+			const int fileDescriptor = open(fileName.c_str(), O_RDONLY);
+			if (fileDescriptor < 0)
+				throw MemoryMappingException("Cannot open the npy file");
+
+			struct stat fileStatus;
+			if (fstat(fileDescriptor, &fileStatus) != 0 || fileStatus.st_size <= 0)
+			{
+				close(fileDescriptor);
+				throw MemoryMappingException("Cannot read the npy file size");
+			}
+
+			// private and writable: writes are copy-on-write, the file is never modified
+			_mappingSize = static_cast<size_t>(fileStatus.st_size);
+			_mapping = mmap(nullptr, _mappingSize, PROT_READ | PROT_WRITE, MAP_PRIVATE, fileDescriptor, 0);
+
+			// the mapping stays valid after closing the file descriptor
+			close(fileDescriptor);
+			if (_mapping == MAP_FAILED)
+			{
+				_mapping = nullptr;
+				throw MemoryMappingException("mmap failed");
+			}
+
+			try
+			{
+				if (arrayOffset >= _mappingSize)
+					throw MemoryMappingException("Array offset past the end of the file");
+				ParseHeader(static_cast<const char*>(_mapping) + arrayOffset, _mappingSize - arrayOffset);
+			}
+			catch (...)
+			{
+				munmap(_mapping, _mappingSize);
+				throw;
+			}
+#else
+			(void)fileName;
+			(void)arrayOffset;
+			throw NotImplementedException();
+#endif
+		}
+
+		MemoryMappedFile::~MemoryMappedFile()
+		{
+#ifndef _MSC_VER
+			if (_mapping)
+				munmap(_mapping, _mappingSize);
+#endif
+		}
+
+		void MemoryMappedFile::ParseHeader(const char* begin, const size_t size)
+		{
+			_header = ParseNpyHeader(begin, size);
+			if (_header.dataOffset + GetSize() * _header.GetElementSize() > size)
+				throw MemoryMappingException("Truncated npy data");
+
+			_data = reinterpret_cast<ptr_t>(begin + _header.dataOffset);
+		}
+	}	 // namespace routines
+}	 // namespace cl
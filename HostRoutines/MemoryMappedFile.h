@@ -0,0 +1,58 @@
+#pragma once
+
+#include <NpyFile.h>
+#include <Types.h>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace cl
+{
+	namespace routines
+	{
+		/**
+		 * Uncompressed .npy file mapped in memory: GetData points directly at the array payload, so buffers can be backed by
+		 * the file without copying it. Pages are loaded on demand and shared in the page cache with other processes mapping
+		 * the same file.
+		 *
+		 * The mapping is private (copy-on-write): writing through GetData never modifies the file, and only the touched
+		 * pages get copied.
+		 *
+		 * arrayOffset is where the .npy file starts, e.g. the data offset of an array stored in a .npz archive.
+		 */
+		class MemoryMappedFile
+		{
+		public:
+			explicit MemoryMappedFile(const std::string& fileName, const size_t arrayOffset = 0);
+			~MemoryMappedFile();
+
+			MemoryMappedFile(const MemoryMappedFile&) = delete;
+			MemoryMappedFile& operator=(const MemoryMappedFile&) = delete;
+
+			ptr_t GetData() const noexcept { return _data; }
+
+			const std::vector<size_t>& GetShape() const noexcept { return _header.shape; }
+
+			// number of elements in the array
+			size_t GetSize() const noexcept { return _header.GetSize(); }
+
+			bool IsFortranOrder() const noexcept { return _header.fortranOrder; }
+
+			/**
+			 * Whether the payload can be used in place as a buffer of the given math domain (i.e. it has the same
+			 * little-endian element type)
+			 */
+			bool HasMathDomain(const MathDomain mathDomain) const noexcept { return _header.HasMathDomain(mathDomain); }
+
+		private:
+			void ParseHeader(const char* begin, const size_t size);
+
+			void* _mapping = nullptr;
+			size_t _mappingSize = 0;
+
+			ptr_t _data = 0;
+			NpyHeader _header {};
+		};
+	}	 // namespace routines
+}	 // namespace cl
@@ -0,0 +1,320 @@
+#include <MemoryPool.h>
+
+#include <Exceptions.h>
+#include <MklAllWrappers.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cstdlib>
+#include <mutex>
+#include <vector>
+
+namespace cl
+{
+	namespace routines
+	{
+		namespace pool
+		{
+			namespace
+			{
+#ifdef USE_MEMORY_POOL
+				constexpr bool enabled = true;
+#else
+				constexpr bool enabled = false;
+#endif
+
+				constexpr size_t alignmentBits = { 64 };
+
+				constexpr unsigned minClassLog = 6;	 // 64 bytes
+				constexpr unsigned maxClassLog = 30;	 // blocks bigger than 1GB always go to the system allocator
+				constexpr unsigned subClassesLog = 2;
+				constexpr size_t nSubClasses = size_t(1) << subClassesLog;
+				constexpr size_t nClasses = 1 + (maxClassLog - minClassLog) * nSubClasses;
+
+				// Test, OpenBlas and GenericBlas share the aligned system allocator, Mkl has its own
+				constexpr size_t nAllocators = 2;
+
+				/**
+				 * Returns nClasses if the request is too big for being pooled.
+				 * Above 64 bytes each power of two interval (2^e, 2^(e+1)] is split in 4 classes, so that the rounding wastes at most 25%
+				 */
+				size_t GetSizeClass(const size_t bytes, size_t& classBytes) noexcept
+				{
+					if (bytes <= (size_t(1) << minClassLog))
+					{
+						classBytes = size_t(1) << minClassLog;
+						return 0;
+					}
+
+					// 2^e <= bytes - 1 < 2^(e+1)
+					unsigned e = 0;
+					for (size_t x = bytes - 1; x > 1; x >>= 1)
+						++e;
+					if (e >= maxClassLog)
+						return nClasses;
+
+					const size_t step = size_t(1) << (e - subClassesLog);
+					const size_t nSteps = (bytes - 1) / step + 1;	 // in [nSubClasses + 1, 2 * nSubClasses]
+					classBytes = nSteps * step;
+
+					return 1 + (e - minClassLog) * nSubClasses + (nSteps - nSubClasses - 1);
+				}
+
+				bool IsPooled(const MemorySpace memorySpace) noexcept
+				{
+					switch (memorySpace)
+					{
+						case MemorySpace::Test:
+						case MemorySpace::OpenBlas:
+						case MemorySpace::GenericBlas:
+						case MemorySpace::Mkl:
+							return true;
+						default:
+							return false;
+					}
+				}
+
+				size_t GetAllocatorIndex(const MemorySpace memorySpace) noexcept { return memorySpace == MemorySpace::Mkl ? 1 : 0; }
+
+				void* SystemAlloc(const size_t bytes, const size_t allocator)
+				{
+					if (allocator == GetAllocatorIndex(MemorySpace::Mkl))
+					{
+						// class sizes are multiple of 16 bytes
+						MemoryBuffer block(0, static_cast<unsigned>(bytes / sizeof(float)), MemorySpace::Mkl, MathDomain::Float);
+						mkr::Alloc(block);
+						return reinterpret_cast<void*>(block.pointer);	  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+					}
+
+					void* ptr = nullptr;
+					auto err = posix_memalign(&ptr, alignmentBits, bytes);
+					assert(err == 0);
+					assert(ptr != nullptr);
+
+					return ptr;
+				}
+
+				void SystemFree(void* ptr, const size_t allocator)
+				{
+					if (allocator == GetAllocatorIndex(MemorySpace::Mkl))
+					{
+						MemoryBuffer block(reinterpret_cast<ptr_t>(ptr), 0, MemorySpace::Mkl, MathDomain::Float);	 // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+						mkr::Free(block);
+						return;
+					}
+
+					std::free(ptr);	   // NOLINT
+				}
+
+				std::atomic<size_t> highWaterMark { size_t(256) << 20 };
+
+				struct ThreadCache
+				{
+					ThreadCache();
+					~ThreadCache();
+
+					ThreadCache(const ThreadCache&) = delete;
+					ThreadCache(ThreadCache&&) = delete;
+					ThreadCache& operator=(const ThreadCache&) = delete;
+					ThreadCache& operator=(ThreadCache&&) = delete;
+
+					// only contended by Trim/GetStatistics
+					std::mutex mutex {};
+					std::array<std::array<std::vector<void*>, nClasses>, nAllocators> freeLists {};
+					Statistics statistics {};
+
+					void FreeAll()
+					{
+						for (size_t allocator = 0; allocator < nAllocators; ++allocator)
+						{
+							for (auto& freeList : freeLists[allocator])
+							{
+								for (auto* ptr : freeList)
+									SystemFree(ptr, allocator);
+								freeList.clear();
+								freeList.shrink_to_fit();
+							}
+						}
+
+						statistics.cachedBytes = 0;
+						statistics.cachedBlocks = 0;
+					}
+				};
+
+				struct Registry
+				{
+					std::mutex mutex {};
+					std::vector<ThreadCache*> caches {};
+
+					// counters of the threads that already exited
+					Statistics retired {};
+				};
+
+				Registry& GetRegistry()
+				{
+					static Registry registry;
+					return registry;
+				}
+
+				ThreadCache::ThreadCache()
+				{
+					auto& registry = GetRegistry();
+					std::lock_guard<std::mutex> lock(registry.mutex);
+					registry.caches.push_back(this);
+				}
+
+				ThreadCache::~ThreadCache()
+				{
+					auto& registry = GetRegistry();
+					std::lock_guard<std::mutex> registryLock(registry.mutex);
+					registry.caches.erase(std::remove(registry.caches.begin(), registry.caches.end(), this), registry.caches.end());
+
+					std::lock_guard<std::mutex> lock(mutex);
+					FreeAll();
+
+					registry.retired.hits += statistics.hits;
+					registry.retired.misses += statistics.misses;
+					registry.retired.releases += statistics.releases;
+					registry.retired.evictions += statistics.evictions;
+				}
+
+				ThreadCache& GetThreadCache()
+				{
+					thread_local ThreadCache cache;
+					return cache;
+				}
+
+				void Accumulate(Statistics& out, const Statistics& in) noexcept
+				{
+					out.hits += in.hits;
+					out.misses += in.misses;
+					out.releases += in.releases;
+					out.evictions += in.evictions;
+					out.cachedBytes += in.cachedBytes;
+					out.cachedBlocks += in.cachedBlocks;
+				}
+			}	 // namespace
+
+			bool IsEnabled() noexcept { return enabled; }
+
+			void SetHighWaterMark(const size_t bytes) { highWaterMark.store(bytes); }
+
+			size_t GetHighWaterMark() noexcept { return highWaterMark.load(); }
+
+			void Trim()
+			{
+				auto& registry = GetRegistry();
+				std::lock_guard<std::mutex> registryLock(registry.mutex);
+				for (auto* cache : registry.caches)
+				{
+					std::lock_guard<std::mutex> lock(cache->mutex);
+					cache->FreeAll();
+				}
+			}
+
+			Statistics GetStatistics()
+			{
+				auto& registry = GetRegistry();
+				std::lock_guard<std::mutex> registryLock(registry.mutex);
+
+				Statistics ret = registry.retired;
+				for (auto* cache : registry.caches)
+				{
+					std::lock_guard<std::mutex> lock(cache->mutex);
+					Accumulate(ret, cache->statistics);
+				}
+
+				return ret;
+			}
+
+			void ResetStatistics()
+			{
+				auto& registry = GetRegistry();
+				std::lock_guard<std::mutex> registryLock(registry.mutex);
+
+				registry.retired = Statistics();
+				for (auto* cache : registry.caches)
+				{
+					std::lock_guard<std::mutex> lock(cache->mutex);
+
+					// cached bytes/blocks describe the current state, they're not counters
+					const size_t cachedBytes = cache->statistics.cachedBytes;
+					const size_t cachedBlocks = cache->statistics.cachedBlocks;
+					cache->statistics = Statistics();
+					cache->statistics.cachedBytes = cachedBytes;
+					cache->statistics.cachedBlocks = cachedBlocks;
+				}
+			}
+
+			bool Acquire(MemoryBuffer& buf)
+			{
+				if (!enabled || !IsPooled(buf.memorySpace))
+					return false;
+
+				size_t classBytes = 0;
+				const size_t sizeClass = GetSizeClass(buf.TotalSize(), classBytes);
+				if (sizeClass >= nClasses)
+					return false;
+
+				const size_t allocator = GetAllocatorIndex(buf.memorySpace);
+				auto& cache = GetThreadCache();
+				{
+					std::lock_guard<std::mutex> lock(cache.mutex);
+
+					auto& freeList = cache.freeLists[allocator][sizeClass];
+					if (!freeList.empty())
+					{
+						buf.pointer = reinterpret_cast<ptr_t>(freeList.back());	 // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+						freeList.pop_back();
+
+						++cache.statistics.hits;
+						cache.statistics.cachedBytes -= classBytes;
+						--cache.statistics.cachedBlocks;
+						return true;
+					}
+
+					++cache.statistics.misses;
+				}
+
+				buf.pointer = reinterpret_cast<ptr_t>(SystemAlloc(classBytes, allocator));	  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+				return true;
+			}
+
+			bool Release(MemoryBuffer& buf)
+			{
+				if (!enabled || !IsPooled(buf.memorySpace))
+					return false;
+
+				size_t classBytes = 0;
+				const size_t sizeClass = GetSizeClass(buf.TotalSize(), classBytes);
+				if (sizeClass >= nClasses)
+					return false;
+
+				const size_t allocator = GetAllocatorIndex(buf.memorySpace);
+				auto* ptr = reinterpret_cast<void*>(buf.pointer);	 // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+
+				auto& cache = GetThreadCache();
+				{
+					std::lock_guard<std::mutex> lock(cache.mutex);
+
+					if (cache.statistics.cachedBytes + classBytes <= highWaterMark.load(std::memory_order_relaxed))
+					{
+						cache.freeLists[allocator][sizeClass].push_back(ptr);
+
+						++cache.statistics.releases;
+						cache.statistics.cachedBytes += classBytes;
+						++cache.statistics.cachedBlocks;
+						return true;
+					}
+
+					++cache.statistics.evictions;
+				}
+
+				SystemFree(ptr, allocator);
+				return true;
+			}
+		}	 // namespace pool
+	}		 // namespace routines
+}	 // namespace cl
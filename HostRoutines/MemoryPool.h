@@ -0,0 +1,61 @@
+#pragma once
+
+#include <Flags.h>
+#include <Types.h>
+
+#include <cstddef>
+
+namespace cl
+{
+	namespace routines
+	{
+		/**
+		 * Size-class caching pool used by Alloc/Free for the host memory spaces (Test, OpenBlas, GenericBlas, Mkl).
+		 * It's enabled at compile time with USE_MEMORY_POOL: when disabled Acquire/Release never take ownership of a buffer
+		 * and every allocation goes straight to the system allocator.
+		 *
+		 * Requests are rounded up to a size class (4 classes per power of two, starting from 64 bytes), and released blocks
+		 * are kept in a per-thread free list until the thread cache exceeds the high-water mark.
+		 */
+		namespace pool
+		{
+			struct Statistics
+			{
+				size_t hits = 0;
+				size_t misses = 0;
+				size_t releases = 0;
+				size_t evictions = 0;	 // blocks given back to the system because the thread cache was full
+				size_t cachedBytes = 0;
+				size_t cachedBlocks = 0;
+
+				double HitRate() const noexcept { return hits + misses == 0 ? 0.0 : static_cast<double>(hits) / static_cast<double>(hits + misses); }
+			};
+
+			extern bool IsEnabled() noexcept;
+
+			/**
+			 * Maximum number of bytes cached by each thread; 0 disables caching without disabling the size-class rounding
+			 */
+			extern void SetHighWaterMark(const size_t bytes);
+			extern size_t GetHighWaterMark() noexcept;
+
+			/**
+			 * Gives back to the system every cached block, from all the threads
+			 */
+			extern void Trim();
+
+			extern Statistics GetStatistics();
+			extern void ResetStatistics();
+
+			/**
+			 * Sets buf.pointer to a block able to hold buf.TotalSize() bytes, returns false if buf is not handled by the pool
+			 */
+			extern bool Acquire(MemoryBuffer& buf);
+
+			/**
+			 * Returns buf.pointer to the pool, returns false if buf is not handled by the pool
+			 */
+			extern bool Release(MemoryBuffer& buf);
+		}	 // namespace pool
+	}		 // namespace routines
+}	 // namespace cl
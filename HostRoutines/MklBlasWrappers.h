@@ -1,9 +1,13 @@
 #pragma once
 
 #include <BufferInitializer.h>
+#include <Common.h>
+#include <ElementWiseMath.h>
 #include <Exceptions.h>
+#include <SolverWorkspace.h>
 #include <Types.h>
 
+#include <algorithm>
 #include <array>
 #include <vector>
 
@@ -15,6 +19,8 @@ namespace cl
 	{
 		namespace mkr
 		{
+			static inline void SetNumThreads(const size_t) {}
+
 			template<MathDomain md>
 			static void Add(MemoryBuffer&, const MemoryBuffer&, const MemoryBuffer&, const double)
 			{
@@ -51,6 +57,12 @@ namespace cl
 				throw NotImplementedException();
 			}
 
+			template<MathDomain md>
+			static void ApplyElementWiseFunction(MemoryBuffer&, const MemoryBuffer&, const ElementWiseFunction, const double)
+			{
+				throw NotImplementedException();
+			}
+
 			template<MathDomain md>
 			static void SubMultiply(MemoryTile&, const MemoryTile&, const MemoryTile&, const unsigned, const unsigned, const unsigned, const MatrixOperation, const MatrixOperation, const double, const double)
 			{
@@ -76,7 +88,25 @@ namespace cl
 			}
 
 			template<MathDomain md>
-			static void Solve(const MemoryTile&, MemoryTile&, const MatrixOperation, const LinearSystemSolverType)
+			static void Factorize(MemoryTile&, MemoryBuffer&, const DenseSolverType, SolverWorkspace&)
+			{
+				throw NotImplementedException();
+			}
+
+			template<MathDomain md>
+			static void SolveFactorized(const MemoryTile&, const MemoryBuffer&, MemoryTile&, const MatrixOperation, const DenseSolverType, SolverWorkspace&)
+			{
+				throw NotImplementedException();
+			}
+
+			template<MathDomain md>
+			static void Solve(const MemoryTile&, MemoryTile&, const MatrixOperation, const DenseSolverType, SolverWorkspace&)
+			{
+				throw NotImplementedException();
+			}
+
+			template<MathDomain md>
+			static void InvertSymmetric(MemoryTile&, const DenseSolverType, SolverWorkspace&)
 			{
 				throw NotImplementedException();
 			}
@@ -111,6 +141,13 @@ namespace cl
 			{
 				throw NotImplementedException();
 			}
+
+			// result = x^T * y
+			template<MathDomain md>
+			static void InnerProduct(double&, const MemoryBuffer&, const MemoryBuffer&)
+			{
+				throw NotImplementedException();
+			}
 		}	 // namespace mkr
 	}		 // namespace routines
 }	 // namespace cl
@@ -131,6 +168,9 @@ namespace cl
 		{
 			static constexpr mkl::CBLAS_LAYOUT columnMajorLayout = { mkl::CBLAS_LAYOUT::CblasColMajor };
 			static constexpr std::array<mkl::CBLAS_TRANSPOSE, 2> mklOperationsEnum = { mkl::CBLAS_TRANSPOSE::CblasNoTrans, mkl::CBLAS_TRANSPOSE::CblasTrans };
+			static constexpr std::array<const char*, 2> mklOperationGemm = { "N", "T" };
+
+			static inline void SetNumThreads(const size_t nThreads) { mkl::mkl_set_num_threads(static_cast<int>(nThreads)); }
 
 			template<MathDomain md>
 			static void Add(MemoryBuffer& z, const MemoryBuffer& x, const MemoryBuffer& y, const double alpha);
@@ -225,6 +265,72 @@ namespace cl
 					Scale<MathDomain::Float>(z, alpha);
 			}
 
+			// y = function(x) through VML, which is multithreaded
+			template<MathDomain md>
+			static void ApplyElementWiseFunction(MemoryBuffer& y, const MemoryBuffer& x, const ElementWiseFunction function, const double exponent);
+
+			template<>
+			inline void ApplyElementWiseFunction<MathDomain::Float>(MemoryBuffer& y, const MemoryBuffer& x, const ElementWiseFunction function, const double exponent)
+			{
+				const auto n = static_cast<int>(y.size);
+				const auto* xPtr = reinterpret_cast<const float*>(x.pointer);
+				auto* yPtr = reinterpret_cast<float*>(y.pointer);
+				switch (function)
+				{
+					case ElementWiseFunction::Exp:
+						mkl::vsExp(n, xPtr, yPtr);
+						break;
+					case ElementWiseFunction::Log:
+						mkl::vsLn(n, xPtr, yPtr);
+						break;
+					case ElementWiseFunction::Sqrt:
+						mkl::vsSqrt(n, xPtr, yPtr);
+						break;
+					case ElementWiseFunction::Pow:
+						mkl::vsPowx(n, xPtr, static_cast<float>(exponent), yPtr);
+						break;
+					case ElementWiseFunction::Tanh:
+						mkl::vsTanh(n, xPtr, yPtr);
+						break;
+					case ElementWiseFunction::Erf:
+						mkl::vsErf(n, xPtr, yPtr);
+						break;
+					default:
+						throw NotImplementedException();
+				}
+			}
+
+			template<>
+			inline void ApplyElementWiseFunction<MathDomain::Double>(MemoryBuffer& y, const MemoryBuffer& x, const ElementWiseFunction function, const double exponent)
+			{
+				const auto n = static_cast<int>(y.size);
+				const auto* xPtr = reinterpret_cast<const double*>(x.pointer);
+				auto* yPtr = reinterpret_cast<double*>(y.pointer);
+				switch (function)
+				{
+					case ElementWiseFunction::Exp:
+						mkl::vdExp(n, xPtr, yPtr);
+						break;
+					case ElementWiseFunction::Log:
+						mkl::vdLn(n, xPtr, yPtr);
+						break;
+					case ElementWiseFunction::Sqrt:
+						mkl::vdSqrt(n, xPtr, yPtr);
+						break;
+					case ElementWiseFunction::Pow:
+						mkl::vdPowx(n, xPtr, exponent, yPtr);
+						break;
+					case ElementWiseFunction::Tanh:
+						mkl::vdTanh(n, xPtr, yPtr);
+						break;
+					case ElementWiseFunction::Erf:
+						mkl::vdErf(n, xPtr, yPtr);
+						break;
+					default:
+						throw NotImplementedException();
+				}
+			}
+
 			template<MathDomain md>
 			static void SubMultiply(MemoryTile& A, const MemoryTile& B, const MemoryTile& C, const unsigned nRowsB, const unsigned nColsB, const unsigned nColsC, const MatrixOperation bOperation, const MatrixOperation cOperation, const double alpha, const double beta);
 
@@ -326,157 +432,345 @@ namespace cl
 				mkl::cblas_dger(columnMajorLayout, static_cast<int>(x.size), static_cast<int>(y.size), alpha, reinterpret_cast<double*>(x.pointer), 1, reinterpret_cast<double*>(y.pointer), 1, reinterpret_cast<double*>(A.pointer), static_cast<int>(A.nRows));
 			}
 
+			// LAPACK work buffer size, as a multiple of the number of columns
+			static constexpr size_t workBufferMultiple = { 64 };
+
+			/**
+			 * Overwrites A with its factorization: auxiliary holds the pivot indices (Lu) or the Householder coefficients (Qr)
+			 */
 			template<MathDomain md>
-			static void Solve(const MemoryTile& A, MemoryTile& B, const MatrixOperation aOperation, const LinearSystemSolverType solver);
+			static void Factorize(MemoryTile& A, MemoryBuffer& auxiliary, const DenseSolverType solver, SolverWorkspace& workspace);
+
+			/**
+			 * B = A^(-1) * B, A and auxiliary being the output of Factorize
+			 */
+			template<MathDomain md>
+			static void SolveFactorized(const MemoryTile& A, const MemoryBuffer& auxiliary, MemoryTile& B, const MatrixOperation aOperation, const DenseSolverType solver, SolverWorkspace& workspace);
 
 			template<>
-			inline void Solve<MathDomain::Float>(const MemoryTile& A, MemoryTile& B, const MatrixOperation aOperation, const LinearSystemSolverType solver)
+			inline void Factorize<MathDomain::Float>(MemoryTile& A, MemoryBuffer& auxiliary, const DenseSolverType solver, SolverWorkspace& workspace)
 			{
-				// Need to copy A, as it will be overwritten by its factorization
-				MemoryTile aCopy(A);
-				Alloc(aCopy);
-				Copy<MathDomain::Float>(aCopy, A);
+				const auto nra = static_cast<int>(A.nRows);
+				const auto lda = static_cast<int>(A.leadingDimension);
+
+				int info = 0;
+				switch (solver)
+				{
+					case DenseSolverType::Lu:
+						// A = P * L * U, overwrites A with L and U
+						mkl::sgetrf(&nra, &nra, reinterpret_cast<float*>(A.pointer), &lda, reinterpret_cast<int*>(auxiliary.pointer), &info);
+						break;
+					case DenseSolverType::Qr:
+					{
+						const int workSize = static_cast<int>(A.nCols * workBufferMultiple);
+						MemoryBuffer buffer = workspace.GetWork(static_cast<unsigned>(workSize), A.memorySpace, MathDomain::Float);
+
+						// A = Q * R, overwrites A with R and the Householder reflectors
+						mkl::sgeqrf(&nra, &nra, reinterpret_cast<float*>(A.pointer), &lda, reinterpret_cast<float*>(auxiliary.pointer), reinterpret_cast<float*>(buffer.pointer), &workSize, &info);
+						break;
+					}
+					case DenseSolverType::Cholesky:
+						// A = L * L^T, overwrites the lower triangular part of A with L
+						mkl::spotrf("L", &nra, reinterpret_cast<float*>(A.pointer), &lda, &info);
+						break;
+					case DenseSolverType::Ldlt:
+					{
+						const int workSize = static_cast<int>(A.nCols * workBufferMultiple);
+						MemoryBuffer buffer = workspace.GetWork(static_cast<unsigned>(workSize), A.memorySpace, MathDomain::Float);
 
+						// A = L * D * L^T with Bunch-Kaufman pivoting, overwrites the lower triangular part of A with D and L
+						mkl::ssytrf("L", &nra, reinterpret_cast<float*>(A.pointer), &lda, reinterpret_cast<int*>(auxiliary.pointer), reinterpret_cast<float*>(buffer.pointer), &workSize, &info);
+						break;
+					}
+					default:
+						throw NotImplementedException();
+				}
+
+				if (info > 0)
+					throw FactorizationException(solver, info);
+				if (info != 0)
+					throw MklException(__func__);
+			}
+
+			template<>
+			inline void SolveFactorized<MathDomain::Float>(const MemoryTile& A, const MemoryBuffer& auxiliary, MemoryTile& B, const MatrixOperation aOperation, const DenseSolverType solver, SolverWorkspace& workspace)
+			{
 				const auto nra = static_cast<int>(A.nRows);
 				const auto lda = static_cast<int>(A.leadingDimension);
 				const auto ncb = static_cast<int>(B.nCols);
 				const auto ldb = static_cast<int>(B.leadingDimension);
 
-				// Initializes auxliary value for solver
 				int info = 0;
-
 				switch (solver)
 				{
-					case LinearSystemSolverType::Lu:
+					case DenseSolverType::Lu:
+						mkl::sgetrs(mklOperationGemm[static_cast<unsigned>(aOperation)], &nra, &ncb, reinterpret_cast<float*>(A.pointer), &lda, reinterpret_cast<int*>(auxiliary.pointer), reinterpret_cast<float*>(B.pointer), &ldb, &info);
+						break;
+					case DenseSolverType::Qr:
 					{
-						// allocate memory for pivoting
-						MemoryBuffer pivot(0, A.nRows, A.memorySpace, MathDomain::Int);
-						Alloc(pivot);
+						const int workSize = static_cast<int>(std::max(A.nCols, B.nCols) * workBufferMultiple);
+						MemoryBuffer buffer = workspace.GetWork(static_cast<unsigned>(workSize), A.memorySpace, MathDomain::Float);
+
+						if (aOperation == MatrixOperation::None)
+						{
+							// B = Q^T * B
+							mkl::sormqr("L", "T", &nra, &ncb, &nra, reinterpret_cast<float*>(A.pointer), &lda, reinterpret_cast<float*>(auxiliary.pointer), reinterpret_cast<float*>(B.pointer), &ldb, reinterpret_cast<float*>(buffer.pointer), &workSize, &info);
+							if (info != 0)
+								break;
+
+							// X = R \ (Q^T * B)
+							mkl::cblas_strsm(columnMajorLayout, mkl::CBLAS_SIDE::CblasLeft, mkl::CBLAS_UPLO::CblasUpper, mkl::CBLAS_TRANSPOSE::CblasNoTrans, mkl::CBLAS_DIAG::CblasNonUnit, nra, ncb, 1.0, reinterpret_cast<float*>(A.pointer), lda, reinterpret_cast<float*>(B.pointer), ldb);
+						}
+						else
+						{
+							// A^T = R^T * Q^T: B = R^T \ B
+							mkl::cblas_strsm(columnMajorLayout, mkl::CBLAS_SIDE::CblasLeft, mkl::CBLAS_UPLO::CblasUpper, mkl::CBLAS_TRANSPOSE::CblasTrans, mkl::CBLAS_DIAG::CblasNonUnit, nra, ncb, 1.0, reinterpret_cast<float*>(A.pointer), lda, reinterpret_cast<float*>(B.pointer), ldb);
+
+							// X = Q * B
+							mkl::sormqr("L", "N", &nra, &ncb, &nra, reinterpret_cast<float*>(A.pointer), &lda, reinterpret_cast<float*>(auxiliary.pointer), reinterpret_cast<float*>(B.pointer), &ldb, reinterpret_cast<float*>(buffer.pointer), &workSize, &info);
+						}
+						break;
+					}
+					case DenseSolverType::Cholesky:
+						// A is symmetric: aOperation is irrelevant
+						mkl::spotrs("L", &nra, &ncb, reinterpret_cast<float*>(A.pointer), &lda, reinterpret_cast<float*>(B.pointer), &ldb, &info);
+						break;
+					case DenseSolverType::Ldlt:
+						mkl::ssytrs("L", &nra, &ncb, reinterpret_cast<float*>(A.pointer), &lda, reinterpret_cast<int*>(auxiliary.pointer), reinterpret_cast<float*>(B.pointer), &ldb, &info);
+						break;
+					default:
+						throw NotImplementedException();
+				}
 
-						// Factorize A (and overwrite it with L)
-						mkl::sgetrf(&nra, &nra, reinterpret_cast<float*>(aCopy.pointer), &lda, reinterpret_cast<int*>(pivot.pointer), &info);
-						if (info != 0)
-							throw MklException(__func__);
+				if (info != 0)
+					throw MklException(__func__);
+			}
 
-						// Solve factorized system
-						mkl::sgetrs(mklOperationGemm[static_cast<unsigned>(aOperation)], &nra, &ncb, reinterpret_cast<float*>(aCopy.pointer), &lda, reinterpret_cast<int*>(pivot.pointer), reinterpret_cast<float*>(B.pointer), &ldb, &info);
-						if (info != 0)
-							throw MklException(__func__);
+			template<>
+			inline void Factorize<MathDomain::Double>(MemoryTile& A, MemoryBuffer& auxiliary, const DenseSolverType solver, SolverWorkspace& workspace)
+			{
+				const auto nra = static_cast<int>(A.nRows);
+				const auto lda = static_cast<int>(A.leadingDimension);
 
-						// free memory
-						Free(pivot);
+				int info = 0;
+				switch (solver)
+				{
+					case DenseSolverType::Lu:
+						// A = P * L * U, overwrites A with L and U
+						mkl::dgetrf(&nra, &nra, reinterpret_cast<double*>(A.pointer), &lda, reinterpret_cast<int*>(auxiliary.pointer), &info);
+						break;
+					case DenseSolverType::Qr:
+					{
+						const int workSize = static_cast<int>(A.nCols * workBufferMultiple);
+						MemoryBuffer buffer = workspace.GetWork(static_cast<unsigned>(workSize), A.memorySpace, MathDomain::Double);
 
+						// A = Q * R, overwrites A with R and the Householder reflectors
+						mkl::dgeqrf(&nra, &nra, reinterpret_cast<double*>(A.pointer), &lda, reinterpret_cast<double*>(auxiliary.pointer), reinterpret_cast<double*>(buffer.pointer), &workSize, &info);
 						break;
 					}
-					case LinearSystemSolverType::Qr:
+					case DenseSolverType::Cholesky:
+						// A = L * L^T, overwrites the lower triangular part of A with L
+						mkl::dpotrf("L", &nra, reinterpret_cast<double*>(A.pointer), &lda, &info);
+						break;
+					case DenseSolverType::Ldlt:
 					{
-						// allocate memory for tau
-						MemoryBuffer tau(0, A.nRows, A.memorySpace, MathDomain::Float);
-						Alloc(tau);
-
-						static constexpr size_t workBufferMultiple = { 64 };
 						const int workSize = static_cast<int>(A.nCols * workBufferMultiple);
-						// allocate memory for workBuffer
-						MemoryBuffer buffer(0, static_cast<unsigned>(workSize), A.memorySpace, MathDomain::Float);
-						Alloc(buffer);
-
-						// A = Q * R
-						mkl::sgeqrf(&nra, &nra, reinterpret_cast<float*>(aCopy.pointer), &lda, reinterpret_cast<float*>(tau.pointer), reinterpret_cast<float*>(buffer.pointer), &workSize, &info);
-						if (info != 0)
-							throw MklException(__func__);
-
-						// B = Q^T * B
-						mkl::sormqr("L", "T", &nra, &nra, &ncb, reinterpret_cast<float*>(aCopy.pointer), &lda, reinterpret_cast<float*>(tau.pointer), reinterpret_cast<float*>(B.pointer), &ldb, reinterpret_cast<float*>(buffer.pointer), &workSize, &info);
-						if (info != 0)
-							throw MklException(__func__);
-
-						// Solve (x = R \ (Q^T * B))
-						mkl::cblas_strsm(columnMajorLayout, mkl::CBLAS_SIDE::CblasLeft, mkl::CBLAS_UPLO::CblasUpper, mklOperationsEnum[static_cast<unsigned>(aOperation)], mkl::CBLAS_DIAG::CblasNonUnit, nra, nra, 1.0, reinterpret_cast<float*>(aCopy.pointer), lda, reinterpret_cast<float*>(B.pointer), ldb);
-
-						// free memory
-						Free(tau);
-						Free(buffer);
+						MemoryBuffer buffer = workspace.GetWork(static_cast<unsigned>(workSize), A.memorySpace, MathDomain::Double);
 
+						// A = L * D * L^T with Bunch-Kaufman pivoting, overwrites the lower triangular part of A with D and L
+						mkl::dsytrf("L", &nra, reinterpret_cast<double*>(A.pointer), &lda, reinterpret_cast<int*>(auxiliary.pointer), reinterpret_cast<double*>(buffer.pointer), &workSize, &info);
 						break;
 					}
 					default:
 						throw NotImplementedException();
 				}
 
-				Free(aCopy);
+				if (info > 0)
+					throw FactorizationException(solver, info);
+				if (info != 0)
+					throw MklException(__func__);
 			}
 
 			template<>
-			inline void Solve<MathDomain::Double>(const MemoryTile& A, MemoryTile& B, const MatrixOperation aOperation, const LinearSystemSolverType solver)
+			inline void SolveFactorized<MathDomain::Double>(const MemoryTile& A, const MemoryBuffer& auxiliary, MemoryTile& B, const MatrixOperation aOperation, const DenseSolverType solver, SolverWorkspace& workspace)
 			{
-				// Need to copy A, as it will be overwritten by its factorization
-				MemoryTile aCopy(A);
-				Alloc(aCopy);
-				Copy<MathDomain::Double>(aCopy, A);
-
 				const auto nra = static_cast<int>(A.nRows);
 				const auto lda = static_cast<int>(A.leadingDimension);
 				const auto ncb = static_cast<int>(B.nCols);
 				const auto ldb = static_cast<int>(B.leadingDimension);
 
-				// Initializes auxliary value for solver
 				int info = 0;
-
 				switch (solver)
 				{
-					case LinearSystemSolverType::Lu:
+					case DenseSolverType::Lu:
+						mkl::dgetrs(mklOperationGemm[static_cast<unsigned>(aOperation)], &nra, &ncb, reinterpret_cast<double*>(A.pointer), &lda, reinterpret_cast<int*>(auxiliary.pointer), reinterpret_cast<double*>(B.pointer), &ldb, &info);
+						break;
+					case DenseSolverType::Qr:
 					{
-						// allocate memory for pivoting
-						MemoryBuffer pivot(0, A.nRows, A.memorySpace, MathDomain::Int);
-						Alloc(pivot);
+						const int workSize = static_cast<int>(std::max(A.nCols, B.nCols) * workBufferMultiple);
+						MemoryBuffer buffer = workspace.GetWork(static_cast<unsigned>(workSize), A.memorySpace, MathDomain::Double);
+
+						if (aOperation == MatrixOperation::None)
+						{
+							// B = Q^T * B
+							mkl::dormqr("L", "T", &nra, &ncb, &nra, reinterpret_cast<double*>(A.pointer), &lda, reinterpret_cast<double*>(auxiliary.pointer), reinterpret_cast<double*>(B.pointer), &ldb, reinterpret_cast<double*>(buffer.pointer), &workSize, &info);
+							if (info != 0)
+								break;
+
+							// X = R \ (Q^T * B)
+							mkl::cblas_dtrsm(columnMajorLayout, mkl::CBLAS_SIDE::CblasLeft, mkl::CBLAS_UPLO::CblasUpper, mkl::CBLAS_TRANSPOSE::CblasNoTrans, mkl::CBLAS_DIAG::CblasNonUnit, nra, ncb, 1.0, reinterpret_cast<double*>(A.pointer), lda, reinterpret_cast<double*>(B.pointer), ldb);
+						}
+						else
+						{
+							// A^T = R^T * Q^T: B = R^T \ B
+							mkl::cblas_dtrsm(columnMajorLayout, mkl::CBLAS_SIDE::CblasLeft, mkl::CBLAS_UPLO::CblasUpper, mkl::CBLAS_TRANSPOSE::CblasTrans, mkl::CBLAS_DIAG::CblasNonUnit, nra, ncb, 1.0, reinterpret_cast<double*>(A.pointer), lda, reinterpret_cast<double*>(B.pointer), ldb);
+
+							// X = Q * B
+							mkl::dormqr("L", "N", &nra, &ncb, &nra, reinterpret_cast<double*>(A.pointer), &lda, reinterpret_cast<double*>(auxiliary.pointer), reinterpret_cast<double*>(B.pointer), &ldb, reinterpret_cast<double*>(buffer.pointer), &workSize, &info);
+						}
+						break;
+					}
+					case DenseSolverType::Cholesky:
+						// A is symmetric: aOperation is irrelevant
+						mkl::dpotrs("L", &nra, &ncb, reinterpret_cast<double*>(A.pointer), &lda, reinterpret_cast<double*>(B.pointer), &ldb, &info);
+						break;
+					case DenseSolverType::Ldlt:
+						mkl::dsytrs("L", &nra, &ncb, reinterpret_cast<double*>(A.pointer), &lda, reinterpret_cast<int*>(auxiliary.pointer), reinterpret_cast<double*>(B.pointer), &ldb, &info);
+						break;
+					default:
+						throw NotImplementedException();
+				}
+
+				if (info != 0)
+					throw MklException(__func__);
+			}
+
+			/**
+			 * Pivot indices (Lu, Ldlt), Householder coefficients (Qr) or nothing (Cholesky)
+			 */
+			template<MathDomain md>
+			static MemoryBuffer GetAuxiliaryBuffer(const MemoryTile& A, const DenseSolverType solver, SolverWorkspace& workspace)
+			{
+				switch (solver)
+				{
+					case DenseSolverType::Qr:
+						return workspace.GetTau(A.nRows, A.memorySpace, md);
+					case DenseSolverType::Cholesky:
+						return MemoryBuffer(0, 0, A.memorySpace, md);
+					default:
+						return workspace.GetPivot(A.nRows, A.memorySpace);
+				}
+			}
+
+			/**
+			 * Copies the lower triangular part of A into the upper one
+			 */
+			template<MathDomain md>
+			static void SymmetrizeLower(MemoryTile& A)
+			{
+				auto* a = GetPointer<md>(A);
+				for (size_t j = 1; j < A.nCols; ++j)
+				{
+					for (size_t i = 0; i < j; ++i)
+						a[i + j * A.leadingDimension] = a[j + i * A.leadingDimension];
+				}
+			}
 
-						// Factorize A (and overwrite it with L)
-						mkl::dgetrf(&nra, &nra, reinterpret_cast<double*>(aCopy.pointer), &lda, reinterpret_cast<int*>(pivot.pointer), &info);
-						if (info != 0)
-							throw MklException(__func__);
+			/**
+			 * A = A^(-1) for symmetric A, overwritten in place (Cholesky with potri, Ldlt with sytri)
+			 */
+			template<MathDomain md>
+			static void InvertSymmetric(MemoryTile& A, const DenseSolverType solver, SolverWorkspace& workspace);
 
-						// Solve factorized system
-						mkl::dgetrs(mklOperationGemm[static_cast<unsigned>(aOperation)], &nra, &ncb, reinterpret_cast<double*>(aCopy.pointer), &lda, reinterpret_cast<int*>(pivot.pointer), reinterpret_cast<double*>(B.pointer), &ldb, &info);
-						if (info != 0)
-							throw MklException(__func__);
+			template<>
+			inline void InvertSymmetric<MathDomain::Float>(MemoryTile& A, const DenseSolverType solver, SolverWorkspace& workspace)
+			{
+				MemoryBuffer auxiliary = GetAuxiliaryBuffer<MathDomain::Float>(A, solver, workspace);
+				Factorize<MathDomain::Float>(A, auxiliary, solver, workspace);
 
-						// free memory
-						Free(pivot);
+				const auto nra = static_cast<int>(A.nRows);
+				const auto lda = static_cast<int>(A.leadingDimension);
 
+				int info = 0;
+				switch (solver)
+				{
+					case DenseSolverType::Cholesky:
+						mkl::spotri("L", &nra, reinterpret_cast<float*>(A.pointer), &lda, &info);
 						break;
-					}
-					case LinearSystemSolverType::Qr:
+					case DenseSolverType::Ldlt:
 					{
-						// allocate memory for tau
-						MemoryBuffer tau(0, A.nRows, A.memorySpace, MathDomain::Double);
-						Alloc(tau);
+						MemoryBuffer buffer = workspace.GetWork(A.nRows, A.memorySpace, MathDomain::Float);
+						mkl::ssytri("L", &nra, reinterpret_cast<float*>(A.pointer), &lda, reinterpret_cast<int*>(auxiliary.pointer), reinterpret_cast<float*>(buffer.pointer), &info);
+						break;
+					}
+					default:
+						throw NotImplementedException();
+				}
 
-						static constexpr size_t workBufferMultiple = { 64 };
-						const int workSize = static_cast<int>(A.nCols * workBufferMultiple);
-						// allocate memory for workBuffer
-						MemoryBuffer buffer(0, static_cast<unsigned>(workSize), A.memorySpace, MathDomain::Double);
-						Alloc(buffer);
+				if (info > 0)
+					throw FactorizationException(solver, info);
+				if (info != 0)
+					throw MklException(__func__);
 
-						// A = Q * R
-						mkl::dgeqrf(&nra, &nra, reinterpret_cast<double*>(aCopy.pointer), &lda, reinterpret_cast<double*>(tau.pointer), reinterpret_cast<double*>(buffer.pointer), &workSize, &info);
-						if (info != 0)
-							throw MklException(__func__);
+				SymmetrizeLower<MathDomain::Float>(A);
+			}
 
-						// B = Q^T * B
-						mkl::dormqr("L", "T", &nra, &nra, &ncb, reinterpret_cast<double*>(aCopy.pointer), &lda, reinterpret_cast<double*>(tau.pointer), reinterpret_cast<double*>(B.pointer), &ldb, reinterpret_cast<double*>(buffer.pointer), &workSize, &info);
-						if (info != 0)
-							throw MklException(__func__);
+			template<>
+			inline void InvertSymmetric<MathDomain::Double>(MemoryTile& A, const DenseSolverType solver, SolverWorkspace& workspace)
+			{
+				MemoryBuffer auxiliary = GetAuxiliaryBuffer<MathDomain::Double>(A, solver, workspace);
+				Factorize<MathDomain::Double>(A, auxiliary, solver, workspace);
 
-						// Solve (x = R \ (Q^T * B))
-						mkl::cblas_dtrsm(columnMajorLayout, mkl::CBLAS_SIDE::CblasLeft, mkl::CBLAS_UPLO::CblasUpper, mklOperationsEnum[static_cast<unsigned>(aOperation)], mkl::CBLAS_DIAG::CblasNonUnit, nra, nra, 1.0, reinterpret_cast<double*>(aCopy.pointer), lda, reinterpret_cast<double*>(B.pointer), ldb);
+				const auto nra = static_cast<int>(A.nRows);
+				const auto lda = static_cast<int>(A.leadingDimension);
 
+				int info = 0;
+				switch (solver)
+				{
+					case DenseSolverType::Cholesky:
+						mkl::dpotri("L", &nra, reinterpret_cast<double*>(A.pointer), &lda, &info);
+						break;
+					case DenseSolverType::Ldlt:
+					{
+						MemoryBuffer buffer = workspace.GetWork(A.nRows, A.memorySpace, MathDomain::Double);
+						mkl::dsytri("L", &nra, reinterpret_cast<double*>(A.pointer), &lda, reinterpret_cast<int*>(auxiliary.pointer), reinterpret_cast<double*>(buffer.pointer), &info);
 						break;
 					}
 					default:
 						throw NotImplementedException();
 				}
 
-				Free(aCopy);
+				if (info > 0)
+					throw FactorizationException(solver, info);
+				if (info != 0)
+					throw MklException(__func__);
+
+				SymmetrizeLower<MathDomain::Double>(A);
+			}
+
+			template<MathDomain md>
+			static void Solve(const MemoryTile& A, MemoryTile& B, const MatrixOperation aOperation, const DenseSolverType solver, SolverWorkspace& workspace)
+			{
+				// Need to copy A, as it will be overwritten by its factorization
+				MemoryTile aCopy = workspace.GetMatrix(A);
+				if (A.leadingDimension == A.nRows)
+					Copy<md>(aCopy, A);
+				else
+				{
+					// sub-matrix view: its columns aren't contiguous
+					for (unsigned j = 0; j < A.nCols; ++j)
+					{
+						MemoryBuffer column;
+						MemoryBuffer columnCopy;
+						ExtractColumnBufferFromMatrix(column, A, j);
+						ExtractColumnBufferFromMatrix(columnCopy, aCopy, j);
+						Copy<md>(columnCopy, column);
+					}
+				}
+
+				MemoryBuffer auxiliary = GetAuxiliaryBuffer<md>(A, solver, workspace);
+				Factorize<md>(aCopy, auxiliary, solver, workspace);
+				SolveFactorized<md>(aCopy, auxiliary, B, aOperation, solver, workspace);
 			}
 
 			template<MathDomain md>
@@ -561,6 +855,21 @@ namespace cl
 			{
 				norm = mkl::cblas_dnrm2(static_cast<int>(z.size), reinterpret_cast<double*>(z.pointer), 1);
 			}
+
+			// result = x^T * y
+			template<MathDomain md>
+			static void InnerProduct(double& result, const MemoryBuffer& x, const MemoryBuffer& y);
+
+			template<>
+			inline void InnerProduct<MathDomain::Float>(double& result, const MemoryBuffer& x, const MemoryBuffer& y)
+			{
+				result = static_cast<double>(mkl::cblas_sdot(static_cast<int>(x.size), reinterpret_cast<float*>(x.pointer), 1, reinterpret_cast<float*>(y.pointer), 1));
+			}
+			template<>
+			inline void InnerProduct<MathDomain::Double>(double& result, const MemoryBuffer& x, const MemoryBuffer& y)
+			{
+				result = mkl::cblas_ddot(static_cast<int>(x.size), reinterpret_cast<double*>(x.pointer), 1, reinterpret_cast<double*>(y.pointer), 1);
+			}
 		}	 // namespace mkr
 	}		 // namespace routines
 }	 // namespace cl
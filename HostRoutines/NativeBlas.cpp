@@ -0,0 +1,642 @@
+#include <NativeBlas.h>
+
+#include <Parallel.h>
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+	// kernels are compiled for every instruction set, and picked at runtime: no need for -mavx2/-mfma
+	#define CL_X86_DISPATCH
+	#define CL_TARGET_AVX2 __attribute__((target("avx2,fma")))
+	#include <immintrin.h>
+#endif
+
+namespace cl
+{
+	namespace routines
+	{
+		namespace nbr
+		{
+			namespace
+			{
+				// below this number of multiply-adds per thread, spawning threads costs more than it saves
+				constexpr size_t minMultiplyAddsPerThread = { 1 << 21 };
+				constexpr size_t minElementsPerThread = { 1 << 16 };
+
+				// block size of the triangular solves and of the LU factorization: the rest of the work is done by GEMM
+				constexpr size_t blockSize = { 64 };
+
+				enum class InstructionSet
+				{
+					Scalar,
+					Avx2
+				};
+
+				InstructionSet DetectInstructionSet() noexcept
+				{
+#ifdef CL_X86_DISPATCH
+					__builtin_cpu_init();
+					if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+						return InstructionSet::Avx2;
+#endif
+					return InstructionSet::Scalar;
+				}
+
+				InstructionSet GetInstructionSetType() noexcept
+				{
+					static const InstructionSet instructionSet = DetectInstructionSet();
+					return instructionSet;
+				}
+
+				/**
+				 * mr x nr is the register tile of the micro-kernel (two AVX2 registers per column, six columns);
+				 * an mc x kc block of A is meant to stay in L2, and a kc x nr panel of B in L1.
+				 * The micro-kernel accumulates at most ku products in registers before adding them to C: this blocked summation bounds the
+				 * rounding error by ~(k / ku + ku) eps rather than k eps, for a C tile load/store every ku iterations
+				 */
+				template<typename T>
+				struct Blocking;
+
+				template<>
+				struct Blocking<float>
+				{
+					static constexpr size_t mr = { 16 };
+					static constexpr size_t nr = { 6 };
+					static constexpr size_t mc = { 192 };
+					static constexpr size_t kc = { 256 };
+					static constexpr size_t ku = { 32 };
+					static constexpr size_t nc = { 4080 };
+				};
+
+				template<>
+				struct Blocking<double>
+				{
+					static constexpr size_t mr = { 8 };
+					static constexpr size_t nr = { 6 };
+					static constexpr size_t mc = { 96 };
+					static constexpr size_t kc = { 256 };
+					static constexpr size_t ku = { 32 };
+					static constexpr size_t nc = { 4080 };
+				};
+
+				/**
+				 * C[:mr, :nr] += alpha * a * b, a being a packed mr x kc panel and b a packed kc x nr panel (zero padded up to Blocking<T>::mr/nr)
+				 */
+				template<typename T>
+				using MicroKernel = void (*)(const size_t kc, const T* a, const T* b, T* c, const size_t ldc, const T alpha, const size_t mr, const size_t nr);
+
+#pragma region Scalar
+
+				template<typename T>
+				void MicroKernelScalar(const size_t kc, const T* a, const T* b, T* c, const size_t ldc, const T alpha, const size_t mr, const size_t nr) noexcept
+				{
+					constexpr size_t MR = Blocking<T>::mr;
+					constexpr size_t NR = Blocking<T>::nr;
+
+					T ab[NR][MR] = {};
+					for (size_t p = 0; p < kc; ++p, a += MR, b += NR)
+					{
+						for (size_t j = 0; j < NR; ++j)
+						{
+							const T bj = b[j];
+							for (size_t i = 0; i < MR; ++i)
+								ab[j][i] += a[i] * bj;
+						}
+					}
+
+					for (size_t j = 0; j < nr; ++j)
+						for (size_t i = 0; i < mr; ++i)
+							c[i + j * ldc] += alpha * ab[j][i];
+				}
+
+#pragma endregion
+
+#ifdef CL_X86_DISPATCH
+
+#pragma region Avx2
+
+				CL_TARGET_AVX2 void MicroKernelAvx2(const size_t kc, const float* a, const float* b, float* c, const size_t ldc, const float alpha, const size_t mr, const size_t nr) noexcept
+				{
+					constexpr size_t MR = Blocking<float>::mr;
+					constexpr size_t NR = Blocking<float>::nr;
+
+					__m256 ab[NR][2];
+					for (size_t j = 0; j < NR; ++j)
+						ab[j][0] = ab[j][1] = _mm256_setzero_ps();
+
+					for (size_t p = 0; p < kc; ++p, a += MR, b += NR)
+					{
+						const __m256 a0 = _mm256_loadu_ps(a);
+						const __m256 a1 = _mm256_loadu_ps(a + 8);
+						for (size_t j = 0; j < NR; ++j)
+						{
+							const __m256 bj = _mm256_broadcast_ss(b + j);
+							ab[j][0] = _mm256_fmadd_ps(a0, bj, ab[j][0]);
+							ab[j][1] = _mm256_fmadd_ps(a1, bj, ab[j][1]);
+						}
+					}
+
+					const __m256 alpha_ = _mm256_set1_ps(alpha);
+					if (mr == MR && nr == NR)
+					{
+						for (size_t j = 0; j < NR; ++j)
+						{
+							float* cj = c + j * ldc;
+							_mm256_storeu_ps(cj, _mm256_fmadd_ps(alpha_, ab[j][0], _mm256_loadu_ps(cj)));
+							_mm256_storeu_ps(cj + 8, _mm256_fmadd_ps(alpha_, ab[j][1], _mm256_loadu_ps(cj + 8)));
+						}
+						return;
+					}
+
+					// edge tile: C is only partially covered
+					alignas(32) float tile[NR][MR];
+					for (size_t j = 0; j < NR; ++j)
+					{
+						_mm256_store_ps(tile[j], _mm256_mul_ps(alpha_, ab[j][0]));
+						_mm256_store_ps(tile[j] + 8, _mm256_mul_ps(alpha_, ab[j][1]));
+					}
+					for (size_t j = 0; j < nr; ++j)
+						for (size_t i = 0; i < mr; ++i)
+							c[i + j * ldc] += tile[j][i];
+				}
+
+				CL_TARGET_AVX2 void MicroKernelAvx2(const size_t kc, const double* a, const double* b, double* c, const size_t ldc, const double alpha, const size_t mr, const size_t nr) noexcept
+				{
+					constexpr size_t MR = Blocking<double>::mr;
+					constexpr size_t NR = Blocking<double>::nr;
+
+					__m256d ab[NR][2];
+					for (size_t j = 0; j < NR; ++j)
+						ab[j][0] = ab[j][1] = _mm256_setzero_pd();
+
+					for (size_t p = 0; p < kc; ++p, a += MR, b += NR)
+					{
+						const __m256d a0 = _mm256_loadu_pd(a);
+						const __m256d a1 = _mm256_loadu_pd(a + 4);
+						for (size_t j = 0; j < NR; ++j)
+						{
+							const __m256d bj = _mm256_broadcast_sd(b + j);
+							ab[j][0] = _mm256_fmadd_pd(a0, bj, ab[j][0]);
+							ab[j][1] = _mm256_fmadd_pd(a1, bj, ab[j][1]);
+						}
+					}
+
+					const __m256d alpha_ = _mm256_set1_pd(alpha);
+					if (mr == MR && nr == NR)
+					{
+						for (size_t j = 0; j < NR; ++j)
+						{
+							double* cj = c + j * ldc;
+							_mm256_storeu_pd(cj, _mm256_fmadd_pd(alpha_, ab[j][0], _mm256_loadu_pd(cj)));
+							_mm256_storeu_pd(cj + 4, _mm256_fmadd_pd(alpha_, ab[j][1], _mm256_loadu_pd(cj + 4)));
+						}
+						return;
+					}
+
+					// edge tile: C is only partially covered
+					alignas(32) double tile[NR][MR];
+					for (size_t j = 0; j < NR; ++j)
+					{
+						_mm256_store_pd(tile[j], _mm256_mul_pd(alpha_, ab[j][0]));
+						_mm256_store_pd(tile[j] + 4, _mm256_mul_pd(alpha_, ab[j][1]));
+					}
+					for (size_t j = 0; j < nr; ++j)
+						for (size_t i = 0; i < mr; ++i)
+							c[i + j * ldc] += tile[j][i];
+				}
+
+#pragma endregion
+
+#endif
+
+				template<typename T>
+				MicroKernel<T> GetMicroKernel() noexcept
+				{
+					switch (GetInstructionSetType())
+					{
+#ifdef CL_X86_DISPATCH
+						case InstructionSet::Avx2:
+						{
+							const MicroKernel<T> kernel = MicroKernelAvx2;
+							return kernel;
+						}
+#endif
+						default:
+							return MicroKernelScalar<T>;
+					}
+				}
+
+#pragma region Packing
+
+				/**
+				 * op(A)[:mc, :kc] -> panels of mr rows, each of them stored as kc consecutive columns of mr values
+				 */
+				template<typename T>
+				void PackA(const MatrixOperation aOperation, const size_t mc, const size_t kc, const T* A, const size_t lda, T* out) noexcept
+				{
+					constexpr size_t MR = Blocking<T>::mr;
+
+					for (size_t ir = 0; ir < mc; ir += MR)
+					{
+						const size_t mr = std::min(MR, mc - ir);
+						for (size_t p = 0; p < kc; ++p, out += MR)
+						{
+							if (aOperation == MatrixOperation::None)
+							{
+								const T* a = A + ir + p * lda;
+								for (size_t i = 0; i < mr; ++i)
+									out[i] = a[i];
+							}
+							else
+							{
+								const T* a = A + p + ir * lda;
+								for (size_t i = 0; i < mr; ++i)
+									out[i] = a[i * lda];
+							}
+							for (size_t i = mr; i < MR; ++i)
+								out[i] = T(0);
+						}
+					}
+				}
+
+				/**
+				 * op(B)[:kc, :nc] -> panels of nr columns, each of them stored as kc consecutive rows of nr values
+				 */
+				template<typename T>
+				void PackB(const MatrixOperation bOperation, const size_t kc, const size_t nc, const T* B, const size_t ldb, T* out) noexcept
+				{
+					constexpr size_t NR = Blocking<T>::nr;
+
+					for (size_t jr = 0; jr < nc; jr += NR)
+					{
+						const size_t nr = std::min(NR, nc - jr);
+						for (size_t p = 0; p < kc; ++p, out += NR)
+						{
+							if (bOperation == MatrixOperation::None)
+							{
+								const T* b = B + p + jr * ldb;
+								for (size_t j = 0; j < nr; ++j)
+									out[j] = b[j * ldb];
+							}
+							else
+							{
+								const T* b = B + jr + p * ldb;
+								for (size_t j = 0; j < nr; ++j)
+									out[j] = b[j];
+							}
+							for (size_t j = nr; j < NR; ++j)
+								out[j] = T(0);
+						}
+					}
+				}
+
+#pragma endregion
+
+				/**
+				 * C[:, jBegin:jEnd] += alpha * op(A) * op(B)[:, jBegin:jEnd], single threaded.
+				 * With an epilogue, each micro-tile of C is then replaced by activation(C + bias) as soon as its last block of k is accumulated
+				 */
+				template<typename T>
+				void GemmColumns(const MatrixOperation aOperation, const MatrixOperation bOperation, const size_t m, const size_t jBegin, const size_t jEnd, const size_t k, const T alpha, const T* A, const size_t lda, const T* B, const size_t ldb, T* C, const size_t ldc, const MicroKernel<T> kernel, const T* bias = nullptr, const ActivationType activation = ActivationType::None)
+				{
+					const bool hasEpilogue = bias != nullptr || activation != ActivationType::None;
+
+					using blocking = Blocking<T>;
+
+					// packing buffers are reused by the following calls on the same thread, and only grow
+					thread_local std::vector<T> aPack;
+					thread_local std::vector<T> bPack;
+					const size_t kcMax = std::min(blocking::kc, k);
+					const size_t mcMax = (std::min(blocking::mc, m) + blocking::mr - 1) / blocking::mr * blocking::mr;
+					const size_t ncMax = (std::min(blocking::nc, jEnd - jBegin) + blocking::nr - 1) / blocking::nr * blocking::nr;
+					if (aPack.size() < mcMax * kcMax)
+						aPack.resize(mcMax * kcMax);
+					if (bPack.size() < ncMax * kcMax)
+						bPack.resize(ncMax * kcMax);
+
+					for (size_t jc = jBegin; jc < jEnd; jc += blocking::nc)
+					{
+						const size_t nc = std::min(blocking::nc, jEnd - jc);
+						for (size_t pc = 0; pc < k; pc += blocking::kc)
+						{
+							const size_t kc = std::min(blocking::kc, k - pc);
+							PackB(bOperation, kc, nc, bOperation == MatrixOperation::None ? B + pc + jc * ldb : B + jc + pc * ldb, ldb, bPack.data());
+
+							for (size_t ic = 0; ic < m; ic += blocking::mc)
+							{
+								const size_t mc = std::min(blocking::mc, m - ic);
+								PackA(aOperation, mc, kc, aOperation == MatrixOperation::None ? A + ic + pc * lda : A + pc + ic * lda, lda, aPack.data());
+
+								const bool isLastBlock = pc + kc == k;
+								for (size_t jr = 0; jr < nc; jr += blocking::nr)
+								{
+									for (size_t ir = 0; ir < mc; ir += blocking::mr)
+									{
+										T* c = C + (ic + ir) + (jc + jr) * ldc;
+										const size_t mr = std::min(blocking::mr, mc - ir);
+										const size_t nr = std::min(blocking::nr, nc - jr);
+										for (size_t pu = 0; pu < kc; pu += blocking::ku)
+											kernel(std::min(blocking::ku, kc - pu), aPack.data() + ir * kc + pu * blocking::mr, bPack.data() + jr * kc + pu * blocking::nr, c, ldc, alpha, mr, nr);
+										if (hasEpilogue && isLastBlock)
+											detail::BiasActivation(c, ldc, mr, nr, bias ? bias + ic + ir : nullptr, activation);
+									}
+								}
+							}
+						}
+					}
+				}
+
+				template<typename T>
+				void SwapRows(const size_t i, const size_t j, const size_t nCols, T* A, const size_t lda) noexcept
+				{
+					for (size_t c = 0; c < nCols; ++c)
+						std::swap(A[i + c * lda], A[j + c * lda]);
+				}
+
+				/**
+				 * Unblocked LU of the n x nb panel A (partial pivoting): rows are swapped across all the nCols columns of the matrix,
+				 * the panel starting at column offset (and row offset as well, A being square)
+				 */
+				template<typename T>
+				int PanelGetrf(const size_t n, const size_t offset, const size_t nb, T* A, const size_t lda, int* pivot) noexcept
+				{
+					int info = 0;
+					for (size_t j = offset; j < offset + nb; ++j)
+					{
+						T* aj = A + j * lda;
+
+						size_t p = j;
+						for (size_t i = j + 1; i < n; ++i)
+						{
+							if (std::abs(aj[i]) > std::abs(aj[p]))
+								p = i;
+						}
+						pivot[j] = static_cast<int>(p + 1);
+
+						if (aj[p] == T(0))
+						{
+							// the column below the diagonal is zero already: nothing to eliminate
+							if (info == 0)
+								info = static_cast<int>(j + 1);
+							continue;
+						}
+
+						if (p != j)
+							SwapRows(j, p, n, A, lda);
+
+						const T inverse = T(1) / aj[j];
+						for (size_t i = j + 1; i < n; ++i)
+							aj[i] *= inverse;
+
+						for (size_t c = j + 1; c < offset + nb; ++c)
+						{
+							T* ac = A + c * lda;
+							const T ujc = ac[j];
+							if (ujc == T(0))
+								continue;
+							for (size_t i = j + 1; i < n; ++i)
+								ac[i] -= aj[i] * ujc;
+						}
+					}
+
+					return info;
+				}
+			}	 // namespace
+
+			const char* GetInstructionSet() noexcept
+			{
+				switch (GetInstructionSetType())
+				{
+					case InstructionSet::Avx2:
+						return "AVX2";
+					default:
+						return "Scalar";
+				}
+			}
+
+			template<typename T>
+			void Gemm(const MatrixOperation aOperation, const MatrixOperation bOperation, const size_t m, const size_t n, const size_t k, const T alpha, const T* A, const size_t lda, const T* B, const size_t ldb, const T beta, T* C, const size_t ldc)
+			{
+				GemmFused(aOperation, bOperation, m, n, k, alpha, A, lda, B, ldb, beta, C, ldc, static_cast<const T*>(nullptr), ActivationType::None);
+			}
+
+			template<typename T>
+			void GemmFused(const MatrixOperation aOperation, const MatrixOperation bOperation, const size_t m, const size_t n, const size_t k, const T alpha, const T* A, const size_t lda, const T* B, const size_t ldb, const T beta, T* C, const size_t ldc, const T* bias, const ActivationType activation)
+			{
+				if (m == 0 || n == 0)
+					return;
+
+				if (beta != T(1))
+				{
+					for (size_t j = 0; j < n; ++j)
+					{
+						T* cj = C + j * ldc;
+						for (size_t i = 0; i < m; ++i)
+							cj[i] = beta == T(0) ? T(0) : beta * cj[i];
+					}
+				}
+
+				if (k == 0 || alpha == T(0))
+				{
+					// no micro-kernel runs, hence neither does the epilogue
+					if (bias != nullptr || activation != ActivationType::None)
+						detail::BiasActivation(C, ldc, m, n, bias, activation);
+					return;
+				}
+
+				// threads take contiguous ranges of micro-panels of C's columns, each of them packing its own blocks
+				constexpr size_t NR = Blocking<T>::nr;
+				const size_t nPanels = (n + NR - 1) / NR;
+				const size_t nPartitions = std::min(nPanels, detail::GetNumberOfPartitions(m * n * k, minMultiplyAddsPerThread));
+
+				const MicroKernel<T> kernel = GetMicroKernel<T>();
+				detail::ParallelFor(nPartitions, [&](const size_t p) {
+					const size_t jBegin = std::min(n, NR * (nPanels * p / nPartitions));
+					const size_t jEnd = std::min(n, NR * (nPanels * (p + 1) / nPartitions));
+					GemmColumns(aOperation, bOperation, m, jBegin, jEnd, k, alpha, A, lda, B, ldb, C, ldc, kernel, bias, activation);
+				});
+			}
+
+			template<typename T>
+			void Gemv(const MatrixOperation aOperation, const size_t m, const size_t n, const T alpha, const T* A, const size_t lda, const T* x, const T beta, T* y)
+			{
+				const size_t nPartitions = detail::GetNumberOfPartitions(m * n, minElementsPerThread);
+
+				if (aOperation == MatrixOperation::None)
+				{
+					// y[rows] = beta * y[rows] + sum_j (alpha * x[j]) * A[rows, j]: columns are read contiguously
+					const size_t nRowPartitions = std::max(size_t(1), std::min(nPartitions, m / 64));
+					detail::ParallelFor(nRowPartitions, [&](const size_t p) {
+						const size_t iBegin = m * p / nRowPartitions;
+						const size_t iEnd = m * (p + 1) / nRowPartitions;
+						for (size_t i = iBegin; i < iEnd; ++i)
+							y[i] = beta == T(0) ? T(0) : beta * y[i];
+
+						for (size_t j = 0; j < n; ++j)
+						{
+							const T* aj = A + j * lda;
+							const T t = alpha * x[j];
+							for (size_t i = iBegin; i < iEnd; ++i)
+								y[i] += t * aj[i];
+						}
+					});
+					return;
+				}
+
+				// y[j] = beta * y[j] + alpha * A[:, j] . x
+				const size_t nColPartitions = std::max(size_t(1), std::min(nPartitions, n));
+				detail::ParallelFor(nColPartitions, [&](const size_t p) {
+					for (size_t j = n * p / nColPartitions; j < n * (p + 1) / nColPartitions; ++j)
+					{
+						const T* aj = A + j * lda;
+
+						// independent accumulators break the dependency chain
+						T s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+						size_t i = 0;
+						for (; i + 4 <= m; i += 4)
+						{
+							s0 += aj[i] * x[i];
+							s1 += aj[i + 1] * x[i + 1];
+							s2 += aj[i + 2] * x[i + 2];
+							s3 += aj[i + 3] * x[i + 3];
+						}
+						for (; i < m; ++i)
+							s0 += aj[i] * x[i];
+
+						const T dot = (s0 + s1) + (s2 + s3);
+						y[j] = (beta == T(0) ? T(0) : beta * y[j]) + alpha * dot;
+					}
+				});
+			}
+
+			template<typename T>
+			void Trsm(const bool lower, const MatrixOperation aOperation, const bool unitDiagonal, const size_t n, const size_t nRhs, const T* A, const size_t lda, T* B, const size_t ldb)
+			{
+				if (n == 0 || nRhs == 0)
+					return;
+
+				const bool transpose = aOperation == MatrixOperation::Transpose;
+				auto op = [&](const size_t i, const size_t j) { return transpose ? A[j + i * lda] : A[i + j * lda]; };
+
+				// op(A) is lower triangular: forward substitution, otherwise backward
+				const bool forward = lower != transpose;
+				const size_t nBlocks = (n + blockSize - 1) / blockSize;
+				for (size_t b = 0; b < nBlocks; ++b)
+				{
+					const size_t i0 = (forward ? b : nBlocks - 1 - b) * blockSize;
+					const size_t i1 = std::min(n, i0 + blockSize);
+
+					// diagonal block
+					for (size_t c = 0; c < nRhs; ++c)
+					{
+						T* bc = B + c * ldb;
+						for (size_t s = 0; s < i1 - i0; ++s)
+						{
+							const size_t i = forward ? i0 + s : i1 - 1 - s;
+							T x = bc[i];
+							if (forward)
+							{
+								for (size_t l = i0; l < i; ++l)
+									x -= op(i, l) * bc[l];
+							}
+							else
+							{
+								for (size_t l = i + 1; l < i1; ++l)
+									x -= op(i, l) * bc[l];
+							}
+							bc[i] = unitDiagonal ? x : x / op(i, i);
+						}
+					}
+
+					// the rows still to be solved are updated with the solved block
+					if (forward && i1 < n)
+						Gemm(aOperation, MatrixOperation::None, n - i1, nRhs, i1 - i0, T(-1), transpose ? A + i0 + i1 * lda : A + i1 + i0 * lda, lda, B + i0, ldb, T(1), B + i1, ldb);
+					else if (!forward && i0 > 0)
+						Gemm(aOperation, MatrixOperation::None, i0, nRhs, i1 - i0, T(-1), transpose ? A + i0 : A + i0 * lda, lda, B + i0, ldb, T(1), B, ldb);
+				}
+			}
+
+			template<typename T>
+			int Getrf(const size_t n, T* A, const size_t lda, int* pivot)
+			{
+				int info = 0;
+				for (size_t j0 = 0; j0 < n; j0 += blockSize)
+				{
+					const size_t jb = std::min(blockSize, n - j0);
+
+					const int panelInfo = PanelGetrf(n, j0, jb, A, lda, pivot);
+					if (info == 0)
+						info = panelInfo;
+
+					const size_t j1 = j0 + jb;
+					if (j1 >= n)
+						break;
+
+					// U12 = L11^(-1) * A12
+					Trsm(true, MatrixOperation::None, true, jb, n - j1, A + j0 + j0 * lda, lda, A + j0 + j1 * lda, lda);
+
+					// A22 -= L21 * U12
+					Gemm(MatrixOperation::None, MatrixOperation::None, n - j1, n - j1, jb, T(-1), A + j1 + j0 * lda, lda, A + j0 + j1 * lda, lda, T(1), A + j1 + j1 * lda, lda);
+				}
+
+				return info;
+			}
+
+			template<typename T>
+			void Getrs(const MatrixOperation aOperation, const size_t n, const size_t nRhs, const T* A, const size_t lda, const int* pivot, T* B, const size_t ldb)
+			{
+				if (aOperation == MatrixOperation::None)
+				{
+					// A = P * L * U
+					for (size_t i = 0; i < n; ++i)
+					{
+						const auto p = static_cast<size_t>(pivot[i] - 1);
+						if (p != i)
+							SwapRows(i, p, nRhs, B, ldb);
+					}
+
+					Trsm(true, MatrixOperation::None, true, n, nRhs, A, lda, B, ldb);
+					Trsm(false, MatrixOperation::None, false, n, nRhs, A, lda, B, ldb);
+				}
+				else
+				{
+					// A^T = U^T * L^T * P^T
+					Trsm(false, MatrixOperation::Transpose, false, n, nRhs, A, lda, B, ldb);
+					Trsm(true, MatrixOperation::Transpose, true, n, nRhs, A, lda, B, ldb);
+
+					for (size_t i = n; i-- > 0;)
+					{
+						const auto p = static_cast<size_t>(pivot[i] - 1);
+						if (p != i)
+							SwapRows(i, p, nRhs, B, ldb);
+					}
+				}
+			}
+
+#pragma region Explicit instantiations
+
+			template void Gemm<float>(const MatrixOperation aOperation, const MatrixOperation bOperation, const size_t m, const size_t n, const size_t k, const float alpha, const float* A, const size_t lda, const float* B, const size_t ldb, const float beta, float* C, const size_t ldc);
+			template void Gemm<double>(const MatrixOperation aOperation, const MatrixOperation bOperation, const size_t m, const size_t n, const size_t k, const double alpha, const double* A, const size_t lda, const double* B, const size_t ldb, const double beta, double* C, const size_t ldc);
+
+			template void GemmFused<float>(const MatrixOperation aOperation, const MatrixOperation bOperation, const size_t m, const size_t n, const size_t k, const float alpha, const float* A, const size_t lda, const float* B, const size_t ldb, const float beta, float* C, const size_t ldc, const float* bias, const ActivationType activation);
+			template void GemmFused<double>(const MatrixOperation aOperation, const MatrixOperation bOperation, const size_t m, const size_t n, const size_t k, const double alpha, const double* A, const size_t lda, const double* B, const size_t ldb, const double beta, double* C, const size_t ldc, const double* bias, const ActivationType activation);
+
+			template void Gemv<float>(const MatrixOperation aOperation, const size_t m, const size_t n, const float alpha, const float* A, const size_t lda, const float* x, const float beta, float* y);
+			template void Gemv<double>(const MatrixOperation aOperation, const size_t m, const size_t n, const double alpha, const double* A, const size_t lda, const double* x, const double beta, double* y);
+
+			template void Trsm<float>(const bool lower, const MatrixOperation aOperation, const bool unitDiagonal, const size_t n, const size_t nRhs, const float* A, const size_t lda, float* B, const size_t ldb);
+			template void Trsm<double>(const bool lower, const MatrixOperation aOperation, const bool unitDiagonal, const size_t n, const size_t nRhs, const double* A, const size_t lda, double* B, const size_t ldb);
+
+			template int Getrf<float>(const size_t n, float* A, const size_t lda, int* pivot);
+			template int Getrf<double>(const size_t n, double* A, const size_t lda, int* pivot);
+
+			template void Getrs<float>(const MatrixOperation aOperation, const size_t n, const size_t nRhs, const float* A, const size_t lda, const int* pivot, float* B, const size_t ldb);
+			template void Getrs<double>(const MatrixOperation aOperation, const size_t n, const size_t nRhs, const double* A, const size_t lda, const int* pivot, double* B, const size_t ldb);
+
+#pragma endregion
+		}	 // namespace nbr
+	}		 // namespace routines
+}	 // namespace cl
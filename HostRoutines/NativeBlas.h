@@ -0,0 +1,106 @@
+#pragma once
+
+#include <Activation.h>
+#include <Common.h>
+#include <Exceptions.h>
+#include <SolverWorkspace.h>
+#include <Types.h>
+
+#include <algorithm>
+#include <cstddef>
+
+namespace cl
+{
+	namespace routines
+	{
+		/**
+		 * Pure C++ dense kernels, used by the Test memory space in place of a BLAS/LAPACK provider.
+		 * Matrices are column major, with the same argument conventions of BLAS (m, n, k, leading dimensions) and LAPACK (1-based pivots).
+		 * GEMM packs op(A) and op(B) in cache sized blocks and runs a register tiled micro-kernel on them: the micro-kernel instruction set
+		 * (AVX2 + FMA or plain C++) is chosen at runtime, according to what the CPU supports.
+		 */
+		namespace nbr
+		{
+			// name of the instruction set used by the GEMM micro-kernel, for diagnostics
+			extern const char* GetInstructionSet() noexcept;
+
+			/**
+			 * C = alpha * op(A) * op(B) + beta * C, op(A) being m x k and op(B) k x n. beta = 0 overwrites C, as in BLAS
+			 */
+			template<typename T>
+			void Gemm(const MatrixOperation aOperation, const MatrixOperation bOperation, const size_t m, const size_t n, const size_t k, const T alpha, const T* A, const size_t lda, const T* B, const size_t ldb, const T beta, T* C, const size_t ldc);
+
+			/**
+			 * C = activation(alpha * op(A) * op(B) + beta * C + bias), bias (which can be null) being added to every column of C.
+			 * Bias and activation are applied by the GEMM itself, to each micro-tile of C as soon as it's complete, while it's still in cache
+			 */
+			template<typename T>
+			void GemmFused(const MatrixOperation aOperation, const MatrixOperation bOperation, const size_t m, const size_t n, const size_t k, const T alpha, const T* A, const size_t lda, const T* B, const size_t ldb, const T beta, T* C, const size_t ldc, const T* bias, const ActivationType activation);
+
+			/**
+			 * y = alpha * op(A) * x + beta * y, A being m x n
+			 */
+			template<typename T>
+			void Gemv(const MatrixOperation aOperation, const size_t m, const size_t n, const T alpha, const T* A, const size_t lda, const T* x, const T beta, T* y);
+
+			/**
+			 * B = op(A)^(-1) * B, A being n x n lower (or upper) triangular, and B n x nRhs
+			 */
+			template<typename T>
+			void Trsm(const bool lower, const MatrixOperation aOperation, const bool unitDiagonal, const size_t n, const size_t nRhs, const T* A, const size_t lda, T* B, const size_t ldb);
+
+			/**
+			 * A = P * L * U with partial pivoting, overwriting A with L and U (as getrf): returns 0, or the 1-based index of the first zero pivot
+			 */
+			template<typename T>
+			int Getrf(const size_t n, T* A, const size_t lda, int* pivot);
+
+			/**
+			 * B = op(A)^(-1) * B, A and pivot being the output of Getrf (as getrs)
+			 */
+			template<typename T>
+			void Getrs(const MatrixOperation aOperation, const size_t n, const size_t nRhs, const T* A, const size_t lda, const int* pivot, T* B, const size_t ldb);
+
+			/**
+			 * Same interface of the BLAS memory spaces wrappers: only Lu is available
+			 */
+			template<MathDomain md>
+			static void Factorize(MemoryTile& A, MemoryBuffer& auxiliary, const DenseSolverType solver)
+			{
+				if (solver != DenseSolverType::Lu)
+					throw NotImplementedException();
+
+				const int info = Getrf(A.nRows, GetPointer<md>(A), A.leadingDimension, GetPointer<MathDomain::Int>(auxiliary));
+				if (info != 0)
+					throw FactorizationException(solver, info);
+			}
+
+			template<MathDomain md>
+			static void SolveFactorized(const MemoryTile& A, const MemoryBuffer& auxiliary, MemoryTile& B, const MatrixOperation aOperation, const DenseSolverType solver)
+			{
+				if (solver != DenseSolverType::Lu)
+					throw NotImplementedException();
+
+				Getrs(aOperation, A.nRows, B.nCols, GetPointer<md>(A), A.leadingDimension, GetPointer<MathDomain::Int>(auxiliary), GetPointer<md>(B), B.leadingDimension);
+			}
+
+			template<MathDomain md>
+			static void Solve(const MemoryTile& A, MemoryTile& B, const MatrixOperation aOperation, const DenseSolverType solver, SolverWorkspace& workspace)
+			{
+				if (solver != DenseSolverType::Lu)
+					throw NotImplementedException();
+
+				// Need to copy A, as it will be overwritten by its factorization
+				MemoryTile aCopy = workspace.GetMatrix(A);
+				const auto* a = GetPointer<md>(A);
+				auto* aCopyPtr = GetPointer<md>(aCopy);
+				for (size_t j = 0; j < A.nCols; ++j)
+					std::copy(a + j * A.leadingDimension, a + j * A.leadingDimension + A.nRows, aCopyPtr + j * aCopy.leadingDimension);
+
+				MemoryBuffer pivot = workspace.GetPivot(A.nRows, A.memorySpace);
+				Factorize<md>(aCopy, pivot, solver);
+				SolveFactorized<md>(aCopy, pivot, B, aOperation, solver);
+			}
+		}	 // namespace nbr
+	}		 // namespace routines
+}	 // namespace cl
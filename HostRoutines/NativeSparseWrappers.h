@@ -0,0 +1,298 @@
+#pragma once
+
+#include <Common.h>
+#include <Parallel.h>
+#include <Types.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace cl
+{
+	namespace routines
+	{
+		/**
+		 * Native CSR kernels, used by the memory spaces without a sparse BLAS (Test, OpenBlas, GenericBlas).
+		 * Rows are split in contiguous ranges with roughly the same number of non-zeros, and each range is processed by its own thread.
+		 */
+		namespace nsr
+		{
+			// below this number of non-zeros per thread, spawning threads costs more than it saves
+			static constexpr size_t minNonZerosPerThread = { 1 << 15 };
+
+			/**
+			 * Partition p covers the rows [ret[p], ret[p + 1]), and has ~nNonZeros / nPartitions non-zeros
+			 */
+			static inline std::vector<unsigned> BalanceRows(const int* rowPtr, const unsigned nRows, const size_t nPartitions)
+			{
+				std::vector<unsigned> ret(nPartitions + 1, nRows);
+				ret[0] = 0;
+
+				const auto nNonZeros = static_cast<size_t>(rowPtr[nRows]);
+				for (size_t p = 1; p < nPartitions; ++p)
+				{
+					const auto target = static_cast<int>(nNonZeros * p / nPartitions);
+					const auto row = static_cast<unsigned>(std::lower_bound(rowPtr, rowPtr + nRows, target) - rowPtr);
+					ret[p] = std::max(ret[p - 1], row);
+				}
+
+				return ret;
+			}
+
+			/**
+			 * z = y + alpha * x
+			 */
+			template<MathDomain md>
+			static void SparseAdd(MemoryBuffer& z, const SparseMemoryBuffer& x, const MemoryBuffer& y, const double alpha)
+			{
+				using stdType = typename Traits<md>::stdType;
+
+				const auto* iPtr = reinterpret_cast<const int*>(x.indices);	   // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast,performance-no-int-to-ptr)
+				const auto* xPtr = GetPointer<md>(x);
+				const auto* yPtr = GetPointer<md>(y);
+				auto* zPtr = GetPointer<md>(z);
+
+				// z might be a freshly allocated buffer: the dense part has to be copied over as well
+				if (zPtr != yPtr)
+					std::copy(yPtr, yPtr + y.size, zPtr);
+
+				for (size_t i = 0; i < x.size; ++i)
+					zPtr[iPtr[i]] += static_cast<stdType>(alpha) * xPtr[i];
+			}
+
+			/**
+			 * y = alpha * A * x + beta * y
+			 */
+			template<MathDomain md>
+			static void SparseDot(MemoryBuffer& y, const SparseMemoryTile& A, const MemoryBuffer& x, const MatrixOperation aOperation, const double alpha, const double beta)
+			{
+				using stdType = typename Traits<md>::stdType;
+
+				const auto* rowPtr = reinterpret_cast<const int*>(A.nNonZeroRows);	  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast,performance-no-int-to-ptr)
+				const auto* colIdx = reinterpret_cast<const int*>(A.nonZeroColumnIndices);	  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast,performance-no-int-to-ptr)
+				const auto* aPtr = GetPointer<md>(A);
+				const auto* xPtr = GetPointer<md>(x);
+				auto* yPtr = GetPointer<md>(y);
+
+				const auto a = static_cast<stdType>(alpha);
+				const auto b = static_cast<stdType>(beta);
+
+				const size_t nPartitions = detail::GetNumberOfPartitions(A.size, minNonZerosPerThread);
+				const auto rows = BalanceRows(rowPtr, A.nRows, nPartitions);
+
+				if (aOperation == MatrixOperation::None)
+				{
+					detail::ParallelFor(nPartitions, [&](const size_t p) {
+						for (unsigned i = rows[p]; i < rows[p + 1]; ++i)
+						{
+							stdType sum = 0;
+							for (int k = rowPtr[i]; k < rowPtr[i + 1]; ++k)
+								sum += aPtr[k] * xPtr[colIdx[k]];
+
+							// beta = 0 must not read y, as it might be uninitialised
+							yPtr[i] = beta == 0.0 ? a * sum : a * sum + b * yPtr[i];
+						}
+					});
+
+					return;
+				}
+
+				// y = alpha * A^T * x: rows of A scatter into y, so each partition but the first accumulates in its own buffer
+				for (size_t j = 0; j < A.nCols; ++j)
+					yPtr[j] = beta == 0.0 ? stdType(0) : b * yPtr[j];
+
+				std::vector<std::vector<stdType>> partials(nPartitions - 1, std::vector<stdType>(A.nCols, stdType(0)));
+				detail::ParallelFor(nPartitions, [&](const size_t p) {
+					stdType* out = p == 0 ? yPtr : partials[p - 1].data();
+					for (unsigned i = rows[p]; i < rows[p + 1]; ++i)
+					{
+						const stdType ax = a * xPtr[i];
+						for (int k = rowPtr[i]; k < rowPtr[i + 1]; ++k)
+							out[colIdx[k]] += aPtr[k] * ax;
+					}
+				});
+
+				for (const auto& partial : partials)
+				{
+					for (size_t j = 0; j < A.nCols; ++j)
+						yPtr[j] += partial[j];
+				}
+			}
+
+			/**
+			 * A = alpha * B * C
+			 */
+			template<MathDomain md>
+			static void SparseMultiply(MemoryTile& A, const SparseMemoryTile& B, const MemoryTile& C, const MatrixOperation bOperation, const double alpha)
+			{
+				using stdType = typename Traits<md>::stdType;
+
+				const auto* rowPtr = reinterpret_cast<const int*>(B.nNonZeroRows);	  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast,performance-no-int-to-ptr)
+				const auto* colIdx = reinterpret_cast<const int*>(B.nonZeroColumnIndices);	  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast,performance-no-int-to-ptr)
+				const auto* bPtr = GetPointer<md>(B);
+				const auto* cPtr = GetPointer<md>(C);
+				auto* aPtr = GetPointer<md>(A);
+
+				const auto a = static_cast<stdType>(alpha);
+				const size_t lda = A.leadingDimension;
+				const size_t ldc = C.leadingDimension;
+
+				if (bOperation == MatrixOperation::None)
+				{
+					const size_t nPartitions = detail::GetNumberOfPartitions(static_cast<size_t>(B.size) * A.nCols, minNonZerosPerThread);
+					const auto rows = BalanceRows(rowPtr, B.nRows, nPartitions);
+
+					detail::ParallelFor(nPartitions, [&](const size_t p) {
+						for (size_t j = 0; j < A.nCols; ++j)
+						{
+							const stdType* cColumn = cPtr + j * ldc;
+							stdType* aColumn = aPtr + j * lda;
+							for (unsigned i = rows[p]; i < rows[p + 1]; ++i)
+							{
+								stdType sum = 0;
+								for (int k = rowPtr[i]; k < rowPtr[i + 1]; ++k)
+									sum += bPtr[k] * cColumn[colIdx[k]];
+								aColumn[i] = a * sum;
+							}
+						}
+					});
+
+					return;
+				}
+
+				// A = alpha * B^T * C: rows of B scatter into A, so columns of C are split among threads instead
+				const size_t nPartitions = std::max(size_t(1), std::min(static_cast<size_t>(A.nCols), detail::GetNumberOfPartitions(static_cast<size_t>(B.size) * A.nCols, minNonZerosPerThread)));
+				detail::ParallelFor(nPartitions, [&](const size_t p) {
+					for (size_t j = A.nCols * p / nPartitions; j < A.nCols * (p + 1) / nPartitions; ++j)
+					{
+						const stdType* cColumn = cPtr + j * ldc;
+						stdType* aColumn = aPtr + j * lda;
+						std::fill(aColumn, aColumn + B.nCols, stdType(0));
+
+						for (unsigned i = 0; i < B.nRows; ++i)
+						{
+							const stdType ac = a * cColumn[i];
+							for (int k = rowPtr[i]; k < rowPtr[i + 1]; ++k)
+								aColumn[colIdx[k]] += bPtr[k] * ac;
+						}
+					}
+				});
+			}
+
+			/**
+			 * d[i] = A[i, i], or 0 if the diagonal isn't stored
+			 */
+			template<MathDomain md>
+			static void SparseDiagonal(MemoryBuffer& d, const SparseMemoryTile& A)
+			{
+				using stdType = typename Traits<md>::stdType;
+
+				const auto* rowPtr = reinterpret_cast<const int*>(A.nNonZeroRows);	  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast,performance-no-int-to-ptr)
+				const auto* colIdx = reinterpret_cast<const int*>(A.nonZeroColumnIndices);	  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast,performance-no-int-to-ptr)
+				const auto* aPtr = GetPointer<md>(A);
+				auto* dPtr = GetPointer<md>(d);
+
+				detail::ParallelFor(A.nRows, detail::GetSliceGrainSize(A.size / std::max(1u, A.nRows)), [&](const size_t begin, const size_t end) {
+					for (size_t i = begin; i < end; ++i)
+					{
+						dPtr[i] = stdType(0);
+						for (int k = rowPtr[i]; k < rowPtr[i + 1]; ++k)
+						{
+							if (colIdx[k] == static_cast<int>(i))
+								dPtr[i] = aPtr[k];
+						}
+					}
+				});
+			}
+
+			/**
+			 * Incomplete LU without fill-in (ILU(0)), overwriting the values of A: L (unit diagonal) below the diagonal, U on and above it.
+			 * Column indices have to be sorted within each row. diagonal[i] is set to the position of A[i, i] in the values, for SparseSolveIncompleteLu.
+			 * Returns 0, or the 1-based index of the first row with a zero (or missing) pivot
+			 */
+			template<MathDomain md>
+			static int SparseIncompleteLu(SparseMemoryTile& A, MemoryBuffer& diagonal)
+			{
+				using stdType = typename Traits<md>::stdType;
+
+				const auto* rowPtr = reinterpret_cast<const int*>(A.nNonZeroRows);	  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast,performance-no-int-to-ptr)
+				const auto* colIdx = reinterpret_cast<const int*>(A.nonZeroColumnIndices);	  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast,performance-no-int-to-ptr)
+				auto* aPtr = GetPointer<md>(A);
+				auto* diagonalPtr = GetPointer<MathDomain::Int>(diagonal);
+
+				for (unsigned i = 0; i < A.nRows; ++i)
+				{
+					const int* diagonalPosition = std::lower_bound(colIdx + rowPtr[i], colIdx + rowPtr[i + 1], static_cast<int>(i));
+					if (diagonalPosition == colIdx + rowPtr[i + 1] || *diagonalPosition != static_cast<int>(i))
+						return static_cast<int>(i) + 1;
+					diagonalPtr[i] = static_cast<int>(diagonalPosition - colIdx);
+				}
+
+				// position of each column in the row being eliminated, -1 if it's not stored
+				std::vector<int> position(A.nCols, -1);
+				for (unsigned i = 0; i < A.nRows; ++i)
+				{
+					for (int k = rowPtr[i]; k < rowPtr[i + 1]; ++k)
+						position[colIdx[k]] = k;
+
+					// row i -= l(i, j) * row j, for each j < i in the pattern: updates outside of the pattern are dropped
+					for (int k = rowPtr[i]; k < diagonalPtr[i]; ++k)
+					{
+						const int j = colIdx[k];
+						aPtr[k] /= aPtr[diagonalPtr[j]];
+
+						const stdType l = aPtr[k];
+						for (int kk = diagonalPtr[j] + 1; kk < rowPtr[j + 1]; ++kk)
+						{
+							const int target = position[colIdx[kk]];
+							if (target >= 0)
+								aPtr[target] -= l * aPtr[kk];
+						}
+					}
+
+					for (int k = rowPtr[i]; k < rowPtr[i + 1]; ++k)
+						position[colIdx[k]] = -1;
+
+					if (aPtr[diagonalPtr[i]] == stdType(0))
+						return static_cast<int>(i) + 1;
+				}
+
+				return 0;
+			}
+
+			/**
+			 * x = (L * U)^(-1) * x, A and diagonal being the output of SparseIncompleteLu
+			 */
+			template<MathDomain md>
+			static void SparseSolveIncompleteLu(const SparseMemoryTile& A, const MemoryBuffer& diagonal, MemoryBuffer& x)
+			{
+				using stdType = typename Traits<md>::stdType;
+
+				const auto* rowPtr = reinterpret_cast<const int*>(A.nNonZeroRows);	  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast,performance-no-int-to-ptr)
+				const auto* colIdx = reinterpret_cast<const int*>(A.nonZeroColumnIndices);	  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast,performance-no-int-to-ptr)
+				const auto* aPtr = GetPointer<md>(A);
+				const auto* diagonalPtr = GetPointer<MathDomain::Int>(diagonal);
+				auto* xPtr = GetPointer<md>(x);
+
+				// L * y = x
+				for (unsigned i = 0; i < A.nRows; ++i)
+				{
+					stdType sum = xPtr[i];
+					for (int k = rowPtr[i]; k < diagonalPtr[i]; ++k)
+						sum -= aPtr[k] * xPtr[colIdx[k]];
+					xPtr[i] = sum;
+				}
+
+				// U * x = y
+				for (unsigned i = A.nRows; i > 0; --i)
+				{
+					const unsigned row = i - 1;
+					stdType sum = xPtr[row];
+					for (int k = diagonalPtr[row] + 1; k < rowPtr[row + 1]; ++k)
+						sum -= aPtr[k] * xPtr[colIdx[k]];
+					xPtr[row] = sum / aPtr[diagonalPtr[row]];
+				}
+			}
+		}	 // namespace nsr
+	}		 // namespace routines
+}	 // namespace cl
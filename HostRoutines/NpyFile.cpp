@@ -0,0 +1,246 @@
+#include <NpyFile.h>
+
+#include <Exceptions.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+
+namespace cl
+{
+	namespace routines
+	{
+		namespace detail
+		{
+			static constexpr char npyMagic[] = { '\x93', 'N', 'U', 'M', 'P', 'Y' };
+			static constexpr size_t npyMagicSize = { sizeof(npyMagic) };
+
+			// the header, including magic string, version and its own length, is padded to a multiple of this
+			static constexpr size_t npyHeaderAlignment = 64;
+
+			// value of a python dict entry in the npy header, e.g. 'descr': '<f4'
+			static std::string GetHeaderEntry(const std::string& header, const std::string& key)
+			{
+				const size_t keyPos = header.find("'" + key + "'");
+				if (keyPos == std::string::npos)
+					throw NpyFileException("Npy header entry not found");
+
+				const size_t begin = header.find(':', keyPos);
+				if (begin == std::string::npos)
+					throw NpyFileException("Invalid npy header");
+
+				// the shape is a tuple, hence it contains commas
+				const size_t end = header[header.find_first_not_of(' ', begin + 1)] == '(' ? header.find(')', begin) + 1 : header.find_first_of(",}", begin);
+				if (end == std::string::npos)
+					throw NpyFileException("Invalid npy header");
+
+				const size_t valueBegin = header.find_first_not_of(" '", begin + 1);
+				const size_t valueEnd = header.find_last_not_of(" '", end - 1);
+				return header.substr(valueBegin, valueEnd - valueBegin + 1);
+			}
+
+		}	 // namespace detail
+
+		std::string GetNpyDataType(const MathDomain mathDomain)
+		{
+			switch (mathDomain)
+			{
+				case MathDomain::Int:
+					return "<i4";
+				case MathDomain::Float:
+					return "<f4";
+				case MathDomain::Double:
+					return "<f8";
+				default:
+					throw NotImplementedException();
+			}
+		}
+
+		std::string GetNpyHeader(const std::string& dataType, const std::vector<size_t>& shape, const bool fortranOrder)
+		{
+			std::ostringstream dict;
+			dict << "{'descr': '" << dataType << "', 'fortran_order': " << (fortranOrder ? "True" : "False") << ", 'shape': (";
+			for (size_t i = 0; i < shape.size(); ++i)
+			{
+				dict << shape[i] << (shape.size() == 1 || i + 1 < shape.size() ? "," : "");
+				if (i + 1 < shape.size())
+					dict << " ";
+			}
+			dict << "), }";
+
+			// version 1.0 stores the header length in 2 bytes, version 2.0 in 4 bytes
+			std::string header = dict.str();
+			const bool isVersion1 = detail::npyMagicSize + 4 + header.size() + detail::npyHeaderAlignment < (1 << 16);
+			const size_t prefixSize = detail::npyMagicSize + (isVersion1 ? 4 : 6);
+			header.append((detail::npyHeaderAlignment - (prefixSize + header.size() + 1) % detail::npyHeaderAlignment) % detail::npyHeaderAlignment, ' ');
+			header.push_back('\n');
+
+			std::string ret(detail::npyMagic, detail::npyMagicSize);
+			ret.push_back(static_cast<char>(isVersion1 ? 1 : 2));
+			ret.push_back(0);
+			const size_t headerSize = header.size();
+			for (size_t byte = 0; byte < (isVersion1 ? 2u : 4u); ++byte)
+				ret.push_back(static_cast<char>((headerSize >> (8 * byte)) & 0xff));
+
+			return ret + header;
+		}
+
+		size_t NpyHeader::GetSize() const noexcept
+		{
+			size_t size = 1;
+			for (const size_t dimension : shape)
+				size *= dimension;
+
+			return size;
+		}
+
+		size_t NpyHeader::GetElementSize() const noexcept
+		{
+			if (dataType.size() < 3)
+				return 0;
+
+			return static_cast<size_t>(std::atoi(dataType.c_str() + 2));
+		}
+
+		bool NpyHeader::HasMathDomain(const MathDomain mathDomain) const noexcept
+		{
+			// '=' is the native byte order, which is little-endian on all the supported platforms
+			if (dataType.size() != 3 || (dataType[0] != '<' && dataType[0] != '='))
+				return false;
+
+			const std::string type = dataType.substr(1);
+			switch (mathDomain)
+			{
+				case MathDomain::Int:
+					return type == "i4";
+				case MathDomain::Float:
+					return type == "f4";
+				case MathDomain::Double:
+					return type == "f8";
+				default:
+					return false;
+			}
+		}
+
+		NpyHeader ParseNpyHeader(const char* begin, const size_t size)
+		{
+			// magic string, major/minor version and header length (2 bytes in version 1, 4 bytes in version 2 and 3)
+			if (size < detail::npyMagicSize + 4 || std::memcmp(begin, detail::npyMagic, detail::npyMagicSize) != 0)
+				throw NpyFileException("Not a npy file");
+
+			const auto* bytes = reinterpret_cast<const unsigned char*>(begin);
+			const unsigned majorVersion = bytes[detail::npyMagicSize];
+
+			size_t headerOffset = detail::npyMagicSize + 2;
+			size_t headerSize = 0;
+			if (majorVersion == 1)
+			{
+				headerSize = bytes[headerOffset] | (bytes[headerOffset + 1] << 8);
+				headerOffset += 2;
+			}
+			else
+			{
+				if (size < headerOffset + 4)
+					throw NpyFileException("Not a npy file");
+				headerSize = bytes[headerOffset] | (bytes[headerOffset + 1] << 8) | (bytes[headerOffset + 2] << 16) | (static_cast<size_t>(bytes[headerOffset + 3]) << 24);
+				headerOffset += 4;
+			}
+
+			if (headerOffset + headerSize > size)
+				throw NpyFileException("Truncated npy header");
+			const std::string header(begin + headerOffset, headerSize);
+
+			NpyHeader ret;
+			ret.dataType = detail::GetHeaderEntry(header, "descr");
+			ret.fortranOrder = detail::GetHeaderEntry(header, "fortran_order") == "True";
+
+			const std::string shape = detail::GetHeaderEntry(header, "shape");
+			for (size_t pos = shape.find_first_of("0123456789"); pos != std::string::npos; pos = shape.find_first_of("0123456789", pos))
+			{
+				size_t nDigits = 0;
+				ret.shape.push_back(std::stoul(shape.substr(pos), &nDigits));
+				pos += nDigits;
+			}
+
+			ret.dataOffset = headerOffset + headerSize;
+			return ret;
+		}
+
+		NpyFileWriter::NpyFileWriter(const std::string& fileName, const MathDomain mathDomain, const std::vector<size_t>& shape, const bool fortranOrder)
+			: _file(fileName, std::ios::binary | std::ios::trunc), _elementSize(mathDomain == MathDomain::Double ? sizeof(double) : sizeof(float)), _size(1)
+		{
+			if (!_file)
+				throw NpyFileException("Cannot open the npy file");
+
+			for (const size_t dimension : shape)
+				_size *= dimension;
+
+			const std::string header = GetNpyHeader(GetNpyDataType(mathDomain), shape, fortranOrder);
+			_file.write(header.data(), static_cast<std::streamsize>(header.size()));
+
+			if (!_file)
+				throw NpyFileException("Cannot write the npy header");
+		}
+
+		void NpyFileWriter::Write(const void* data, const size_t nElements)
+		{
+			if (_nWrittenElements + nElements > _size)
+				throw NpyFileException("Writing more elements than declared in the npy header");
+
+			_file.write(static_cast<const char*>(data), static_cast<std::streamsize>(nElements * _elementSize));
+			if (!_file)
+				throw NpyFileException("Cannot write the npy data");
+
+			_nWrittenElements += nElements;
+			if (IsComplete())
+				_file.flush();
+		}
+
+		NpyFileReader::NpyFileReader(const std::string& fileName)
+			: _file(fileName, std::ios::binary)
+		{
+			if (!_file)
+				throw NpyFileException("Cannot open the npy file");
+
+			// fixed part first, which tells how long the rest of the header is
+			std::vector<char> header(detail::npyMagicSize + 6);
+			_file.read(header.data(), static_cast<std::streamsize>(header.size()));
+			if (!_file)
+				throw NpyFileException("Not a npy file");
+
+			const auto* bytes = reinterpret_cast<const unsigned char*>(header.data());
+			size_t headerSize = detail::npyMagicSize + 4;
+			if (bytes[detail::npyMagicSize] == 1)
+				headerSize += bytes[detail::npyMagicSize + 2] | (bytes[detail::npyMagicSize + 3] << 8);
+			else
+				headerSize += 2 + (bytes[detail::npyMagicSize + 2] | (bytes[detail::npyMagicSize + 3] << 8) | (bytes[detail::npyMagicSize + 4] << 16) | (static_cast<size_t>(bytes[detail::npyMagicSize + 5]) << 24));
+
+			const size_t fixedSize = header.size();
+			header.resize(std::max(headerSize, fixedSize));
+			if (headerSize > fixedSize)
+				_file.read(header.data() + fixedSize, static_cast<std::streamsize>(headerSize - fixedSize));
+			if (!_file)
+				throw NpyFileException("Truncated npy header");
+
+			_header = ParseNpyHeader(header.data(), header.size());
+
+			// the fixed part might have read past a short header
+			_file.seekg(static_cast<std::streamoff>(_header.dataOffset));
+		}
+
+		void NpyFileReader::Read(void* data, const size_t nElements, const MathDomain mathDomain)
+		{
+			if (!_header.HasMathDomain(mathDomain))
+				throw NpyFileException("The npy element type doesn't match the math domain");
+			if (_nReadElements + nElements > _header.GetSize())
+				throw NpyFileException("Reading more elements than stored in the npy file");
+
+			_file.read(static_cast<char*>(data), static_cast<std::streamsize>(nElements * _header.GetElementSize()));
+			if (!_file)
+				throw NpyFileException("Truncated npy data");
+
+			_nReadElements += nElements;
+		}
+	}	 // namespace routines
+}	 // namespace cl
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <Types.h>
+
+#include <cstddef>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace cl
+{
+	namespace routines
+	{
+		/**
+		 * Header of a .npy file: the array data follows it, with no padding
+		 */
+		struct NpyHeader
+		{
+			// numpy type string, e.g. '<f4'
+			std::string dataType {};
+			std::vector<size_t> shape {};
+			bool fortranOrder = false;
+
+			// bytes from the beginning of the file to the array data
+			size_t dataOffset = 0;
+
+			// number of elements in the array
+			size_t GetSize() const noexcept;
+
+			size_t GetElementSize() const noexcept;
+
+			/**
+			 * Whether the data can be used in place as a buffer of the given math domain (i.e. it has the same little-endian element type)
+			 */
+			bool HasMathDomain(const MathDomain mathDomain) const noexcept;
+		};
+
+		/**
+		 * Parses the header at the beginning of a .npy file (format version 1.0, 2.0 or 3.0): size is the number of bytes available from begin
+		 */
+		extern NpyHeader ParseNpyHeader(const char* begin, const size_t size);
+
+		/**
+		 * numpy type string of the elements of mathDomain, e.g. '<f4'
+		 */
+		extern std::string GetNpyDataType(const MathDomain mathDomain);
+
+		/**
+		 * Magic string, version and header of a .npy file: it's padded so that the array data that follows it is 64-byte aligned
+		 */
+		extern std::string GetNpyHeader(const std::string& dataType, const std::vector<size_t>& shape, const bool fortranOrder);
+
+		/**
+		 * Writes an uncompressed .npy file chunk by chunk, straight from host memory: the array never has to be gathered in a single std::vector.
+		 * The header is written at construction, and the file is valid once all the elements declared by shape have been written.
+		 * With fortranOrder the first index is the fastest varying one, which is the layout of the column-wise buffers.
+		 */
+		class NpyFileWriter
+		{
+		public:
+			NpyFileWriter(const std::string& fileName, const MathDomain mathDomain, const std::vector<size_t>& shape, const bool fortranOrder);
+
+			NpyFileWriter(const NpyFileWriter&) = delete;
+			NpyFileWriter& operator=(const NpyFileWriter&) = delete;
+
+			/**
+			 * Appends nElements elements to the array data
+			 */
+			void Write(const void* data, const size_t nElements);
+
+			bool IsComplete() const noexcept { return _nWrittenElements == _size; }
+
+		private:
+			std::ofstream _file;
+			size_t _elementSize;
+			size_t _size;
+			size_t _nWrittenElements = 0;
+		};
+
+		/**
+		 * Reads an uncompressed .npy file chunk by chunk into host memory
+		 */
+		class NpyFileReader
+		{
+		public:
+			explicit NpyFileReader(const std::string& fileName);
+
+			NpyFileReader(const NpyFileReader&) = delete;
+			NpyFileReader& operator=(const NpyFileReader&) = delete;
+
+			const NpyHeader& GetHeader() const noexcept { return _header; }
+
+			/**
+			 * Reads the next nElements elements of the array data, which has to have the same element type of mathDomain
+			 */
+			void Read(void* data, const size_t nElements, const MathDomain mathDomain);
+
+		private:
+			std::ifstream _file;
+			NpyHeader _header {};
+			size_t _nReadElements = 0;
+		};
+	}	 // namespace routines
+}	 // namespace cl
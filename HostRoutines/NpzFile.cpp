@@ -0,0 +1,514 @@
+#include <NpzFile.h>
+
+#include <Exceptions.h>
+
+#include <algorithm>
+
+#include <zlib.h>
+
+namespace cl
+{
+	namespace routines
+	{
+		namespace detail
+		{
+			static constexpr uint32_t localHeaderSignature = 0x04034b50;
+			static constexpr uint32_t centralHeaderSignature = 0x02014b50;
+			static constexpr uint32_t endOfCentralDirectorySignature = 0x06054b50;
+			static constexpr uint32_t zip64EndOfCentralDirectorySignature = 0x06064b50;
+			static constexpr uint32_t zip64LocatorSignature = 0x07064b50;
+
+			static constexpr size_t localHeaderSize = 30;
+			static constexpr size_t centralHeaderSize = 46;
+			static constexpr size_t endOfCentralDirectorySize = 22;
+			static constexpr size_t zip64EndOfCentralDirectorySize = 56;
+			static constexpr size_t zip64LocatorSize = 20;
+
+			static constexpr uint16_t zip64ExtraId = 0x0001;
+			// same id used by zipalign for padding the local headers
+			static constexpr uint16_t paddingExtraId = 0xd935;
+
+			static constexpr uint16_t storedMethod = 0;
+			static constexpr uint16_t deflatedMethod = 8;
+
+			// 1980-01-01 00:00, the earliest date in a zip file
+			static constexpr uint16_t dosDate = (1 << 5) | 1;
+			static constexpr uint16_t dosTime = 0;
+
+			static constexpr uint64_t maxSize32 = 0xffffffff;
+			static constexpr uint64_t maxEntries16 = 0xffff;
+
+			// same as the .npy header, so that stored arrays can be memory mapped
+			static constexpr size_t dataAlignment = 64;
+
+			// zlib counts bytes in 32 bits
+			static constexpr size_t zlibChunkSize = size_t(1) << 30;
+
+			static void Put(std::string& out, const uint64_t value, const size_t nBytes)
+			{
+				for (size_t byte = 0; byte < nBytes; ++byte)
+					out.push_back(static_cast<char>((value >> (8 * byte)) & 0xff));
+			}
+
+			static uint64_t Get(const char* in, const size_t nBytes)
+			{
+				const auto* bytes = reinterpret_cast<const unsigned char*>(in);
+
+				uint64_t ret = 0;
+				for (size_t byte = 0; byte < nBytes; ++byte)
+					ret |= static_cast<uint64_t>(bytes[byte]) << (8 * byte);
+				return ret;
+			}
+
+			static uint32_t Crc32(uint32_t crc, const char* data, size_t nBytes)
+			{
+				while (nBytes > 0)
+				{
+					const size_t chunkSize = std::min(nBytes, zlibChunkSize);
+					crc = static_cast<uint32_t>(crc32(crc, reinterpret_cast<const Bytef*>(data), static_cast<uInt>(chunkSize)));
+					data += chunkSize;
+					nBytes -= chunkSize;
+				}
+
+				return crc;
+			}
+
+			/**
+			 * Raw deflate (no zlib header) of the .npy header followed by the array data
+			 */
+			static std::vector<char> Deflate(const std::string& header, const char* data, const size_t nBytes)
+			{
+				z_stream stream {};
+				if (deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+					throw NpyFileException("deflateInit failed");
+
+				std::vector<char> ret(deflateBound(&stream, static_cast<uLong>(header.size() + nBytes)));
+				size_t nCompressedBytes = 0;
+
+				const char* inputs[] = { header.data(), data };
+				const size_t inputSizes[] = { header.size(), nBytes };
+				int status = Z_OK;
+				for (size_t i = 0; i < 2; ++i)
+				{
+					const char* input = inputs[i];
+					size_t remaining = inputSizes[i];
+					do
+					{
+						const size_t chunkSize = std::min(remaining, zlibChunkSize);
+						stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(input));
+						stream.avail_in = static_cast<uInt>(chunkSize);
+						input += chunkSize;
+						remaining -= chunkSize;
+
+						const int flush = i == 1 && remaining == 0 ? Z_FINISH : Z_NO_FLUSH;
+						do
+						{
+							if (nCompressedBytes == ret.size())
+								ret.resize(2 * ret.size());
+							const size_t available = std::min(ret.size() - nCompressedBytes, zlibChunkSize);
+							stream.next_out = reinterpret_cast<Bytef*>(ret.data() + nCompressedBytes);
+							stream.avail_out = static_cast<uInt>(available);
+
+							status = deflate(&stream, flush);
+							nCompressedBytes += available - stream.avail_out;
+						} while (stream.avail_out == 0 || (flush == Z_FINISH && status != Z_STREAM_END));
+					} while (remaining > 0);
+				}
+				deflateEnd(&stream);
+
+				if (status != Z_STREAM_END)
+					throw NpyFileException("deflate failed");
+
+				ret.resize(nCompressedBytes);
+				return ret;
+			}
+
+			static void Inflate(const std::vector<char>& compressedData, std::vector<char>& data)
+			{
+				z_stream stream {};
+				if (inflateInit2(&stream, -MAX_WBITS) != Z_OK)
+					throw NpyFileException("inflateInit failed");
+
+				size_t nReadBytes = 0;
+				size_t nWrittenBytes = 0;
+				int status = Z_OK;
+				while (status == Z_OK)
+				{
+					const size_t inputSize = std::min(compressedData.size() - nReadBytes, zlibChunkSize);
+					const size_t outputSize = std::min(data.size() - nWrittenBytes, zlibChunkSize);
+					stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(compressedData.data() + nReadBytes));
+					stream.avail_in = static_cast<uInt>(inputSize);
+					stream.next_out = reinterpret_cast<Bytef*>(data.data() + nWrittenBytes);
+					stream.avail_out = static_cast<uInt>(outputSize);
+
+					status = inflate(&stream, Z_NO_FLUSH);
+					nReadBytes += inputSize - stream.avail_in;
+					nWrittenBytes += outputSize - stream.avail_out;
+
+					// no progress: either the input is truncated or the output is full
+					if (status == Z_OK && stream.avail_in == inputSize && stream.avail_out == outputSize)
+						break;
+				}
+				inflateEnd(&stream);
+
+				if (status != Z_STREAM_END || nWrittenBytes != data.size())
+					throw NpyFileException("Corrupted npz entry");
+			}
+		}	 // namespace detail
+
+		NpzFileWriter::NpzFileWriter(const std::string& fileName, const bool compressed)
+			: _file(fileName, std::ios::binary | std::ios::trunc), _compressed(compressed)
+		{
+			if (!_file)
+				throw NpyFileException("Cannot open the npz file");
+		}
+
+		NpzFileWriter::~NpzFileWriter()
+		{
+			if (!_file.is_open())
+				return;
+
+			try
+			{
+				Close();
+			}
+			catch (...)
+			{
+			}
+		}
+
+		void NpzFileWriter::Write(const std::string& arrayName, const std::string& dataType, const std::vector<size_t>& shape, const void* data, const size_t nBytes)
+		{
+			const std::string header = GetNpyHeader(dataType, shape, false);
+			const char* bytes = static_cast<const char*>(data);
+
+			NpzEntry entry;
+			entry.name = arrayName;
+			entry.compressed = _compressed;
+			entry.size = header.size() + nBytes;
+			entry.crc = detail::Crc32(detail::Crc32(0, header.data(), header.size()), bytes, nBytes);
+			entry.localHeaderOffset = _offset;
+
+			std::vector<char> compressedData {};
+			if (_compressed)
+			{
+				compressedData = detail::Deflate(header, bytes, nBytes);
+				entry.compressedSize = compressedData.size();
+			}
+			else
+				entry.compressedSize = entry.size;
+
+			const std::string fileName = arrayName + ".npy";
+			const bool isZip64 = entry.size >= detail::maxSize32 || entry.compressedSize >= detail::maxSize32;
+
+			std::string extra;
+			if (isZip64)
+			{
+				detail::Put(extra, detail::zip64ExtraId, 2);
+				detail::Put(extra, 16, 2);
+				detail::Put(extra, entry.size, 8);
+				detail::Put(extra, entry.compressedSize, 8);
+			}
+			if (!_compressed)
+			{
+				const size_t dataOffset = _offset + detail::localHeaderSize + fileName.size() + extra.size();
+				size_t padding = (detail::dataAlignment - dataOffset % detail::dataAlignment) % detail::dataAlignment;
+
+				// an extra field takes at least 4 bytes
+				if (padding > 0 && padding < 4)
+					padding += detail::dataAlignment;
+				if (padding > 0)
+				{
+					detail::Put(extra, detail::paddingExtraId, 2);
+					detail::Put(extra, padding - 4, 2);
+					extra.append(padding - 4, '\0');
+				}
+			}
+			entry.dataOffset = _offset + detail::localHeaderSize + fileName.size() + extra.size();
+
+			std::string localHeader;
+			detail::Put(localHeader, detail::localHeaderSignature, 4);
+			detail::Put(localHeader, isZip64 ? 45 : 20, 2);
+			detail::Put(localHeader, 0, 2);
+			detail::Put(localHeader, _compressed ? detail::deflatedMethod : detail::storedMethod, 2);
+			detail::Put(localHeader, detail::dosTime, 2);
+			detail::Put(localHeader, detail::dosDate, 2);
+			detail::Put(localHeader, entry.crc, 4);
+			detail::Put(localHeader, isZip64 ? detail::maxSize32 : entry.compressedSize, 4);
+			detail::Put(localHeader, isZip64 ? detail::maxSize32 : entry.size, 4);
+			detail::Put(localHeader, fileName.size(), 2);
+			detail::Put(localHeader, extra.size(), 2);
+			localHeader += fileName;
+			localHeader += extra;
+			_file.write(localHeader.data(), static_cast<std::streamsize>(localHeader.size()));
+
+			if (_compressed)
+				_file.write(compressedData.data(), static_cast<std::streamsize>(compressedData.size()));
+			else
+			{
+				_file.write(header.data(), static_cast<std::streamsize>(header.size()));
+				_file.write(bytes, static_cast<std::streamsize>(nBytes));
+			}
+
+			if (!_file)
+				throw NpyFileException("Cannot write the npz entry");
+
+			_offset = entry.dataOffset + entry.compressedSize;
+			_entries.push_back(std::move(entry));
+		}
+
+		void NpzFileWriter::Write(const std::string& arrayName, const MathDomain mathDomain, const std::vector<size_t>& shape, const void* data, const size_t nElements)
+		{
+			const size_t elementSize = mathDomain == MathDomain::Double ? sizeof(double) : sizeof(float);
+			Write(arrayName, GetNpyDataType(mathDomain), shape, data, nElements * elementSize);
+		}
+
+		void NpzFileWriter::Close()
+		{
+			const size_t centralDirectoryOffset = _offset;
+
+			std::string centralDirectory;
+			for (const auto& entry : _entries)
+			{
+				// only the values that don't fit in 32 bits go in the zip64 extra field, in this order
+				std::string extra;
+				for (const size_t value : { entry.size, entry.compressedSize, entry.localHeaderOffset })
+				{
+					if (value >= detail::maxSize32)
+						detail::Put(extra, value, 8);
+				}
+				if (!extra.empty())
+				{
+					std::string zip64Extra;
+					detail::Put(zip64Extra, detail::zip64ExtraId, 2);
+					detail::Put(zip64Extra, extra.size(), 2);
+					extra = zip64Extra + extra;
+				}
+
+				const std::string fileName = entry.name + ".npy";
+				detail::Put(centralDirectory, detail::centralHeaderSignature, 4);
+				detail::Put(centralDirectory, 45, 2);
+				detail::Put(centralDirectory, extra.empty() ? 20 : 45, 2);
+				detail::Put(centralDirectory, 0, 2);
+				detail::Put(centralDirectory, entry.compressed ? detail::deflatedMethod : detail::storedMethod, 2);
+				detail::Put(centralDirectory, detail::dosTime, 2);
+				detail::Put(centralDirectory, detail::dosDate, 2);
+				detail::Put(centralDirectory, entry.crc, 4);
+				detail::Put(centralDirectory, std::min<uint64_t>(entry.compressedSize, detail::maxSize32), 4);
+				detail::Put(centralDirectory, std::min<uint64_t>(entry.size, detail::maxSize32), 4);
+				detail::Put(centralDirectory, fileName.size(), 2);
+				detail::Put(centralDirectory, extra.size(), 2);
+				detail::Put(centralDirectory, 0, 2);  // comment length
+				detail::Put(centralDirectory, 0, 2);  // disk number
+				detail::Put(centralDirectory, 0, 2);  // internal attributes
+				detail::Put(centralDirectory, 0600u << 16, 4);	// unix permissions
+				detail::Put(centralDirectory, std::min<uint64_t>(entry.localHeaderOffset, detail::maxSize32), 4);
+				centralDirectory += fileName;
+				centralDirectory += extra;
+			}
+
+			std::string end;
+			const bool isZip64 = _entries.size() >= detail::maxEntries16 || centralDirectory.size() >= detail::maxSize32 || centralDirectoryOffset >= detail::maxSize32;
+			if (isZip64)
+			{
+				const size_t zip64EndOffset = centralDirectoryOffset + centralDirectory.size();
+				detail::Put(end, detail::zip64EndOfCentralDirectorySignature, 4);
+				detail::Put(end, detail::zip64EndOfCentralDirectorySize - 12, 8);
+				detail::Put(end, 45, 2);
+				detail::Put(end, 45, 2);
+				detail::Put(end, 0, 4);
+				detail::Put(end, 0, 4);
+				detail::Put(end, _entries.size(), 8);
+				detail::Put(end, _entries.size(), 8);
+				detail::Put(end, centralDirectory.size(), 8);
+				detail::Put(end, centralDirectoryOffset, 8);
+
+				detail::Put(end, detail::zip64LocatorSignature, 4);
+				detail::Put(end, 0, 4);
+				detail::Put(end, zip64EndOffset, 8);
+				detail::Put(end, 1, 4);
+			}
+
+			detail::Put(end, detail::endOfCentralDirectorySignature, 4);
+			detail::Put(end, 0, 2);
+			detail::Put(end, 0, 2);
+			detail::Put(end, std::min<uint64_t>(_entries.size(), detail::maxEntries16), 2);
+			detail::Put(end, std::min<uint64_t>(_entries.size(), detail::maxEntries16), 2);
+			detail::Put(end, std::min<uint64_t>(centralDirectory.size(), detail::maxSize32), 4);
+			detail::Put(end, std::min<uint64_t>(centralDirectoryOffset, detail::maxSize32), 4);
+			detail::Put(end, 0, 2);	 // comment length
+
+			_file.write(centralDirectory.data(), static_cast<std::streamsize>(centralDirectory.size()));
+			_file.write(end.data(), static_cast<std::streamsize>(end.size()));
+			_file.close();
+
+			if (!_file)
+				throw NpyFileException("Cannot write the npz central directory");
+		}
+
+		NpzFileReader::NpzFileReader(const std::string& fileName)
+			: _file(fileName, std::ios::binary)
+		{
+			if (!_file)
+				throw NpyFileException("Cannot open the npz file");
+
+			_file.seekg(0, std::ios::end);
+			_fileSize = static_cast<size_t>(_file.tellg());
+			if (_fileSize < detail::endOfCentralDirectorySize)
+				throw NpyFileException("Not a npz file");
+
+			// the end of central directory record is followed by a comment of at most 64KB
+			const size_t tailSize = std::min(_fileSize, detail::endOfCentralDirectorySize + 0xffff);
+			std::vector<char> tail(tailSize);
+			ReadBytes(_fileSize - tailSize, tailSize, tail.data());
+
+			size_t endPosition = tailSize - detail::endOfCentralDirectorySize + 1;
+			do
+			{
+				--endPosition;
+				if (detail::Get(tail.data() + endPosition, 4) == detail::endOfCentralDirectorySignature)
+					break;
+			} while (endPosition > 0);
+			if (detail::Get(tail.data() + endPosition, 4) != detail::endOfCentralDirectorySignature)
+				throw NpyFileException("Not a npz file");
+
+			const char* end = tail.data() + endPosition;
+			uint64_t nEntries = detail::Get(end + 10, 2);
+			uint64_t centralDirectorySize = detail::Get(end + 12, 4);
+			uint64_t centralDirectoryOffset = detail::Get(end + 16, 4);
+			if (nEntries == detail::maxEntries16 || centralDirectorySize == detail::maxSize32 || centralDirectoryOffset == detail::maxSize32)
+			{
+				const size_t absoluteEndPosition = _fileSize - tailSize + endPosition;
+				if (absoluteEndPosition < detail::zip64LocatorSize)
+					throw NpyFileException("Invalid npz zip64 locator");
+
+				char locator[detail::zip64LocatorSize];
+				ReadBytes(absoluteEndPosition - detail::zip64LocatorSize, detail::zip64LocatorSize, locator);
+				if (detail::Get(locator, 4) != detail::zip64LocatorSignature)
+					throw NpyFileException("Invalid npz zip64 locator");
+
+				char zip64End[detail::zip64EndOfCentralDirectorySize];
+				ReadBytes(detail::Get(locator + 8, 8), detail::zip64EndOfCentralDirectorySize, zip64End);
+				if (detail::Get(zip64End, 4) != detail::zip64EndOfCentralDirectorySignature)
+					throw NpyFileException("Invalid npz zip64 end of central directory");
+
+				nEntries = detail::Get(zip64End + 32, 8);
+				centralDirectorySize = detail::Get(zip64End + 40, 8);
+				centralDirectoryOffset = detail::Get(zip64End + 48, 8);
+			}
+
+			std::vector<char> centralDirectory(centralDirectorySize);
+			ReadBytes(centralDirectoryOffset, centralDirectorySize, centralDirectory.data());
+
+			size_t position = 0;
+			for (uint64_t i = 0; i < nEntries; ++i)
+			{
+				if (position + detail::centralHeaderSize > centralDirectory.size() || detail::Get(centralDirectory.data() + position, 4) != detail::centralHeaderSignature)
+					throw NpyFileException("Invalid npz central directory");
+
+				const char* header = centralDirectory.data() + position;
+				const size_t nameSize = detail::Get(header + 28, 2);
+				const size_t extraSize = detail::Get(header + 30, 2);
+				const size_t commentSize = detail::Get(header + 32, 2);
+				if (position + detail::centralHeaderSize + nameSize + extraSize + commentSize > centralDirectory.size())
+					throw NpyFileException("Invalid npz central directory");
+
+				NpzEntry entry;
+				const uint64_t method = detail::Get(header + 10, 2);
+				if (method != detail::storedMethod && method != detail::deflatedMethod)
+					throw NpyFileException("Unsupported npz compression method");
+				entry.compressed = method == detail::deflatedMethod;
+				entry.crc = static_cast<uint32_t>(detail::Get(header + 16, 4));
+				entry.compressedSize = detail::Get(header + 20, 4);
+				entry.size = detail::Get(header + 24, 4);
+				entry.localHeaderOffset = detail::Get(header + 42, 4);
+
+				// the values that don't fit in 32 bits are in the zip64 extra field, in this order
+				const char* extra = header + detail::centralHeaderSize + nameSize;
+				for (size_t extraPosition = 0; extraPosition + 4 <= extraSize;)
+				{
+					const uint64_t id = detail::Get(extra + extraPosition, 2);
+					const size_t fieldSize = detail::Get(extra + extraPosition + 2, 2);
+					if (id == detail::zip64ExtraId)
+					{
+						const char* field = extra + extraPosition + 4;
+						for (size_t* value : { &entry.size, &entry.compressedSize, &entry.localHeaderOffset })
+						{
+							if (*value == detail::maxSize32 && field + 8 <= extra + extraPosition + 4 + fieldSize)
+							{
+								*value = detail::Get(field, 8);
+								field += 8;
+							}
+						}
+					}
+					extraPosition += 4 + fieldSize;
+				}
+
+				entry.name = std::string(header + detail::centralHeaderSize, nameSize);
+				if (entry.name.size() > 4 && entry.name.compare(entry.name.size() - 4, 4, ".npy") == 0)
+					entry.name.resize(entry.name.size() - 4);
+
+				// the local extra field can be different from the central one, e.g. because of padding
+				char localHeader[detail::localHeaderSize];
+				ReadBytes(entry.localHeaderOffset, detail::localHeaderSize, localHeader);
+				if (detail::Get(localHeader, 4) != detail::localHeaderSignature)
+					throw NpyFileException("Invalid npz local header");
+				entry.dataOffset = entry.localHeaderOffset + detail::localHeaderSize + detail::Get(localHeader + 26, 2) + detail::Get(localHeader + 28, 2);
+				if (entry.dataOffset + entry.compressedSize > _fileSize)
+					throw NpyFileException("Truncated npz entry");
+
+				_entries.push_back(std::move(entry));
+				position += detail::centralHeaderSize + nameSize + extraSize + commentSize;
+			}
+		}
+
+		bool NpzFileReader::HasEntry(const std::string& arrayName) const noexcept
+		{
+			return std::any_of(_entries.begin(), _entries.end(), [&arrayName](const NpzEntry& entry) { return entry.name == arrayName; });
+		}
+
+		const NpzEntry& NpzFileReader::GetEntry(const std::string& arrayName) const
+		{
+			const auto it = std::find_if(_entries.begin(), _entries.end(), [&arrayName](const NpzEntry& entry) { return entry.name == arrayName; });
+			if (it == _entries.end())
+				throw NpyFileException("Npz entry not found");
+
+			return *it;
+		}
+
+		NpyHeader NpzFileReader::Read(const std::string& arrayName, std::vector<char>& data)
+		{
+			const NpzEntry& entry = GetEntry(arrayName);
+
+			data.resize(entry.size);
+			if (entry.compressed)
+			{
+				std::vector<char> compressedData(entry.compressedSize);
+				ReadBytes(entry.dataOffset, entry.compressedSize, compressedData.data());
+				detail::Inflate(compressedData, data);
+			}
+			else
+				ReadBytes(entry.dataOffset, entry.size, data.data());
+
+			if (detail::Crc32(0, data.data(), data.size()) != entry.crc)
+				throw NpyFileException("Corrupted npz entry");
+
+			const NpyHeader header = ParseNpyHeader(data.data(), data.size());
+			if (header.dataOffset + header.GetSize() * header.GetElementSize() > data.size())
+				throw NpyFileException("Truncated npy data");
+
+			return header;
+		}
+
+		void NpzFileReader::ReadBytes(const size_t offset, const size_t nBytes, char* out)
+		{
+			if (offset + nBytes > _fileSize)
+				throw NpyFileException("Truncated npz file");
+
+			_file.seekg(static_cast<std::streamoff>(offset));
+			_file.read(out, static_cast<std::streamsize>(nBytes));
+			if (!_file)
+				throw NpyFileException("Cannot read the npz file");
+		}
+	}	 // namespace routines
+}	 // namespace cl
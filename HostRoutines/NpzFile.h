@@ -0,0 +1,99 @@
+#pragma once
+
+#include <NpyFile.h>
+#include <Types.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace cl
+{
+	namespace routines
+	{
+		/**
+		 * Array stored in a .npz archive, i.e. a zip file with one .npy file per array
+		 */
+		struct NpzEntry
+		{
+			// name of the array, without the .npy extension
+			std::string name {};
+
+			// deflated, otherwise the .npy file is stored as it is
+			bool compressed = false;
+
+			size_t compressedSize = 0;
+			size_t size = 0;
+			uint32_t crc = 0;
+
+			// bytes from the beginning of the archive to the local header and to the .npy file
+			size_t localHeaderOffset = 0;
+			size_t dataOffset = 0;
+		};
+
+		/**
+		 * Writes a .npz archive compatible with numpy.load: arrays are either stored, like numpy.savez, or deflated, like numpy.savez_compressed.
+		 * Stored arrays are padded so that their data is 64-byte aligned in the archive, hence they can be memory mapped in place.
+		 * The archive is valid only after Close.
+		 */
+		class NpzFileWriter
+		{
+		public:
+			NpzFileWriter(const std::string& fileName, const bool compressed);
+			~NpzFileWriter();
+
+			NpzFileWriter(const NpzFileWriter&) = delete;
+			NpzFileWriter& operator=(const NpzFileWriter&) = delete;
+
+			/**
+			 * Adds the array arrayName, whose nBytes bytes of data are elements of the numpy type dataType
+			 */
+			void Write(const std::string& arrayName, const std::string& dataType, const std::vector<size_t>& shape, const void* data, const size_t nBytes);
+
+			void Write(const std::string& arrayName, const MathDomain mathDomain, const std::vector<size_t>& shape, const void* data, const size_t nElements);
+
+			/**
+			 * Writes the central directory
+			 */
+			void Close();
+
+		private:
+			std::ofstream _file;
+			bool _compressed;
+			std::vector<NpzEntry> _entries {};
+			size_t _offset = 0;
+		};
+
+		/**
+		 * Reads the arrays of a .npz archive, as written by numpy.savez, numpy.savez_compressed or NpzFileWriter
+		 */
+		class NpzFileReader
+		{
+		public:
+			explicit NpzFileReader(const std::string& fileName);
+
+			NpzFileReader(const NpzFileReader&) = delete;
+			NpzFileReader& operator=(const NpzFileReader&) = delete;
+
+			const std::vector<NpzEntry>& GetEntries() const noexcept { return _entries; }
+
+			bool HasEntry(const std::string& arrayName) const noexcept;
+
+			const NpzEntry& GetEntry(const std::string& arrayName) const;
+
+			/**
+			 * Reads the array arrayName, inflating it when it's compressed: data holds the whole .npy file, whose header is returned
+			 */
+			NpyHeader Read(const std::string& arrayName, std::vector<char>& data);
+
+		private:
+			void ReadBytes(const size_t offset, const size_t nBytes, char* out);
+
+			std::ifstream _file;
+			size_t _fileSize = 0;
+			std::vector<NpzEntry> _entries {};
+		};
+	}	 // namespace routines
+}	 // namespace cl
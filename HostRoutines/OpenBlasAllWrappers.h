@@ -1,7 +1,9 @@
 #pragma once
 
 #include <BufferInitializer.h>
+#include <Common.h>
 #include <MemoryManager.h>
+#include <SolverWorkspace.h>
 #include <Types.h>
 
 #include <array>
@@ -28,5 +30,7 @@
 
 #ifdef USE_OPEN_BLAS
 	#define GENERIC_API_DEFINE
+	#define GENERIC_API_SET_NUM_THREADS openblas_set_num_threads
+	#define GENERIC_API_GET_NUM_THREADS openblas_get_num_threads
 #endif
 #include <GenericBlasApiWrappers.h>
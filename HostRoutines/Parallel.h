@@ -0,0 +1,64 @@
+#pragma once
+
+#include <ThreadPool.h>
+
+#include <algorithm>
+#include <cstddef>
+
+namespace cl
+{
+	namespace routines
+	{
+		namespace detail
+		{
+			// element-wise loops are split in chunks of at least this many items: fewer aren't worth a task
+			static constexpr size_t elementWiseGrainSize = size_t(1) << 14;
+
+			// chunks per thread: more than one, so that idle threads can steal from the slow ones
+			static constexpr size_t nChunksPerThread = 4;
+
+			static inline size_t GetNumberOfThreads() noexcept { return ThreadPool::Instance().GetNumberOfThreads(); }
+
+			/**
+			 * Number of threads worth spawning for nWorkItems items, when each thread needs at least minWorkItemsPerThread to pay off
+			 */
+			static inline size_t GetNumberOfPartitions(const size_t nWorkItems, const size_t minWorkItemsPerThread) noexcept
+			{
+				return std::max(size_t(1), std::min(GetNumberOfThreads(), nWorkItems / minWorkItemsPerThread));
+			}
+
+			/**
+			 * Grain size for loops over columns (or any other slice) made of nItemsPerSlice items each
+			 */
+			static inline size_t GetSliceGrainSize(const size_t nItemsPerSlice) noexcept { return std::max(size_t(1), elementWiseGrainSize / std::max(size_t(1), nItemsPerSlice)); }
+
+			/**
+			 * Runs f(0), ..., f(nPartitions - 1) concurrently on the thread pool, the calling thread included
+			 */
+			template<typename F>
+			static void ParallelFor(const size_t nPartitions, const F& f)
+			{
+				ThreadPool::Instance().Run(nPartitions, f);
+			}
+
+			/**
+			 * Runs f(begin, end) over chunks of [0, size) of at least grainSize items each (bar the last one): small loops stay on the calling thread
+			 */
+			template<typename F>
+			static void ParallelFor(const size_t size, const size_t grainSize, const F& f)
+			{
+				if (size == 0)
+					return;
+
+				const size_t nChunks = std::min((size + grainSize - 1) / grainSize, GetNumberOfThreads() * nChunksPerThread);
+				if (nChunks <= 1)
+				{
+					f(size_t(0), size);
+					return;
+				}
+
+				ThreadPool::Instance().Run(nChunks, [&](const size_t chunk) { f(chunk * size / nChunks, (chunk + 1) * size / nChunks); });
+			}
+		}	 // namespace detail
+	}		 // namespace routines
+}	 // namespace cl
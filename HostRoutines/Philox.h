@@ -0,0 +1,147 @@
+#pragma once
+
+#include <Parallel.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+namespace cl
+{
+	namespace routines
+	{
+		/**
+		 * Philox4x32-10 counter-based generator (Salmon et al., "Parallel Random Numbers: As Easy as 1, 2, 3").
+		 * The i-th group of random numbers only depends on the seed and on i: buffers are split in blocks which are filled
+		 * independently by each thread, and the output doesn't depend on the number of threads.
+		 */
+		namespace philox
+		{
+			using Counter = std::array<uint32_t, 4>;
+
+			static constexpr uint32_t multiplier0 = { 0xD2511F53 };
+			static constexpr uint32_t multiplier1 = { 0xCD9E8D57 };
+			static constexpr uint32_t weyl0 = { 0x9E3779B9 };
+			static constexpr uint32_t weyl1 = { 0xBB67AE85 };
+			static constexpr unsigned nRounds = { 10 };
+			static constexpr double twoPi = { 6.283185307179586 };
+
+			// counters generated by a thread in one go: big enough for amortizing the scheduling, small enough for staying in cache
+			static constexpr size_t countersPerBlock = { 1 << 12 };
+			static constexpr size_t minElementsPerThread = { 1 << 16 };
+
+			static inline Counter Generate(Counter counter, const uint32_t key0, const uint32_t key1) noexcept
+			{
+				uint32_t k0 = key0;
+				uint32_t k1 = key1;
+				for (unsigned r = 0; r < nRounds; ++r)
+				{
+					const uint64_t product0 = static_cast<uint64_t>(multiplier0) * counter[0];
+					const uint64_t product1 = static_cast<uint64_t>(multiplier1) * counter[2];
+
+					counter = { static_cast<uint32_t>(product1 >> 32) ^ counter[1] ^ k0, static_cast<uint32_t>(product1),
+								static_cast<uint32_t>(product0 >> 32) ^ counter[3] ^ k1, static_cast<uint32_t>(product0) };
+
+					k0 += weyl0;
+					k1 += weyl1;
+				}
+
+				return counter;
+			}
+
+			static inline Counter Generate(const uint64_t index, const unsigned seed) noexcept
+			{
+				return Generate({ static_cast<uint32_t>(index), static_cast<uint32_t>(index >> 32), 0, 0 }, seed, 0);
+			}
+
+			// [0, 1)
+			static inline float ToUniform(const uint32_t x) noexcept { return static_cast<float>(x >> 8) * (1.0f / 16777216.0f); }
+			static inline double ToUniform(const uint32_t hi, const uint32_t lo) noexcept
+			{
+				return static_cast<double>(((static_cast<uint64_t>(hi) << 32) | lo) >> 11) * (1.0 / 9007199254740992.0);
+			}
+
+			// (0, 1]: safe for taking the logarithm
+			static inline float ToPositiveUniform(const uint32_t x) noexcept { return static_cast<float>((x >> 8) + 1) * (1.0f / 16777216.0f); }
+			static inline double ToPositiveUniform(const uint32_t hi, const uint32_t lo) noexcept
+			{
+				return static_cast<double>((((static_cast<uint64_t>(hi) << 32) | lo) >> 11) + 1) * (1.0 / 9007199254740992.0);
+			}
+
+			/**
+			 * Each counter produces valuesPerCounter outputs through transform(counter, out): counters are split in blocks,
+			 * and blocks are distributed among threads
+			 */
+			template<size_t valuesPerCounter, typename T, typename Transform>
+			static void Fill(T* ptr, const size_t size, const unsigned seed, const Transform& transform)
+			{
+				const size_t nCounters = (size + valuesPerCounter - 1) / valuesPerCounter;
+				const size_t nBlocks = (nCounters + countersPerBlock - 1) / countersPerBlock;
+				const size_t nPartitions = std::max(size_t(1), std::min(nBlocks, detail::GetNumberOfPartitions(size, minElementsPerThread)));
+
+				detail::ParallelFor(nPartitions, [&](const size_t p) {
+					for (size_t b = p; b < nBlocks; b += nPartitions)
+					{
+						const size_t begin = b * countersPerBlock;
+						const size_t end = std::min(nCounters, begin + countersPerBlock);
+
+						// all the full counters can be written in place, the last one might overflow the buffer
+						const size_t nFullCounters = std::min(end, size / valuesPerCounter);
+						for (size_t c = begin; c < nFullCounters; ++c)
+							transform(Generate(c, seed), ptr + c * valuesPerCounter);
+
+						if (nFullCounters < end)
+						{
+							std::array<T, valuesPerCounter> tail {};
+							transform(Generate(nFullCounters, seed), tail.data());
+							std::copy(tail.begin(), tail.begin() + (size - nFullCounters * valuesPerCounter), ptr + nFullCounters * valuesPerCounter);
+						}
+					}
+				});
+			}
+
+			static inline void FillUniform(float* ptr, const size_t size, const unsigned seed)
+			{
+				Fill<4>(ptr, size, seed, [](const Counter& x, float* out) {
+					for (size_t i = 0; i < 4; ++i)
+						out[i] = ToUniform(x[i]);
+				});
+			}
+
+			static inline void FillUniform(double* ptr, const size_t size, const unsigned seed)
+			{
+				Fill<2>(ptr, size, seed, [](const Counter& x, double* out) {
+					out[0] = ToUniform(x[0], x[1]);
+					out[1] = ToUniform(x[2], x[3]);
+				});
+			}
+
+			/**
+			 * Box-Muller: every pair of uniforms gives a pair of independent standard normals
+			 */
+			static inline void FillNormal(float* ptr, const size_t size, const unsigned seed)
+			{
+				Fill<4>(ptr, size, seed, [](const Counter& x, float* out) {
+					for (size_t i = 0; i < 4; i += 2)
+					{
+						const float radius = std::sqrt(-2.0f * std::log(ToPositiveUniform(x[i])));
+						const float angle = static_cast<float>(twoPi) * ToUniform(x[i + 1]);
+						out[i] = radius * std::cos(angle);
+						out[i + 1] = radius * std::sin(angle);
+					}
+				});
+			}
+
+			static inline void FillNormal(double* ptr, const size_t size, const unsigned seed)
+			{
+				Fill<2>(ptr, size, seed, [](const Counter& x, double* out) {
+					const double radius = std::sqrt(-2.0 * std::log(ToPositiveUniform(x[0], x[1])));
+					const double angle = twoPi * ToUniform(x[2], x[3]);
+					out[0] = radius * std::cos(angle);
+					out[1] = radius * std::sin(angle);
+				});
+			}
+		}	 // namespace philox
+	}		 // namespace routines
+}	 // namespace cl
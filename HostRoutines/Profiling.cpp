@@ -0,0 +1,276 @@
+#include <Profiling.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+namespace cl
+{
+	namespace profiling
+	{
+		namespace
+		{
+#ifdef USE_PROFILING
+			constexpr bool compiled = true;
+#else
+			constexpr bool compiled = false;
+#endif
+
+			bool IsEnabledFromEnvironment() noexcept
+			{
+				const char* value = std::getenv("CL_PROFILING");	// NOLINT(concurrency-mt-unsafe): read once at static initialization
+				return compiled && value != nullptr && *value != '\0' && *value != '0';
+			}
+
+			std::atomic<bool> enabled { IsEnabledFromEnvironment() };
+			std::atomic<size_t> maxTraceEvents { size_t(1) << 20 };
+
+			long long Now() noexcept
+			{
+				using namespace std::chrono;
+				return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+			}
+
+			// routine names are literals, so they're compared by address: Snapshot merges entries with equal names
+			using Key = std::tuple<const char*, MemorySpace, MathDomain>;
+
+			struct Event
+			{
+				const char* routine;
+				MemorySpace memorySpace;
+				MathDomain mathDomain;
+				long long start;
+				long long duration;
+			};
+
+			struct ThreadRecorder
+			{
+				ThreadRecorder();
+				~ThreadRecorder();
+
+				ThreadRecorder(const ThreadRecorder&) = delete;
+				ThreadRecorder(ThreadRecorder&&) = delete;
+				ThreadRecorder& operator=(const ThreadRecorder&) = delete;
+				ThreadRecorder& operator=(ThreadRecorder&&) = delete;
+
+				// only contended by Snapshot/Reset/WriteChromeTrace
+				std::mutex mutex {};
+				std::map<Key, Counters> counters {};
+				std::vector<Event> events {};
+				size_t threadId = std::hash<std::thread::id>()(std::this_thread::get_id());
+			};
+
+			struct Registry
+			{
+				std::mutex mutex {};
+				std::vector<ThreadRecorder*> recorders {};
+
+				// data of the threads that already exited
+				std::map<Key, Counters> retiredCounters {};
+				std::vector<std::pair<size_t, Event>> retiredEvents {};
+			};
+
+			Registry& GetRegistry()
+			{
+				static Registry registry;
+				return registry;
+			}
+
+			void Accumulate(Counters& out, const Counters& in) noexcept
+			{
+				out.calls += in.calls;
+				out.seconds += in.seconds;
+				out.flops += in.flops;
+				out.bytes += in.bytes;
+			}
+
+			ThreadRecorder::ThreadRecorder()
+			{
+				auto& registry = GetRegistry();
+				std::lock_guard<std::mutex> lock(registry.mutex);
+				registry.recorders.push_back(this);
+			}
+
+			ThreadRecorder::~ThreadRecorder()
+			{
+				auto& registry = GetRegistry();
+				std::lock_guard<std::mutex> registryLock(registry.mutex);
+				registry.recorders.erase(std::remove(registry.recorders.begin(), registry.recorders.end(), this), registry.recorders.end());
+
+				std::lock_guard<std::mutex> lock(mutex);
+				for (const auto& iter : counters)
+					Accumulate(registry.retiredCounters[iter.first], iter.second);
+				for (const auto& event : events)
+					registry.retiredEvents.emplace_back(threadId, event);
+			}
+
+			ThreadRecorder& GetThreadRecorder()
+			{
+				thread_local ThreadRecorder recorder;
+				return recorder;
+			}
+
+			const char* ToString(const MemorySpace memorySpace) noexcept
+			{
+				switch (memorySpace)
+				{
+					case MemorySpace::Host:
+						return "Host";
+					case MemorySpace::Device:
+						return "Device";
+					case MemorySpace::Test:
+						return "Test";
+					case MemorySpace::Mkl:
+						return "Mkl";
+					case MemorySpace::OpenBlas:
+						return "OpenBlas";
+					case MemorySpace::GenericBlas:
+						return "GenericBlas";
+					default:
+						return "Null";
+				}
+			}
+
+			const char* ToString(const MathDomain mathDomain) noexcept
+			{
+				switch (mathDomain)
+				{
+					case MathDomain::Int:
+						return "Int";
+					case MathDomain::Float:
+						return "Float";
+					case MathDomain::Double:
+						return "Double";
+					default:
+						return "Null";
+				}
+			}
+
+			void WriteEvent(std::ostream& stream, const Event& event, const size_t threadId, const long long origin, bool& first)
+			{
+				if (!first)
+					stream << ",\n";
+				first = false;
+
+				// timestamps are in microseconds
+				stream << R"({"name":")" << event.routine << R"(","cat":")" << ToString(event.memorySpace) << R"(","ph":"X","pid":0,"tid":)" << threadId;
+				stream << R"(,"ts":)" << 1e-3 * static_cast<double>(event.start - origin) << R"(,"dur":)" << 1e-3 * static_cast<double>(event.duration);
+				stream << R"(,"args":{"mathDomain":")" << ToString(event.mathDomain) << R"("}})";
+			}
+		}	 // namespace
+
+		bool IsCompiled() noexcept { return compiled; }
+
+		bool IsEnabled() noexcept { return enabled.load(std::memory_order_relaxed); }
+
+		void SetEnabled(const bool enabled_) noexcept { enabled.store(compiled && enabled_, std::memory_order_relaxed); }
+
+		void SetMaxTraceEvents(const size_t maxEvents) { maxTraceEvents.store(maxEvents); }
+
+		std::vector<Entry> Snapshot()
+		{
+			auto& registry = GetRegistry();
+			std::lock_guard<std::mutex> registryLock(registry.mutex);
+
+			std::map<std::tuple<std::string, MemorySpace, MathDomain>, Counters> merged;
+			auto merge = [&merged](const std::map<Key, Counters>& counters) {
+				for (const auto& iter : counters)
+					Accumulate(merged[std::make_tuple(std::string(std::get<0>(iter.first)), std::get<1>(iter.first), std::get<2>(iter.first))], iter.second);
+			};
+
+			merge(registry.retiredCounters);
+			for (auto* recorder : registry.recorders)
+			{
+				std::lock_guard<std::mutex> lock(recorder->mutex);
+				merge(recorder->counters);
+			}
+
+			std::vector<Entry> ret;
+			ret.reserve(merged.size());
+			for (const auto& iter : merged)
+				ret.push_back({ std::get<0>(iter.first), std::get<1>(iter.first), std::get<2>(iter.first), iter.second });
+
+			return ret;
+		}
+
+		void Reset()
+		{
+			auto& registry = GetRegistry();
+			std::lock_guard<std::mutex> registryLock(registry.mutex);
+
+			registry.retiredCounters.clear();
+			registry.retiredEvents.clear();
+			for (auto* recorder : registry.recorders)
+			{
+				std::lock_guard<std::mutex> lock(recorder->mutex);
+				recorder->counters.clear();
+				recorder->events.clear();
+			}
+		}
+
+		void WriteChromeTrace(std::ostream& stream)
+		{
+			auto& registry = GetRegistry();
+			std::lock_guard<std::mutex> registryLock(registry.mutex);
+
+			std::vector<std::pair<size_t, Event>> events = registry.retiredEvents;
+			for (auto* recorder : registry.recorders)
+			{
+				std::lock_guard<std::mutex> lock(recorder->mutex);
+				for (const auto& event : recorder->events)
+					events.emplace_back(recorder->threadId, event);
+			}
+
+			long long origin = 0;
+			if (!events.empty())
+				origin = std::min_element(events.begin(), events.end(), [](const auto& lhs, const auto& rhs) { return lhs.second.start < rhs.second.start; })->second.start;
+
+			stream << "{\"traceEvents\":[\n";
+			bool first = true;
+			for (const auto& iter : events)
+				WriteEvent(stream, iter.second, iter.first, origin, first);
+			stream << "\n],\"displayTimeUnit\":\"ns\"}\n";
+		}
+
+		void WriteChromeTrace(const std::string& fileName)
+		{
+			std::ofstream stream(fileName);
+			WriteChromeTrace(stream);
+		}
+
+		ScopedTimer::ScopedTimer(const char* routine, const MemorySpace memorySpace, const MathDomain mathDomain, const double flops, const double bytes) noexcept
+			: _routine(routine), _memorySpace(memorySpace), _mathDomain(mathDomain), _flops(flops), _bytes(bytes)
+		{
+			if (IsEnabled())
+				_start = Now();
+		}
+
+		ScopedTimer::~ScopedTimer()
+		{
+			if (_start < 0)
+				return;
+
+			const long long duration = Now() - _start;
+
+			auto& recorder = GetThreadRecorder();
+			std::lock_guard<std::mutex> lock(recorder.mutex);
+
+			auto& counters = recorder.counters[Key(_routine, _memorySpace, _mathDomain)];
+			++counters.calls;
+			counters.seconds += 1e-9 * static_cast<double>(duration);
+			counters.flops += _flops;
+			counters.bytes += _bytes;
+
+			if (recorder.events.size() < maxTraceEvents.load(std::memory_order_relaxed))
+				recorder.events.push_back({ _routine, _memorySpace, _mathDomain, _start, duration });
+		}
+	}	 // namespace profiling
+}	 // namespace cl
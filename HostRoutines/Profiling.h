@@ -0,0 +1,92 @@
+#pragma once
+
+#include <Types.h>
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace cl
+{
+	/**
+	 * Per-routine call count, wall time, estimated flops and bytes moved, keyed by routine, memory space and math domain.
+	 * The hooks are compiled in with USE_PROFILING: without it CL_PROFILE expands to nothing and the routines are not touched.
+	 * When compiled in, recording starts disabled unless the CL_PROFILING environment variable is set to a non-zero value,
+	 * and it can be toggled at runtime with SetEnabled: while disabled each hook costs a relaxed atomic load.
+	 *
+	 * Routines that forward to another one (e.g. Subtract, Multiply) are recorded under the routine doing the work.
+	 */
+	namespace profiling
+	{
+		struct Counters
+		{
+			size_t calls = 0;
+			double seconds = 0.0;
+			double flops = 0.0;	   // estimated from the operand sizes, not measured
+			double bytes = 0.0;	   // minimum traffic: every operand read/written once
+
+			double GigaFlopsPerSecond() const noexcept { return seconds <= 0.0 ? 0.0 : 1e-9 * flops / seconds; }
+			double GigaBytesPerSecond() const noexcept { return seconds <= 0.0 ? 0.0 : 1e-9 * bytes / seconds; }
+		};
+
+		struct Entry
+		{
+			std::string routine;
+			MemorySpace memorySpace;
+			MathDomain mathDomain;
+			Counters counters;
+		};
+
+		extern bool IsCompiled() noexcept;
+		extern bool IsEnabled() noexcept;
+		extern void SetEnabled(const bool enabled) noexcept;
+
+		/**
+		 * Maximum number of calls kept for the trace, per thread: when reached, older calls are still counted but not traced
+		 */
+		extern void SetMaxTraceEvents(const size_t maxEvents);
+
+		/**
+		 * Aggregated counters from all the threads, sorted by routine, memory space and math domain
+		 */
+		extern std::vector<Entry> Snapshot();
+		extern void Reset();
+
+		/**
+		 * Writes the recorded calls in Chrome trace event format (chrome://tracing, Perfetto)
+		 */
+		extern void WriteChromeTrace(std::ostream& stream);
+		extern void WriteChromeTrace(const std::string& fileName);
+
+		/**
+		 * Records the enclosing scope: routine must be a string literal (or have static storage duration)
+		 */
+		class ScopedTimer
+		{
+		public:
+			ScopedTimer(const char* routine, const MemorySpace memorySpace, const MathDomain mathDomain, const double flops, const double bytes) noexcept;
+			~ScopedTimer();
+
+			ScopedTimer(const ScopedTimer&) = delete;
+			ScopedTimer(ScopedTimer&&) = delete;
+			ScopedTimer& operator=(const ScopedTimer&) = delete;
+			ScopedTimer& operator=(ScopedTimer&&) = delete;
+
+		private:
+			const char* _routine;
+			MemorySpace _memorySpace;
+			MathDomain _mathDomain;
+			double _flops;
+			double _bytes;
+			long long _start = -1;	  // nanoseconds, -1 if recording was disabled at construction
+		};
+	}	 // namespace profiling
+}	 // namespace cl
+
+#ifdef USE_PROFILING
+	#define CL_PROFILE(buffer, flops, bytes) \
+		const ::cl::profiling::ScopedTimer clProfilingTimer { __func__, (buffer).memorySpace, (buffer).mathDomain, static_cast<double>(flops), static_cast<double>(bytes) }
+#else
+	#define CL_PROFILE(buffer, flops, bytes)
+#endif
@@ -0,0 +1,807 @@
+#include <Reductions.h>
+
+#include <Parallel.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+	// kernels are compiled for every instruction set, and picked at runtime: no need for -mavx2/-mavx512f
+	#define CL_X86_DISPATCH
+	#define CL_TARGET_AVX2 __attribute__((target("avx2")))
+	#define CL_TARGET_AVX512 __attribute__((target("avx512f")))
+	#include <immintrin.h>
+#endif
+
+namespace cl
+{
+	namespace routines
+	{
+		namespace reductions
+		{
+			namespace
+			{
+				// below this number of elements per thread, spawning threads costs more than it saves
+				constexpr size_t minElementsPerThread = { 1 << 18 };
+
+				std::atomic<bool> deterministic { false };
+
+				enum class InstructionSet
+				{
+					Scalar,
+					Avx2,
+					Avx512
+				};
+
+				InstructionSet DetectInstructionSet() noexcept
+				{
+#ifdef CL_X86_DISPATCH
+					__builtin_cpu_init();
+					if (__builtin_cpu_supports("avx512f"))
+						return InstructionSet::Avx512;
+					if (__builtin_cpu_supports("avx2"))
+						return InstructionSet::Avx2;
+#endif
+					return InstructionSet::Scalar;
+				}
+
+				InstructionSet GetInstructionSetType() noexcept
+				{
+					static const InstructionSet instructionSet = DetectInstructionSet();
+					return instructionSet;
+				}
+
+				// floating point sums are accumulated in double precision, integer ones in 64 bits
+				template<typename T>
+				struct Accumulator
+				{
+					using type = double;
+				};
+
+				template<>
+				struct Accumulator<int>
+				{
+					using type = int64_t;
+				};
+
+				template<typename T>
+				inline T Abs(const T x) noexcept
+				{
+					return x < T(0) ? -x : x;
+				}
+
+				template<bool minimum, typename T>
+				inline T Pick(const T lhs, const T rhs) noexcept
+				{
+					return minimum ? std::min(lhs, rhs) : std::max(lhs, rhs);
+				}
+
+#pragma region Scalar
+
+				template<typename T>
+				typename Accumulator<T>::type SumScalar(const T* x, const size_t size) noexcept
+				{
+					using acc = typename Accumulator<T>::type;
+
+					// independent accumulators break the dependency chain
+					acc s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+					size_t i = 0;
+					for (; i + 4 <= size; i += 4)
+					{
+						s0 += x[i];
+						s1 += x[i + 1];
+						s2 += x[i + 2];
+						s3 += x[i + 3];
+					}
+					for (; i < size; ++i)
+						s0 += x[i];
+
+					return (s0 + s1) + (s2 + s3);
+				}
+
+				template<typename T>
+				typename Accumulator<T>::type SumOfSquaresScalar(const T* x, const size_t size) noexcept
+				{
+					using acc = typename Accumulator<T>::type;
+
+					acc s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+					size_t i = 0;
+					for (; i + 4 <= size; i += 4)
+					{
+						s0 += static_cast<acc>(x[i]) * x[i];
+						s1 += static_cast<acc>(x[i + 1]) * x[i + 1];
+						s2 += static_cast<acc>(x[i + 2]) * x[i + 2];
+						s3 += static_cast<acc>(x[i + 3]) * x[i + 3];
+					}
+					for (; i < size; ++i)
+						s0 += static_cast<acc>(x[i]) * x[i];
+
+					return (s0 + s1) + (s2 + s3);
+				}
+
+				template<bool absolute, bool minimum, typename T>
+				T ExtremumScalar(const T* x, const size_t size) noexcept
+				{
+					T ret = absolute ? Abs(x[0]) : x[0];
+					for (size_t i = 1; i < size; ++i)
+						ret = Pick<minimum>(ret, absolute ? Abs(x[i]) : x[i]);
+
+					return ret;
+				}
+
+#pragma endregion
+
+#ifdef CL_X86_DISPATCH
+
+#pragma region Avx2
+
+				CL_TARGET_AVX2 double HorizontalSum(const __m256d x) noexcept
+				{
+					alignas(32) double lanes[4];
+					_mm256_store_pd(lanes, x);
+
+					return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+				}
+
+				CL_TARGET_AVX2 double SumAvx2(const float* x, const size_t size) noexcept
+				{
+					__m256d acc0 = _mm256_setzero_pd();
+					__m256d acc1 = _mm256_setzero_pd();
+					__m256d acc2 = _mm256_setzero_pd();
+					__m256d acc3 = _mm256_setzero_pd();
+
+					size_t i = 0;
+					for (; i + 16 <= size; i += 16)
+					{
+						const __m256 v0 = _mm256_loadu_ps(x + i);
+						const __m256 v1 = _mm256_loadu_ps(x + i + 8);
+						acc0 = _mm256_add_pd(acc0, _mm256_cvtps_pd(_mm256_castps256_ps128(v0)));
+						acc1 = _mm256_add_pd(acc1, _mm256_cvtps_pd(_mm256_extractf128_ps(v0, 1)));
+						acc2 = _mm256_add_pd(acc2, _mm256_cvtps_pd(_mm256_castps256_ps128(v1)));
+						acc3 = _mm256_add_pd(acc3, _mm256_cvtps_pd(_mm256_extractf128_ps(v1, 1)));
+					}
+
+					const double ret = HorizontalSum(_mm256_add_pd(_mm256_add_pd(acc0, acc1), _mm256_add_pd(acc2, acc3)));
+					return ret + SumScalar(x + i, size - i);
+				}
+
+				CL_TARGET_AVX2 double SumAvx2(const double* x, const size_t size) noexcept
+				{
+					__m256d acc0 = _mm256_setzero_pd();
+					__m256d acc1 = _mm256_setzero_pd();
+					__m256d acc2 = _mm256_setzero_pd();
+					__m256d acc3 = _mm256_setzero_pd();
+
+					size_t i = 0;
+					for (; i + 16 <= size; i += 16)
+					{
+						acc0 = _mm256_add_pd(acc0, _mm256_loadu_pd(x + i));
+						acc1 = _mm256_add_pd(acc1, _mm256_loadu_pd(x + i + 4));
+						acc2 = _mm256_add_pd(acc2, _mm256_loadu_pd(x + i + 8));
+						acc3 = _mm256_add_pd(acc3, _mm256_loadu_pd(x + i + 12));
+					}
+
+					const double ret = HorizontalSum(_mm256_add_pd(_mm256_add_pd(acc0, acc1), _mm256_add_pd(acc2, acc3)));
+					return ret + SumScalar(x + i, size - i);
+				}
+
+				template<bool absolute, bool minimum>
+				CL_TARGET_AVX2 float ExtremumAvx2(const float* x, const size_t size) noexcept
+				{
+					if (size < 16)
+						return ExtremumScalar<absolute, minimum>(x, size);
+
+					const __m256 signMask = _mm256_set1_ps(-0.0f);
+					__m256 acc0 = _mm256_loadu_ps(x);
+					__m256 acc1 = _mm256_loadu_ps(x + 8);
+					if (absolute)
+					{
+						acc0 = _mm256_andnot_ps(signMask, acc0);
+						acc1 = _mm256_andnot_ps(signMask, acc1);
+					}
+
+					size_t i = 16;
+					for (; i + 16 <= size; i += 16)
+					{
+						__m256 v0 = _mm256_loadu_ps(x + i);
+						__m256 v1 = _mm256_loadu_ps(x + i + 8);
+						if (absolute)
+						{
+							v0 = _mm256_andnot_ps(signMask, v0);
+							v1 = _mm256_andnot_ps(signMask, v1);
+						}
+						acc0 = minimum ? _mm256_min_ps(acc0, v0) : _mm256_max_ps(acc0, v0);
+						acc1 = minimum ? _mm256_min_ps(acc1, v1) : _mm256_max_ps(acc1, v1);
+					}
+
+					alignas(32) float lanes[8];
+					_mm256_store_ps(lanes, minimum ? _mm256_min_ps(acc0, acc1) : _mm256_max_ps(acc0, acc1));
+					const float ret = ExtremumScalar<false, minimum>(lanes, 8);
+					if (i == size)
+						return ret;
+
+					return Pick<minimum>(ret, ExtremumScalar<absolute, minimum>(x + i, size - i));
+				}
+
+				template<bool absolute, bool minimum>
+				CL_TARGET_AVX2 double ExtremumAvx2(const double* x, const size_t size) noexcept
+				{
+					if (size < 8)
+						return ExtremumScalar<absolute, minimum>(x, size);
+
+					const __m256d signMask = _mm256_set1_pd(-0.0);
+					__m256d acc0 = _mm256_loadu_pd(x);
+					__m256d acc1 = _mm256_loadu_pd(x + 4);
+					if (absolute)
+					{
+						acc0 = _mm256_andnot_pd(signMask, acc0);
+						acc1 = _mm256_andnot_pd(signMask, acc1);
+					}
+
+					size_t i = 8;
+					for (; i + 8 <= size; i += 8)
+					{
+						__m256d v0 = _mm256_loadu_pd(x + i);
+						__m256d v1 = _mm256_loadu_pd(x + i + 4);
+						if (absolute)
+						{
+							v0 = _mm256_andnot_pd(signMask, v0);
+							v1 = _mm256_andnot_pd(signMask, v1);
+						}
+						acc0 = minimum ? _mm256_min_pd(acc0, v0) : _mm256_max_pd(acc0, v0);
+						acc1 = minimum ? _mm256_min_pd(acc1, v1) : _mm256_max_pd(acc1, v1);
+					}
+
+					alignas(32) double lanes[4];
+					_mm256_store_pd(lanes, minimum ? _mm256_min_pd(acc0, acc1) : _mm256_max_pd(acc0, acc1));
+					const double ret = ExtremumScalar<false, minimum>(lanes, 4);
+					if (i == size)
+						return ret;
+
+					return Pick<minimum>(ret, ExtremumScalar<absolute, minimum>(x + i, size - i));
+				}
+
+#pragma endregion
+
+#pragma region Avx512
+
+				/**
+				 * GCC 12 implements the unmasked min/max/cvtps_pd/extract intrinsics (hence _mm512_reduce_* and _mm512_castpd512_pd256 as well) by passing
+				 * _mm*_undefined_* as the merge source, and warns about an uninitialized '__Y' once they're inlined. The zero-masked versions with an all-ones
+				 * mask compile to the same instructions without the warning.
+				 */
+				template<bool minimum>
+				CL_TARGET_AVX512 __m512 PickAvx512(const __m512 lhs, const __m512 rhs) noexcept
+				{
+					return minimum ? _mm512_maskz_min_ps(0xFFFF, lhs, rhs) : _mm512_maskz_max_ps(0xFFFF, lhs, rhs);
+				}
+
+				template<bool minimum>
+				CL_TARGET_AVX512 __m512d PickAvx512(const __m512d lhs, const __m512d rhs) noexcept
+				{
+					return minimum ? _mm512_maskz_min_pd(0xFF, lhs, rhs) : _mm512_maskz_max_pd(0xFF, lhs, rhs);
+				}
+
+				CL_TARGET_AVX512 __m512d ToDouble(const __m256 x) noexcept { return _mm512_maskz_cvtps_pd(0xFF, x); }
+
+				/** Lower and upper 256-bit halves, reduced with AVX2 */
+				CL_TARGET_AVX512 __m256d LowerHalf(const __m512d x) noexcept { return _mm512_maskz_extractf64x4_pd(0xFF, x, 0); }
+				CL_TARGET_AVX512 __m256d UpperHalf(const __m512d x) noexcept { return _mm512_maskz_extractf64x4_pd(0xFF, x, 1); }
+				CL_TARGET_AVX512 __m256 LowerHalf(const __m512 x) noexcept { return _mm256_castpd_ps(LowerHalf(_mm512_castps_pd(x))); }
+				CL_TARGET_AVX512 __m256 UpperHalf(const __m512 x) noexcept { return _mm256_castpd_ps(UpperHalf(_mm512_castps_pd(x))); }
+
+				CL_TARGET_AVX512 double HorizontalSum(const __m512d x) noexcept { return HorizontalSum(_mm256_add_pd(LowerHalf(x), UpperHalf(x))); }
+
+				template<bool minimum>
+				CL_TARGET_AVX512 float HorizontalExtremum(const __m512 x) noexcept
+				{
+					alignas(32) float lanes[8];
+					_mm256_store_ps(lanes, minimum ? _mm256_min_ps(LowerHalf(x), UpperHalf(x)) : _mm256_max_ps(LowerHalf(x), UpperHalf(x)));
+					return ExtremumScalar<false, minimum>(lanes, 8);
+				}
+
+				template<bool minimum>
+				CL_TARGET_AVX512 double HorizontalExtremum(const __m512d x) noexcept
+				{
+					alignas(32) double lanes[4];
+					_mm256_store_pd(lanes, minimum ? _mm256_min_pd(LowerHalf(x), UpperHalf(x)) : _mm256_max_pd(LowerHalf(x), UpperHalf(x)));
+					return ExtremumScalar<false, minimum>(lanes, 4);
+				}
+
+				CL_TARGET_AVX512 double SumAvx512(const float* x, const size_t size) noexcept
+				{
+					__m512d acc0 = _mm512_setzero_pd();
+					__m512d acc1 = _mm512_setzero_pd();
+					__m512d acc2 = _mm512_setzero_pd();
+					__m512d acc3 = _mm512_setzero_pd();
+
+					size_t i = 0;
+					for (; i + 32 <= size; i += 32)
+					{
+						acc0 = _mm512_add_pd(acc0, ToDouble(_mm256_loadu_ps(x + i)));
+						acc1 = _mm512_add_pd(acc1, ToDouble(_mm256_loadu_ps(x + i + 8)));
+						acc2 = _mm512_add_pd(acc2, ToDouble(_mm256_loadu_ps(x + i + 16)));
+						acc3 = _mm512_add_pd(acc3, ToDouble(_mm256_loadu_ps(x + i + 24)));
+					}
+
+					const double ret = HorizontalSum(_mm512_add_pd(_mm512_add_pd(acc0, acc1), _mm512_add_pd(acc2, acc3)));
+					return ret + SumScalar(x + i, size - i);
+				}
+
+				CL_TARGET_AVX512 double SumAvx512(const double* x, const size_t size) noexcept
+				{
+					__m512d acc0 = _mm512_setzero_pd();
+					__m512d acc1 = _mm512_setzero_pd();
+					__m512d acc2 = _mm512_setzero_pd();
+					__m512d acc3 = _mm512_setzero_pd();
+
+					size_t i = 0;
+					for (; i + 32 <= size; i += 32)
+					{
+						acc0 = _mm512_add_pd(acc0, _mm512_loadu_pd(x + i));
+						acc1 = _mm512_add_pd(acc1, _mm512_loadu_pd(x + i + 8));
+						acc2 = _mm512_add_pd(acc2, _mm512_loadu_pd(x + i + 16));
+						acc3 = _mm512_add_pd(acc3, _mm512_loadu_pd(x + i + 24));
+					}
+
+					const double ret = HorizontalSum(_mm512_add_pd(_mm512_add_pd(acc0, acc1), _mm512_add_pd(acc2, acc3)));
+					return ret + SumScalar(x + i, size - i);
+				}
+
+				template<bool absolute, bool minimum>
+				CL_TARGET_AVX512 float ExtremumAvx512(const float* x, const size_t size) noexcept
+				{
+					if (size < 32)
+						return ExtremumScalar<absolute, minimum>(x, size);
+
+					__m512 acc0 = _mm512_loadu_ps(x);
+					__m512 acc1 = _mm512_loadu_ps(x + 16);
+					if (absolute)
+					{
+						acc0 = _mm512_abs_ps(acc0);
+						acc1 = _mm512_abs_ps(acc1);
+					}
+
+					size_t i = 32;
+					for (; i + 32 <= size; i += 32)
+					{
+						__m512 v0 = _mm512_loadu_ps(x + i);
+						__m512 v1 = _mm512_loadu_ps(x + i + 16);
+						if (absolute)
+						{
+							v0 = _mm512_abs_ps(v0);
+							v1 = _mm512_abs_ps(v1);
+						}
+						acc0 = PickAvx512<minimum>(acc0, v0);
+						acc1 = PickAvx512<minimum>(acc1, v1);
+					}
+
+					const float ret = HorizontalExtremum<minimum>(PickAvx512<minimum>(acc0, acc1));
+					if (i == size)
+						return ret;
+
+					return Pick<minimum>(ret, ExtremumScalar<absolute, minimum>(x + i, size - i));
+				}
+
+				template<bool absolute, bool minimum>
+				CL_TARGET_AVX512 double ExtremumAvx512(const double* x, const size_t size) noexcept
+				{
+					if (size < 16)
+						return ExtremumScalar<absolute, minimum>(x, size);
+
+					__m512d acc0 = _mm512_loadu_pd(x);
+					__m512d acc1 = _mm512_loadu_pd(x + 8);
+					if (absolute)
+					{
+						acc0 = _mm512_abs_pd(acc0);
+						acc1 = _mm512_abs_pd(acc1);
+					}
+
+					size_t i = 16;
+					for (; i + 16 <= size; i += 16)
+					{
+						__m512d v0 = _mm512_loadu_pd(x + i);
+						__m512d v1 = _mm512_loadu_pd(x + i + 8);
+						if (absolute)
+						{
+							v0 = _mm512_abs_pd(v0);
+							v1 = _mm512_abs_pd(v1);
+						}
+						acc0 = PickAvx512<minimum>(acc0, v0);
+						acc1 = PickAvx512<minimum>(acc1, v1);
+					}
+
+					const double ret = HorizontalExtremum<minimum>(PickAvx512<minimum>(acc0, acc1));
+					if (i == size)
+						return ret;
+
+					return Pick<minimum>(ret, ExtremumScalar<absolute, minimum>(x + i, size - i));
+				}
+
+#pragma endregion
+
+#endif
+
+#pragma region Dispatch
+
+				template<typename T>
+				typename Accumulator<T>::type SumKernel(const T* x, const size_t size) noexcept
+				{
+					switch (GetInstructionSetType())
+					{
+#ifdef CL_X86_DISPATCH
+						case InstructionSet::Avx512:
+							return SumAvx512(x, size);
+						case InstructionSet::Avx2:
+							return SumAvx2(x, size);
+#endif
+						default:
+							return SumScalar(x, size);
+					}
+				}
+
+				// integers are left to the compiler's auto-vectorization
+				template<>
+				int64_t SumKernel<int>(const int* x, const size_t size) noexcept
+				{
+					return SumScalar(x, size);
+				}
+
+				template<bool absolute, bool minimum, typename T>
+				T ExtremumKernel(const T* x, const size_t size) noexcept
+				{
+					switch (GetInstructionSetType())
+					{
+#ifdef CL_X86_DISPATCH
+						case InstructionSet::Avx512:
+							return ExtremumAvx512<absolute, minimum>(x, size);
+						case InstructionSet::Avx2:
+							return ExtremumAvx2<absolute, minimum>(x, size);
+#endif
+						default:
+							return ExtremumScalar<absolute, minimum>(x, size);
+					}
+				}
+
+				template<bool absolute, bool minimum>
+				int ExtremumKernel(const int* x, const size_t size) noexcept
+				{
+					return ExtremumScalar<absolute, minimum>(x, size);
+				}
+
+#pragma endregion
+
+				/**
+				 * Splits [0, size) in chunks, reduces each of them with kernel(begin, end), and combines the partial results in order.
+				 * Chunks are as big as possible, unless the result depends on the order of the operations and the deterministic mode is enabled:
+				 * in that case chunks have a fixed size, so that the result doesn't depend on the number of threads.
+				 */
+				template<typename Result, typename Kernel, typename Combine>
+				Result Reduce(const size_t size, const bool orderSensitive, const Kernel& kernel, const Combine& combine)
+				{
+					if (size == 0)
+						return Result(0);
+
+					const size_t nThreads = detail::GetNumberOfPartitions(size, minElementsPerThread);
+					const size_t chunkSize = orderSensitive && deterministic ? deterministicChunkSize : (size + nThreads - 1) / nThreads;
+					const size_t nChunks = (size + chunkSize - 1) / chunkSize;
+					if (nChunks == 1)
+						return kernel(0, size);
+
+					std::vector<Result> partials(nChunks);
+					const size_t nPartitions = std::min(nThreads, nChunks);
+					detail::ParallelFor(nPartitions, [&](const size_t p) {
+						for (size_t c = p; c < nChunks; c += nPartitions)
+							partials[c] = kernel(c * chunkSize, std::min(size, (c + 1) * chunkSize));
+					});
+
+					Result ret = partials[0];
+					for (size_t c = 1; c < nChunks; ++c)
+						ret = combine(ret, partials[c]);
+
+					return ret;
+				}
+
+				template<bool absolute, bool minimum, typename T>
+				double Extremum(const T* x, const size_t size)
+				{
+					const T ret = Reduce<T>(
+						size, false, [x](const size_t begin, const size_t end) { return ExtremumKernel<absolute, minimum>(x + begin, end - begin); },
+						[](const T lhs, const T rhs) { return Pick<minimum>(lhs, rhs); });
+
+					return static_cast<double>(ret);
+				}
+
+				// rows reduced together by the row-wise kernels: their accumulators stay in L1 while the columns are streamed through
+				constexpr size_t rowBlockSize = { 512 };
+
+				/**
+				 * Same as Reduce, but on the calling thread: the chunks used in deterministic mode are the same, hence so is the result
+				 */
+				template<typename Result, typename Kernel, typename Combine>
+				Result SerialReduce(const size_t size, const bool orderSensitive, const Kernel& kernel, const Combine& combine)
+				{
+					if (size == 0)
+						return Result(0);
+
+					const size_t chunkSize = orderSensitive && deterministic ? deterministicChunkSize : size;
+					Result ret = kernel(0, std::min(size, chunkSize));
+					for (size_t begin = chunkSize; begin < size; begin += chunkSize)
+						ret = combine(ret, kernel(begin, std::min(size, begin + chunkSize)));
+
+					return ret;
+				}
+
+				/**
+				 * out[j] = finalize(reduction of the j-th column), with kernel(x, size) reducing size contiguous elements.
+				 * Columns are spread across threads, unless they're too few to keep all of them busy: then each column is split in chunks by Reduce.
+				 */
+				template<typename Result, typename T, typename Kernel, typename Combine, typename Finalize>
+				void ColumnWiseReduce(T* out, const T* A, const size_t nRows, const size_t nCols, const size_t leadingDimension, const bool orderSensitive, const Kernel& kernel, const Combine& combine, const Finalize& finalize)
+				{
+					if (nCols >= detail::GetNumberOfPartitions(nRows * nCols, minElementsPerThread))
+					{
+						detail::ParallelFor(nCols, detail::GetSliceGrainSize(nRows), [&](const size_t begin, const size_t end) {
+							for (size_t j = begin; j < end; ++j)
+							{
+								const T* x = A + j * leadingDimension;
+								out[j] = finalize(SerialReduce<Result>(
+									nRows, orderSensitive, [x, &kernel](const size_t rowBegin, const size_t rowEnd) { return kernel(x + rowBegin, rowEnd - rowBegin); }, combine));
+							}
+						});
+						return;
+					}
+
+					for (size_t j = 0; j < nCols; ++j)
+					{
+						const T* x = A + j * leadingDimension;
+						out[j] = finalize(Reduce<Result>(
+							nRows, orderSensitive, [x, &kernel](const size_t rowBegin, const size_t rowEnd) { return kernel(x + rowBegin, rowEnd - rowBegin); }, combine));
+					}
+				}
+
+				/**
+				 * out[i] = finalize(reduction of transform(A(i, j)) over j): blocks of rows are reduced column after column, so that A is read contiguously.
+				 * Row blocks are spread across threads; when they're too few, the columns are split among the threads as well, and the partial results
+				 * combined in order afterwards - unless the result depends on the order of the operations and the deterministic mode is enabled.
+				 */
+				template<typename Result, typename T, typename Transform, typename Combine, typename Finalize>
+				void RowWiseReduce(T* out, const T* A, const size_t nRows, const size_t nCols, const size_t leadingDimension, const bool orderSensitive, const Transform& transform, const Combine& combine, const Finalize& finalize)
+				{
+					if (nRows == 0 || nCols == 0)
+						return;
+
+					const size_t nRowBlocks = (nRows + rowBlockSize - 1) / rowBlockSize;
+					const size_t nThreads = detail::GetNumberOfPartitions(nRows * nCols, minElementsPerThread);
+					const size_t nColChunks = nRowBlocks >= nThreads || (orderSensitive && deterministic) ? 1 : std::min(nCols, nThreads);
+
+					std::vector<Result> partials(nColChunks > 1 ? nColChunks * nRows : 0);
+					detail::ParallelFor(nColChunks * nRowBlocks, detail::GetSliceGrainSize(rowBlockSize * nCols / nColChunks), [&](const size_t begin, const size_t end) {
+						Result acc[rowBlockSize];
+						for (size_t task = begin; task < end; ++task)
+						{
+							const size_t rowBegin = (task % nRowBlocks) * rowBlockSize;
+							const size_t nBlockRows = std::min(rowBlockSize, nRows - rowBegin);
+							const size_t colChunk = task / nRowBlocks;
+							const size_t colBegin = colChunk * nCols / nColChunks;
+							const size_t colEnd = (colChunk + 1) * nCols / nColChunks;
+
+							const T* x = A + rowBegin + colBegin * leadingDimension;
+							for (size_t i = 0; i < nBlockRows; ++i)
+								acc[i] = transform(x[i]);
+							for (size_t j = colBegin + 1; j < colEnd; ++j)
+							{
+								x = A + rowBegin + j * leadingDimension;
+								for (size_t i = 0; i < nBlockRows; ++i)
+									acc[i] = combine(acc[i], transform(x[i]));
+							}
+
+							if (nColChunks == 1)
+							{
+								for (size_t i = 0; i < nBlockRows; ++i)
+									out[rowBegin + i] = finalize(acc[i]);
+							}
+							else
+								std::copy(acc, acc + nBlockRows, partials.begin() + colChunk * nRows + rowBegin);
+						}
+					});
+
+					if (nColChunks == 1)
+						return;
+
+					for (size_t i = 0; i < nRows; ++i)
+					{
+						Result ret = partials[i];
+						for (size_t colChunk = 1; colChunk < nColChunks; ++colChunk)
+							ret = combine(ret, partials[colChunk * nRows + i]);
+						out[i] = finalize(ret);
+					}
+				}
+
+				template<typename Result>
+				inline Result Add(const Result lhs, const Result rhs) noexcept
+				{
+					return lhs + rhs;
+				}
+
+				template<typename Result, typename T>
+				inline T Cast(const Result x) noexcept
+				{
+					return static_cast<T>(x);
+				}
+
+				template<typename Result, typename T>
+				inline T SquareRoot(const Result x) noexcept
+				{
+					return static_cast<T>(std::sqrt(static_cast<double>(x)));
+				}
+			}	 // namespace
+
+			void SetDeterministic(const bool deterministic_) noexcept { deterministic = deterministic_; }
+
+			bool IsDeterministic() noexcept { return deterministic; }
+
+			const char* GetInstructionSet() noexcept
+			{
+				switch (GetInstructionSetType())
+				{
+					case InstructionSet::Avx512:
+						return "AVX-512";
+					case InstructionSet::Avx2:
+						return "AVX2";
+					default:
+						return "Scalar";
+				}
+			}
+
+			template<typename T>
+			double Sum(const T* x, const size_t size)
+			{
+				using acc = typename Accumulator<T>::type;
+
+				const acc ret = Reduce<acc>(
+					size, true, [x](const size_t begin, const size_t end) { return SumKernel(x + begin, end - begin); },
+					[](const acc lhs, const acc rhs) { return lhs + rhs; });
+
+				return static_cast<double>(ret);
+			}
+
+			template<typename T>
+			double Min(const T* x, const size_t size)
+			{
+				return Extremum<false, true>(x, size);
+			}
+
+			template<typename T>
+			double Max(const T* x, const size_t size)
+			{
+				return Extremum<false, false>(x, size);
+			}
+
+			template<typename T>
+			double AbsMin(const T* x, const size_t size)
+			{
+				return Extremum<true, true>(x, size);
+			}
+
+			template<typename T>
+			double AbsMax(const T* x, const size_t size)
+			{
+				return Extremum<true, false>(x, size);
+			}
+
+			template<typename T>
+			void ColumnWiseSum(T* out, const T* A, const size_t nRows, const size_t nCols, const size_t leadingDimension)
+			{
+				using acc = typename Accumulator<T>::type;
+				ColumnWiseReduce<acc>(out, A, nRows, nCols, leadingDimension, true, [](const T* x, const size_t size) { return SumKernel(x, size); }, Add<acc>, Cast<acc, T>);
+			}
+
+			template<typename T>
+			void ColumnWiseMin(T* out, const T* A, const size_t nRows, const size_t nCols, const size_t leadingDimension)
+			{
+				ColumnWiseReduce<T>(out, A, nRows, nCols, leadingDimension, false, [](const T* x, const size_t size) { return ExtremumKernel<false, true>(x, size); }, Pick<true, T>, Cast<T, T>);
+			}
+
+			template<typename T>
+			void ColumnWiseMax(T* out, const T* A, const size_t nRows, const size_t nCols, const size_t leadingDimension)
+			{
+				ColumnWiseReduce<T>(out, A, nRows, nCols, leadingDimension, false, [](const T* x, const size_t size) { return ExtremumKernel<false, false>(x, size); }, Pick<false, T>, Cast<T, T>);
+			}
+
+			template<typename T>
+			void ColumnWiseNorm(T* out, const T* A, const size_t nRows, const size_t nCols, const size_t leadingDimension)
+			{
+				using acc = typename Accumulator<T>::type;
+				ColumnWiseReduce<acc>(out, A, nRows, nCols, leadingDimension, true, SumOfSquaresScalar<T>, Add<acc>, SquareRoot<acc, T>);
+			}
+
+			template<typename T>
+			void RowWiseSum(T* out, const T* A, const size_t nRows, const size_t nCols, const size_t leadingDimension)
+			{
+				using acc = typename Accumulator<T>::type;
+				RowWiseReduce<acc>(out, A, nRows, nCols, leadingDimension, true, Cast<T, acc>, Add<acc>, Cast<acc, T>);
+			}
+
+			template<typename T>
+			void RowWiseMin(T* out, const T* A, const size_t nRows, const size_t nCols, const size_t leadingDimension)
+			{
+				RowWiseReduce<T>(out, A, nRows, nCols, leadingDimension, false, Cast<T, T>, Pick<true, T>, Cast<T, T>);
+			}
+
+			template<typename T>
+			void RowWiseMax(T* out, const T* A, const size_t nRows, const size_t nCols, const size_t leadingDimension)
+			{
+				RowWiseReduce<T>(out, A, nRows, nCols, leadingDimension, false, Cast<T, T>, Pick<false, T>, Cast<T, T>);
+			}
+
+			template<typename T>
+			void RowWiseNorm(T* out, const T* A, const size_t nRows, const size_t nCols, const size_t leadingDimension)
+			{
+				using acc = typename Accumulator<T>::type;
+				RowWiseReduce<acc>(
+					out, A, nRows, nCols, leadingDimension, true, [](const T x) { return static_cast<acc>(x) * x; }, Add<acc>, SquareRoot<acc, T>);
+			}
+
+#pragma region Explicit instantiations
+
+			template double Sum<float>(const float* x, const size_t size);
+			template double Sum<double>(const double* x, const size_t size);
+			template double Sum<int>(const int* x, const size_t size);
+
+			template double Min<float>(const float* x, const size_t size);
+			template double Min<double>(const double* x, const size_t size);
+			template double Min<int>(const int* x, const size_t size);
+
+			template double Max<float>(const float* x, const size_t size);
+			template double Max<double>(const double* x, const size_t size);
+			template double Max<int>(const int* x, const size_t size);
+
+			template double AbsMin<float>(const float* x, const size_t size);
+			template double AbsMin<double>(const double* x, const size_t size);
+			template double AbsMin<int>(const int* x, const size_t size);
+
+			template double AbsMax<float>(const float* x, const size_t size);
+			template double AbsMax<double>(const double* x, const size_t size);
+			template double AbsMax<int>(const int* x, const size_t size);
+
+			template void ColumnWiseSum<float>(float* out, const float* A, const size_t nRows, const size_t nCols, const size_t leadingDimension);
+			template void ColumnWiseSum<double>(double* out, const double* A, const size_t nRows, const size_t nCols, const size_t leadingDimension);
+			template void ColumnWiseSum<int>(int* out, const int* A, const size_t nRows, const size_t nCols, const size_t leadingDimension);
+
+			template void ColumnWiseMin<float>(float* out, const float* A, const size_t nRows, const size_t nCols, const size_t leadingDimension);
+			template void ColumnWiseMin<double>(double* out, const double* A, const size_t nRows, const size_t nCols, const size_t leadingDimension);
+			template void ColumnWiseMin<int>(int* out, const int* A, const size_t nRows, const size_t nCols, const size_t leadingDimension);
+
+			template void ColumnWiseMax<float>(float* out, const float* A, const size_t nRows, const size_t nCols, const size_t leadingDimension);
+			template void ColumnWiseMax<double>(double* out, const double* A, const size_t nRows, const size_t nCols, const size_t leadingDimension);
+			template void ColumnWiseMax<int>(int* out, const int* A, const size_t nRows, const size_t nCols, const size_t leadingDimension);
+
+			template void ColumnWiseNorm<float>(float* out, const float* A, const size_t nRows, const size_t nCols, const size_t leadingDimension);
+			template void ColumnWiseNorm<double>(double* out, const double* A, const size_t nRows, const size_t nCols, const size_t leadingDimension);
+			template void ColumnWiseNorm<int>(int* out, const int* A, const size_t nRows, const size_t nCols, const size_t leadingDimension);
+
+			template void RowWiseSum<float>(float* out, const float* A, const size_t nRows, const size_t nCols, const size_t leadingDimension);
+			template void RowWiseSum<double>(double* out, const double* A, const size_t nRows, const size_t nCols, const size_t leadingDimension);
+			template void RowWiseSum<int>(int* out, const int* A, const size_t nRows, const size_t nCols, const size_t leadingDimension);
+
+			template void RowWiseMin<float>(float* out, const float* A, const size_t nRows, const size_t nCols, const size_t leadingDimension);
+			template void RowWiseMin<double>(double* out, const double* A, const size_t nRows, const size_t nCols, const size_t leadingDimension);
+			template void RowWiseMin<int>(int* out, const int* A, const size_t nRows, const size_t nCols, const size_t leadingDimension);
+
+			template void RowWiseMax<float>(float* out, const float* A, const size_t nRows, const size_t nCols, const size_t leadingDimension);
+			template void RowWiseMax<double>(double* out, const double* A, const size_t nRows, const size_t nCols, const size_t leadingDimension);
+			template void RowWiseMax<int>(int* out, const int* A, const size_t nRows, const size_t nCols, const size_t leadingDimension);
+
+			template void RowWiseNorm<float>(float* out, const float* A, const size_t nRows, const size_t nCols, const size_t leadingDimension);
+			template void RowWiseNorm<double>(double* out, const double* A, const size_t nRows, const size_t nCols, const size_t leadingDimension);
+			template void RowWiseNorm<int>(int* out, const int* A, const size_t nRows, const size_t nCols, const size_t leadingDimension);
+
+#pragma endregion
+		}	 // namespace reductions
+	}		 // namespace routines
+}	 // namespace cl
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstddef>
+
+namespace cl
+{
+	namespace routines
+	{
+		/**
+		 * Vectorized, multithreaded reductions used by the host memory spaces.
+		 * The instruction set (AVX-512, AVX2 or plain C++) is chosen at runtime, according to what the CPU supports.
+		 */
+		namespace reductions
+		{
+			// in deterministic mode sums are computed in chunks of this size, which are then added up in order
+			static constexpr size_t deterministicChunkSize = { 1 << 16 };
+
+			/**
+			 * When enabled, Sum doesn't depend on the number of threads used. Min/Max are always deterministic.
+			 */
+			extern void SetDeterministic(const bool deterministic) noexcept;
+			extern bool IsDeterministic() noexcept;
+
+			// name of the instruction set used by the kernels, for diagnostics
+			extern const char* GetInstructionSet() noexcept;
+
+			template<typename T>
+			double Sum(const T* x, const size_t size);
+
+			template<typename T>
+			double Min(const T* x, const size_t size);
+
+			template<typename T>
+			double Max(const T* x, const size_t size);
+
+			template<typename T>
+			double AbsMin(const T* x, const size_t size);
+
+			template<typename T>
+			double AbsMax(const T* x, const size_t size);
+
+			/**
+			 * Reductions along the axes of the column-major nRows x nCols matrix A, whose columns are leadingDimension elements apart:
+			 * ColumnWise* store the reduction of the j-th column in out[j], RowWise* the one of the i-th row in out[i].
+			 * Norm is the Euclidean norm.
+			 */
+			template<typename T>
+			void ColumnWiseSum(T* out, const T* A, const size_t nRows, const size_t nCols, const size_t leadingDimension);
+
+			template<typename T>
+			void ColumnWiseMin(T* out, const T* A, const size_t nRows, const size_t nCols, const size_t leadingDimension);
+
+			template<typename T>
+			void ColumnWiseMax(T* out, const T* A, const size_t nRows, const size_t nCols, const size_t leadingDimension);
+
+			template<typename T>
+			void ColumnWiseNorm(T* out, const T* A, const size_t nRows, const size_t nCols, const size_t leadingDimension);
+
+			template<typename T>
+			void RowWiseSum(T* out, const T* A, const size_t nRows, const size_t nCols, const size_t leadingDimension);
+
+			template<typename T>
+			void RowWiseMin(T* out, const T* A, const size_t nRows, const size_t nCols, const size_t leadingDimension);
+
+			template<typename T>
+			void RowWiseMax(T* out, const T* A, const size_t nRows, const size_t nCols, const size_t leadingDimension);
+
+			template<typename T>
+			void RowWiseNorm(T* out, const T* A, const size_t nRows, const size_t nCols, const size_t leadingDimension);
+		}	 // namespace reductions
+	}		 // namespace routines
+}	 // namespace cl
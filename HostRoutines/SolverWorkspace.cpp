@@ -0,0 +1,116 @@
+#include <SolverWorkspace.h>
+
+#include <MemoryManager.h>
+
+#include <utility>
+
+namespace cl
+{
+	namespace routines
+	{
+		SolverWorkspace::~SolverWorkspace() { Clear(); }
+
+		SolverWorkspace::SolverWorkspace(SolverWorkspace&& rhs) noexcept
+			: _matrix(rhs._matrix), _rightHandSide(rhs._rightHandSide), _pivot(rhs._pivot), _tau(rhs._tau), _work(rhs._work), _solution(rhs._solution), _residual(rhs._residual)
+		{
+			rhs._matrix.pointer = 0;
+			rhs._rightHandSide.pointer = 0;
+			rhs._pivot.pointer = 0;
+			rhs._tau.pointer = 0;
+			rhs._work.pointer = 0;
+			rhs._solution.pointer = 0;
+			rhs._residual.pointer = 0;
+		}
+
+		SolverWorkspace& SolverWorkspace::operator=(SolverWorkspace&& rhs) noexcept
+		{
+			if (this != &rhs)
+			{
+				Clear();
+				std::swap(_matrix, rhs._matrix);
+				std::swap(_rightHandSide, rhs._rightHandSide);
+				std::swap(_pivot, rhs._pivot);
+				std::swap(_tau, rhs._tau);
+				std::swap(_work, rhs._work);
+				std::swap(_solution, rhs._solution);
+				std::swap(_residual, rhs._residual);
+			}
+
+			return *this;
+		}
+
+		MemoryTile SolverWorkspace::GetMatrix(const MemoryTile& A)
+		{
+			// A might be a sub-matrix view: its copy is contiguous
+			MemoryTile ret(A);
+			ret.pointer = Reserve(_matrix, A.size, A.memorySpace, A.mathDomain).pointer;
+			ret.leadingDimension = A.nRows;
+
+			return ret;
+		}
+
+		MemoryTile SolverWorkspace::GetRightHandSide(const unsigned nRows, const unsigned nCols, const MemorySpace memorySpace, const MathDomain mathDomain) { return ReserveTile(_rightHandSide, nRows, nCols, memorySpace, mathDomain); }
+
+		MemoryTile SolverWorkspace::GetSolution(const unsigned nRows, const unsigned nCols, const MemorySpace memorySpace, const MathDomain mathDomain) { return ReserveTile(_solution, nRows, nCols, memorySpace, mathDomain); }
+
+		MemoryTile SolverWorkspace::GetResidual(const unsigned nRows, const unsigned nCols, const MemorySpace memorySpace, const MathDomain mathDomain) { return ReserveTile(_residual, nRows, nCols, memorySpace, mathDomain); }
+
+		MemoryBuffer SolverWorkspace::GetPivot(const unsigned size, const MemorySpace memorySpace) { return Reserve(_pivot, size, memorySpace, MathDomain::Int); }
+
+		MemoryBuffer SolverWorkspace::GetTau(const unsigned size, const MemorySpace memorySpace, const MathDomain mathDomain) { return Reserve(_tau, size, memorySpace, mathDomain); }
+
+		MemoryBuffer SolverWorkspace::GetWork(const unsigned size, const MemorySpace memorySpace, const MathDomain mathDomain) { return Reserve(_work, size, memorySpace, mathDomain); }
+
+		void SolverWorkspace::Clear()
+		{
+			for (auto* storage : { &_matrix, &_rightHandSide, &_pivot, &_tau, &_work, &_solution, &_residual })
+			{
+				if (storage->pointer != 0)
+					Free(*storage);
+				*storage = MemoryBuffer();
+			}
+		}
+
+		size_t SolverWorkspace::GetAllocatedBytes() const noexcept
+		{
+			size_t ret = 0;
+			for (const auto* storage : { &_matrix, &_rightHandSide, &_pivot, &_tau, &_work, &_solution, &_residual })
+			{
+				if (storage->pointer != 0)
+					ret += storage->TotalSize();
+			}
+
+			return ret;
+		}
+
+		SolverWorkspace& SolverWorkspace::Default()
+		{
+			thread_local SolverWorkspace workspace;
+			return workspace;
+		}
+
+		MemoryTile SolverWorkspace::ReserveTile(MemoryBuffer& storage, const unsigned nRows, const unsigned nCols, const MemorySpace memorySpace, const MathDomain mathDomain)
+		{
+			MemoryTile ret(0, nRows, nCols, memorySpace, mathDomain);
+			ret.pointer = Reserve(storage, ret.size, memorySpace, mathDomain).pointer;
+
+			return ret;
+		}
+
+		MemoryBuffer SolverWorkspace::Reserve(MemoryBuffer& storage, const unsigned size, const MemorySpace memorySpace, const MathDomain mathDomain)
+		{
+			MemoryBuffer ret(0, size, memorySpace, mathDomain);
+			if (storage.pointer == 0 || storage.memorySpace != memorySpace || storage.TotalSize() < ret.TotalSize())
+			{
+				if (storage.pointer != 0)
+					Free(storage);
+
+				storage = ret;
+				Alloc(storage);
+			}
+
+			ret.pointer = storage.pointer;
+			return ret;
+		}
+	}	 // namespace routines
+}	 // namespace cl
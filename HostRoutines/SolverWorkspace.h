@@ -0,0 +1,76 @@
+#pragma once
+
+#include <Types.h>
+
+#include <cstddef>
+
+namespace cl
+{
+	namespace routines
+	{
+		/**
+		 * Scratch buffers for the LAPACK temporaries used by Solve/Invert (copy of A, pivots, tau, work buffer, identity for Invert, refinement of MixedPrecisionLu).
+		 * Buffers are kept between calls and only reallocated when a bigger one, or one in a different memory space, is requested:
+		 * repeated solves of the same size don't allocate at all.
+		 *
+		 * The returned buffers are views over the workspace memory: they're valid until the next request of the same kind.
+		 */
+		class SolverWorkspace
+		{
+		public:
+			SolverWorkspace() = default;
+			~SolverWorkspace();
+
+			SolverWorkspace(const SolverWorkspace&) = delete;
+			SolverWorkspace& operator=(const SolverWorkspace&) = delete;
+			SolverWorkspace(SolverWorkspace&& rhs) noexcept;
+			SolverWorkspace& operator=(SolverWorkspace&& rhs) noexcept;
+
+			/**
+			 * Buffer with the same shape of A, used for storing its factorization
+			 */
+			MemoryTile GetMatrix(const MemoryTile& A);
+
+			/**
+			 * nRows x nCols buffer used as right hand side by Invert, and for the single precision corrections of MixedPrecisionLu
+			 */
+			MemoryTile GetRightHandSide(const unsigned nRows, const unsigned nCols, const MemorySpace memorySpace, const MathDomain mathDomain);
+
+			/**
+			 * nRows x nCols buffers for the solution and the residual refined by MixedPrecisionLu
+			 */
+			MemoryTile GetSolution(const unsigned nRows, const unsigned nCols, const MemorySpace memorySpace, const MathDomain mathDomain);
+			MemoryTile GetResidual(const unsigned nRows, const unsigned nCols, const MemorySpace memorySpace, const MathDomain mathDomain);
+
+			MemoryBuffer GetPivot(const unsigned size, const MemorySpace memorySpace);
+
+			MemoryBuffer GetTau(const unsigned size, const MemorySpace memorySpace, const MathDomain mathDomain);
+
+			MemoryBuffer GetWork(const unsigned size, const MemorySpace memorySpace, const MathDomain mathDomain);
+
+			/**
+			 * Frees all the buffers
+			 */
+			void Clear();
+
+			size_t GetAllocatedBytes() const noexcept;
+
+			/**
+			 * Thread-local workspace, used when no workspace is explicitly passed to Solve/Invert
+			 */
+			static SolverWorkspace& Default();
+
+		private:
+			static MemoryTile ReserveTile(MemoryBuffer& storage, const unsigned nRows, const unsigned nCols, const MemorySpace memorySpace, const MathDomain mathDomain);
+			static MemoryBuffer Reserve(MemoryBuffer& storage, const unsigned size, const MemorySpace memorySpace, const MathDomain mathDomain);
+
+			MemoryBuffer _matrix {};
+			MemoryBuffer _rightHandSide {};
+			MemoryBuffer _pivot {};
+			MemoryBuffer _tau {};
+			MemoryBuffer _work {};
+			MemoryBuffer _solution {};
+			MemoryBuffer _residual {};
+		};
+	}	 // namespace routines
+}	 // namespace cl
@@ -0,0 +1,327 @@
+#include <Sorting.h>
+
+#include <Parallel.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace cl
+{
+	namespace routines
+	{
+		namespace sorting
+		{
+			namespace
+			{
+				// below this number of elements per thread, spawning threads costs more than it saves
+				constexpr size_t minElementsPerThread = { 1 << 16 };
+
+				// below this size a comparison sort beats the radix passes
+				constexpr size_t minRadixSortSize = { 1 << 10 };
+
+				// radix sort digits: each pass is a histogram and a scatter over 2^radixBits buckets
+				constexpr unsigned radixBits = { 8 };
+				constexpr size_t nBuckets = { size_t(1) << radixBits };
+
+				// TopK keeps at most this many candidates per thread, besides the k it has selected so far
+				constexpr size_t minTopKCandidates = { 1 << 10 };
+
+				template<typename T>
+				struct RadixKey
+				{
+					using type = uint32_t;
+				};
+
+				template<>
+				struct RadixKey<double>
+				{
+					using type = uint64_t;
+				};
+
+				template<typename T>
+				using Key = typename RadixKey<T>::type;
+
+				/**
+				 * Unsigned integer with the same order of x: flipping all of its bits reverses the order, which gives a stable descending sort
+				 */
+				template<typename T>
+				inline Key<T> ToKey(const T x, const bool ascending) noexcept
+				{
+					using K = Key<T>;
+					constexpr K signBit = K(1) << (8 * sizeof(K) - 1);
+
+					// NaNs are all mapped to the same positive one
+					const T value = std::isnan(x) ? std::numeric_limits<T>::quiet_NaN() : x;
+					K bits;
+					std::memcpy(&bits, &value, sizeof(K));
+
+					K key;
+					if (std::is_integral<T>::value)
+						key = bits ^ signBit;
+					else
+						key = (bits & signBit) ? ~bits : (bits | signBit);
+
+					return ascending ? key : ~key;
+				}
+
+				template<typename T>
+				inline T FromKey(const Key<T> key, const bool ascending) noexcept
+				{
+					using K = Key<T>;
+					constexpr K signBit = K(1) << (8 * sizeof(K) - 1);
+
+					const K k = ascending ? key : ~key;
+					K bits;
+					if (std::is_integral<T>::value)
+						bits = k ^ signBit;
+					else
+						bits = (k & signBit) ? (k ^ signBit) : ~k;
+
+					T x;
+					std::memcpy(&x, &bits, sizeof(K));
+					return x;
+				}
+
+				/**
+				 * Runs f(p, begin, end) over nPartitions contiguous chunks of [0, size), on the calling thread when there's a single one
+				 */
+				template<typename F>
+				void ForEachPartition(const size_t size, const size_t nPartitions, const F& f)
+				{
+					if (nPartitions <= 1)
+					{
+						f(size_t(0), size_t(0), size);
+						return;
+					}
+
+					detail::ParallelFor(nPartitions, [&](const size_t p) { f(p, p * size / nPartitions, (p + 1) * size / nPartitions); });
+				}
+
+				/**
+				 * Stable LSD radix sort of keys, moving values (when not null) along with them: the buffers are scratch space of the same size.
+				 * Returns whether the sorted data has ended up in the buffers. Each thread has its own histogram of a contiguous chunk, and
+				 * the scatter offsets are ordered by digit first and by chunk next, which keeps equal keys in their original order.
+				 */
+				template<typename K>
+				bool RadixSort(K* keys, int* values, K* keysBuffer, int* valuesBuffer, const size_t size, const size_t nPartitions)
+				{
+					std::vector<size_t> histograms(nPartitions * nBuckets);
+
+					K* source = keys;
+					K* destination = keysBuffer;
+					int* sourceValues = values;
+					int* destinationValues = valuesBuffer;
+					bool swapped = false;
+					for (unsigned shift = 0; shift < 8 * sizeof(K); shift += radixBits)
+					{
+						std::fill(histograms.begin(), histograms.end(), size_t(0));
+						ForEachPartition(size, nPartitions, [&](const size_t p, const size_t begin, const size_t end) {
+							size_t* histogram = histograms.data() + p * nBuckets;
+							for (size_t i = begin; i < end; ++i)
+								++histogram[(source[i] >> shift) & (nBuckets - 1)];
+						});
+
+						// when all the keys share this digit there's nothing to move
+						const size_t firstDigit = (source[0] >> shift) & (nBuckets - 1);
+						size_t nFirstDigit = 0;
+						for (size_t p = 0; p < nPartitions; ++p)
+							nFirstDigit += histograms[p * nBuckets + firstDigit];
+						if (nFirstDigit == size)
+							continue;
+
+						size_t offset = 0;
+						for (size_t digit = 0; digit < nBuckets; ++digit)
+						{
+							for (size_t p = 0; p < nPartitions; ++p)
+							{
+								const size_t count = histograms[p * nBuckets + digit];
+								histograms[p * nBuckets + digit] = offset;
+								offset += count;
+							}
+						}
+
+						ForEachPartition(size, nPartitions, [&](const size_t p, const size_t begin, const size_t end) {
+							size_t* positions = histograms.data() + p * nBuckets;
+							for (size_t i = begin; i < end; ++i)
+							{
+								const size_t j = positions[(source[i] >> shift) & (nBuckets - 1)]++;
+								destination[j] = source[i];
+								if (sourceValues)
+									destinationValues[j] = sourceValues[i];
+							}
+						});
+
+						std::swap(source, destination);
+						std::swap(sourceValues, destinationValues);
+						swapped = !swapped;
+					}
+
+					return swapped;
+				}
+
+				template<typename T>
+				void Sort(T* x, const size_t size, const bool ascending, const size_t nPartitions)
+				{
+					using K = Key<T>;
+
+					std::vector<K> keys(size);
+					ForEachPartition(size, nPartitions, [&](const size_t, const size_t begin, const size_t end) {
+						for (size_t i = begin; i < end; ++i)
+							keys[i] = ToKey(x[i], ascending);
+					});
+
+					if (size < minRadixSortSize)
+						std::sort(keys.begin(), keys.end());
+					else
+					{
+						std::vector<K> keysBuffer(size);
+						if (RadixSort<K>(keys.data(), nullptr, keysBuffer.data(), nullptr, size, nPartitions))
+							keys.swap(keysBuffer);
+					}
+
+					ForEachPartition(size, nPartitions, [&](const size_t, const size_t begin, const size_t end) {
+						for (size_t i = begin; i < end; ++i)
+							x[i] = FromKey<T>(keys[i], ascending);
+					});
+				}
+			}	 // namespace
+
+			template<typename T>
+			void Sort(T* x, const size_t size, const bool ascending)
+			{
+				Sort(x, size, ascending, detail::GetNumberOfPartitions(size, minElementsPerThread));
+			}
+
+			template<typename T>
+			void ArgSort(int* indices, const T* x, const size_t size, const bool ascending)
+			{
+				using K = Key<T>;
+				assert(size <= static_cast<size_t>(std::numeric_limits<int>::max()));
+
+				const size_t nPartitions = detail::GetNumberOfPartitions(size, minElementsPerThread);
+				std::vector<K> keys(size);
+				ForEachPartition(size, nPartitions, [&](const size_t, const size_t begin, const size_t end) {
+					for (size_t i = begin; i < end; ++i)
+					{
+						keys[i] = ToKey(x[i], ascending);
+						indices[i] = static_cast<int>(i);
+					}
+				});
+
+				if (size < minRadixSortSize)
+				{
+					std::stable_sort(indices, indices + size, [&keys](const int i, const int j) { return keys[i] < keys[j]; });
+					return;
+				}
+
+				std::vector<K> keysBuffer(size);
+				std::vector<int> indicesBuffer(size);
+				if (RadixSort<K>(keys.data(), indices, keysBuffer.data(), indicesBuffer.data(), size, nPartitions))
+					std::copy(indicesBuffer.begin(), indicesBuffer.end(), indices);
+			}
+
+			template<typename T>
+			void TopK(T* values, int* indices, const T* x, const size_t size, const size_t k, const bool largest)
+			{
+				// the smallest keys are selected: the index breaks ties
+				using Candidate = std::pair<Key<T>, int>;
+				assert(k <= size);
+				if (k == 0)
+					return;
+
+				// each thread keeps its best k candidates, pruning them whenever the buffer is full
+				const size_t nPartitions = detail::GetNumberOfPartitions(size, minElementsPerThread);
+				const size_t capacity = k + std::max(k, minTopKCandidates);
+				std::vector<std::vector<Candidate>> candidates(nPartitions);
+				ForEachPartition(size, nPartitions, [&](const size_t p, const size_t begin, const size_t end) {
+					auto& partitionCandidates = candidates[p];
+					partitionCandidates.reserve(std::min(capacity, end - begin));
+					for (size_t i = begin; i < end; ++i)
+					{
+						partitionCandidates.emplace_back(ToKey(x[i], !largest), static_cast<int>(i));
+						if (partitionCandidates.size() == capacity)
+						{
+							std::nth_element(partitionCandidates.begin(), partitionCandidates.begin() + static_cast<std::ptrdiff_t>(k), partitionCandidates.end());
+							partitionCandidates.resize(k);
+						}
+					}
+				});
+
+				std::vector<Candidate> best = std::move(candidates.front());
+				for (size_t p = 1; p < nPartitions; ++p)
+					best.insert(best.end(), candidates[p].begin(), candidates[p].end());
+				if (best.size() > k)
+				{
+					std::nth_element(best.begin(), best.begin() + static_cast<std::ptrdiff_t>(k), best.end());
+					best.resize(k);
+				}
+				std::sort(best.begin(), best.end());
+
+				for (size_t i = 0; i < k; ++i)
+				{
+					values[i] = x[best[i].second];
+					indices[i] = best[i].second;
+				}
+			}
+
+			template<typename T>
+			void SegmentedSort(T* x, const size_t* offsets, const size_t nSegments, const bool ascending)
+			{
+				// segments big enough for all the threads are sorted one after the other, the rest concurrently, a segment per task
+				std::vector<size_t> smallSegments;
+				size_t nSmallSegmentElements = 0;
+				for (size_t s = 0; s < nSegments; ++s)
+				{
+					const size_t size = offsets[s + 1] - offsets[s];
+					const size_t nPartitions = detail::GetNumberOfPartitions(size, minElementsPerThread);
+					if (nPartitions > 1)
+						Sort(x + offsets[s], size, ascending, nPartitions);
+					else
+					{
+						smallSegments.push_back(s);
+						nSmallSegmentElements += size;
+					}
+				}
+
+				if (smallSegments.empty())
+					return;
+
+				const size_t grainSize = detail::GetSliceGrainSize(nSmallSegmentElements / smallSegments.size());
+				detail::ParallelFor(smallSegments.size(), grainSize, [&](const size_t begin, const size_t end) {
+					for (size_t j = begin; j < end; ++j)
+					{
+						const size_t s = smallSegments[j];
+						Sort(x + offsets[s], offsets[s + 1] - offsets[s], ascending, 1);
+					}
+				});
+			}
+
+#pragma region Explicit instantiations
+
+			template void Sort<float>(float* x, const size_t size, const bool ascending);
+			template void Sort<double>(double* x, const size_t size, const bool ascending);
+			template void Sort<int>(int* x, const size_t size, const bool ascending);
+
+			template void ArgSort<float>(int* indices, const float* x, const size_t size, const bool ascending);
+			template void ArgSort<double>(int* indices, const double* x, const size_t size, const bool ascending);
+			template void ArgSort<int>(int* indices, const int* x, const size_t size, const bool ascending);
+
+			template void TopK<float>(float* values, int* indices, const float* x, const size_t size, const size_t k, const bool largest);
+			template void TopK<double>(double* values, int* indices, const double* x, const size_t size, const size_t k, const bool largest);
+			template void TopK<int>(int* values, int* indices, const int* x, const size_t size, const size_t k, const bool largest);
+
+			template void SegmentedSort<float>(float* x, const size_t* offsets, const size_t nSegments, const bool ascending);
+			template void SegmentedSort<double>(double* x, const size_t* offsets, const size_t nSegments, const bool ascending);
+			template void SegmentedSort<int>(int* x, const size_t* offsets, const size_t nSegments, const bool ascending);
+
+#pragma endregion
+		}	 // namespace sorting
+	}		 // namespace routines
+}	 // namespace cl
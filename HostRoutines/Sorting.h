@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+
+namespace cl
+{
+	namespace routines
+	{
+		/**
+		 * Multithreaded sorting and selection used by the host memory spaces. Sorting is a stable LSD radix sort on the bit patterns of the
+		 * elements, remapped so that their unsigned order is the numerical one: NaNs go after +inf in ascending order and before it in descending one.
+		 */
+		namespace sorting
+		{
+			template<typename T>
+			void Sort(T* x, const size_t size, const bool ascending = true);
+
+			/**
+			 * indices = the permutation that sorts x: equal elements keep their relative order
+			 */
+			template<typename T>
+			void ArgSort(int* indices, const T* x, const size_t size, const bool ascending = true);
+
+			/**
+			 * values/indices = the k largest (or smallest) elements of x and their positions, in order: among equal elements the first ones win
+			 */
+			template<typename T>
+			void TopK(T* values, int* indices, const T* x, const size_t size, const size_t k, const bool largest = true);
+
+			/**
+			 * Sorts x[offsets[s]:offsets[s + 1]] for each of the nSegments segments: offsets has nSegments + 1 entries
+			 */
+			template<typename T>
+			void SegmentedSort(T* x, const size_t* offsets, const size_t nSegments, const bool ascending = true);
+		}	 // namespace sorting
+	}		 // namespace routines
+}	 // namespace cl
@@ -1,8 +1,13 @@
 
 #include "Common.h"
+#include <Exceptions.h>
 #include <MklAllWrappers.h>
+#include <NativeSparseWrappers.h>
+#include <Profiling.h>
 #include <SparseWrappers.h>
 
+#include <algorithm>
+
 namespace cl
 {
 	namespace routines
@@ -19,6 +24,8 @@ namespace cl
 							mkr::AllocateCsrHandle<MathDomain::Float>(A);
 							break;
 						case MemorySpace::Test:
+						case MemorySpace::OpenBlas:
+						case MemorySpace::GenericBlas:
 							break;
 						default:
 							throw NotImplementedException();
@@ -33,6 +40,8 @@ namespace cl
 							mkr::AllocateCsrHandle<MathDomain::Double>(A);
 							break;
 						case MemorySpace::Test:
+						case MemorySpace::OpenBlas:
+						case MemorySpace::GenericBlas:
 							break;
 						default:
 							throw NotImplementedException();
@@ -46,6 +55,8 @@ namespace cl
 						case MemorySpace::Mkl:
 							throw NotImplementedException();
 						case MemorySpace::Test:
+						case MemorySpace::OpenBlas:
+						case MemorySpace::GenericBlas:
 							break;
 						default:
 							throw NotImplementedException();
@@ -69,6 +80,8 @@ namespace cl
 							mkr::DestroyCsrHandle<MathDomain::Float>(A);
 							break;
 						case MemorySpace::Test:
+						case MemorySpace::OpenBlas:
+						case MemorySpace::GenericBlas:
 							break;
 						default:
 							throw NotImplementedException();
@@ -83,6 +96,8 @@ namespace cl
 							mkr::DestroyCsrHandle<MathDomain::Double>(A);
 							break;
 						case MemorySpace::Test:
+						case MemorySpace::OpenBlas:
+						case MemorySpace::GenericBlas:
 							break;
 						default:
 							throw NotImplementedException();
@@ -96,6 +111,8 @@ namespace cl
 						case MemorySpace::Mkl:
 							throw NotImplementedException();
 						case MemorySpace::Test:
+						case MemorySpace::OpenBlas:
+						case MemorySpace::GenericBlas:
 							break;
 						default:
 							throw NotImplementedException();
@@ -117,6 +134,8 @@ namespace cl
 			assert(z.mathDomain == x.mathDomain);
 			assert(z.mathDomain == y.mathDomain);
 
+			CL_PROFILE(z, 2.0 * x.size, 1.0 * x.TotalSize() + 4.0 * x.size + 2.0 * z.TotalSize());
+
 			switch (z.mathDomain)
 			{
 				case MathDomain::Float:
@@ -128,16 +147,11 @@ namespace cl
 							break;
 
 						case MemorySpace::Test:
-						{
-							const auto* iPtr = reinterpret_cast<const int*>(x.indices);	   // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast,performance-no-int-to-ptr)
-							auto* zPtr = GetPointer<MathDomain::Float>(z);
-							auto* xPtr = GetPointer<MathDomain::Float>(x);
-							auto* yPtr = GetPointer<MathDomain::Float>(y);
-
-							for (size_t i = 0; i < x.size; ++i)
-								zPtr[iPtr[i]] = static_cast<float>(alpha) * xPtr[i] + yPtr[iPtr[i]];
+						case MemorySpace::OpenBlas:
+						case MemorySpace::GenericBlas:
+							nsr::SparseAdd<MathDomain::Float>(z, x, y, alpha);
 							break;
-						}
+
 						default:
 							throw NotImplementedException();
 					}
@@ -152,16 +166,11 @@ namespace cl
 							break;
 
 						case MemorySpace::Test:
-						{
-							const auto* iPtr = reinterpret_cast<const int*>(x.indices);	   // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast,performance-no-int-to-ptr)
-							auto* zPtr = GetPointer<MathDomain::Double>(z);
-							auto* xPtr = GetPointer<MathDomain::Double>(x);
-							auto* yPtr = GetPointer<MathDomain::Double>(y);
-
-							for (size_t i = 0; i < x.size; ++i)
-								zPtr[iPtr[i]] = alpha * xPtr[i] + yPtr[iPtr[i]];
+						case MemorySpace::OpenBlas:
+						case MemorySpace::GenericBlas:
+							nsr::SparseAdd<MathDomain::Double>(z, x, y, alpha);
 							break;
-						}
+
 						default:
 							throw NotImplementedException();
 					}
@@ -172,17 +181,12 @@ namespace cl
 					switch (z.memorySpace)
 					{
 						case MemorySpace::Test:
+						case MemorySpace::OpenBlas:
+						case MemorySpace::GenericBlas:
 						case MemorySpace::Mkl:	  // TODO
-						{
-							const auto* iPtr = reinterpret_cast<const int*>(x.indices);	   // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast,performance-no-int-to-ptr)
-							auto* zPtr = GetPointer<MathDomain::Int>(z);
-							auto* xPtr = GetPointer<MathDomain::Int>(x);
-							auto* yPtr = GetPointer<MathDomain::Int>(y);
-
-							for (size_t i = 0; i < x.size; ++i)
-								zPtr[iPtr[i]] = static_cast<int>(alpha) * xPtr[i] + yPtr[iPtr[i]];
+							nsr::SparseAdd<MathDomain::Int>(z, x, y, alpha);
 							break;
-						}
+
 						default:
 							throw NotImplementedException();
 					}
@@ -203,6 +207,8 @@ namespace cl
 		 */
 		void SparseDot(MemoryBuffer& y, SparseMemoryTile& A, const MemoryBuffer& x, const MatrixOperation aOperation, const double alpha, const double beta)
 		{
+			CL_PROFILE(A, 2.0 * A.size, 1.0 * A.TotalSize() + 4.0 * (A.size + A.nRows + 1) + (1.0 * x.size + 2.0 * y.size) * y.ElementarySize());
+
 			switch (A.mathDomain)
 			{
 				case MathDomain::Float:
@@ -214,6 +220,11 @@ namespace cl
 							break;
 
 						case MemorySpace::Test:
+						case MemorySpace::OpenBlas:
+						case MemorySpace::GenericBlas:
+							nsr::SparseDot<MathDomain::Float>(y, A, x, aOperation, alpha, beta);
+							break;
+
 						default:
 							throw NotImplementedException();
 					}
@@ -228,6 +239,11 @@ namespace cl
 							break;
 
 						case MemorySpace::Test:
+						case MemorySpace::OpenBlas:
+						case MemorySpace::GenericBlas:
+							nsr::SparseDot<MathDomain::Double>(y, A, x, aOperation, alpha, beta);
+							break;
+
 						default:
 							throw NotImplementedException();
 					}
@@ -238,10 +254,16 @@ namespace cl
 					switch (A.memorySpace)
 					{
 						case MemorySpace::Test:
+						case MemorySpace::OpenBlas:
+						case MemorySpace::GenericBlas:
+							nsr::SparseDot<MathDomain::Int>(y, A, x, aOperation, alpha, beta);
+							break;
+
 						case MemorySpace::Mkl:
 						default:
 							throw NotImplementedException();
 					}
+					break;
 				}
 				default:
 					throw NotImplementedException();
@@ -253,6 +275,8 @@ namespace cl
 		 */
 		void SparseMultiply(MemoryTile& A, SparseMemoryTile& B, const MemoryTile& C, const MatrixOperation bOperation, const double alpha)
 		{
+			CL_PROFILE(A, 2.0 * B.size * A.nCols, 1.0 * B.TotalSize() + 4.0 * (B.size + B.nRows + 1) + (1.0 * C.nRows * C.nCols + 2.0 * A.nRows * A.nCols) * A.ElementarySize());
+
 			switch (A.mathDomain)
 			{
 				case MathDomain::Float:
@@ -264,6 +288,11 @@ namespace cl
 							break;
 
 						case MemorySpace::Test:
+						case MemorySpace::OpenBlas:
+						case MemorySpace::GenericBlas:
+							nsr::SparseMultiply<MathDomain::Float>(A, B, C, bOperation, alpha);
+							break;
+
 						default:
 							throw NotImplementedException();
 					}
@@ -278,6 +307,11 @@ namespace cl
 							break;
 
 						case MemorySpace::Test:
+						case MemorySpace::OpenBlas:
+						case MemorySpace::GenericBlas:
+							nsr::SparseMultiply<MathDomain::Double>(A, B, C, bOperation, alpha);
+							break;
+
 						default:
 							throw NotImplementedException();
 					}
@@ -288,10 +322,16 @@ namespace cl
 					switch (A.memorySpace)
 					{
 						case MemorySpace::Test:
+						case MemorySpace::OpenBlas:
+						case MemorySpace::GenericBlas:
+							nsr::SparseMultiply<MathDomain::Int>(A, B, C, bOperation, alpha);
+							break;
+
 						case MemorySpace::Mkl:
 						default:
 							throw NotImplementedException();
 					}
+					break;
 				}
 				default:
 					throw NotImplementedException();
@@ -300,6 +340,8 @@ namespace cl
 
 		void SparseSolve(SparseMemoryTile& A, MemoryTile& B, LinearSystemSolverType solver)
 		{
+			CL_PROFILE(A, 0.0, 1.0 * A.TotalSize() + 4.0 * (A.size + A.nRows + 1) + 2.0 * B.nRows * B.nCols * B.ElementarySize());
+
 			switch (A.mathDomain)
 			{
 				case MathDomain::Float:
@@ -344,5 +386,140 @@ namespace cl
 					throw NotImplementedException();
 			}
 		}
+
+		void SparseDiagonal(MemoryBuffer& d, const SparseMemoryTile& A)
+		{
+			CL_PROFILE(A, 0.0, 1.0 * A.TotalSize() + 4.0 * (A.size + A.nRows + 1) + 1.0 * d.TotalSize());
+
+			switch (A.mathDomain)
+			{
+				case MathDomain::Float:
+				{
+					switch (A.memorySpace)
+					{
+						case MemorySpace::Test:
+						case MemorySpace::Mkl:
+						case MemorySpace::OpenBlas:
+						case MemorySpace::GenericBlas:
+							nsr::SparseDiagonal<MathDomain::Float>(d, A);
+							break;
+
+						default:
+							throw NotImplementedException();
+					}
+					break;
+				}
+				case MathDomain::Double:
+				{
+					switch (A.memorySpace)
+					{
+						case MemorySpace::Test:
+						case MemorySpace::Mkl:
+						case MemorySpace::OpenBlas:
+						case MemorySpace::GenericBlas:
+							nsr::SparseDiagonal<MathDomain::Double>(d, A);
+							break;
+
+						default:
+							throw NotImplementedException();
+					}
+					break;
+				}
+				default:
+					throw NotImplementedException();
+			}
+		}
+
+		void SparseIncompleteLu(SparseMemoryTile& A, MemoryBuffer& diagonal)
+		{
+			CL_PROFILE(A, 2.0 * A.size * A.size / std::max(1u, A.nRows), 2.0 * A.TotalSize() + 4.0 * (A.size + A.nRows + 1) + 1.0 * diagonal.TotalSize());
+
+			// ILU(0) is an incomplete LU: a failure is reported the same way
+			int info = 0;
+
+			switch (A.mathDomain)
+			{
+				case MathDomain::Float:
+				{
+					switch (A.memorySpace)
+					{
+						case MemorySpace::Test:
+						case MemorySpace::Mkl:
+						case MemorySpace::OpenBlas:
+						case MemorySpace::GenericBlas:
+							info = nsr::SparseIncompleteLu<MathDomain::Float>(A, diagonal);
+							break;
+
+						default:
+							throw NotImplementedException();
+					}
+					break;
+				}
+				case MathDomain::Double:
+				{
+					switch (A.memorySpace)
+					{
+						case MemorySpace::Test:
+						case MemorySpace::Mkl:
+						case MemorySpace::OpenBlas:
+						case MemorySpace::GenericBlas:
+							info = nsr::SparseIncompleteLu<MathDomain::Double>(A, diagonal);
+							break;
+
+						default:
+							throw NotImplementedException();
+					}
+					break;
+				}
+				default:
+					throw NotImplementedException();
+			}
+
+			if (info != 0)
+				throw FactorizationException(DenseSolverType::Lu, info);
+		}
+
+		void SparseSolveIncompleteLu(const SparseMemoryTile& A, const MemoryBuffer& diagonal, MemoryBuffer& x)
+		{
+			CL_PROFILE(A, 2.0 * A.size, 1.0 * A.TotalSize() + 4.0 * (A.size + 2.0 * A.nRows + 1) + 2.0 * x.TotalSize());
+
+			switch (A.mathDomain)
+			{
+				case MathDomain::Float:
+				{
+					switch (A.memorySpace)
+					{
+						case MemorySpace::Test:
+						case MemorySpace::Mkl:
+						case MemorySpace::OpenBlas:
+						case MemorySpace::GenericBlas:
+							nsr::SparseSolveIncompleteLu<MathDomain::Float>(A, diagonal, x);
+							break;
+
+						default:
+							throw NotImplementedException();
+					}
+					break;
+				}
+				case MathDomain::Double:
+				{
+					switch (A.memorySpace)
+					{
+						case MemorySpace::Test:
+						case MemorySpace::Mkl:
+						case MemorySpace::OpenBlas:
+						case MemorySpace::GenericBlas:
+							nsr::SparseSolveIncompleteLu<MathDomain::Double>(A, diagonal, x);
+							break;
+
+						default:
+							throw NotImplementedException();
+					}
+					break;
+				}
+				default:
+					throw NotImplementedException();
+			}
+		}
 	}	 // namespace routines
 }	 // namespace cl
@@ -31,5 +31,21 @@ namespace cl
 		extern void SparseMultiply(MemoryTile& A, SparseMemoryTile& B, const MemoryTile& C, const MatrixOperation bOperation = MatrixOperation::None, const double alpha = 1.0);
 
 		extern void SparseSolve(SparseMemoryTile& A, MemoryTile& B, LinearSystemSolverType solver = LinearSystemSolverType::Lu);
+
+		/**
+		 * dDense = diag(ASparse)
+		 */
+		extern void SparseDiagonal(MemoryBuffer& d, const SparseMemoryTile& A);
+
+		/**
+		 * ASparse = L * U with no fill-in (ILU(0)), overwriting its values: diagonal (Int, nRows) receives the position of the pivots.
+		 * Throws FactorizationException on a zero or missing pivot
+		 */
+		extern void SparseIncompleteLu(SparseMemoryTile& A, MemoryBuffer& diagonal);
+
+		/**
+		 * xDense = (L * U)^(-1) * xDense, A and diagonal being the output of SparseIncompleteLu
+		 */
+		extern void SparseSolveIncompleteLu(const SparseMemoryTile& A, const MemoryBuffer& diagonal, MemoryBuffer& x);
 	}	 // namespace routines
 }	 // namespace cl
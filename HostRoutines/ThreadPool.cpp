@@ -0,0 +1,198 @@
+#include <ThreadPool.h>
+
+#include <GenericBlasAllWrappers.h>
+#include <MklAllWrappers.h>
+#include <OpenBlasAllWrappers.h>
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace cl
+{
+	namespace routines
+	{
+		namespace detail
+		{
+			namespace
+			{
+				// queue owned by the current thread, if it's a worker of the given pool
+				thread_local const ThreadPool* currentPool = nullptr;
+				thread_local size_t currentQueue = 0;
+
+				size_t GetDefaultNumberOfThreads() noexcept
+				{
+					const char* value = std::getenv("CL_NUM_THREADS");	  // NOLINT(concurrency-mt-unsafe): read once at static initialization
+					if (value != nullptr)
+					{
+						const long nThreads = std::strtol(value, nullptr, 10);
+						if (nThreads > 0)
+							return static_cast<size_t>(nThreads);
+					}
+
+					return std::max(1u, std::thread::hardware_concurrency());
+				}
+			}	 // namespace
+
+			ThreadPool::ThreadPool(const size_t nThreads) { Start(nThreads); }
+
+			ThreadPool::~ThreadPool() { Stop(); }
+
+			ThreadPool& ThreadPool::Instance()
+			{
+				static ThreadPool pool(GetDefaultNumberOfThreads());
+				return pool;
+			}
+
+			void ThreadPool::Resize(const size_t nThreads)
+			{
+				if (nThreads == GetNumberOfThreads())
+					return;
+
+				Stop();
+				Start(nThreads);
+			}
+
+			void ThreadPool::Start(const size_t nThreads)
+			{
+				const size_t nWorkers = std::max(size_t(1), nThreads) - 1;
+
+				_stop = false;
+				_queues.clear();
+				for (size_t q = 0; q <= nWorkers; ++q)
+					_queues.push_back(std::make_unique<Queue>());
+
+				_workers.reserve(nWorkers);
+				for (size_t w = 0; w < nWorkers; ++w)
+					_workers.emplace_back(&ThreadPool::WorkerLoop, this, w + 1);
+			}
+
+			void ThreadPool::Stop()
+			{
+				{
+					std::lock_guard<std::mutex> lock(_mutex);
+					_stop = true;
+				}
+				_wakeUp.notify_all();
+
+				for (auto& worker : _workers)
+					worker.join();
+				_workers.clear();
+			}
+
+			void ThreadPool::Run(Job& job)
+			{
+				const size_t nTasks = job.remaining.load(std::memory_order_relaxed);
+				const size_t ownQueue = currentPool == this ? currentQueue : 0;
+
+				// counted before being queued, so that the counter never underflows when a task is popped straight away
+				{
+					std::lock_guard<std::mutex> lock(_mutex);
+					_nQueuedTasks.fetch_add(nTasks);
+				}
+
+				// round robin over the queues, starting from the caller's one, which is then served first
+				for (size_t task = 0; task < nTasks; ++task)
+				{
+					auto& queue = *_queues[(ownQueue + task) % _queues.size()];
+					std::lock_guard<std::mutex> lock(queue.mutex);
+					queue.tasks.push_back({ &job, task });
+				}
+				_wakeUp.notify_all();
+
+				// help until all the tasks of this job are done: the ones still queued can be from other jobs as well
+				Task task {};
+				while (job.remaining.load(std::memory_order_acquire) > 0)
+				{
+					if (TryPop(ownQueue, task))
+						Execute(task);
+					else
+						std::this_thread::yield();
+				}
+
+				if (job.error)
+					std::rethrow_exception(job.error);
+			}
+
+			void ThreadPool::WorkerLoop(const size_t queue)
+			{
+				currentPool = this;
+				currentQueue = queue;
+
+				Task task {};
+				while (true)
+				{
+					if (TryPop(queue, task))
+					{
+						Execute(task);
+						continue;
+					}
+
+					std::unique_lock<std::mutex> lock(_mutex);
+					_wakeUp.wait(lock, [this]() { return _stop || _nQueuedTasks.load() > 0; });
+					if (_stop)
+						return;
+				}
+			}
+
+			bool ThreadPool::TryPop(const size_t queue, Task& task)
+			{
+				{
+					auto& own = *_queues[queue];
+					std::lock_guard<std::mutex> lock(own.mutex);
+					if (!own.tasks.empty())
+					{
+						task = own.tasks.back();
+						own.tasks.pop_back();
+						_nQueuedTasks.fetch_sub(1);
+						return true;
+					}
+				}
+
+				for (size_t offset = 1; offset < _queues.size(); ++offset)
+				{
+					auto& victim = *_queues[(queue + offset) % _queues.size()];
+					std::lock_guard<std::mutex> lock(victim.mutex);
+					if (!victim.tasks.empty())
+					{
+						task = victim.tasks.front();
+						victim.tasks.pop_front();
+						_nQueuedTasks.fetch_sub(1);
+						return true;
+					}
+				}
+
+				return false;
+			}
+
+			void ThreadPool::Execute(const Task& task) noexcept
+			{
+				Job& job = *task.job;
+				try
+				{
+					job.invoke(job.function, task.index);
+				}
+				catch (...)
+				{
+					std::lock_guard<std::mutex> lock(job.errorMutex);
+					if (!job.error)
+						job.error = std::current_exception();
+				}
+
+				// last access to the job: the thread waiting on it can return as soon as it sees zero
+				job.remaining.fetch_sub(1, std::memory_order_release);
+			}
+		}	 // namespace detail
+	}		 // namespace routines
+
+	void SetNumThreads(const size_t nThreads)
+	{
+		const size_t nThreads_ = std::max(size_t(1), nThreads);
+		routines::detail::ThreadPool::Instance().Resize(nThreads_);
+
+		routines::mkr::SetNumThreads(nThreads_);
+		routines::obr::SetNumThreads(nThreads_);
+		routines::gbr::SetNumThreads(nThreads_);
+	}
+
+	size_t GetNumThreads() noexcept { return routines::detail::ThreadPool::Instance().GetNumberOfThreads(); }
+}	 // namespace cl
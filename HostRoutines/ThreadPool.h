@@ -0,0 +1,119 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace cl
+{
+	/**
+	 * Number of threads used by the host routines, the calling thread included. The same number is forwarded to MKL/OpenBLAS,
+	 * and routines that call BLAS from the pool's threads switch it to a single thread meanwhile: the two never oversubscribe the cores.
+	 * Defaults to the CL_NUM_THREADS environment variable, or to the number of hardware threads.
+	 *
+	 * Not meant to be called while host routines are running on other threads.
+	 */
+	extern void SetNumThreads(const size_t nThreads);
+	extern size_t GetNumThreads() noexcept;
+
+	namespace routines
+	{
+		namespace detail
+		{
+			/**
+			 * Work-stealing pool shared by the hand-written host loops.
+			 * Each worker has its own queue: it pops its own tasks LIFO, and steals from the other queues FIFO when it runs out of them.
+			 * The thread calling Run executes tasks as well until its job is done, so nested Run calls from a task can't deadlock.
+			 */
+			class ThreadPool
+			{
+			public:
+				explicit ThreadPool(const size_t nThreads);
+				~ThreadPool();
+
+				ThreadPool(const ThreadPool&) = delete;
+				ThreadPool(ThreadPool&&) = delete;
+				ThreadPool& operator=(const ThreadPool&) = delete;
+				ThreadPool& operator=(ThreadPool&&) = delete;
+
+				static ThreadPool& Instance();
+
+				size_t GetNumberOfThreads() const noexcept { return _workers.size() + 1; }
+
+				/**
+				 * Stops the workers and starts nThreads - 1 new ones: no job can be running
+				 */
+				void Resize(const size_t nThreads);
+
+				/**
+				 * Runs f(0), ..., f(nTasks - 1) and waits for them: the first exception thrown by a task is rethrown here
+				 */
+				template<typename F>
+				void Run(const size_t nTasks, const F& f)
+				{
+					if (nTasks == 0)
+						return;
+					if (nTasks == 1 || _workers.empty())
+					{
+						for (size_t task = 0; task < nTasks; ++task)
+							f(task);
+						return;
+					}
+
+					Job job(&f, [](const void* function, const size_t task) { (*static_cast<const F*>(function))(task); }, nTasks);
+					Run(job);
+				}
+
+			private:
+				struct Job
+				{
+					Job(const void* function_, void (*invoke_)(const void*, const size_t), const size_t nTasks) : function(function_), invoke(invoke_), remaining(nTasks) {}
+
+					const void* function;
+					void (*invoke)(const void* function, const size_t task);
+					std::atomic<size_t> remaining;
+
+					std::mutex errorMutex {};
+					std::exception_ptr error {};
+				};
+
+				struct Task
+				{
+					Job* job;
+					size_t index;
+				};
+
+				struct Queue
+				{
+					std::mutex mutex {};
+					std::deque<Task> tasks {};
+				};
+
+				void Run(Job& job);
+				void Start(const size_t nThreads);
+				void Stop();
+				void WorkerLoop(const size_t queue);
+
+				// own queue first (newest task), then the others (oldest task)
+				bool TryPop(const size_t queue, Task& task);
+				static void Execute(const Task& task) noexcept;
+
+				std::vector<std::thread> _workers {};
+
+				// one queue per worker, plus one for the threads outside the pool
+				std::vector<std::unique_ptr<Queue>> _queues {};
+
+				std::mutex _mutex {};
+				std::condition_variable _wakeUp {};
+				std::atomic<size_t> _nQueuedTasks { 0 };
+				bool _stop = false;
+			};
+		}	 // namespace detail
+	}		 // namespace routines
+}	 // namespace cl
@@ -368,6 +368,19 @@ namespace clt
 		}
 	}
 
+	TEST_F(CuBlasTests, SolveMixedPrecisionLu)
+	{
+		// the device has no refinement: same as Lu
+		cl::mat v = GetInvertibleMatrix(128);
+		cl::mat u = GetInvertibleMatrix(v.nRows(), 2345);
+		cl::mat w(u);
+		v.Solve(u, MatrixOperation::None, cl::DenseSolverType::MixedPrecisionLu);
+		v.Solve(w, MatrixOperation::None, cl::DenseSolverType::Lu);
+		dm::DeviceManager::CheckDeviceSanity();
+
+		ASSERT_EQ(w.Get(), u.Get());
+	}
+
 	TEST_F(CuBlasTests, KroneckerProduct)
 	{
 		cl::vec u(64, 0.1f);
@@ -0,0 +1,152 @@
+#include <gtest/gtest.h>
+
+#include <CompressedSparseRowMatrix.h>
+#include <SparseVector.h>
+
+namespace clt
+{
+	class GenericBlasSparseTests: public ::testing::Test
+	{
+	};
+
+	/**
+	 * Banded matrix with nBands non-zeros per row, large enough to be split among several threads
+	 */
+	static gblas::dmat GetBandedMatrix(unsigned nRows, unsigned nCols, unsigned nBands)
+	{
+		gblas::dmat A(nRows, nCols, 0.0);
+		auto _A = A.Get();
+
+		for (size_t i = 0; i < nRows; ++i)
+		{
+			for (size_t k = 0; k < nBands; ++k)
+			{
+				const size_t j = (i + k * 7) % nCols;
+				_A[i + nRows * j] = 1.0 + static_cast<double>((i + k) % 13) / 13.0;
+			}
+		}
+
+		A.ReadFrom(_A);
+		return A;
+	}
+
+	TEST_F(GenericBlasSparseTests, Add)
+	{
+		std::vector<int> _indices = { 0, 5, 10, 50, 75 };
+		gblas::ivec indices(static_cast<unsigned>(_indices.size()), 0);
+		indices.ReadFrom(_indices);
+
+		gblas::svec v1(100, indices, 1.2345f);
+		auto _v1 = v1.Get();
+
+		gblas::vec v2 = gblas::vec::RandomUniform(v1.denseSize, 1234);
+		auto _v2 = v2.Get();
+
+		auto v3 = v1 + v2;
+		auto _v3 = v3.Get();
+
+		for (size_t i = 0; i < v1.size(); ++i)
+			ASSERT_TRUE(std::fabs(_v3[i] - _v1[i] - _v2[i]) <= 1.5e-7f) << i << " | " << std::fabs(_v3[i] - _v1[i] - _v2[i]);
+	}
+
+	TEST_F(GenericBlasSparseTests, Multiply)
+	{
+		std::vector<int> _NonZeroCols = { 0, 1, 1, 3, 2, 3, 4, 5 };
+		gblas::ivec nonZeroCols(static_cast<unsigned>(_NonZeroCols.size()), 0);
+		nonZeroCols.ReadFrom(_NonZeroCols);
+
+		std::vector<int> _NonZeroRows = { 0, 2, 4, 7, 8 };
+		gblas::ivec nonZeroRows(static_cast<unsigned>(_NonZeroRows.size()), 0);
+		nonZeroRows.ReadFrom(_NonZeroRows);
+
+		gblas::smat m1(4, 6, nonZeroCols, nonZeroRows, 1.2345f);
+		auto _m1 = m1.Get();
+
+		gblas::mat m2(6, 8, 9.8765f);
+		auto _m2 = m2.Get();
+
+		auto m3 = m1 * m2;
+		auto _m3 = m3.Get();
+
+		for (size_t i = 0; i < m1.nRows(); ++i)
+		{
+			for (size_t j = 0; j < m2.nCols(); ++j)
+			{
+				double m1m2 = 0.0;
+				for (size_t k = 0; k < m1.nCols(); ++k)
+					m1m2 += static_cast<double>(_m1[i + k * m1.nRows()] * _m2[k + j * m2.nRows()]);
+				ASSERT_TRUE(std::fabs(m1m2 - static_cast<double>(_m3[i + j * m1.nRows()])) <= 5e-5) << i << "|" << j << "|" << m1m2 << "|" << _m3[i + j * m1.nRows()];
+			}
+		}
+	}
+
+	TEST_F(GenericBlasSparseTests, Dot)
+	{
+		const auto A = GetBandedMatrix(3000, 1000, 32);
+		const auto _A = A.Get();
+		const gblas::dsmat sA(A);
+
+		const gblas::dvec x = gblas::dvec::RandomUniform(A.nCols(), 1234);
+		const auto _x = x.Get();
+
+		auto y = sA * x;
+		ASSERT_EQ(A.nRows(), y.size());
+		const auto _y = y.Get();
+
+		for (size_t i = 0; i < A.nRows(); ++i)
+		{
+			double expected = 0.0;
+			for (size_t j = 0; j < A.nCols(); ++j)
+				expected += _A[i + j * A.nRows()] * _x[j];
+			ASSERT_NEAR(expected, _y[i], 1e-10) << i;
+		}
+	}
+
+	TEST_F(GenericBlasSparseTests, DotTranspose)
+	{
+		const auto A = GetBandedMatrix(3000, 1000, 32);
+		const auto _A = A.Get();
+		const gblas::dsmat sA(A);
+
+		const gblas::dvec x = gblas::dvec::RandomUniform(A.nRows(), 1234);
+		const auto _x = x.Get();
+
+		auto y = sA.Dot(x, MatrixOperation::Transpose, 2.0);
+		ASSERT_EQ(A.nCols(), y.size());
+		const auto _y = y.Get();
+
+		for (size_t j = 0; j < A.nCols(); ++j)
+		{
+			double expected = 0.0;
+			for (size_t i = 0; i < A.nRows(); ++i)
+				expected += 2.0 * _A[i + j * A.nRows()] * _x[i];
+			ASSERT_NEAR(expected, _y[j], 1e-9) << j;
+		}
+	}
+
+	TEST_F(GenericBlasSparseTests, MultiplyTranspose)
+	{
+		const auto A = GetBandedMatrix(600, 200, 8);
+		const auto _A = A.Get();
+		const gblas::dsmat sA(A);
+
+		const gblas::dmat B = gblas::dmat::RandomUniform(A.nRows(), 16, 1234);
+		const auto _B = B.Get();
+
+		auto C = sA.Multiply(B, MatrixOperation::Transpose);
+		ASSERT_EQ(A.nCols(), C.nRows());
+		ASSERT_EQ(B.nCols(), C.nCols());
+		const auto _C = C.Get();
+
+		for (size_t i = 0; i < A.nCols(); ++i)
+		{
+			for (size_t j = 0; j < B.nCols(); ++j)
+			{
+				double expected = 0.0;
+				for (size_t k = 0; k < A.nRows(); ++k)
+					expected += _A[k + i * A.nRows()] * _B[k + j * B.nRows()];
+				ASSERT_NEAR(expected, _C[i + j * C.nRows()], 1e-10) << i << "|" << j;
+			}
+		}
+	}
+}	 // namespace clt
@@ -2,9 +2,12 @@
 #include <gtest/gtest.h>
 
 #include <ColumnWiseMatrix.h>
+#include <Tensor.h>
 #include <Vector.h>
 //#include <HostTensor.h>
 
+#include <BlasWrappers.h>
+#include <MemoryManager.h>
 #include <Exceptions.h>
 
 namespace clt
@@ -200,152 +203,152 @@ namespace clt
 			ASSERT_TRUE(std::fabs(_v3[i] - _v1[i] * _v2[i]) <= 1e-7f);
 	}
 
-	//	TEST_F(HostBlasTests, Multiply)
-	//	{
-	//		cl::test::mat m1(10, 10, 1.2345f);
-	//
-	//		auto _m1 = m1.Get();
-	//
-	//		cl::test::mat m2(10, 10, 9.8765f);
-	//
-	//		auto _m2 = m2.Get();
-	//
-	//		auto m3 = m1 * m2;
-	//
-	//		auto _m3 = m3.Get();
-	//
-	//		for (size_t i = 0; i < m1.nRows(); ++i)
-	//		{
-	//			for (size_t j = 0; j < m1.nCols(); ++j)
-	//			{
-	//				double m1m2 = 0.0;
-	//				for (size_t k = 0; k < m1.nCols(); ++k)
-	//					m1m2 += static_cast<double>(_m1[i + k * m1.nRows()] * _m2[k + j * m2.nRows()]);
-	//				ASSERT_TRUE(std::fabs(static_cast<float>(m1m2) - _m3[i + j * m1.nRows()]) <= 5e-5f);
-	//			}
-	//		}
-	//	}
-	//
-	//	TEST_F(HostBlasTests, SubMultiply)
-	//	{
-	//		cl::test::mat m1(10, 10, 1.2345f);
-	//
-	//		auto _m1 = m1.Get();
-	//
-	//		cl::test::mat m2(10, 10, 9.8765f);
-	//
-	//		auto _m2 = m2.Get();
-	//
-	//		cl::test::mat m3(m1.nRows(), m2.nCols(), -123456789.0f);
-	//		auto _initialM3 = m3.Get();
-	//
-	//		cl::test::mat m4 = m1 * m2;
-	//		auto _m4 = m4.Get();
-	//
-	//		const size_t rowStartM1 = 2;
-	//		const size_t nRowsM1 = 3;
-	//
-	//		const size_t colStartM1 = 4;
-	//		const size_t nColsM1 = 4;
-	//
-	//		const size_t rowStartM2 = 3;
-	//		const size_t colStartM2 = 3;
-	//		const size_t nColsM2 = 5;
-	//		m1.SubMultiply(m3, m2, rowStartM1, colStartM1, nRowsM1, nColsM1, colStartM2, nColsM2);
-	//
-	//		auto _m3 = m3.Get();
-	//
-	//		for (size_t i = rowStartM1; i < rowStartM1 + nRowsM1; ++i)
-	//		{
-	//			for (size_t j = colStartM2; j < colStartM2 + nColsM2; ++j)
-	//			{
-	//				double m1m2 = 0.0;
-	//				for (size_t k = 0; k < nColsM1; ++k)
-	//					m1m2 += static_cast<double>(_m1[i + (k + colStartM1) * m1.nRows()] * _m2[(k + rowStartM2) + j * m2.nRows()]);
-	//
-	//				ASSERT_NEAR(m1m2, _m3[i + j * m1.nRows()], 5e-5) << "i=" << i << "; j=" << j << "; idx=" << i + j * m1.nRows();
-	//			}
-	//		}
-	//
-	//		for (size_t i = 0; i < rowStartM1; ++i)
-	//			for (size_t j = 0; j < colStartM2; ++j)
-	//				ASSERT_NEAR(_initialM3[i + j * m1.nRows()], _m3[i + j * m1.nRows()], 5e-5);
-	//		for (size_t i = rowStartM1 + nRowsM1; i < m1.nRows(); ++i)
-	//			for (size_t j = colStartM2 + nColsM2; j < m1.nCols(); ++j)
-	//				ASSERT_NEAR(_initialM3[i + j * m1.nRows()], _m3[i + j * m1.nRows()], 5e-5);
-	//	}
+	TEST_F(HostBlasTests, Multiply)
+	{
+		cl::test::mat m1(10, 10, 1.2345f);
 
-	//	TEST_F(HostBlasTests, Dot)
-	//	{
-	//		cl::test::mat m1(10, 10, 1.2345f);
-	//
-	//		auto _m1 = m1.Get();
-	//
-	//		cl::test::vec v1(10, 9.8765f);
-	//
-	//		auto _v1 = v1.Get();
-	//
-	//		auto v2 = m1 * v1;
-	//
-	//		auto _v2 = v2.Get();
-	//
-	//		for (size_t i = 0; i < m1.nRows(); ++i)
-	//		{
-	//			double m1v1 = 0.0;
-	//			for (size_t j = 0; j < m1.nCols(); ++j)
-	//				m1v1 += static_cast<double>(_m1[i + j * m1.nRows()] * _v1[j]);
-	//			ASSERT_TRUE(std::fabs(static_cast<float>(m1v1) - _v2[i]) <= 5e-5f);
-	//		}
-	//	}
+		auto _m1 = m1.Get();
 
-	//	TEST_F(HostBlasTests, Invert)
-	//	{
-	//		cl::test::mat v = GetInvertibleMatrix(128);
-	//
-	//
-	//		cl::test::mat vMinus1(v);
-	//		vMinus1.Invert();
-	//
-	//
-	//		auto eye = v.Multiply(vMinus1);
-	//		auto _eye = eye.Get();
-	//		auto _v = v.Get();
-	//		auto _vMinus1 = vMinus1.Get();
-	//
-	//		for (size_t i = 0; i < v.nRows(); ++i)
-	//		{
-	//			for (size_t j = 0; j < v.nRows(); ++j)
-	//			{
-	//				float expected = i == j ? 1.0 : 0.0;
-	//				ASSERT_TRUE(std::fabs(_eye[i + v.nRows() * j] - expected) <= 5e-5f);
-	//			}
-	//		}
-	//	}
-	//
-	//	TEST_F(HostBlasTests, Solve)
-	//	{
-	//		cl::test::mat v = GetInvertibleMatrix(128);
-	//
-	//		auto _v = v.Get();
-	//
-	//		cl::test::mat u = GetInvertibleMatrix(v.nRows(), 2345);
-	//		auto _u = u.Get();
-	//		v.Solve(u);
-	//
-	//		auto _x = u.Get();
-	//
-	//		auto uSanity = v.Multiply(u);
-	//		auto _uSanity = uSanity.Get();
-	//
-	//		for (size_t i = 0; i < v.nRows(); ++i)
-	//		{
-	//			for (size_t j = 0; j < v.nRows(); ++j)
-	//			{
-	//				float expected = _u[i + v.nRows() * j];
-	//				ASSERT_TRUE(std::fabs(_uSanity[i + v.nRows() * j] - expected) <= 5e-5f);
-	//			}
-	//		}
-	//	}
+		cl::test::mat m2(10, 10, 9.8765f);
+
+		auto _m2 = m2.Get();
+
+		auto m3 = m1 * m2;
+
+		auto _m3 = m3.Get();
+
+		for (size_t i = 0; i < m1.nRows(); ++i)
+		{
+			for (size_t j = 0; j < m1.nCols(); ++j)
+			{
+				double m1m2 = 0.0;
+				for (size_t k = 0; k < m1.nCols(); ++k)
+					m1m2 += static_cast<double>(_m1[i + k * m1.nRows()] * _m2[k + j * m2.nRows()]);
+				ASSERT_TRUE(std::fabs(static_cast<float>(m1m2) - _m3[i + j * m1.nRows()]) <= 5e-5f);
+			}
+		}
+	}
+
+	TEST_F(HostBlasTests, SubMultiply)
+	{
+		cl::test::mat m1(10, 10, 1.2345f);
+
+		auto _m1 = m1.Get();
+
+		cl::test::mat m2(10, 10, 9.8765f);
+
+		auto _m2 = m2.Get();
+
+		cl::test::mat m3(m1.nRows(), m2.nCols(), -123456789.0f);
+		auto _initialM3 = m3.Get();
+
+		cl::test::mat m4 = m1 * m2;
+		auto _m4 = m4.Get();
+
+		const size_t rowStartM1 = 2;
+		const size_t nRowsM1 = 3;
+
+		const size_t colStartM1 = 4;
+		const size_t nColsM1 = 4;
+
+		const size_t rowStartM2 = 3;
+		const size_t colStartM2 = 3;
+		const size_t nColsM2 = 5;
+		m1.SubMultiply(m3, m2, rowStartM1, colStartM1, nRowsM1, nColsM1, colStartM2, nColsM2);
+
+		auto _m3 = m3.Get();
+
+		for (size_t i = rowStartM1; i < rowStartM1 + nRowsM1; ++i)
+		{
+			for (size_t j = colStartM2; j < colStartM2 + nColsM2; ++j)
+			{
+				double m1m2 = 0.0;
+				for (size_t k = 0; k < nColsM1; ++k)
+					m1m2 += static_cast<double>(_m1[i + (k + colStartM1) * m1.nRows()] * _m2[(k + rowStartM2) + j * m2.nRows()]);
+
+				ASSERT_NEAR(m1m2, _m3[i + j * m1.nRows()], 5e-5) << "i=" << i << "; j=" << j << "; idx=" << i + j * m1.nRows();
+			}
+		}
+
+		for (size_t i = 0; i < rowStartM1; ++i)
+			for (size_t j = 0; j < colStartM2; ++j)
+				ASSERT_NEAR(_initialM3[i + j * m1.nRows()], _m3[i + j * m1.nRows()], 5e-5);
+		for (size_t i = rowStartM1 + nRowsM1; i < m1.nRows(); ++i)
+			for (size_t j = colStartM2 + nColsM2; j < m1.nCols(); ++j)
+				ASSERT_NEAR(_initialM3[i + j * m1.nRows()], _m3[i + j * m1.nRows()], 5e-5);
+	}
+
+	TEST_F(HostBlasTests, Dot)
+	{
+		cl::test::mat m1(10, 10, 1.2345f);
+
+		auto _m1 = m1.Get();
+
+		cl::test::vec v1(10, 9.8765f);
+
+		auto _v1 = v1.Get();
+
+		auto v2 = m1 * v1;
+
+		auto _v2 = v2.Get();
+
+		for (size_t i = 0; i < m1.nRows(); ++i)
+		{
+			double m1v1 = 0.0;
+			for (size_t j = 0; j < m1.nCols(); ++j)
+				m1v1 += static_cast<double>(_m1[i + j * m1.nRows()] * _v1[j]);
+			ASSERT_TRUE(std::fabs(static_cast<float>(m1v1) - _v2[i]) <= 5e-5f);
+		}
+	}
+
+	TEST_F(HostBlasTests, Invert)
+	{
+		cl::test::mat v = GetInvertibleMatrix(128);
+
+
+		cl::test::mat vMinus1(v);
+		vMinus1.Invert();
+
+
+		auto eye = v.Multiply(vMinus1);
+		auto _eye = eye.Get();
+		auto _v = v.Get();
+		auto _vMinus1 = vMinus1.Get();
+
+		for (size_t i = 0; i < v.nRows(); ++i)
+		{
+			for (size_t j = 0; j < v.nRows(); ++j)
+			{
+				float expected = i == j ? 1.0 : 0.0;
+				ASSERT_TRUE(std::fabs(_eye[i + v.nRows() * j] - expected) <= 5e-5f);
+			}
+		}
+	}
+
+	TEST_F(HostBlasTests, Solve)
+	{
+		cl::test::mat v = GetInvertibleMatrix(128);
+
+		auto _v = v.Get();
+
+		cl::test::mat u = GetInvertibleMatrix(v.nRows(), 2345);
+		auto _u = u.Get();
+		v.Solve(u);
+
+		auto _x = u.Get();
+
+		auto uSanity = v.Multiply(u);
+		auto _uSanity = uSanity.Get();
+
+		for (size_t i = 0; i < v.nRows(); ++i)
+		{
+			for (size_t j = 0; j < v.nRows(); ++j)
+			{
+				float expected = _u[i + v.nRows() * j];
+				ASSERT_TRUE(std::fabs(_uSanity[i + v.nRows() * j] - expected) <= 5e-5f);
+			}
+		}
+	}
 
 	//	TEST_F(HostBlasTests, KroneckerProduct)
 	//	{
@@ -567,64 +570,91 @@ namespace clt
 		ASSERT_EQ(w.CountEquals(v), 0);
 	}
 
-	//	TEST_F(HostBlasTests, TransposeMultiply)
-	//	{
-	//		cl::test::mat A(64, 128);
-	//		A.RandomUniform();
-	//
-	//		cl::test::mat B(64, 32);  // for A^T * B
-	//		B.RandomUniform();
-	//
-	//		cl::test::mat C(16, 128);  // for A * C^T
-	//		C.RandomUniform();
-	//
-	//		cl::test::mat D(32, 64);  // for A^T * D^T
-	//		D.RandomUniform();
-	//
-	//		auto ATB  = A.Multiply(B, MatrixOperation::Transpose, MatrixOperation::None);
-	//		auto ACT  = A.Multiply(C, MatrixOperation::None, MatrixOperation::Transpose);
-	//		auto ATDT = A.Multiply(D, MatrixOperation::Transpose, MatrixOperation::Transpose);
-	//
-	//		auto _A = A.Get();
-	//		auto _B = B.Get();
-	//		auto _C = C.Get();
-	//		auto _D = D.Get();
-	//
-	//		auto _ATB = ATB.Get();
-	//		auto _ACT = ACT.Get();
-	//		auto _ATDT = ATDT.Get();
-	//
-	//		for (size_t i = 0; i < A.nRows(); ++i)
-	//		{
-	//			for (size_t j = 0; j < B.nCols(); ++j)
-	//			{
-	//				double goldenATB = 0.0;
-	//				for (size_t k = 0; k < A.nRows(); ++k)
-	//					goldenATB += static_cast<double>(_A[k + i * A.nRows()] * _B[k + j * B.nRows()]);
-	//				ASSERT_NEAR(goldenATB / static_cast<double>(_ATB[i + j * ATB.nRows()]), 1.0, 5e-7);
-	//			}
-	//		}
-	//
-	//		for (size_t i = 0; i < A.nRows(); ++i)
-	//		{
-	//			for (size_t j = 0; j < C.nRows(); ++j)
-	//			{
-	//				double goldenACT = 0.0;
-	//				for (size_t k = 0; k < A.nCols(); ++k)
-	//					goldenACT += static_cast<double>(_A[i + k * A.nRows()] * _C[j + k * C.nRows()]);
-	//				ASSERT_NEAR(goldenACT / static_cast<double>(_ACT[i + j * ACT.nRows()]), 1.0, 5e-7);
-	//			}
-	//		}
-	//
-	//		for (size_t i = 0; i < A.nCols(); ++i)
-	//		{
-	//			for (size_t j = 0; j < D.nRows(); ++j)
-	//			{
-	//				double goldenATDT = 0.0;
-	//				for (size_t k = 0; k < A.nRows(); ++k)
-	//					goldenATDT += static_cast<double>(_A[k + i * A.nRows()] * _D[j + k * D.nRows()]);
-	//				ASSERT_NEAR(goldenATDT / static_cast<double>(_ATDT[i + j * ATDT.nRows()]), 1.0, 5e-7);
-	//			}
-	//		}
-	//	}
+	TEST_F(HostBlasTests, CubeWiseSum)
+	{
+		// nCols != nMatrices: CubeWiseSum batches one product per column
+		const auto T = cl::test::dten::RandomUniform(16, 12, 5, 1234);
+		const auto _T = T.Get();
+
+		cl::test::dmat out(T.nRows(), T.nCols(), -1.0);
+		MemoryCube cacheReshape;
+		MemoryBuffer cacheOnes;
+		cl::routines::CubeWiseSum(out.GetTile(), T.GetCube(), cacheReshape, cacheOnes);
+		const auto _out = out.Get();
+
+		for (size_t i = 0; i < T.nRows(); ++i)
+		{
+			for (size_t j = 0; j < T.nCols(); ++j)
+			{
+				double golden = 0.0;
+				for (size_t k = 0; k < T.nMatrices(); ++k)
+					golden += _T[i + j * T.nRows() + k * T.nRows() * T.nCols()];
+				ASSERT_NEAR(golden, _out[i + j * T.nRows()], 1e-12) << "i=" << i << "; j=" << j;
+			}
+		}
+
+		cl::routines::Free(cacheReshape);
+		cl::routines::Free(cacheOnes);
+	}
+
+	TEST_F(HostBlasTests, TransposeMultiply)
+	{
+		cl::test::mat A(64, 128);
+		A.RandomUniform();
+
+		cl::test::mat B(64, 32);  // for A^T * B
+		B.RandomUniform();
+
+		cl::test::mat C(16, 128);  // for A * C^T
+		C.RandomUniform();
+
+		cl::test::mat D(32, 64);  // for A^T * D^T
+		D.RandomUniform();
+
+		auto ATB  = A.Multiply(B, MatrixOperation::Transpose, MatrixOperation::None);
+		auto ACT  = A.Multiply(C, MatrixOperation::None, MatrixOperation::Transpose);
+		auto ATDT = A.Multiply(D, MatrixOperation::Transpose, MatrixOperation::Transpose);
+
+		auto _A = A.Get();
+		auto _B = B.Get();
+		auto _C = C.Get();
+		auto _D = D.Get();
+
+		auto _ATB = ATB.Get();
+		auto _ACT = ACT.Get();
+		auto _ATDT = ATDT.Get();
+
+		for (size_t i = 0; i < A.nRows(); ++i)
+		{
+			for (size_t j = 0; j < B.nCols(); ++j)
+			{
+				double goldenATB = 0.0;
+				for (size_t k = 0; k < A.nRows(); ++k)
+					goldenATB += static_cast<double>(_A[k + i * A.nRows()] * _B[k + j * B.nRows()]);
+				ASSERT_NEAR(goldenATB / static_cast<double>(_ATB[i + j * ATB.nRows()]), 1.0, 5e-7);
+			}
+		}
+
+		for (size_t i = 0; i < A.nRows(); ++i)
+		{
+			for (size_t j = 0; j < C.nRows(); ++j)
+			{
+				double goldenACT = 0.0;
+				for (size_t k = 0; k < A.nCols(); ++k)
+					goldenACT += static_cast<double>(_A[i + k * A.nRows()] * _C[j + k * C.nRows()]);
+				ASSERT_NEAR(goldenACT / static_cast<double>(_ACT[i + j * ACT.nRows()]), 1.0, 5e-7);
+			}
+		}
+
+		for (size_t i = 0; i < A.nCols(); ++i)
+		{
+			for (size_t j = 0; j < D.nRows(); ++j)
+			{
+				double goldenATDT = 0.0;
+				for (size_t k = 0; k < A.nRows(); ++k)
+					goldenATDT += static_cast<double>(_A[k + i * A.nRows()] * _D[j + k * D.nRows()]);
+				ASSERT_NEAR(goldenATDT / static_cast<double>(_ATDT[i + j * ATDT.nRows()]), 1.0, 5e-7);
+			}
+		}
+	}
 }	 // namespace clt
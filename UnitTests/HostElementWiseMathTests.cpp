@@ -0,0 +1,158 @@
+#include <gtest/gtest.h>
+
+#include <HostRoutines/ElementWiseMath.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+namespace clt
+{
+	class HostElementWiseMathTests: public ::testing::Test
+	{
+	};
+
+	using cl::routines::ElementWiseFunction;
+
+	static std::vector<float> GetLinSpace(const float x0, const float x1, const size_t size)
+	{
+		std::vector<float> x(size);
+		for (size_t i = 0; i < size; ++i)
+			x[i] = x0 + (x1 - x0) * static_cast<float>(i) / static_cast<float>(size - 1);
+
+		return x;
+	}
+
+	// a sample of all the positive finite floats, denormals included
+	static std::vector<float> GetPositiveFloats()
+	{
+		std::vector<float> x;
+		for (uint32_t bits = 1; bits < 0x7F800000; bits += 1009)
+		{
+			float value;
+			std::memcpy(&value, &bits, sizeof(float));
+			x.push_back(value);
+		}
+
+		return x;
+	}
+
+	/**
+	 * Compares with the double precision function, relatively: the absolute tolerance is scaled to FLT_MIN for results that underflow
+	 */
+	template<typename F>
+	static void CheckFunction(const ElementWiseFunction function, const std::vector<float>& x, const F& f, const double tolerance, const double exponent = 1.0)
+	{
+		std::vector<float> y(x.size());
+		cl::routines::elementwise::Apply(y.data(), x.data(), x.size(), function, exponent);
+
+		for (size_t i = 0; i < x.size(); ++i)
+		{
+			const double expected = f(static_cast<double>(x[i]));
+			const auto reference = static_cast<float>(expected);
+			if (std::isnan(reference))
+				ASSERT_TRUE(std::isnan(y[i])) << x[i];
+			else if (std::isinf(reference))
+				ASSERT_EQ(reference, y[i]) << x[i];
+			else
+				ASSERT_NEAR(expected, y[i], tolerance * std::max(std::fabs(expected), static_cast<double>(std::numeric_limits<float>::min()))) << x[i];
+		}
+	}
+
+	TEST_F(HostElementWiseMathTests, Exp)
+	{
+		// past both the overflow and the underflow thresholds
+		CheckFunction(ElementWiseFunction::Exp, GetLinSpace(-110.0f, 95.0f, 1000003), [](const double x) { return std::exp(x); }, 5e-7);
+		CheckFunction(ElementWiseFunction::Exp, GetLinSpace(-1e-3f, 1e-3f, 1001), [](const double x) { return std::exp(x); }, 5e-7);
+
+		const float inf = std::numeric_limits<float>::infinity();
+		CheckFunction(ElementWiseFunction::Exp, { -inf, inf, std::nanf(""), 0.0f }, [](const double x) { return std::exp(x); }, 0.0);
+	}
+
+	TEST_F(HostElementWiseMathTests, Log)
+	{
+		CheckFunction(ElementWiseFunction::Log, GetPositiveFloats(), [](const double x) { return std::log(x); }, 5e-7);
+		CheckFunction(ElementWiseFunction::Log, GetLinSpace(0.5f, 2.0f, 100003), [](const double x) { return std::log(x); }, 5e-7);
+
+		const float inf = std::numeric_limits<float>::infinity();
+		CheckFunction(ElementWiseFunction::Log, { 0.0f, -0.0f, -1.0f, -inf, inf, std::nanf(""), 1.0f }, [](const double x) { return std::log(x); }, 0.0);
+	}
+
+	TEST_F(HostElementWiseMathTests, Sqrt)
+	{
+		CheckFunction(ElementWiseFunction::Sqrt, GetPositiveFloats(), [](const double x) { return std::sqrt(x); }, 1e-7);
+
+		const float inf = std::numeric_limits<float>::infinity();
+		CheckFunction(ElementWiseFunction::Sqrt, { 0.0f, -1.0f, inf, std::nanf("") }, [](const double x) { return std::sqrt(x); }, 0.0);
+	}
+
+	TEST_F(HostElementWiseMathTests, Pow)
+	{
+		const auto x = GetLinSpace(0.01f, 10.0f, 100003);
+		const auto negativeX = GetLinSpace(-3.0f, 3.0f, 100003);
+		for (const double exponent : { 2.5, -1.5, 0.5, 0.0, 1.0, 2.0, -3.0, 7.0, 64.0 })
+			CheckFunction(ElementWiseFunction::Pow, x, [exponent](const double x) { return std::pow(x, exponent); }, 1e-5, exponent);
+
+		// integer exponents keep the sign of negative numbers, the others give NaN
+		for (const double exponent : { 3.0, -2.0, 65.0, 66.0, 2.5 })
+			CheckFunction(ElementWiseFunction::Pow, negativeX, [exponent](const double x) { return std::pow(x, exponent); }, 1e-5, exponent);
+
+		CheckFunction(ElementWiseFunction::Pow, { 0.0f, 1.0f, std::numeric_limits<float>::infinity() }, [](const double x) { return std::pow(x, -1.5); }, 0.0, -1.5);
+	}
+
+	TEST_F(HostElementWiseMathTests, Tanh)
+	{
+		CheckFunction(ElementWiseFunction::Tanh, GetLinSpace(-12.0f, 12.0f, 1000003), [](const double x) { return std::tanh(x); }, 5e-7);
+		CheckFunction(ElementWiseFunction::Tanh, GetLinSpace(-1e-3f, 1e-3f, 1001), [](const double x) { return std::tanh(x); }, 5e-7);
+
+		const float inf = std::numeric_limits<float>::infinity();
+		CheckFunction(ElementWiseFunction::Tanh, { -inf, inf, std::nanf(""), 0.0f }, [](const double x) { return std::tanh(x); }, 0.0);
+	}
+
+	TEST_F(HostElementWiseMathTests, Erf)
+	{
+		CheckFunction(ElementWiseFunction::Erf, GetLinSpace(-6.0f, 6.0f, 1000003), [](const double x) { return std::erf(x); }, 1e-6);
+		CheckFunction(ElementWiseFunction::Erf, GetLinSpace(-1e-3f, 1e-3f, 1001), [](const double x) { return std::erf(x); }, 1e-6);
+
+		const float inf = std::numeric_limits<float>::infinity();
+		CheckFunction(ElementWiseFunction::Erf, { -inf, inf, std::nanf(""), 0.0f }, [](const double x) { return std::erf(x); }, 0.0);
+	}
+
+	TEST_F(HostElementWiseMathTests, InPlace)
+	{
+		// odd sizes go through the remainder of the vector loops
+		for (const size_t size : { size_t(2), size_t(7), size_t(33), size_t(100003) })
+		{
+			const auto x = GetLinSpace(-2.0f, 2.0f, size);
+			std::vector<float> y(size);
+			cl::routines::elementwise::Apply(y.data(), x.data(), size, ElementWiseFunction::Tanh);
+
+			auto z = x;
+			cl::routines::elementwise::Apply(z.data(), z.data(), size, ElementWiseFunction::Tanh);
+			ASSERT_EQ(y, z) << size;
+		}
+	}
+
+	TEST_F(HostElementWiseMathTests, Double)
+	{
+		std::vector<double> x(10007);
+		for (size_t i = 0; i < x.size(); ++i)
+			x[i] = 0.001 + 0.01 * static_cast<double>(i);
+
+		std::vector<double> y(x.size());
+		cl::routines::elementwise::Apply(y.data(), x.data(), x.size(), ElementWiseFunction::Sqrt);
+		for (size_t i = 0; i < x.size(); ++i)
+			ASSERT_EQ(std::sqrt(x[i]), y[i]);
+
+		cl::routines::elementwise::Apply(y.data(), x.data(), x.size(), ElementWiseFunction::Log);
+		for (size_t i = 0; i < x.size(); ++i)
+			ASSERT_DOUBLE_EQ(std::log(x[i]), y[i]);
+
+		cl::routines::elementwise::Apply(y.data(), x.data(), x.size(), ElementWiseFunction::Pow, 1.7);
+		for (size_t i = 0; i < x.size(); ++i)
+			ASSERT_DOUBLE_EQ(std::pow(x[i], 1.7), y[i]);
+	}
+}	 // namespace clt
@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+
+#include <ColumnWiseMatrix.h>
+#include <Expression.h>
+#include <Vector.h>
+
+namespace clt
+{
+	class HostExpressionTests: public ::testing::Test
+	{
+	};
+
+	TEST_F(HostExpressionTests, FusedVectorExpression)
+	{
+		const cl::test::vec a = cl::test::vec::RandomUniform(1000, 1234);
+		const cl::test::vec b = cl::test::vec::RandomUniform(1000, 2345);
+		const cl::test::vec c = cl::test::vec::RandomUniform(1000, 3456);
+		const cl::test::vec d = cl::test::vec::RandomUniform(1000, 4567);
+
+		cl::test::vec out(1000, 0.0f);
+		cl::Assign(out, cl::Lazy(a) + cl::Lazy(b) % c - d);
+
+		// same result as the eager operators
+		const auto expected = (a + b % c - d).Get();
+		const auto _out = out.Get();
+		for (size_t i = 0; i < _out.size(); ++i)
+			ASSERT_FLOAT_EQ(expected[i], _out[i]) << i;
+	}
+
+	TEST_F(HostExpressionTests, ScaledExpression)
+	{
+		const cl::test::dvec a = cl::test::dvec::RandomUniform(100, 1234);
+		const cl::test::dvec b = cl::test::dvec::RandomUniform(100, 2345);
+
+		cl::test::dvec out(100, 0.0);
+		cl::Assign(out, 2.0 * cl::Lazy(a) - cl::Lazy(b) * 0.5);
+
+		const auto _a = a.Get();
+		const auto _b = b.Get();
+		const auto _out = out.Get();
+		for (size_t i = 0; i < _out.size(); ++i)
+			ASSERT_DOUBLE_EQ(2.0 * _a[i] - 0.5 * _b[i], _out[i]) << i;
+	}
+
+	TEST_F(HostExpressionTests, AssignToOperand)
+	{
+		cl::test::dvec a(100, 1.0);
+		const cl::test::dvec b = cl::test::dvec::LinSpace(0.0, 99.0, 100);
+
+		cl::Assign(a, a + cl::Lazy(b) % b);
+
+		const auto _a = a.Get();
+		for (size_t i = 0; i < _a.size(); ++i)
+			ASSERT_DOUBLE_EQ(1.0 + static_cast<double>(i * i), _a[i]) << i;
+	}
+
+	TEST_F(HostExpressionTests, FusedMatrixExpression)
+	{
+		const cl::test::mat a = cl::test::mat::RandomUniform(30, 20, 1234);
+		const cl::test::mat b = cl::test::mat::RandomUniform(30, 20, 2345);
+
+		cl::test::mat out(30, 20, 0.0f);
+		cl::Assign(out, cl::Lazy(a) % a - b);
+
+		const auto expected = (a % a - b).Get();
+		const auto _out = out.Get();
+		for (size_t i = 0; i < _out.size(); ++i)
+			ASSERT_FLOAT_EQ(expected[i], _out[i]) << i;
+	}
+
+	TEST_F(HostExpressionTests, IntegerExpression)
+	{
+		const cl::test::ivec a(50, 3);
+		const cl::test::ivec b(50, 4);
+
+		cl::test::ivec out(50, 0);
+		cl::Assign(out, cl::Lazy(a) % b + a);
+
+		const auto _out = out.Get();
+		for (const auto& iter : _out)
+			ASSERT_EQ(15, iter);
+	}
+
+	TEST_F(HostExpressionTests, AssignToMatrixView)
+	{
+		cl::test::dmat m = cl::test::dmat::RandomUniform(10, 8, 1234);
+		const cl::test::dmat original(m);
+		const cl::test::dmat a = cl::test::dmat::RandomUniform(4, 3, 2345);
+
+		// the view is strided, so the expression is evaluated column by column
+		cl::test::dmat view(m, 2, 4, 1, 3);
+		cl::Assign(view, cl::Lazy(a) % a + a);
+
+		const auto expected = (a % a + a).Get();
+		const auto _view = view.Get();
+		for (size_t i = 0; i < _view.size(); ++i)
+			ASSERT_DOUBLE_EQ(expected[i], _view[i]) << i;
+
+		const auto _m = m.Get();
+		const auto _original = original.Get();
+		for (size_t i = 0; i < m.nRows(); ++i)
+		{
+			for (size_t j = 0; j < m.nCols(); ++j)
+			{
+				const bool inView = i >= 2 && i < 6 && j >= 1 && j < 4;
+				if (!inView)
+				{
+					ASSERT_DOUBLE_EQ(_original[i + j * m.nRows()], _m[i + j * m.nRows()]);
+				}
+			}
+		}
+	}
+}	 // namespace clt
@@ -0,0 +1,222 @@
+#include <gtest/gtest.h>
+
+#include <CompressedSparseRowMatrix.h>
+#include <Exceptions.h>
+#include <IterativeSolver.h>
+#include <Vector.h>
+
+#include <cmath>
+#include <vector>
+
+namespace clt
+{
+	class HostIterativeSolverTests: public ::testing::Test
+	{
+	protected:
+		/**
+		 * 5-point Laplacian on a n x n grid, plus shift * I: symmetric positive definite
+		 */
+		static std::vector<double> GetPoisson(const size_t n, const double shift = 0.0)
+		{
+			const size_t size = n * n;
+			std::vector<double> ret(size * size, 0.0);
+			for (size_t i = 0; i < n; ++i)
+			{
+				for (size_t j = 0; j < n; ++j)
+				{
+					const size_t row = i + j * n;
+					ret[row + row * size] = 4.0 + shift;
+					if (i > 0)
+						ret[row + (row - 1) * size] = -1.0;
+					if (i + 1 < n)
+						ret[row + (row + 1) * size] = -1.0;
+					if (j > 0)
+						ret[row + (row - n) * size] = -1.0;
+					if (j + 1 < n)
+						ret[row + (row + n) * size] = -1.0;
+				}
+			}
+			return ret;
+		}
+
+		/**
+		 * Adds a convection term to the Laplacian, so that it's no longer symmetric
+		 */
+		static std::vector<double> GetConvectionDiffusion(const size_t n)
+		{
+			auto ret = GetPoisson(n);
+			const size_t size = n * n;
+			for (size_t row = 1; row < size; ++row)
+				ret[row + (row - 1) * size] -= 0.5;
+			return ret;
+		}
+
+		static void CheckSolution(const std::vector<double>& A, const size_t size, const cl::test::dvec& x, const cl::test::dvec& b, const double tolerance)
+		{
+			const auto _x = x.Get();
+			const auto _b = b.Get();
+
+			double residual = 0.0;
+			double bNorm = 0.0;
+			for (size_t i = 0; i < size; ++i)
+			{
+				double Ax = 0.0;
+				for (size_t j = 0; j < size; ++j)
+					Ax += A[i + j * size] * _x[j];
+				residual += (_b[i] - Ax) * (_b[i] - Ax);
+				bNorm += _b[i] * _b[i];
+			}
+
+			ASSERT_LE(std::sqrt(residual), tolerance * std::sqrt(bNorm));
+		}
+
+		void Solve(const std::vector<double>& A, const size_t size, const cl::IterativeSolverType solver, const cl::PreconditionerType preconditioner, unsigned& nIterations)
+		{
+			const cl::test::dsmat sA(A, size, size);
+			const cl::test::dvec b = cl::test::dvec::RandomUniform(static_cast<unsigned>(size), 1234);
+			cl::test::dvec x(static_cast<unsigned>(size), 0.0);
+
+			cl::IterativeSolverOptions options;
+			options.tolerance = 1e-10;
+			options.maxIterations = 2000;
+			cl::test::dkrylov krylov(sA, solver, preconditioner, options);
+
+			const auto result = krylov.Solve(x, b);
+			ASSERT_TRUE(result.converged);
+			ASSERT_GT(result.nIterations, 0u);
+			ASSERT_LE(result.relativeResidual, options.tolerance);
+
+			// the recurrences can drift a little from the true residual
+			CheckSolution(A, size, x, b, 1e-8);
+			nIterations = result.nIterations;
+		}
+	};
+
+	TEST_F(HostIterativeSolverTests, ConjugateGradient)
+	{
+		const size_t n = 12;
+		const auto A = GetPoisson(n);
+
+		unsigned nIterations = 0;
+		unsigned nJacobiIterations = 0;
+		unsigned nIluIterations = 0;
+		Solve(A, n * n, cl::IterativeSolverType::ConjugateGradient, cl::PreconditionerType::None, nIterations);
+		Solve(A, n * n, cl::IterativeSolverType::ConjugateGradient, cl::PreconditionerType::Jacobi, nJacobiIterations);
+		Solve(A, n * n, cl::IterativeSolverType::ConjugateGradient, cl::PreconditionerType::IncompleteLu, nIluIterations);
+
+		// ILU(0) of a symmetric matrix is its incomplete Cholesky factorization
+		ASSERT_LT(nIluIterations, nIterations);
+	}
+
+	TEST_F(HostIterativeSolverTests, BiConjugateGradientStabilized)
+	{
+		const size_t n = 12;
+		const auto A = GetConvectionDiffusion(n);
+
+		unsigned nIterations = 0;
+		unsigned nIluIterations = 0;
+		Solve(A, n * n, cl::IterativeSolverType::BiConjugateGradientStabilized, cl::PreconditionerType::None, nIterations);
+		Solve(A, n * n, cl::IterativeSolverType::BiConjugateGradientStabilized, cl::PreconditionerType::Jacobi, nIterations);
+		Solve(A, n * n, cl::IterativeSolverType::BiConjugateGradientStabilized, cl::PreconditionerType::IncompleteLu, nIluIterations);
+	}
+
+	TEST_F(HostIterativeSolverTests, Gmres)
+	{
+		const size_t n = 12;
+		const auto A = GetConvectionDiffusion(n);
+
+		unsigned nIterations = 0;
+		unsigned nIluIterations = 0;
+		Solve(A, n * n, cl::IterativeSolverType::Gmres, cl::PreconditionerType::None, nIterations);
+		Solve(A, n * n, cl::IterativeSolverType::Gmres, cl::PreconditionerType::Jacobi, nIterations);
+		Solve(A, n * n, cl::IterativeSolverType::Gmres, cl::PreconditionerType::IncompleteLu, nIluIterations);
+		ASSERT_LT(nIluIterations, nIterations);
+	}
+
+	TEST_F(HostIterativeSolverTests, GmresRestart)
+	{
+		const size_t n = 8;
+		const auto A = GetConvectionDiffusion(n);
+		const cl::test::dsmat sA(A, n * n, n * n);
+		const cl::test::dvec b(n * n, 1.0);
+
+		cl::IterativeSolverOptions options;
+		options.tolerance = 1e-8;
+		options.restart = 10;
+		cl::test::dkrylov krylov(sA, cl::IterativeSolverType::Gmres, cl::PreconditionerType::None, options);
+
+		cl::test::dvec x(n * n, 0.0);
+		const auto result = krylov.Solve(x, b);
+		ASSERT_TRUE(result.converged);
+		ASSERT_GT(result.nIterations, options.restart);
+		CheckSolution(A, n * n, x, b, 1e-8);
+
+		// a second solve starting from the solution has nothing to do
+		const auto again = krylov.Solve(x, b);
+		ASSERT_TRUE(again.converged);
+		ASSERT_EQ(0u, again.nIterations);
+	}
+
+	TEST_F(HostIterativeSolverTests, MaxIterations)
+	{
+		const size_t n = 12;
+		const auto A = GetPoisson(n);
+		const cl::test::dsmat sA(A, n * n, n * n);
+		const cl::test::dvec b(n * n, 1.0);
+
+		cl::IterativeSolverOptions options;
+		options.tolerance = 1e-12;
+		options.maxIterations = 3;
+		for (const auto solver : { cl::IterativeSolverType::ConjugateGradient, cl::IterativeSolverType::BiConjugateGradientStabilized, cl::IterativeSolverType::Gmres })
+		{
+			cl::test::dkrylov krylov(sA, solver, cl::PreconditionerType::Jacobi, options);
+			cl::test::dvec x(n * n, 0.0);
+			const auto result = krylov.Solve(x, b);
+			ASSERT_FALSE(result.converged);
+			ASSERT_EQ(options.maxIterations, result.nIterations);
+			ASSERT_GT(result.relativeResidual, options.tolerance);
+		}
+	}
+
+	TEST_F(HostIterativeSolverTests, ZeroRightHandSide)
+	{
+		const size_t n = 4;
+		const cl::test::dsmat sA(GetPoisson(n), n * n, n * n);
+		const cl::test::dvec b(n * n, 0.0);
+		cl::test::dvec x(n * n, 1.0);
+
+		cl::test::dkrylov krylov(sA, cl::IterativeSolverType::ConjugateGradient);
+		const auto result = krylov.Solve(x, b);
+		ASSERT_TRUE(result.converged);
+		for (const double xi : x.Get())
+			ASSERT_EQ(0.0, xi);
+	}
+
+	TEST_F(HostIterativeSolverTests, IncompleteLuOfTridiagonal)
+	{
+		// no fill-in: ILU(0) is the exact LU factorization, and the preconditioned solvers converge straight away
+		const size_t size = 50;
+		std::vector<double> A(size * size, 0.0);
+		for (size_t i = 0; i < size; ++i)
+		{
+			A[i + i * size] = 3.0 + static_cast<double>(i % 5);
+			if (i > 0)
+				A[i + (i - 1) * size] = -1.0;
+			if (i + 1 < size)
+				A[i + (i + 1) * size] = -2.0;
+		}
+
+		unsigned nIterations = 0;
+		Solve(A, size, cl::IterativeSolverType::Gmres, cl::PreconditionerType::IncompleteLu, nIterations);
+		ASSERT_EQ(1u, nIterations);
+		Solve(A, size, cl::IterativeSolverType::BiConjugateGradientStabilized, cl::PreconditionerType::IncompleteLu, nIterations);
+		ASSERT_EQ(1u, nIterations);
+	}
+
+	TEST_F(HostIterativeSolverTests, IncompleteLuZeroPivot)
+	{
+		std::vector<double> A = { 0.0, 1.0, 1.0, 0.0 };
+		const cl::test::dsmat sA(A, 2, 2);
+		ASSERT_THROW(cl::test::dkrylov(sA, cl::IterativeSolverType::Gmres, cl::PreconditionerType::IncompleteLu), cl::FactorizationException);
+	}
+}	 // namespace clt
@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+
+#include <HostRoutines/MemoryPool.h>
+#include <Vector.h>
+
+#include <thread>
+
+namespace clt
+{
+	class HostMemoryPoolTests: public ::testing::Test
+	{
+	};
+
+	TEST_F(HostMemoryPoolTests, RecycleSameSize)
+	{
+		cl::routines::pool::Trim();
+		cl::routines::pool::ResetStatistics();
+
+		for (size_t i = 0; i < 10; ++i)
+		{
+			cl::test::vec v1(1000, 1.0f);
+			cl::test::vec v2(1000, 2.0f);
+			auto v3 = v1 + v2;
+
+			auto _v3 = v3.Get();
+			for (const auto& iter : _v3)
+				ASSERT_FLOAT_EQ(3.0f, iter);
+		}
+
+		const auto statistics = cl::routines::pool::GetStatistics();
+		if (!cl::routines::pool::IsEnabled())
+		{
+			ASSERT_EQ(0u, statistics.hits + statistics.misses);
+			return;
+		}
+
+		// only the first iteration goes to the system allocator
+		ASSERT_EQ(3u, statistics.misses);
+		ASSERT_EQ(27u, statistics.hits);
+		ASSERT_EQ(3u, statistics.cachedBlocks);
+		ASSERT_GT(statistics.HitRate(), 0.8);
+	}
+
+	TEST_F(HostMemoryPoolTests, SizeClassRounding)
+	{
+		if (!cl::routines::pool::IsEnabled())
+			return;
+
+		cl::routines::pool::Trim();
+		cl::routines::pool::ResetStatistics();
+
+		{
+			cl::test::dvec v1(1000, 0.0);
+		}
+		{
+			// 1000 and 1010 doubles fall in the same size class
+			cl::test::dvec v2(1010, 1.0);
+			auto _v2 = v2.Get();
+			for (const auto& iter : _v2)
+				ASSERT_DOUBLE_EQ(1.0, iter);
+		}
+
+		const auto statistics = cl::routines::pool::GetStatistics();
+		ASSERT_EQ(1u, statistics.misses);
+		ASSERT_EQ(1u, statistics.hits);
+	}
+
+	TEST_F(HostMemoryPoolTests, HighWaterMarkAndTrim)
+	{
+		if (!cl::routines::pool::IsEnabled())
+			return;
+
+		cl::routines::pool::Trim();
+		cl::routines::pool::ResetStatistics();
+
+		const size_t highWaterMark = cl::routines::pool::GetHighWaterMark();
+		cl::routines::pool::SetHighWaterMark(0);
+		{
+			cl::test::vec v(128, 0.0f);
+		}
+		auto statistics = cl::routines::pool::GetStatistics();
+		ASSERT_EQ(1u, statistics.evictions);
+		ASSERT_EQ(0u, statistics.cachedBytes);
+
+		cl::routines::pool::SetHighWaterMark(highWaterMark);
+		{
+			cl::test::vec v(128, 0.0f);
+		}
+		statistics = cl::routines::pool::GetStatistics();
+		ASSERT_EQ(1u, statistics.cachedBlocks);
+		ASSERT_GE(statistics.cachedBytes, 128 * sizeof(float));
+
+		cl::routines::pool::Trim();
+		statistics = cl::routines::pool::GetStatistics();
+		ASSERT_EQ(0u, statistics.cachedBlocks);
+		ASSERT_EQ(0u, statistics.cachedBytes);
+	}
+
+	TEST_F(HostMemoryPoolTests, PerThreadCaches)
+	{
+		if (!cl::routines::pool::IsEnabled())
+			return;
+
+		cl::routines::pool::Trim();
+		cl::routines::pool::ResetStatistics();
+
+		std::thread worker([]() {
+			for (size_t i = 0; i < 4; ++i)
+				cl::test::dvec v(256, 1.0);
+		});
+		worker.join();
+
+		// worker's cache is given back when the thread exits, but its counters are retained
+		const auto statistics = cl::routines::pool::GetStatistics();
+		ASSERT_EQ(1u, statistics.misses);
+		ASSERT_EQ(3u, statistics.hits);
+		ASSERT_EQ(0u, statistics.cachedBlocks);
+	}
+}	 // namespace clt
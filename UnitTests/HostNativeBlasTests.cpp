@@ -0,0 +1,235 @@
+#include <gtest/gtest.h>
+
+#include <HostRoutines/NativeBlas.h>
+#include <ColumnWiseMatrix.h>
+#include <Exceptions.h>
+#include <Factorization.h>
+#include <Vector.h>
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace clt
+{
+	class HostNativeBlasTests: public ::testing::Test
+	{
+	protected:
+		template<typename T>
+		static std::vector<T> Random(const size_t size, const unsigned seed)
+		{
+			std::vector<T> ret(size);
+			unsigned state = seed;
+			for (auto& x : ret)
+			{
+				state = state * 1664525u + 1013904223u;
+				x = static_cast<T>(state >> 8) / static_cast<T>(1 << 24) - T(0.5);
+			}
+			return ret;
+		}
+
+		// op(A)[i, j] with A column major
+		template<typename T>
+		static T At(const std::vector<T>& A, const size_t lda, const MatrixOperation operation, const size_t i, const size_t j)
+		{
+			return operation == MatrixOperation::None ? A[i + j * lda] : A[j + i * lda];
+		}
+
+		template<typename T>
+		static void CheckGemm(const MatrixOperation aOperation, const MatrixOperation bOperation, const size_t m, const size_t n, const size_t k, const T alpha, const T beta, const double tolerance)
+		{
+			// leading dimensions bigger than the number of rows exercise the strided access
+			const size_t lda = (aOperation == MatrixOperation::None ? m : k) + 3;
+			const size_t ldb = (bOperation == MatrixOperation::None ? k : n) + 1;
+			const size_t ldc = m + 2;
+
+			const auto A = Random<T>(lda * (aOperation == MatrixOperation::None ? k : m), 1);
+			const auto B = Random<T>(ldb * (bOperation == MatrixOperation::None ? n : k), 2);
+			auto C = Random<T>(ldc * n, 3);
+			const auto C0 = C;
+
+			cl::routines::nbr::Gemm(aOperation, bOperation, m, n, k, alpha, A.data(), lda, B.data(), ldb, beta, C.data(), ldc);
+
+			for (size_t i = 0; i < m; ++i)
+			{
+				for (size_t j = 0; j < n; ++j)
+				{
+					double golden = 0.0;
+					for (size_t l = 0; l < k; ++l)
+						golden += static_cast<double>(At(A, lda, aOperation, i, l)) * static_cast<double>(At(B, ldb, bOperation, l, j));
+					golden = static_cast<double>(alpha) * golden + static_cast<double>(beta) * static_cast<double>(C0[i + j * ldc]);
+					ASSERT_NEAR(golden, static_cast<double>(C[i + j * ldc]), tolerance) << "i=" << i << "; j=" << j;
+				}
+
+				// padding rows are left untouched
+				for (size_t j = 0; j < n; ++j)
+					for (size_t i2 = m; i2 < ldc; ++i2)
+						ASSERT_EQ(C0[i2 + j * ldc], C[i2 + j * ldc]);
+			}
+		}
+	};
+
+	TEST_F(HostNativeBlasTests, Gemm)
+	{
+		const MatrixOperation operations[] = { MatrixOperation::None, MatrixOperation::Transpose };
+		for (const auto aOperation : operations)
+		{
+			for (const auto bOperation : operations)
+			{
+				// sizes not multiple of the register tile and bigger than the cache blocks exercise the edge cases
+				CheckGemm<double>(aOperation, bOperation, 1, 1, 1, 1.0, 0.0, 1e-14);
+				CheckGemm<double>(aOperation, bOperation, 203, 131, 300, 0.5, -2.0, 1e-12);
+				CheckGemm<float>(aOperation, bOperation, 205, 37, 259, 2.0f, 1.0f, 1e-4);
+			}
+		}
+
+		std::cout << "[          ] GEMM micro-kernel: " << cl::routines::nbr::GetInstructionSet() << std::endl;
+	}
+
+	TEST_F(HostNativeBlasTests, GemmOverwrite)
+	{
+		// beta = 0 doesn't read C, as in BLAS
+		const size_t n = 17;
+		const auto A = Random<double>(n * n, 4);
+		const std::vector<double> eye = [n]() {
+			std::vector<double> ret(n * n, 0.0);
+			for (size_t i = 0; i < n; ++i)
+				ret[i + i * n] = 1.0;
+			return ret;
+		}();
+		std::vector<double> C(n * n, std::numeric_limits<double>::quiet_NaN());
+
+		cl::routines::nbr::Gemm(MatrixOperation::None, MatrixOperation::None, n, n, n, 1.0, A.data(), n, eye.data(), n, 0.0, C.data(), n);
+		for (size_t i = 0; i < n * n; ++i)
+			ASSERT_DOUBLE_EQ(A[i], C[i]);
+	}
+
+	TEST_F(HostNativeBlasTests, GemmFused)
+	{
+		// k spans several cache blocks: the epilogue has to run only once the whole product is accumulated
+		const size_t m = 203;
+		const size_t n = 37;
+		const size_t k = 600;
+		const auto A = Random<double>(m * k, 5);
+		const auto B = Random<double>(k * n, 6);
+		const auto bias = Random<double>(m, 7);
+
+		for (const bool hasBias : { false, true })
+		{
+			std::vector<double> C(m * n);
+			cl::routines::nbr::GemmFused(MatrixOperation::None, MatrixOperation::None, m, n, k, 1.0, A.data(), m, B.data(), k, 0.0, C.data(), m, hasBias ? bias.data() : nullptr, cl::ActivationType::Relu);
+
+			for (size_t i = 0; i < m; ++i)
+			{
+				for (size_t j = 0; j < n; ++j)
+				{
+					double golden = hasBias ? bias[i] : 0.0;
+					for (size_t l = 0; l < k; ++l)
+						golden += A[i + l * m] * B[l + j * k];
+					ASSERT_NEAR(std::max(golden, 0.0), C[i + j * m], 1e-12) << "i=" << i << "; j=" << j;
+				}
+			}
+		}
+	}
+
+	TEST_F(HostNativeBlasTests, Gemv)
+	{
+		const size_t m = 131;
+		const size_t n = 67;
+		const size_t lda = m + 5;
+		const auto A = Random<double>(lda * n, 5);
+
+		for (const auto operation : { MatrixOperation::None, MatrixOperation::Transpose })
+		{
+			const size_t nRowsOp = operation == MatrixOperation::None ? m : n;
+			const size_t nColsOp = operation == MatrixOperation::None ? n : m;
+
+			const auto x = Random<double>(nColsOp, 6);
+			auto y = Random<double>(nRowsOp, 7);
+			const auto y0 = y;
+			cl::routines::nbr::Gemv(operation, m, n, 2.0, A.data(), lda, x.data(), -1.0, y.data());
+
+			for (size_t i = 0; i < nRowsOp; ++i)
+			{
+				double golden = -y0[i];
+				for (size_t j = 0; j < nColsOp; ++j)
+					golden += 2.0 * At(A, lda, operation, i, j) * x[j];
+				ASSERT_NEAR(golden, y[i], 1e-12) << i;
+			}
+		}
+	}
+
+	TEST_F(HostNativeBlasTests, Lu)
+	{
+		// bigger than the LU block size, so that the trailing updates go through GEMM
+		const size_t n = 157;
+		const size_t nRhs = 9;
+
+		auto A = Random<double>(n * n, 8);
+		const auto A0 = A;
+		const auto B0 = Random<double>(n * nRhs, 9);
+
+		std::vector<int> pivot(n);
+		ASSERT_EQ(0, cl::routines::nbr::Getrf(n, A.data(), n, pivot.data()));
+
+		for (const auto operation : { MatrixOperation::None, MatrixOperation::Transpose })
+		{
+			auto X = B0;
+			cl::routines::nbr::Getrs(operation, n, nRhs, A.data(), n, pivot.data(), X.data(), n);
+
+			for (size_t c = 0; c < nRhs; ++c)
+			{
+				for (size_t i = 0; i < n; ++i)
+				{
+					double residual = -B0[i + c * n];
+					for (size_t j = 0; j < n; ++j)
+						residual += At(A0, n, operation, i, j) * X[j + c * n];
+					ASSERT_NEAR(0.0, residual, 1e-10) << "i=" << i << "; c=" << c;
+				}
+			}
+		}
+	}
+
+	TEST_F(HostNativeBlasTests, Singular)
+	{
+		const size_t n = 5;
+		std::vector<double> A(n * n, 1.0);
+		std::vector<int> pivot(n);
+		ASSERT_EQ(2, cl::routines::nbr::Getrf(n, A.data(), n, pivot.data()));
+
+		const cl::test::dmat B(4, 4, 1.0);
+		cl::test::dmat X(4, 4, 1.0);
+		ASSERT_THROW(B.Solve(X), cl::FactorizationException);
+	}
+
+	TEST_F(HostNativeBlasTests, Factorization)
+	{
+		cl::test::dmat A = cl::test::dmat::RandomUniform(96, 96, 1234);
+		auto _A = A.Get();
+		for (size_t i = 0; i < A.nRows(); ++i)
+			_A[i + i * A.nRows()] += 2.0;
+		A.ReadFrom(_A);
+
+		const cl::test::dfact factorization(A);
+
+		const cl::test::dvec b = cl::test::dvec::RandomUniform(A.nRows(), 2345);
+		for (const auto operation : { MatrixOperation::None, MatrixOperation::Transpose })
+		{
+			cl::test::dvec x(b);
+			factorization.Solve(x, operation);
+
+			cl::test::dvec residual(b);
+			A.Dot(residual, x, operation, 1.0, -1.0);
+			const auto _residual = residual.Get();
+			for (size_t i = 0; i < _residual.size(); ++i)
+				ASSERT_NEAR(0.0, _residual[i], 1e-10) << i;
+		}
+	}
+
+	TEST_F(HostNativeBlasTests, FactorizationOnlyLu)
+	{
+		const cl::test::dmat A(8, 8, 1.0);
+		for (const auto solver : { cl::DenseSolverType::Qr, cl::DenseSolverType::Cholesky, cl::DenseSolverType::Ldlt })
+			ASSERT_THROW(cl::test::dfact(A, solver), cl::NotImplementedException);
+	}
+}	 // namespace clt
@@ -0,0 +1,222 @@
+#include <gtest/gtest.h>
+
+#include <HostRoutines/BlasWrappers.h>
+#include <HostRoutines/Extra.h>
+#include <HostRoutines/Profiling.h>
+#include <ColumnWiseMatrix.h>
+#include <Tensor.h>
+#include <Vector.h>
+
+#include <sstream>
+#include <thread>
+
+namespace clt
+{
+	class HostProfilingTests: public ::testing::Test
+	{
+	protected:
+		void SetUp() override
+		{
+			cl::profiling::SetEnabled(true);
+			cl::profiling::Reset();
+		}
+
+		void TearDown() override
+		{
+			cl::profiling::SetEnabled(false);
+			cl::profiling::Reset();
+		}
+
+		static const cl::profiling::Entry* Find(const std::vector<cl::profiling::Entry>& entries, const std::string& routine, const MathDomain mathDomain)
+		{
+			for (const auto& entry : entries)
+				if (entry.routine == routine && entry.memorySpace == MemorySpace::Test && entry.mathDomain == mathDomain)
+					return &entry;
+			return nullptr;
+		}
+	};
+
+	TEST_F(HostProfilingTests, Counters)
+	{
+		cl::test::vec x(1000, 1.0f);
+		const cl::test::vec y(1000, 2.0f);
+		for (size_t i = 0; i < 5; ++i)
+			cl::routines::AddEqual(x.GetBuffer(), y.GetBuffer(), 1.0);
+
+		cl::test::dmat A(32, 16, 1.0);
+		const cl::test::dmat B(32, 8, 1.0);
+		const cl::test::dmat C(8, 16, 1.0);
+		cl::routines::Multiply(A.GetTile(), B.GetTile(), C.GetTile());
+
+		const auto entries = cl::profiling::Snapshot();
+		if (!cl::profiling::IsCompiled())
+		{
+			ASSERT_FALSE(cl::profiling::IsEnabled());
+			ASSERT_TRUE(entries.empty());
+			return;
+		}
+
+		const auto* addEqual = Find(entries, "AddEqual", MathDomain::Float);
+		ASSERT_NE(nullptr, addEqual);
+		ASSERT_EQ(5u, addEqual->counters.calls);
+		ASSERT_DOUBLE_EQ(5 * 2.0 * 1000, addEqual->counters.flops);
+		ASSERT_DOUBLE_EQ(5 * 3.0 * 1000 * sizeof(float), addEqual->counters.bytes);
+		ASSERT_GE(addEqual->counters.seconds, 0.0);
+
+		// Multiply forwards to SubMultiply
+		ASSERT_EQ(nullptr, Find(entries, "Multiply", MathDomain::Double));
+		const auto* multiply = Find(entries, "SubMultiply", MathDomain::Double);
+		ASSERT_NE(nullptr, multiply);
+		ASSERT_EQ(1u, multiply->counters.calls);
+		ASSERT_DOUBLE_EQ(2.0 * 32 * 16 * 8, multiply->counters.flops);
+
+		cl::profiling::Reset();
+		ASSERT_TRUE(cl::profiling::Snapshot().empty());
+	}
+
+	TEST_F(HostProfilingTests, ElementWiseFunctions)
+	{
+		const cl::test::vec x(100, 1.0f);
+		cl::test::vec y(100, 0.0f);
+		cl::routines::Exp(y.GetBuffer(), x.GetBuffer());
+		cl::routines::Sqrt(y.GetBuffer(), x.GetBuffer());
+		cl::routines::Sqrt(y.GetBuffer(), x.GetBuffer());
+
+		if (!cl::profiling::IsCompiled())
+			return;
+
+		// each public routine is recorded under its own name, not the shared implementation's
+		const auto entries = cl::profiling::Snapshot();
+		ASSERT_EQ(nullptr, Find(entries, "ApplyElementWiseFunction", MathDomain::Float));
+		const auto* exp = Find(entries, "Exp", MathDomain::Float);
+		ASSERT_NE(nullptr, exp);
+		ASSERT_EQ(1u, exp->counters.calls);
+		const auto* sqrt = Find(entries, "Sqrt", MathDomain::Float);
+		ASSERT_NE(nullptr, sqrt);
+		ASSERT_EQ(2u, sqrt->counters.calls);
+		ASSERT_DOUBLE_EQ(2 * 100.0, sqrt->counters.flops);
+	}
+
+	TEST_F(HostProfilingTests, MultiplyFused)
+	{
+		cl::test::dmat A(32, 16, 0.0);
+		const cl::test::dmat B(32, 8, 1.0);
+		const cl::test::dmat C(8, 16, 1.0);
+		const cl::test::dvec bias(32, 1.0);
+		cl::routines::MultiplyFused(A.GetTile(), B.GetTile(), C.GetTile(), bias.GetBuffer(), cl::ActivationType::Relu);
+
+		if (!cl::profiling::IsCompiled())
+			return;
+
+		const auto entries = cl::profiling::Snapshot();
+		const auto* multiplyFused = Find(entries, "MultiplyFused", MathDomain::Double);
+		ASSERT_NE(nullptr, multiplyFused);
+		ASSERT_EQ(1u, multiplyFused->counters.calls);
+		ASSERT_DOUBLE_EQ(2.0 * 32 * 16 * 8 + 2.0 * 32 * 16, multiplyFused->counters.flops);
+	}
+
+	TEST_F(HostProfilingTests, Reductions)
+	{
+		const cl::test::dmat A(32, 16, 1.0);
+		cl::test::dvec x(32, 0.0);
+		MemoryBuffer cache;
+		cl::routines::RowWiseSum(x.GetBuffer(), A.GetTile(), cache);
+
+		const cl::test::dten T(32, 16, 4, 1.0);
+		cl::test::dmat out(32, 16, 0.0);
+		MemoryCube cacheReshape;
+		MemoryBuffer cacheOnes;
+		cl::routines::CubeWiseSum(out.GetTile(), T.GetCube(), cacheReshape, cacheOnes);
+
+		cl::routines::Free(cache);
+		cl::routines::Free(cacheReshape);
+		cl::routines::Free(cacheOnes);
+
+		if (!cl::profiling::IsCompiled())
+			return;
+
+		const auto entries = cl::profiling::Snapshot();
+		const auto* rowWiseSum = Find(entries, "RowWiseSum", MathDomain::Double);
+		ASSERT_NE(nullptr, rowWiseSum);
+		ASSERT_EQ(1u, rowWiseSum->counters.calls);
+		ASSERT_DOUBLE_EQ(32.0 * 16, rowWiseSum->counters.flops);
+
+		const auto* cubeWiseSum = Find(entries, "CubeWiseSum", MathDomain::Double);
+		ASSERT_NE(nullptr, cubeWiseSum);
+		ASSERT_EQ(1u, cubeWiseSum->counters.calls);
+		ASSERT_DOUBLE_EQ(32.0 * 16 * 4, cubeWiseSum->counters.flops);
+	}
+
+	TEST_F(HostProfilingTests, Disabled)
+	{
+		cl::profiling::SetEnabled(false);
+
+		const cl::test::vec x(1000, 1.0f);
+		double sum = 0.0;
+		cl::routines::Sum(sum, x.GetBuffer());
+		ASSERT_DOUBLE_EQ(1000.0, sum);
+
+		ASSERT_TRUE(cl::profiling::Snapshot().empty());
+	}
+
+	TEST_F(HostProfilingTests, MultipleThreads)
+	{
+		if (!cl::profiling::IsCompiled())
+			return;
+
+		constexpr size_t nThreads = 4;
+		constexpr size_t nCalls = 10;
+
+		// the threads exit before the snapshot, so their counters have to survive them
+		std::vector<std::thread> threads;
+		for (size_t t = 0; t < nThreads; ++t)
+		{
+			threads.emplace_back([]() {
+				const cl::test::dvec x(100, 1.0);
+				double sum = 0.0;
+				for (size_t i = 0; i < nCalls; ++i)
+					cl::routines::Sum(sum, x.GetBuffer());
+			});
+		}
+		for (auto& thread : threads)
+			thread.join();
+
+		const auto entries = cl::profiling::Snapshot();
+		const auto* sum = Find(entries, "Sum", MathDomain::Double);
+		ASSERT_NE(nullptr, sum);
+		ASSERT_EQ(nThreads * nCalls, sum->counters.calls);
+	}
+
+	TEST_F(HostProfilingTests, ChromeTrace)
+	{
+		if (!cl::profiling::IsCompiled())
+			return;
+
+		cl::test::vec x(100, 1.0f);
+		cl::routines::Scale(x.GetBuffer(), 2.0);
+		cl::routines::Scale(x.GetBuffer(), 2.0);
+
+		cl::profiling::SetMaxTraceEvents(1);
+		cl::routines::Scale(x.GetBuffer(), 2.0);
+		cl::profiling::SetMaxTraceEvents(size_t(1) << 20);
+
+		std::stringstream stream;
+		cl::profiling::WriteChromeTrace(stream);
+		const std::string trace = stream.str();
+
+		ASSERT_EQ(0u, trace.find("{\"traceEvents\":["));
+		ASSERT_NE(std::string::npos, trace.find(R"("name":"Scale","cat":"Test","ph":"X")"));
+		ASSERT_NE(std::string::npos, trace.find(R"("args":{"mathDomain":"Float"})"));
+
+		// the third call is counted but not traced
+		size_t nEvents = 0;
+		for (size_t pos = trace.find("\"ph\":\"X\""); pos != std::string::npos; pos = trace.find("\"ph\":\"X\"", pos + 1))
+			++nEvents;
+		ASSERT_EQ(2u, nEvents);
+
+		const auto entries = cl::profiling::Snapshot();
+		const auto* scale = Find(entries, "Scale", MathDomain::Float);
+		ASSERT_NE(nullptr, scale);
+		ASSERT_EQ(3u, scale->counters.calls);
+	}
+}	 // namespace clt
@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+
+#include <HostRoutines/Philox.h>
+#include <Vector.h>
+
+#include <cmath>
+
+namespace clt
+{
+	class HostRandomTests: public ::testing::Test
+	{
+	};
+
+	TEST_F(HostRandomTests, PhiloxKnownAnswer)
+	{
+		// reference values from Random123's kat_vectors
+		const auto zero = cl::routines::philox::Generate({ 0, 0, 0, 0 }, 0, 0);
+		ASSERT_EQ(0x6627e8d5u, zero[0]);
+		ASSERT_EQ(0xe169c58du, zero[1]);
+		ASSERT_EQ(0xbc57ac4cu, zero[2]);
+		ASSERT_EQ(0x9b00dbd8u, zero[3]);
+
+		const auto ones = cl::routines::philox::Generate({ 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff }, 0xffffffff, 0xffffffff);
+		ASSERT_EQ(0x408f276du, ones[0]);
+		ASSERT_EQ(0x41c83b0eu, ones[1]);
+		ASSERT_EQ(0xa20bc7c6u, ones[2]);
+		ASSERT_EQ(0x6d5451fdu, ones[3]);
+	}
+
+	TEST_F(HostRandomTests, UniformRange)
+	{
+		const cl::test::vec v = cl::test::vec::RandomUniform(1000003, 1234);
+		const auto _v = v.Get();
+
+		double mean = 0.0;
+		for (const auto& iter : _v)
+		{
+			ASSERT_GE(iter, 0.0f);
+			ASSERT_LT(iter, 1.0f);
+			mean += static_cast<double>(iter);
+		}
+		mean /= static_cast<double>(_v.size());
+		ASSERT_NEAR(0.5, mean, 1e-3);
+	}
+
+	TEST_F(HostRandomTests, NormalMoments)
+	{
+		const cl::test::dvec v = cl::test::dvec::RandomGaussian(1000001, 1234);
+		const auto _v = v.Get();
+
+		double mean = 0.0;
+		double variance = 0.0;
+		for (const auto& iter : _v)
+		{
+			ASSERT_TRUE(std::isfinite(iter));
+			mean += iter;
+			variance += iter * iter;
+		}
+		mean /= static_cast<double>(_v.size());
+		variance = variance / static_cast<double>(_v.size()) - mean * mean;
+
+		ASSERT_NEAR(0.0, mean, 5e-3);
+		ASSERT_NEAR(1.0, variance, 5e-3);
+	}
+
+	TEST_F(HostRandomTests, Reproducible)
+	{
+		// the i-th number only depends on the seed and on i: the smaller vector is a prefix of the bigger one
+		const cl::test::vec small = cl::test::vec::RandomGaussian(1001, 2345);
+		const cl::test::vec big = cl::test::vec::RandomGaussian(3000001, 2345);
+		const cl::test::vec other = cl::test::vec::RandomGaussian(1001, 2346);
+
+		const auto _small = small.Get();
+		const auto _big = big.Get();
+		const auto _other = other.Get();
+
+		size_t nDifferent = 0;
+		for (size_t i = 0; i < _small.size(); ++i)
+		{
+			ASSERT_EQ(_small[i], _big[i]) << i;
+			if (_small[i] != _other[i])
+				++nDifferent;
+		}
+		ASSERT_EQ(_small.size(), nDifferent);
+	}
+}	 // namespace clt
@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+
+#include <HostRoutines/Reductions.h>
+#include <HostRoutines/ThreadPool.h>
+#include <Vector.h>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <thread>
+
+namespace clt
+{
+	class HostReductionsTests: public ::testing::Test
+	{
+	protected:
+		void SetUp() override { nThreads = cl::GetNumThreads(); }
+		void TearDown() override
+		{
+			cl::routines::reductions::SetDeterministic(false);
+			cl::SetNumThreads(nThreads);
+		}
+
+	private:
+		size_t nThreads = 1;
+	};
+
+	TEST_F(HostReductionsTests, MinMax)
+	{
+		// sizes not multiple of the vector width exercise the remainder loops
+		for (const unsigned size : { 1u, 7u, 33u, 1000u, 1000003u })
+		{
+			const cl::test::vec v = cl::test::vec::RandomGaussian(size, size);
+			const auto _v = v.Get();
+
+			auto absCompare = [](const float x, const float y) { return std::fabs(x) < std::fabs(y); };
+			ASSERT_FLOAT_EQ(*std::min_element(_v.begin(), _v.end()), v.Minimum()) << size;
+			ASSERT_FLOAT_EQ(*std::max_element(_v.begin(), _v.end()), v.Maximum()) << size;
+			ASSERT_FLOAT_EQ(std::fabs(*std::min_element(_v.begin(), _v.end(), absCompare)), v.AbsoluteMinimum()) << size;
+			ASSERT_FLOAT_EQ(std::fabs(*std::max_element(_v.begin(), _v.end(), absCompare)), v.AbsoluteMaximum()) << size;
+		}
+	}
+
+	TEST_F(HostReductionsTests, MinMaxDouble)
+	{
+		const cl::test::dvec v = cl::test::dvec::RandomGaussian(100003, 1234);
+		const auto _v = v.Get();
+
+		auto absCompare = [](const double x, const double y) { return std::fabs(x) < std::fabs(y); };
+		ASSERT_DOUBLE_EQ(*std::min_element(_v.begin(), _v.end()), v.Minimum());
+		ASSERT_DOUBLE_EQ(*std::max_element(_v.begin(), _v.end()), v.Maximum());
+		ASSERT_DOUBLE_EQ(std::fabs(*std::min_element(_v.begin(), _v.end(), absCompare)), v.AbsoluteMinimum());
+		ASSERT_DOUBLE_EQ(std::fabs(*std::max_element(_v.begin(), _v.end(), absCompare)), v.AbsoluteMaximum());
+	}
+
+	TEST_F(HostReductionsTests, Sum)
+	{
+		for (const unsigned size : { 1u, 7u, 33u, 1000u, 4000037u })
+		{
+			const cl::test::vec v = cl::test::vec::RandomUniform(size, size);
+			const auto _v = v.Get();
+
+			const double expected = std::accumulate(_v.begin(), _v.end(), 0.0);
+			ASSERT_NEAR(expected, static_cast<double>(v.Sum()), 1e-6 * size) << size;
+		}
+
+		const cl::test::ivec iv(100000, 3);
+		ASSERT_EQ(300000, iv.Sum());
+	}
+
+	TEST_F(HostReductionsTests, DeterministicSum)
+	{
+		cl::routines::reductions::SetDeterministic(true);
+		ASSERT_TRUE(cl::routines::reductions::IsDeterministic());
+
+		constexpr size_t chunkSize = cl::routines::reductions::deterministicChunkSize;
+		const size_t size = 40 * chunkSize + 123;
+		const cl::test::dvec v = cl::test::dvec::RandomGaussian(static_cast<unsigned>(size), 1234);
+		const auto _v = v.Get();
+
+		// the same bits whatever the number of threads
+		cl::SetNumThreads(1);
+		const double expected = cl::routines::reductions::Sum(_v.data(), size);
+		ASSERT_EQ(expected, v.Sum());
+
+		for (const size_t n : { size_t(2), std::max<size_t>(std::thread::hardware_concurrency(), 1) })
+		{
+			cl::SetNumThreads(n);
+			ASSERT_EQ(expected, cl::routines::reductions::Sum(_v.data(), size)) << n;
+			ASSERT_EQ(expected, v.Sum()) << n;
+		}
+	}
+}	 // namespace clt
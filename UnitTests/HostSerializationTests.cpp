@@ -1,6 +1,10 @@
 #include <gtest/gtest.h>
 
 #include <ColumnWiseMatrix.h>
+#include <CompressedSparseRowMatrix.h>
+#include <HostRoutines/NpyFile.h>
+#include <SparseVector.h>
+#include <Tensor.h>
 #include <Vector.h>
 #include <cstdio>
 #include <fstream>
@@ -107,6 +111,300 @@ namespace clt
 		}
 	}
 
+	TEST_F(HostSerializationTests, VectorMemoryMapping)
+	{
+		cl::test::vec v = cl::test::vec::LinSpace(0.0f, 1.0f, 18u);
+		v.ToBinaryFile("v1.npy");
+
+		{
+			cl::test::vec u = cl::test::vec::VectorFromBinaryFile("v1.npy", false, true);
+			ASSERT_TRUE(u.IsMemoryMapped());
+			ASSERT_FALSE(u.OwnsMemory());
+			ASSERT_TRUE(u == v);
+
+			// the mapping is copy-on-write: writes never reach the file (checked below)
+			u.Set(0.5f);
+			ASSERT_TRUE(u == cl::test::vec(18u, 0.5f));
+
+			// moving the buffer keeps the mapping alive
+			cl::test::vec w(std::move(u));
+			ASSERT_TRUE(w.IsMemoryMapped());
+			ASSERT_TRUE(w == cl::test::vec(18u, 0.5f));
+		}
+
+		cl::test::vec u("v1.npy", true);
+		ASSERT_TRUE(u.IsMemoryMapped());
+		ASSERT_TRUE(u == v);
+
+		// different type: it falls back to a copy
+		cl::test::dvec du("v1.npy", true);
+		ASSERT_FALSE(du.IsMemoryMapped());
+		ASSERT_TRUE(du.OwnsMemory());
+
+		std::remove("v1.npy");
+	}
+
+	TEST_F(HostSerializationTests, MatrixMemoryMapping)
+	{
+		cl::test::mat m1(18u, 12u);
+		m1.LinSpace(0.0f, 1.0f);
+		m1.ToBinaryFile("m1.npy");
+
+		cl::test::mat m2 = cl::test::mat::MatrixFromBinaryFile("m1.npy", false, false, true);
+		ASSERT_TRUE(m2.IsMemoryMapped());
+		ASSERT_FALSE(m2.OwnsMemory());
+		ASSERT_EQ(m1.nRows(), m2.nRows());
+		ASSERT_EQ(m1.nCols(), m2.nCols());
+		ASSERT_TRUE(m1 == m2);
+		ASSERT_TRUE(m1.columns[5]->Get() == m2.columns[5]->Get());
+
+		// a copy owns its memory
+		cl::test::mat m3(m2);
+		ASSERT_FALSE(m3.IsMemoryMapped());
+		ASSERT_TRUE(m3.OwnsMemory());
+		ASSERT_TRUE(m1 == m3);
+
+		std::remove("m1.npy");
+	}
+
+	TEST_F(HostSerializationTests, MatrixSerializationToBinaryFileTransposed)
+	{
+		cl::test::mat m1 = cl::test::mat::RandomUniform(130u, 70u, 1234);
+		cl::test::mat::MatrixToBinaryFile(m1, "m1.npy");
+
+		// numpy sees the same matrix, in fortran order
+		ASSERT_TRUE(cl::routines::NpyFileReader("m1.npy").GetHeader().fortranOrder);
+
+		cl::test::mat m2 = cl::test::mat::MatrixFromBinaryFile("m1.npy", true);
+		ASSERT_EQ(m1.nRows(), m2.nRows());
+		ASSERT_EQ(m1.nCols(), m2.nCols());
+		ASSERT_TRUE(m1 == m2);
+
+		cl::test::mat m3 = cl::test::mat::MatrixFromBinaryFile("m1.npy", true, false, true);
+		ASSERT_TRUE(m3.IsMemoryMapped());
+		ASSERT_TRUE(m1 == m3);
+
+		cl::test::mat::MatrixToBinaryFile(m1, "m1.npz", true, true);
+		cl::test::mat m4 = cl::test::mat::MatrixFromBinaryFile("m1.npz", true, true);
+		ASSERT_EQ(m1.nRows(), m4.nRows());
+		ASSERT_EQ(m1.nCols(), m4.nCols());
+		ASSERT_TRUE(m1 == m4);
+
+		std::remove("m1.npy");
+		std::remove("m1.npz");
+	}
+
+	TEST_F(HostSerializationTests, MatrixFromBinaryFileTransposedCOrder)
+	{
+		// large enough to be read in more than one block
+		const unsigned nRows = 1030u, nCols = 1100u;
+		std::vector<float> rowMajor(static_cast<size_t>(nRows) * nCols);
+		for (size_t i = 0; i < rowMajor.size(); ++i)
+			rowMajor[i] = static_cast<float>(i % 1009);
+
+		{
+			cl::routines::NpyFileWriter writer("m1.npy", MathDomain::Float, { nRows, nCols }, false);
+			writer.Write(rowMajor.data(), rowMajor.size());
+		}
+
+		cl::test::mat m = cl::test::mat::MatrixFromBinaryFile("m1.npy", true);
+		ASSERT_EQ(nRows, m.nRows());
+		ASSERT_EQ(nCols, m.nCols());
+
+		const auto _m = m.Get();
+		for (size_t i = 0; i < nRows; ++i)
+		{
+			for (size_t j = 0; j < nCols; ++j)
+				ASSERT_EQ(rowMajor[j + nCols * i], _m[i + nRows * j]);
+		}
+
+		std::remove("m1.npy");
+	}
+
+	TEST_F(HostSerializationTests, TensorSerializationToBinaryFileInversion)
+	{
+		cl::test::ten t1 = cl::test::ten::RandomUniform(7u, 5u, 3u, 1234);
+		t1.ToBinaryFile("t1.npy");
+
+		cl::test::ten t2 = cl::test::ten::TensorFromBinaryFile("t1.npy");
+		ASSERT_EQ(t1.nRows(), t2.nRows());
+		ASSERT_EQ(t1.nCols(), t2.nCols());
+		ASSERT_EQ(t1.nMatrices(), t2.nMatrices());
+		ASSERT_FALSE(t2.IsMemoryMapped());
+		ASSERT_TRUE(t1 == t2);
+
+		// it goes through the vector overloads with a different element type
+		cl::test::dten t3("t1.npy");
+		ASSERT_EQ(t1.nMatrices(), t3.nMatrices());
+		const auto _t1 = t1.Get();
+		const auto _t3 = t3.Get();
+		for (size_t i = 0; i < _t1.size(); ++i)
+			ASSERT_DOUBLE_EQ(static_cast<double>(_t1[i]), _t3[i]);
+
+		std::remove("t1.npy");
+	}
+
+	TEST_F(HostSerializationTests, TensorSerializationToBinaryFileInversionCompressed)
+	{
+		cl::test::ten t1 = cl::test::ten::LinSpace(0.0f, 1.0f, 6u, 4u, 3u);
+		t1.ToBinaryFile("t1.npz", true);
+
+		cl::test::ten t2 = cl::test::ten::TensorFromBinaryFile("t1.npz", true);
+		ASSERT_EQ(t1.nRows(), t2.nRows());
+		ASSERT_EQ(t1.nCols(), t2.nCols());
+		ASSERT_EQ(t1.nMatrices(), t2.nMatrices());
+		ASSERT_TRUE(t1 == t2);
+
+		std::remove("t1.npz");
+	}
+
+	TEST_F(HostSerializationTests, TensorMemoryMapping)
+	{
+		cl::test::ten t1 = cl::test::ten::RandomUniform(9u, 4u, 5u, 1234);
+		t1.ToBinaryFile("t1.npy");
+
+		cl::test::ten t2 = cl::test::ten::TensorFromBinaryFile("t1.npy", false, true);
+		ASSERT_TRUE(t2.IsMemoryMapped());
+		ASSERT_FALSE(t2.OwnsMemory());
+		ASSERT_EQ(t1.nRows(), t2.nRows());
+		ASSERT_EQ(t1.nCols(), t2.nCols());
+		ASSERT_EQ(t1.nMatrices(), t2.nMatrices());
+		ASSERT_TRUE(t1 == t2);
+		ASSERT_TRUE(t1.Get(3) == t2.Get(3));
+		ASSERT_TRUE(t1.Get(4, 2) == t2.Get(4, 2));
+
+		std::remove("t1.npy");
+	}
+
+	TEST_F(HostSerializationTests, TensorFromRowMajorFile)
+	{
+		const unsigned nRows = 3, nCols = 4, nMatrices = 2;
+		std::vector<float> rowMajor(nRows * nCols * nMatrices);
+		for (size_t i = 0; i < rowMajor.size(); ++i)
+			rowMajor[i] = static_cast<float>(i);
+
+		{
+			cl::routines::NpyFileWriter writer("t1.npy", MathDomain::Float, { nRows, nCols, nMatrices }, false);
+			writer.Write(rowMajor.data(), rowMajor.size());
+			ASSERT_TRUE(writer.IsComplete());
+		}
+
+		// C order can't be mapped: it's reordered into a copy
+		cl::test::ten t("t1.npy", true);
+		ASSERT_FALSE(t.IsMemoryMapped());
+		ASSERT_EQ(nRows, t.nRows());
+		ASSERT_EQ(nCols, t.nCols());
+		ASSERT_EQ(nMatrices, t.nMatrices());
+
+		const auto _t = t.Get();
+		for (size_t i = 0; i < nRows; ++i)
+		{
+			for (size_t j = 0; j < nCols; ++j)
+			{
+				for (size_t k = 0; k < nMatrices; ++k)
+					ASSERT_EQ(rowMajor[k + nMatrices * (j + nCols * i)], _t[i + nRows * (j + nCols * k)]);
+			}
+		}
+
+		std::remove("t1.npy");
+	}
+
+	static std::vector<float> GetSparseMatrix(const size_t nRows, const size_t nCols)
+	{
+		std::vector<float> ret(nRows * nCols, 0.0f);
+		for (size_t i = 0; i < nRows; ++i)
+		{
+			for (size_t j = 0; j < nCols; ++j)
+			{
+				if ((3 * i + 7 * j) % 5 == 0)
+					ret[i + nRows * j] = static_cast<float>(1 + i) - 0.25f * static_cast<float>(j);
+			}
+		}
+		return ret;
+	}
+
+	TEST_F(HostSerializationTests, SparseMatrixSerializationToBinaryFileInversion)
+	{
+		const auto dense = GetSparseMatrix(12, 9);
+		cl::test::smat s1(dense, 12, 9);
+		s1.ToBinaryFile("s1.npz");
+		s1.ToBinaryFile("s2.npz", true);
+
+		for (const auto* fileName : { "s1.npz", "s2.npz" })
+		{
+			cl::test::smat s2(fileName);
+			ASSERT_FALSE(s2.IsMemoryMapped());
+			ASSERT_EQ(s1.nRows(), s2.nRows());
+			ASSERT_EQ(s1.nCols(), s2.nCols());
+			ASSERT_EQ(s1.size(), s2.size());
+			ASSERT_TRUE(s1.Get() == s2.Get());
+
+			// the values are converted to the element type of the matrix
+			cl::test::dsmat s3(fileName, true);
+			ASSERT_FALSE(s3.IsMemoryMapped());
+			const auto _s3 = s3.Get();
+			for (size_t i = 0; i < dense.size(); ++i)
+				ASSERT_DOUBLE_EQ(static_cast<double>(dense[i]), _s3[i]);
+		}
+
+		std::remove("s1.npz");
+		std::remove("s2.npz");
+	}
+
+	TEST_F(HostSerializationTests, SparseMatrixMemoryMapping)
+	{
+		const auto dense = GetSparseMatrix(20, 15);
+		cl::test::smat s1(dense, 20, 15);
+		s1.ToBinaryFile("s1.npz");
+
+		cl::test::smat s2("s1.npz", true);
+		ASSERT_TRUE(s2.IsMemoryMapped());
+		ASSERT_EQ(s1.nRows(), s2.nRows());
+		ASSERT_EQ(s1.nCols(), s2.nCols());
+		ASSERT_TRUE(s1.Get() == s2.Get());
+
+		const cl::test::vec x = cl::test::vec::LinSpace(-1.0f, 1.0f, 15u);
+		ASSERT_TRUE((s1 * x) == (s2 * x));
+
+		// deflated arrays can't be used in place
+		s1.ToBinaryFile("s2.npz", true);
+		cl::test::smat s3("s2.npz", true);
+		ASSERT_FALSE(s3.IsMemoryMapped());
+		ASSERT_TRUE(s1.Get() == s3.Get());
+
+		std::remove("s1.npz");
+		std::remove("s2.npz");
+	}
+
+	TEST_F(HostSerializationTests, SparseVectorSerializationToBinaryFileInversion)
+	{
+		std::vector<float> dense(25, 0.0f);
+		for (size_t i = 0; i < dense.size(); i += 3)
+			dense[i] = static_cast<float>(i) + 0.5f;
+		const cl::test::vec v(dense);
+		cl::test::svec v1(v);
+		v1.ToBinaryFile("v1.npz");
+		v1.ToBinaryFile("v2.npz", true);
+
+		cl::test::svec v2("v1.npz", true);
+		ASSERT_TRUE(v2.IsMemoryMapped());
+		ASSERT_EQ(v1.denseSize, v2.denseSize);
+		ASSERT_TRUE(v1.Get() == v2.Get());
+
+		cl::test::svec v3("v2.npz", true);
+		ASSERT_FALSE(v3.IsMemoryMapped());
+		ASSERT_TRUE(v1.Get() == v3.Get());
+
+		// it's a 1 x 25 csr matrix
+		cl::test::smat m("v1.npz");
+		ASSERT_EQ(1u, m.nRows());
+		ASSERT_EQ(25u, m.nCols());
+		ASSERT_TRUE(m.Get() == dense);
+
+		std::remove("v1.npz");
+		std::remove("v2.npz");
+	}
+
 	/*
 	 *	Open file serialized with numpy.savetxt
 	 */
@@ -182,4 +480,19 @@ namespace clt
 
 		std::remove("m.cl");
 	}
+
+	TEST_F(HostSerializationTests, SerializationTensorIntoAFile)
+	{
+		cl::test::ten t = cl::test::ten::LinSpace(0.0f, 1.0f, 3u, 2u, 2u);
+		std::ostringstream os;
+		os << t;
+
+		// one line per row, and an empty line after each matrix
+		std::istringstream is(os.str());
+		std::string line;
+		size_t nLines = 0;
+		while (std::getline(is, line))
+			++nLines;
+		ASSERT_EQ(2u * (3u + 1u), nLines);
+	}
 }	 // namespace clt
@@ -0,0 +1,203 @@
+#include <gtest/gtest.h>
+
+#include <HostRoutines/Sorting.h>
+#include <HostRoutines/ThreadPool.h>
+#include <Vector.h>
+#include <VectorCollection.h>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+namespace clt
+{
+	class HostSortingTests: public ::testing::Test
+	{
+	protected:
+		void SetUp() override
+		{
+			nThreads = cl::GetNumThreads();
+
+			// more threads than cores, so that the radix passes really have one histogram per thread
+			cl::SetNumThreads(4);
+		}
+		void TearDown() override { cl::SetNumThreads(nThreads); }
+
+	private:
+		size_t nThreads = 1;
+	};
+
+	template<typename T>
+	static std::vector<T> GetRandomValues(const size_t size, const T range, const unsigned seed)
+	{
+		std::vector<T> x(size);
+		unsigned state = seed;
+		for (size_t i = 0; i < size; ++i)
+		{
+			state = state * 1664525u + 1013904223u;
+			x[i] = static_cast<T>(static_cast<double>(state) / 4294967296.0 * 2.0 * static_cast<double>(range) - static_cast<double>(range));
+		}
+
+		return x;
+	}
+
+	TEST_F(HostSortingTests, Sort)
+	{
+		// comparison sort, single threaded and multithreaded radix sort
+		for (const size_t size : { size_t(100), size_t(5000), size_t(1000003) })
+		{
+			auto x = GetRandomValues<float>(size, 1000.0f, 1234);
+			auto expected = x;
+			std::sort(expected.begin(), expected.end());
+
+			cl::routines::sorting::Sort(x.data(), x.size());
+			ASSERT_EQ(expected, x) << size;
+
+			auto d = GetRandomValues<double>(size, 1e10, 4321);
+			auto expectedDouble = d;
+			std::sort(expectedDouble.begin(), expectedDouble.end(), std::greater<double>());
+
+			cl::routines::sorting::Sort(d.data(), d.size(), false);
+			ASSERT_EQ(expectedDouble, d) << size;
+
+			auto i = GetRandomValues<int>(size, 1 << 30, 5678);
+			auto expectedInt = i;
+			std::sort(expectedInt.begin(), expectedInt.end());
+
+			cl::routines::sorting::Sort(i.data(), i.size());
+			ASSERT_EQ(expectedInt, i) << size;
+		}
+	}
+
+	TEST_F(HostSortingTests, SpecialValues)
+	{
+		const float inf = std::numeric_limits<float>::infinity();
+		const float nan = std::numeric_limits<float>::quiet_NaN();
+		for (const size_t size : { size_t(10), size_t(100003) })
+		{
+			auto x = GetRandomValues<float>(size, 1.0f, 1234);
+			x[1] = nan;
+			x[3] = -nan;
+			x[5] = inf;
+			x[7] = -inf;
+			x[8] = -0.0f;
+			x[9] = 0.0f;
+
+			auto ascending = x;
+			cl::routines::sorting::Sort(ascending.data(), ascending.size());
+			ASSERT_EQ(-inf, ascending[0]);
+			ASSERT_EQ(inf, ascending[size - 3]);
+			ASSERT_TRUE(std::isnan(ascending[size - 2]));
+			ASSERT_TRUE(std::isnan(ascending[size - 1]));
+			ASSERT_TRUE(std::is_sorted(ascending.begin(), ascending.end() - 2));
+
+			auto descending = x;
+			cl::routines::sorting::Sort(descending.data(), descending.size(), false);
+			ASSERT_TRUE(std::isnan(descending[0]));
+			ASSERT_TRUE(std::isnan(descending[1]));
+			ASSERT_EQ(inf, descending[2]);
+			ASSERT_EQ(-inf, descending[size - 1]);
+			ASSERT_TRUE(std::is_sorted(descending.begin() + 2, descending.end(), std::greater<float>()));
+		}
+
+		std::vector<int> i = { 3, std::numeric_limits<int>::max(), -1, std::numeric_limits<int>::min(), 0 };
+		cl::routines::sorting::Sort(i.data(), i.size());
+		ASSERT_EQ(std::vector<int>({ std::numeric_limits<int>::min(), -1, 0, 3, std::numeric_limits<int>::max() }), i);
+	}
+
+	TEST_F(HostSortingTests, ArgSort)
+	{
+		// few distinct values, so that stability matters
+		for (const size_t size : { size_t(100), size_t(5000), size_t(1000003) })
+		{
+			const auto x = GetRandomValues<int>(size, 50, 1234);
+			for (const bool ascending : { true, false })
+			{
+				std::vector<int> expected(size);
+				std::iota(expected.begin(), expected.end(), 0);
+				std::stable_sort(expected.begin(), expected.end(), [&x, ascending](const int i, const int j) { return ascending ? x[i] < x[j] : x[i] > x[j]; });
+
+				std::vector<int> indices(size);
+				cl::routines::sorting::ArgSort(indices.data(), x.data(), size, ascending);
+				ASSERT_EQ(expected, indices) << size;
+			}
+		}
+	}
+
+	TEST_F(HostSortingTests, TopK)
+	{
+		for (const size_t size : { size_t(100), size_t(1000003) })
+		{
+			const auto x = GetRandomValues<double>(size, 100.0, 1234);
+			std::vector<int> order(size);
+			std::iota(order.begin(), order.end(), 0);
+			std::stable_sort(order.begin(), order.end(), [&x](const int i, const int j) { return x[i] > x[j]; });
+
+			for (const size_t k : { size_t(1), size_t(10), size_t(100) })
+			{
+				std::vector<double> values(k);
+				std::vector<int> indices(k);
+				cl::routines::sorting::TopK(values.data(), indices.data(), x.data(), size, k);
+				for (size_t i = 0; i < k; ++i)
+				{
+					ASSERT_EQ(order[i], indices[i]) << size << " " << k;
+					ASSERT_EQ(x[order[i]], values[i]) << size << " " << k;
+				}
+
+				cl::routines::sorting::TopK(values.data(), indices.data(), x.data(), size, k, false);
+				for (size_t i = 0; i < k; ++i)
+					ASSERT_EQ(order[size - 1 - i], indices[i]) << size << " " << k;
+			}
+		}
+
+		// ties go to the lower index
+		const std::vector<int> x = { 1, 5, 3, 5, 5, 2 };
+		std::vector<int> values(2);
+		std::vector<int> indices(2);
+		cl::routines::sorting::TopK(values.data(), indices.data(), x.data(), x.size(), 2);
+		ASSERT_EQ(std::vector<int>({ 5, 5 }), values);
+		ASSERT_EQ(std::vector<int>({ 1, 3 }), indices);
+	}
+
+	TEST_F(HostSortingTests, SegmentedSort)
+	{
+		// empty, tiny, radix sorted and multithreaded segments
+		const std::vector<size_t> sizes = { 0, 1, 17, 3000, 0, 500000, 64, 2 };
+		std::vector<size_t> offsets(sizes.size() + 1, 0);
+		std::partial_sum(sizes.begin(), sizes.end(), offsets.begin() + 1);
+
+		auto x = GetRandomValues<float>(offsets.back(), 10.0f, 1234);
+		auto expected = x;
+		for (size_t s = 0; s < sizes.size(); ++s)
+			std::sort(expected.begin() + static_cast<std::ptrdiff_t>(offsets[s]), expected.begin() + static_cast<std::ptrdiff_t>(offsets[s + 1]));
+
+		cl::routines::sorting::SegmentedSort(x.data(), offsets.data(), sizes.size());
+		ASSERT_EQ(expected, x);
+	}
+
+	TEST_F(HostSortingTests, Vector)
+	{
+		cl::test::vec v(GetRandomValues<float>(10007, 1.0f, 1234));
+		const auto _v = v.Get();
+
+		const cl::test::ivec indices = v.ArgSort(false);
+		const auto _indices = indices.Get();
+		const cl::test::vec top = v.TopK(5);
+		const auto _top = top.Get();
+
+		v.Sort(false);
+		const auto _sorted = v.Get();
+		for (size_t i = 0; i < _v.size(); ++i)
+			ASSERT_EQ(_v[static_cast<size_t>(_indices[i])], _sorted[i]);
+		for (size_t i = 0; i < _top.size(); ++i)
+			ASSERT_EQ(_sorted[i], _top[i]);
+
+		cl::VectorCollection<MemorySpace::Test, MathDomain::Int> collection({ 3, 1, 3 });
+		collection.Get().ReadFrom(std::vector<int>({ 3, 1, 2, 9, 7, -1, 0 }));
+		collection.Sort();
+		ASSERT_EQ(std::vector<int>({ 1, 2, 3, 9, -1, 0, 7 }), collection.Get().Get());
+	}
+}	 // namespace clt
@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+
+#include <HostRoutines/Parallel.h>
+#include <HostRoutines/ThreadPool.h>
+#include <ColumnWiseMatrix.h>
+#include <Vector.h>
+
+#include <atomic>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+namespace clt
+{
+	class HostThreadPoolTests: public ::testing::Test
+	{
+	protected:
+		void SetUp() override
+		{
+			nThreads = cl::GetNumThreads();
+
+			// more threads than cores, so that chunks are really interleaved
+			cl::SetNumThreads(4);
+		}
+		void TearDown() override { cl::SetNumThreads(nThreads); }
+
+	private:
+		size_t nThreads = 1;
+	};
+
+	TEST_F(HostThreadPoolTests, SetNumThreads)
+	{
+		ASSERT_EQ(4u, cl::GetNumThreads());
+		ASSERT_EQ(4u, cl::routines::detail::GetNumberOfThreads());
+
+		cl::SetNumThreads(0);
+		ASSERT_EQ(1u, cl::GetNumThreads());
+
+		cl::SetNumThreads(3);
+		ASSERT_EQ(3u, cl::GetNumThreads());
+	}
+
+	TEST_F(HostThreadPoolTests, ParallelFor)
+	{
+		for (const size_t size : { size_t(0), size_t(1), size_t(1000), size_t(1000003) })
+		{
+			std::vector<std::atomic<int>> visits(size);
+			cl::routines::detail::ParallelFor(size, 1000, [&](const size_t begin, const size_t end) {
+				for (size_t i = begin; i < end; ++i)
+					++visits[i];
+			});
+
+			for (size_t i = 0; i < size; ++i)
+				ASSERT_EQ(1, visits[i]) << "size=" << size << "; i=" << i;
+		}
+	}
+
+	TEST_F(HostThreadPoolTests, Nested)
+	{
+		// tasks waiting for their own tasks keep on executing queued ones, so this can't deadlock
+		std::atomic<size_t> count { 0 };
+		cl::routines::detail::ParallelFor(16, [&](const size_t) {
+			cl::routines::detail::ParallelFor(16, [&](const size_t) {
+				cl::routines::detail::ParallelFor(size_t(1000), 10, [&](const size_t begin, const size_t end) { count += end - begin; });
+			});
+		});
+
+		ASSERT_EQ(16u * 16u * 1000u, count);
+	}
+
+	TEST_F(HostThreadPoolTests, Exception)
+	{
+		std::atomic<size_t> count { 0 };
+		auto throwSome = [&](const size_t task) {
+			++count;
+			if (task % 7 == 3)
+				throw std::runtime_error("task failed");
+		};
+		ASSERT_THROW(cl::routines::detail::ParallelFor(100, throwSome), std::runtime_error);
+
+		// all the tasks are run anyway, and the pool is still usable
+		ASSERT_EQ(100u, count);
+		count = 0;
+		cl::routines::detail::ParallelFor(100, [&](const size_t) { ++count; });
+		ASSERT_EQ(100u, count);
+	}
+
+	TEST_F(HostThreadPoolTests, ElementWise)
+	{
+		// big enough to be split among the threads
+		const size_t size = 100003;
+		const cl::test::dvec x = cl::test::dvec::RandomGaussian(static_cast<unsigned>(size), 1234);
+		const cl::test::dvec y = cl::test::dvec::RandomGaussian(static_cast<unsigned>(size), 2345);
+		const auto _x = x.Get();
+		const auto _y = y.Get();
+
+		cl::test::dvec z(x);
+		z.AddEqual(y, 2.0);
+		const auto _z = z.Get();
+		for (size_t i = 0; i < size; ++i)
+			ASSERT_DOUBLE_EQ(_x[i] + 2.0 * _y[i], _z[i]) << i;
+
+		size_t argMax = 0;
+		double norm = 0.0;
+		for (size_t i = 0; i < size; ++i)
+		{
+			if (std::fabs(_x[i]) > std::fabs(_x[argMax]))
+				argMax = i;
+			norm += _x[i] * _x[i];
+		}
+		ASSERT_EQ(static_cast<int>(argMax), x.AbsoluteMaximumIndex());
+		ASSERT_NEAR(std::sqrt(norm), x.EuclideanNorm(), 1e-9 * std::sqrt(norm));
+
+		// the result doesn't depend on the number of threads
+		const double norm4 = x.EuclideanNorm();
+		cl::SetNumThreads(1);
+		ASSERT_EQ(norm4, x.EuclideanNorm());
+	}
+
+	TEST_F(HostThreadPoolTests, MakePair)
+	{
+		const size_t size = 40000;
+		const cl::test::ivec x = cl::test::ivec::LinSpace(0, static_cast<int>(size) - 1, static_cast<unsigned>(size));
+		const cl::test::ivec y(static_cast<unsigned>(size), 7);
+
+		const auto pair = cl::test::ivec::MakePair(x, y);
+		ASSERT_EQ(2 * size, pair.size());
+		const auto _pair = pair.Get();
+		for (size_t i = 0; i < size; ++i)
+		{
+			ASSERT_FLOAT_EQ(static_cast<float>(i), _pair[2 * i]) << i;
+			ASSERT_FLOAT_EQ(7.0f, _pair[2 * i + 1]) << i;
+		}
+	}
+}	 // namespace clt
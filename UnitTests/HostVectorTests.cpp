@@ -60,18 +60,19 @@ namespace clt
 		cl::test::vec v = cl::test::vec::RandomGaussian(10, 1234);
 
 		auto _v1 = v.Get();
+		const auto _v0 = _v1;
 
 		cl::test::vec::RandomShuffle(v, 1273);
 		auto _v2 = v.Get();
 		auto _v3 = v.Get();
 
+		// a permutation of the input, but not the identity
+		ASSERT_NE(_v0, _v3);
+
 		std::sort(_v1.begin(), _v1.end());
 		std::sort(_v2.begin(), _v2.end());
 		for (size_t i = 0; i < _v2.size(); ++i)
-		{
 			ASSERT_DOUBLE_EQ(_v1[i], _v2[i]);
-			ASSERT_NE(_v1[i], _v3[i]) << i;
-		}
 	}
 
 	TEST_F(HostVectorTests, RandomShufflePair)
@@ -81,6 +82,8 @@ namespace clt
 
 		auto _u1 = v.Get();
 		auto _v1 = v.Get();
+		const auto _u0 = _u1;
+		const auto _v0 = _v1;
 
 		cl::test::vec::RandomShufflePair(u, v, 1273);
 		auto _u2 = u.Get();
@@ -88,6 +91,10 @@ namespace clt
 		auto _v2 = v.Get();
 		auto _v3 = v.Get();
 
+		// permutations of the inputs, but not the identity
+		ASSERT_NE(_u0, _u3);
+		ASSERT_NE(_v0, _v3);
+
 		std::sort(_v1.begin(), _v1.end());
 		std::sort(_v2.begin(), _v2.end());
 		std::sort(_u1.begin(), _u1.end());
@@ -96,8 +103,6 @@ namespace clt
 		{
 			ASSERT_DOUBLE_EQ(_u1[i], _u2[i]);
 			ASSERT_DOUBLE_EQ(_v1[i], _v2[i]);
-			ASSERT_NE(_u1[i], _u3[i]);
-			ASSERT_NE(_v1[i], _v3[i]);
 
 			// check permutation used the same indices
 			unsigned j = 0;
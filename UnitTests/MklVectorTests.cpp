@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 
 #include <Vector.h>
+#include <VectorCollection.h>
 
 #include <algorithm>
 
@@ -139,4 +140,35 @@ namespace clt
 			normCpu += x * x;
 		ASSERT_NEAR(normCpu, norm * norm, 1e-6);
 	}
+
+	TEST_F(MklVectorTests, Sort)
+	{
+		cl::mkl::vec v = cl::mkl::vec::RandomGaussian(10007, 1234);
+		auto _v = v.Get();
+
+		const cl::mkl::ivec indices = v.ArgSort();
+		const auto _indices = indices.Get();
+
+		v.Sort();
+		const auto _sorted = v.Get();
+		std::sort(_v.begin(), _v.end());
+		ASSERT_EQ(_v, _sorted);
+
+		const auto _unsorted = cl::mkl::vec::RandomGaussian(10007, 1234).Get();
+		for (size_t i = 0; i < _v.size(); ++i)
+			ASSERT_EQ(_sorted[i], _unsorted[static_cast<size_t>(_indices[i])]);
+
+		cl::mkl::dvec u(std::vector<double>({ 0.5, -2.0, 7.0, 3.0, 7.0 }));
+		cl::mkl::dvec values(2u);
+		cl::mkl::ivec topIndices(2u);
+		u.TopK(values, topIndices);
+		ASSERT_EQ(std::vector<double>({ 7.0, 7.0 }), values.Get());
+		ASSERT_EQ(std::vector<int>({ 2, 4 }), topIndices.Get());
+		ASSERT_EQ(std::vector<double>({ -2.0, 0.5, 3.0 }), u.TopK(3, false).Get());
+
+		cl::VectorCollection<MemorySpace::Mkl, MathDomain::Int> collection({ 3, 4 });
+		collection.Get().ReadFrom(std::vector<int>({ 3, 1, 2, 9, 7, -1, 0 }));
+		collection.Sort(false);
+		ASSERT_EQ(std::vector<int>({ 3, 2, 1, 9, 7, 0, -1 }), collection.Get().Get());
+	}
 }	 // namespace clt
@@ -206,4 +206,96 @@ namespace clt
 			}
 		}
 	}
+
+	TEST_F(OpenBlasMatrixTests, SubMatrixView)
+	{
+		cl::oblas::dmat m = cl::oblas::dmat::RandomGaussian(12, 10, 1234);
+		const cl::oblas::dmat original(m);
+
+		const unsigned rowStart = 2, nRows = 6, colStart = 3, nCols = 6;
+		cl::oblas::dmat view(m, rowStart, nRows, colStart, nCols);
+		ASSERT_EQ(view.nRows(), nRows);
+		ASSERT_EQ(view.nCols(), nCols);
+		ASSERT_EQ(view.leadingDimension(), m.nRows());
+		ASSERT_FALSE(view.IsContiguous());
+		ASSERT_FALSE(view.OwnsMemory());
+
+		// copies are contiguous
+		const cl::oblas::dmat copy(view);
+		ASSERT_TRUE(copy.IsContiguous());
+		ASSERT_TRUE(copy == view);
+
+		auto _m = m.Get();
+		auto _view = view.Get();
+		for (size_t i = 0; i < nRows; ++i)
+		{
+			for (size_t j = 0; j < nCols; ++j)
+				ASSERT_DOUBLE_EQ(_m[(i + rowStart) + (j + colStart) * m.nRows()], _view[i + j * nRows]);
+		}
+
+		const cl::oblas::dmat rhs = cl::oblas::dmat::RandomGaussian(nCols, 5, 2345);
+		ASSERT_TRUE(view.Multiply(rhs) == copy.Multiply(rhs));
+		ASSERT_TRUE(rhs.Multiply(view, MatrixOperation::Transpose, MatrixOperation::Transpose) == rhs.Multiply(copy, MatrixOperation::Transpose, MatrixOperation::Transpose));
+
+		const cl::oblas::dvec x = cl::oblas::dvec::LinSpace(-1.0, 1.0, nCols);
+		ASSERT_TRUE(view.Dot(x) == copy.Dot(x));
+
+		// the right-hand side is a view as well
+		cl::oblas::dmat b = cl::oblas::dmat::RandomGaussian(nRows + 3, 4, 3456);
+		cl::oblas::dmat bView(b, 1, nRows, 0, 4);
+		cl::oblas::dmat bCopy(bView);
+		view.Solve(bView);
+		copy.Solve(bCopy);
+		ASSERT_TRUE(bView == bCopy);
+
+		// writes go to the underlying matrix only
+		const cl::oblas::dmat addend(nRows, nCols, 1.0);
+		view.AddEqualMatrix(addend);
+		_m = m.Get();
+		const auto _original = original.Get();
+		for (size_t i = 0; i < m.nRows(); ++i)
+		{
+			for (size_t j = 0; j < m.nCols(); ++j)
+			{
+				const bool inView = i >= rowStart && i < rowStart + nRows && j >= colStart && j < colStart + nCols;
+				ASSERT_DOUBLE_EQ(_m[i + j * m.nRows()], _original[i + j * m.nRows()] + (inView ? 1.0 : 0.0));
+			}
+		}
+	}
+
+	TEST_F(OpenBlasMatrixTests, ElementWiseOnSubMatrixView)
+	{
+		cl::oblas::dmat m = cl::oblas::dmat::RandomGaussian(12, 10, 1234);
+		const cl::oblas::dmat original(m);
+
+		const unsigned rowStart = 3, nRows = 5, colStart = 2, nCols = 4;
+		cl::oblas::dmat view(m, rowStart, nRows, colStart, nCols);
+		ASSERT_FALSE(view.IsContiguous());
+
+		// reductions only see the view
+		const cl::oblas::dmat copy(view);
+		ASSERT_DOUBLE_EQ(view.Sum(), copy.Sum());
+		ASSERT_DOUBLE_EQ(view.Minimum(), copy.Minimum());
+		ASSERT_DOUBLE_EQ(view.Maximum(), copy.Maximum());
+
+		view.Set(2.0);
+		view.Scale(3.0);
+		view += cl::oblas::dmat(nRows, nCols, 1.0);
+		ASSERT_DOUBLE_EQ(view.Sum(), 7.0 * nRows * nCols);
+
+		const auto flat = view.Flatten().Get();
+		for (const auto& iter : flat)
+			ASSERT_DOUBLE_EQ(iter, 7.0);
+
+		const auto _m = m.Get();
+		const auto _original = original.Get();
+		for (size_t i = 0; i < m.nRows(); ++i)
+		{
+			for (size_t j = 0; j < m.nCols(); ++j)
+			{
+				const bool inView = i >= rowStart && i < rowStart + nRows && j >= colStart && j < colStart + nCols;
+				ASSERT_DOUBLE_EQ(_m[i + j * m.nRows()], inView ? 7.0 : _original[i + j * m.nRows()]);
+			}
+		}
+	}
 }	 // namespace clt
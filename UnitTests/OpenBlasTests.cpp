@@ -2,16 +2,28 @@
 #include <gtest/gtest.h>
 
 #include <ColumnWiseMatrix.h>
+#include <Factorization.h>
 #include <Tensor.h>
 #include <Vector.h>
 
+#include <HostRoutines/BlasWrappers.h>
+#include <HostRoutines/Exceptions.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
 namespace clt
 {
 	class OpenBlasTests: public ::testing::Test
 	{
 	};
 
-	static cl::oblas::mat GetInvertibleMatrix(unsigned nRows, const unsigned seed = 1234)
+	/**
+	 * R + 2I, with R uniform in [0, 1]. The default seed differs from the Mkl tests: with the Philox stream, seed 1234 puts the float
+	 * residuals of SolveQr and Factorization above their 5e-5 tolerance
+	 */
+	static cl::oblas::mat GetInvertibleMatrix(unsigned nRows, const unsigned seed = 1252)
 	{
 		cl::oblas::mat A = cl::oblas::mat::RandomUniform(nRows, nRows, seed);
 		auto _A = A.Get();
@@ -23,6 +35,31 @@ namespace clt
 		return A;
 	}
 
+	/**
+	 * (R + R^T) / 2 + nRows * D, with R uniform in [0, 1] and D = I (positive definite) or D = diag(1, -1, 1, ...) (indefinite)
+	 */
+	static cl::oblas::mat GetSymmetricMatrix(unsigned nRows, const bool positiveDefinite, const unsigned seed = 1234)
+	{
+		cl::oblas::mat A = cl::oblas::mat::RandomUniform(nRows, nRows, seed);
+		auto _A = A.Get();
+
+		for (size_t j = 0; j < nRows; ++j)
+		{
+			for (size_t i = 0; i < j; ++i)
+			{
+				_A[i + nRows * j] = .5f * (_A[i + nRows * j] + _A[j + nRows * i]);
+				_A[j + nRows * i] = _A[i + nRows * j];
+			}
+
+			// alternate the sign of the diagonal for making it indefinite
+			const bool negative = !positiveDefinite && j % 2 == 1;
+			_A[j + nRows * j] += negative ? -static_cast<float>(nRows) : static_cast<float>(nRows);
+		}
+
+		A.ReadFrom(_A);
+		return A;
+	}
+
 	TEST_F(OpenBlasTests, Add)
 	{
 		cl::oblas::vec v1 = cl::oblas::vec::LinSpace(-1.0, 1.0, 100);
@@ -161,6 +198,46 @@ namespace clt
 			ASSERT_TRUE(std::fabs(2.0f * _v1[i] - _v2[i]) <= 1e-7f);
 	}
 
+	template<typename T, typename F>
+	static void CheckElementWiseFunction(const std::vector<T>& x, const std::vector<T>& y, const F& f, const double tolerance)
+	{
+		for (size_t i = 0; i < x.size(); ++i)
+		{
+			const double expected = f(static_cast<double>(x[i]));
+			ASSERT_NEAR(expected, y[i], tolerance * std::max(1.0, std::fabs(expected))) << i;
+		}
+	}
+
+	TEST_F(OpenBlasTests, ElementWiseFunctions)
+	{
+		// more than one chunk of the parallel loops, and not a multiple of the vector width
+		const cl::oblas::vec v = cl::oblas::vec::LinSpace(0.01f, 4.0f, 100003);
+		const auto _v = v.Get();
+
+		cl::oblas::vec out(v.size());
+		v.Exp(out);
+		CheckElementWiseFunction(_v, out.Get(), [](const double x) { return std::exp(x); }, 1e-6);
+		v.Log(out);
+		CheckElementWiseFunction(_v, out.Get(), [](const double x) { return std::log(x); }, 1e-6);
+		v.Sqrt(out);
+		CheckElementWiseFunction(_v, out.Get(), [](const double x) { return std::sqrt(x); }, 1e-6);
+		v.Pow(out, 2.5);
+		CheckElementWiseFunction(_v, out.Get(), [](const double x) { return std::pow(x, 2.5); }, 1e-6);
+		v.Pow(out, -3.0);
+		CheckElementWiseFunction(_v, out.Get(), [](const double x) { return std::pow(x, -3.0); }, 1e-6);
+
+		// in place
+		cl::oblas::mat m = cl::oblas::mat::RandomGaussian(37, 51, 1234);
+		const auto _m = m.Get();
+		m.Tanh();
+		CheckElementWiseFunction(_m, m.Get(), [](const double x) { return std::tanh(x); }, 1e-6);
+
+		cl::oblas::dten t = cl::oblas::dten::RandomGaussian(10, 7, 3, 1234);
+		const auto _t = t.Get();
+		t.Erf();
+		CheckElementWiseFunction(_t, t.Get(), [](const double x) { return std::erf(x); }, 1e-15);
+	}
+
 	TEST_F(OpenBlasTests, ScaleColumns)
 	{
 		cl::oblas::mat m = cl::oblas::mat::RandomUniform(10, 100, 1234);
@@ -270,6 +347,56 @@ namespace clt
 				ASSERT_NEAR(_initialM3[i + j * m1.nRows()], _m3[i + j * m1.nRows()], 5e-5);
 	}
 
+	TEST_F(OpenBlasTests, MultiplyFused)
+	{
+		// dense layer: 40 outputs, 30 inputs, batch of 25 along the columns
+		const auto weights = cl::oblas::dmat::RandomGaussian(30, 40, 1234);
+		const auto x = cl::oblas::dmat::RandomGaussian(30, 25, 2345);
+		const auto bias = cl::oblas::dvec::RandomGaussian(40, 3456);
+
+		const auto _weights = weights.Get();
+		const auto _x = x.Get();
+		const auto _bias = bias.Get();
+
+		for (const auto activation : { cl::ActivationType::None, cl::ActivationType::Relu, cl::ActivationType::Tanh, cl::ActivationType::Sigmoid, cl::ActivationType::Gelu })
+		{
+			const auto out = weights.MultiplyFused(x, bias, activation, MatrixOperation::Transpose, MatrixOperation::None, 0.5);
+			ASSERT_EQ(out.nRows(), weights.nCols());
+			ASSERT_EQ(out.nCols(), x.nCols());
+
+			const auto _out = out.Get();
+			for (size_t i = 0; i < out.nRows(); ++i)
+			{
+				for (size_t j = 0; j < out.nCols(); ++j)
+				{
+					double golden = 0.0;
+					for (size_t k = 0; k < x.nRows(); ++k)
+						golden += _weights[k + i * weights.nRows()] * _x[k + j * x.nRows()];
+					golden = 0.5 * golden + _bias[i];
+
+					switch (activation)
+					{
+						case cl::ActivationType::Relu:
+							golden = std::max(golden, 0.0);
+							break;
+						case cl::ActivationType::Tanh:
+							golden = std::tanh(golden);
+							break;
+						case cl::ActivationType::Sigmoid:
+							golden = 1.0 / (1.0 + std::exp(-golden));
+							break;
+						case cl::ActivationType::Gelu:
+							golden = 0.5 * golden * (1.0 + std::erf(golden / std::sqrt(2.0)));
+							break;
+						default:
+							break;
+					}
+					ASSERT_NEAR(golden, _out[i + j * out.nRows()], 1e-12) << "i=" << i << "; j=" << j << "; activation=" << static_cast<int>(activation);
+				}
+			}
+		}
+	}
+
 	TEST_F(OpenBlasTests, Dot)
 	{
 		cl::oblas::mat m1(10, 10, 1.2345f);
@@ -323,7 +450,7 @@ namespace clt
 
 		cl::oblas::mat u = GetInvertibleMatrix(v.nRows(), 2345);
 		auto _u = u.Get();
-		v.Solve(u, MatrixOperation::None, LinearSystemSolverType::Lu);
+		v.Solve(u, MatrixOperation::None, cl::DenseSolverType::Lu);
 
 		auto _x = u.Get();
 
@@ -348,7 +475,7 @@ namespace clt
 
 		cl::oblas::mat u = GetInvertibleMatrix(v.nRows(), 2345);
 		auto _u = u.Get();
-		v.Solve(u, MatrixOperation::None, LinearSystemSolverType::Qr);
+		v.Solve(u, MatrixOperation::None, cl::DenseSolverType::Qr);
 
 		auto _x = u.Get();
 
@@ -365,6 +492,209 @@ namespace clt
 		}
 	}
 
+	TEST_F(OpenBlasTests, SolveWithWorkspace)
+	{
+		cl::routines::SolverWorkspace workspace;
+
+		cl::oblas::mat v = GetInvertibleMatrix(64);
+		for (const auto solver : { cl::DenseSolverType::Lu, cl::DenseSolverType::Qr, cl::DenseSolverType::Lu })
+		{
+			cl::oblas::mat u = GetInvertibleMatrix(v.nRows(), 2345);
+			auto _u = u.Get();
+			v.Solve(u, workspace, MatrixOperation::None, solver);
+
+			auto uSanity = v.Multiply(u);
+			auto _uSanity = uSanity.Get();
+
+			for (size_t i = 0; i < _u.size(); ++i)
+				ASSERT_TRUE(std::fabs(_uSanity[i] - _u[i]) <= 5e-5f);
+		}
+
+		// same size: no further allocation
+		const size_t allocatedBytes = workspace.GetAllocatedBytes();
+		cl::oblas::mat vMinus1(v);
+		vMinus1.Invert(workspace);
+		cl::oblas::mat u = GetInvertibleMatrix(v.nRows(), 2345);
+		v.Solve(u, workspace);
+		ASSERT_EQ(allocatedBytes + v.size() * sizeof(float), workspace.GetAllocatedBytes());	// Invert's right hand side
+
+		auto eye = v.Multiply(vMinus1);
+		auto _eye = eye.Get();
+		for (size_t i = 0; i < v.nRows(); ++i)
+		{
+			for (size_t j = 0; j < v.nRows(); ++j)
+			{
+				float expected = i == j ? 1.0f : 0.0f;
+				ASSERT_TRUE(std::fabs(_eye[i + v.nRows() * j] - expected) <= 5e-5f);
+			}
+		}
+	}
+
+	TEST_F(OpenBlasTests, SolveSymmetric)
+	{
+		for (const auto solver : { cl::DenseSolverType::Cholesky, cl::DenseSolverType::Ldlt })
+		{
+			cl::oblas::mat v = GetSymmetricMatrix(128, solver == cl::DenseSolverType::Cholesky);
+
+			cl::oblas::mat u = GetInvertibleMatrix(v.nRows(), 2345);
+			auto _u = u.Get();
+			v.Solve(u, MatrixOperation::None, solver);
+
+			auto uSanity = v.Multiply(u);
+			auto _uSanity = uSanity.Get();
+			for (size_t i = 0; i < _u.size(); ++i)
+				ASSERT_TRUE(std::fabs(_uSanity[i] - _u[i]) <= 5e-5f);
+		}
+	}
+
+	TEST_F(OpenBlasTests, InvertSymmetric)
+	{
+		for (const auto solver : { cl::DenseSolverType::Cholesky, cl::DenseSolverType::Ldlt })
+		{
+			cl::oblas::mat v = GetSymmetricMatrix(128, solver == cl::DenseSolverType::Cholesky);
+
+			cl::oblas::mat vMinus1(v);
+			vMinus1.Invert(MatrixOperation::None, solver);
+
+			auto eye = v.Multiply(vMinus1);
+			auto _eye = eye.Get();
+			for (size_t i = 0; i < v.nRows(); ++i)
+			{
+				for (size_t j = 0; j < v.nRows(); ++j)
+				{
+					float expected = i == j ? 1.0f : 0.0f;
+					ASSERT_TRUE(std::fabs(_eye[i + v.nRows() * j] - expected) <= 5e-5f);
+				}
+			}
+		}
+	}
+
+	TEST_F(OpenBlasTests, CholeskyNotPositiveDefinite)
+	{
+		cl::oblas::mat v = GetSymmetricMatrix(128, false);
+		cl::oblas::mat u = GetInvertibleMatrix(v.nRows(), 2345);
+
+		ASSERT_THROW(v.Solve(u, MatrixOperation::None, cl::DenseSolverType::Cholesky), cl::FactorizationException);
+
+		// Ldlt handles indefinite matrices
+		cl::oblas::fact factorization(v, cl::DenseSolverType::Ldlt);
+		auto _u = u.Get();
+		factorization.Solve(u);
+
+		auto uSanity = v.Multiply(u);
+		auto _uSanity = uSanity.Get();
+		for (size_t i = 0; i < _u.size(); ++i)
+			ASSERT_TRUE(std::fabs(_uSanity[i] - _u[i]) <= 5e-5f);
+	}
+
+	TEST_F(OpenBlasTests, SolveMixedPrecision)
+	{
+		for (const auto operation : { MatrixOperation::None, MatrixOperation::Transpose })
+		{
+			cl::oblas::dmat v = cl::oblas::dmat::RandomUniform(128, 128, 1252);
+			auto _v = v.Get();
+			for (size_t i = 0; i < v.nRows(); ++i)
+				_v[i + v.nRows() * i] += 2.0;
+			v.ReadFrom(_v);
+
+			cl::oblas::dmat u = cl::oblas::dmat::RandomUniform(v.nRows(), v.nRows(), 2345);
+			auto _u = u.Get();
+			v.Solve(u, operation, cl::DenseSolverType::MixedPrecisionLu);
+
+			// refined to double precision, way beyond what a float LU alone achieves
+			auto uSanity = v.Multiply(u, operation);
+			auto _uSanity = uSanity.Get();
+			for (size_t i = 0; i < _u.size(); ++i)
+				ASSERT_NEAR(_u[i], _uSanity[i], 1e-12) << i;
+		}
+
+		// float matrices are just solved with Lu
+		cl::oblas::mat v = GetInvertibleMatrix(64);
+		cl::oblas::mat u = GetInvertibleMatrix(v.nRows(), 2345);
+		auto _u = u.Get();
+		v.Solve(u, MatrixOperation::None, cl::DenseSolverType::MixedPrecisionLu);
+		auto uSanity = v.Multiply(u);
+		auto _uSanity = uSanity.Get();
+		for (size_t i = 0; i < _u.size(); ++i)
+			ASSERT_TRUE(std::fabs(_uSanity[i] - _u[i]) <= 5e-5f);
+	}
+
+	TEST_F(OpenBlasTests, SolveMixedPrecisionWithWorkspace)
+	{
+		cl::routines::SolverWorkspace workspace;
+
+		cl::oblas::dmat v = cl::oblas::dmat::RandomUniform(64, 64, 1252);
+		auto _v = v.Get();
+		for (size_t i = 0; i < v.nRows(); ++i)
+			_v[i + v.nRows() * i] += 2.0;
+		v.ReadFrom(_v);
+
+		cl::oblas::dmat u = cl::oblas::dmat::RandomUniform(v.nRows(), 4, 2345);
+		v.Solve(u, workspace, MatrixOperation::None, cl::DenseSolverType::MixedPrecisionLu);
+		const size_t allocatedBytes = workspace.GetAllocatedBytes();
+		ASSERT_GT(allocatedBytes, 0u);
+
+		// same size: the float copy of A and the refinement buffers are reused
+		cl::oblas::dmat w = cl::oblas::dmat::RandomUniform(v.nRows(), 4, 3456);
+		auto _w = w.Get();
+		v.Solve(w, workspace, MatrixOperation::None, cl::DenseSolverType::MixedPrecisionLu);
+		ASSERT_EQ(allocatedBytes, workspace.GetAllocatedBytes());
+
+		auto wSanity = v.Multiply(w);
+		auto _wSanity = wSanity.Get();
+		for (size_t i = 0; i < _w.size(); ++i)
+			ASSERT_NEAR(_w[i], _wSanity[i], 1e-12) << i;
+	}
+
+	TEST_F(OpenBlasTests, SolveMixedPrecisionFallback)
+	{
+		// 1 + 2^-30 is 1 in single precision: the float factorization is singular, and the double LU is exact
+		const double delta = std::ldexp(1.0, -30);
+		cl::oblas::dmat v(2, 2, 1.0);
+		v.ReadFrom(std::vector<double> { 1.0, 1.0, 1.0, 1.0 + delta });
+
+		cl::oblas::dmat u(2, 2, 1.0);
+		u.ReadFrom(std::vector<double> { 2.0, 2.0 + delta, 1.0, 1.0 });
+		v.Solve(u, MatrixOperation::None, cl::DenseSolverType::MixedPrecisionLu);
+
+		const auto _u = u.Get();
+		ASSERT_DOUBLE_EQ(1.0, _u[0]);
+		ASSERT_DOUBLE_EQ(1.0, _u[1]);
+		ASSERT_DOUBLE_EQ(1.0, _u[2]);
+		ASSERT_NEAR(0.0, _u[3], 1e-15);
+	}
+
+	TEST_F(OpenBlasTests, Factorization)
+	{
+		cl::oblas::mat v = GetInvertibleMatrix(128);
+		for (const auto solver : { cl::DenseSolverType::Lu, cl::DenseSolverType::Qr })
+		{
+			cl::oblas::fact factorization(v, solver);
+
+			// the factorization is reused for different right hand sides
+			for (const unsigned seed : { 2345u, 3456u })
+			{
+				cl::oblas::mat u = GetInvertibleMatrix(v.nRows(), seed);
+				auto _u = u.Get();
+				factorization.Solve(u);
+
+				auto uSanity = v.Multiply(u);
+				auto _uSanity = uSanity.Get();
+				for (size_t i = 0; i < _u.size(); ++i)
+					ASSERT_TRUE(std::fabs(_uSanity[i] - _u[i]) <= 5e-5f);
+			}
+
+			cl::oblas::vec b = cl::oblas::vec::RandomUniform(v.nRows(), 4567);
+			auto _b = b.Get();
+			factorization.Solve(b, MatrixOperation::Transpose);
+
+			auto bSanity = v.Dot(b, MatrixOperation::Transpose);
+			auto _bSanity = bSanity.Get();
+			for (size_t i = 0; i < _b.size(); ++i)
+				ASSERT_TRUE(std::fabs(_bSanity[i] - _b[i]) <= 5e-5f);
+		}
+	}
+
 	TEST_F(OpenBlasTests, KroneckerProduct)
 	{
 		cl::oblas::vec u(64, 0.1f);
@@ -429,6 +759,171 @@ namespace clt
 		}
 	}
 
+	TEST_F(OpenBlasTests, CumulativeSum)
+	{
+		// fewer and more columns than threads
+		for (const unsigned nCols : { 3u, 64u })
+		{
+			const cl::oblas::dmat A = cl::oblas::dmat::RandomGaussian(200, nCols, 1234);
+			const auto _A = A.Get();
+
+			for (const bool exclusive : { false, true })
+			{
+				cl::oblas::dmat columnWise(A);
+				columnWise.ColumnWiseCumulativeSum(exclusive);
+				const auto _columnWise = columnWise.Get();
+				for (size_t j = 0; j < A.nCols(); ++j)
+				{
+					double goldenSum = 0.0;
+					for (size_t i = 0; i < A.nRows(); ++i)
+					{
+						if (!exclusive)
+							goldenSum += _A[i + j * A.nRows()];
+						ASSERT_NEAR(goldenSum, _columnWise[i + j * A.nRows()], 1e-12);
+						if (exclusive)
+							goldenSum += _A[i + j * A.nRows()];
+					}
+				}
+
+				cl::oblas::dmat rowWise(A);
+				rowWise.RowWiseCumulativeSum(exclusive);
+				const auto _rowWise = rowWise.Get();
+				for (size_t i = 0; i < A.nRows(); ++i)
+				{
+					double goldenSum = 0.0;
+					for (size_t j = 0; j < A.nCols(); ++j)
+					{
+						if (!exclusive)
+							goldenSum += _A[i + j * A.nRows()];
+						ASSERT_NEAR(goldenSum, _rowWise[i + j * A.nRows()], 1e-12);
+						if (exclusive)
+							goldenSum += _A[i + j * A.nRows()];
+					}
+				}
+			}
+
+			cl::oblas::dmat B(A);
+			cl::routines::CumulativeRowSum(B.GetTile());
+			cl::oblas::dmat columnWise(A);
+			columnWise.ColumnWiseCumulativeSum();
+			ASSERT_TRUE(B == columnWise);
+		}
+
+		// long enough to be split in chunks
+		const cl::oblas::dvec x = cl::oblas::dvec::RandomGaussian(100000, 1234);
+		const auto _x = x.Get();
+		for (const bool exclusive : { false, true })
+		{
+			cl::oblas::dvec y(x);
+			y.CumulativeSum(exclusive);
+			const auto _y = y.Get();
+
+			double goldenSum = 0.0;
+			for (size_t i = 0; i < x.size(); ++i)
+			{
+				if (!exclusive)
+					goldenSum += _x[i];
+				ASSERT_NEAR(goldenSum, _y[i], 1e-9);
+				if (exclusive)
+					goldenSum += _x[i];
+			}
+		}
+	}
+
+	static double GetGoldenReduction(const std::vector<double>& x, const cl::ReductionType reductionType)
+	{
+		double ret = reductionType == cl::ReductionType::Min || reductionType == cl::ReductionType::Max ? x[0] : 0.0;
+		for (const double value : x)
+		{
+			switch (reductionType)
+			{
+				case cl::ReductionType::Min:
+					ret = std::min(ret, value);
+					break;
+				case cl::ReductionType::Max:
+					ret = std::max(ret, value);
+					break;
+				case cl::ReductionType::Norm:
+					ret += value * value;
+					break;
+				default:
+					ret += value;
+					break;
+			}
+		}
+
+		if (reductionType == cl::ReductionType::Mean)
+			ret /= static_cast<double>(x.size());
+		if (reductionType == cl::ReductionType::Norm)
+			ret = std::sqrt(ret);
+
+		return ret;
+	}
+
+	/**
+	 * Row-wise and column-wise reductions of A, checked against the ones of its copy on the host
+	 */
+	static void CheckAxisReductions(const cl::oblas::dmat& A)
+	{
+		const auto _A = A.Get();
+		for (const auto reductionType : { cl::ReductionType::Sum, cl::ReductionType::Mean, cl::ReductionType::Min, cl::ReductionType::Max, cl::ReductionType::Norm })
+		{
+			const auto _rowWise = A.RowWiseReduce(reductionType).Get();
+			ASSERT_EQ(_rowWise.size(), A.nRows());
+			for (size_t i = 0; i < A.nRows(); ++i)
+			{
+				std::vector<double> row(A.nCols());
+				for (size_t j = 0; j < A.nCols(); ++j)
+					row[j] = _A[i + j * A.nRows()];
+				ASSERT_NEAR(GetGoldenReduction(row, reductionType), _rowWise[i], 1e-10) << "i=" << i << "; type=" << static_cast<int>(reductionType);
+			}
+
+			const auto _columnWise = A.ColumnWiseReduce(reductionType).Get();
+			ASSERT_EQ(_columnWise.size(), A.nCols());
+			for (size_t j = 0; j < A.nCols(); ++j)
+			{
+				const std::vector<double> column(_A.begin() + j * A.nRows(), _A.begin() + (j + 1) * A.nRows());
+				ASSERT_NEAR(GetGoldenReduction(column, reductionType), _columnWise[j], 1e-10) << "j=" << j << "; type=" << static_cast<int>(reductionType);
+			}
+		}
+	}
+
+	TEST_F(OpenBlasTests, AxisReductions)
+	{
+		const auto A = cl::oblas::dmat::RandomGaussian(700, 40, 1234);
+		CheckAxisReductions(A);
+
+		// strided view
+		const unsigned rowStart = 7, nRows = 600, colStart = 5, nCols = 30;
+		CheckAxisReductions(cl::oblas::dmat(A, rowStart, nRows, colStart, nCols));
+
+		// few long rows, few long columns
+		CheckAxisReductions(cl::oblas::dmat::RandomGaussian(6, 20000, 2345));
+		CheckAxisReductions(cl::oblas::dmat::RandomGaussian(100000, 2, 3456));
+	}
+
+	TEST_F(OpenBlasTests, CubeWiseReduce)
+	{
+		const auto T = cl::oblas::dten::RandomGaussian(16, 12, 20, 1234);
+		const auto _T = T.Get();
+
+		for (const auto reductionType : { cl::ReductionType::Sum, cl::ReductionType::Mean, cl::ReductionType::Min, cl::ReductionType::Max, cl::ReductionType::Norm })
+		{
+			const auto cubeReduction = T.CubeWiseReduce(reductionType);
+			ASSERT_EQ(cubeReduction.nRows(), T.nRows());
+			ASSERT_EQ(cubeReduction.nCols(), T.nCols());
+
+			const auto _cubeReduction = cubeReduction.Get();
+			for (size_t i = 0; i < T.nRows() * T.nCols(); ++i)
+			{
+				std::vector<double> x(T.nMatrices());
+				for (size_t k = 0; k < T.nMatrices(); ++k)
+					x[k] = _T[i + k * T.nRows() * T.nCols()];
+				ASSERT_NEAR(GetGoldenReduction(x, reductionType), _cubeReduction[i], 1e-12) << "i=" << i << "; type=" << static_cast<int>(reductionType);
+			}
+		}
+	}
+
 	TEST_F(OpenBlasTests, CubeWiseSum)
 	{
 		cl::oblas::ten T(64, 128, 32);
@@ -479,6 +974,72 @@ namespace clt
 		}
 	}
 
+	/**
+	 * A[k] = B[k] * C[k * strideC] with many small or few large products, checked against a naive triple loop
+	 */
+	static void CheckBatchedMultiply(const unsigned nRows, const unsigned nInner, const unsigned nCols, const unsigned nMatrices, const bool broadcastC, const MatrixOperation bOperation)
+	{
+		const bool transposeB = bOperation == MatrixOperation::Transpose;
+		const auto B = cl::oblas::dten::RandomUniform(transposeB ? nInner : nRows, transposeB ? nRows : nInner, nMatrices, 1234);
+		const auto C = cl::oblas::dten::RandomUniform(nInner, nCols, broadcastC ? 1 : nMatrices, 2345);
+		cl::oblas::dten A(nRows, nCols, nMatrices, 1.0);
+
+		cl::routines::BatchedMultiply(A.GetCube(), B.GetCube(), C.GetCube(), B.nRows() * B.nCols(), broadcastC ? 0 : nInner * nCols, bOperation, MatrixOperation::None, 2.0, 0.5);
+
+		const auto _A = A.Get();
+		const auto _B = B.Get();
+		const auto _C = C.Get();
+		for (size_t k = 0; k < nMatrices; ++k)
+		{
+			const double* b = _B.data() + k * nRows * nInner;
+			const double* c = _C.data() + (broadcastC ? 0 : k * nInner * nCols);
+			for (size_t i = 0; i < nRows; ++i)
+			{
+				for (size_t j = 0; j < nCols; ++j)
+				{
+					double golden = 0.5;
+					for (size_t l = 0; l < nInner; ++l)
+						golden += 2.0 * (transposeB ? b[l + i * nInner] : b[i + l * nRows]) * c[l + j * nInner];
+					ASSERT_NEAR(golden, _A[i + j * nRows + k * nRows * nCols], 1e-10 * nInner) << "i=" << i << "; j=" << j << "; k=" << k;
+				}
+			}
+		}
+	}
+
+	TEST_F(OpenBlasTests, BatchedMultiply)
+	{
+		// one GEMM per thread
+		CheckBatchedMultiply(8, 12, 10, 256, false, MatrixOperation::None);
+		CheckBatchedMultiply(8, 12, 10, 256, true, MatrixOperation::None);
+		CheckBatchedMultiply(8, 12, 10, 256, false, MatrixOperation::Transpose);
+
+		// threaded GEMMs
+		CheckBatchedMultiply(160, 200, 180, 3, false, MatrixOperation::None);
+		CheckBatchedMultiply(160, 200, 180, 3, true, MatrixOperation::Transpose);
+	}
+
+	TEST_F(OpenBlasTests, MatrixSum)
+	{
+		const auto T = cl::oblas::ten::RandomUniform(32, 16, 8, 1234);
+		const auto _T = T.Get();
+
+		const auto matrixSum = T.MatrixSum();
+		const auto _matrixSum = matrixSum.Get();
+
+		ASSERT_EQ(T.nRows(), matrixSum.nRows());
+		ASSERT_EQ(T.nMatrices(), matrixSum.nCols());
+		for (size_t k = 0; k < T.nMatrices(); ++k)
+		{
+			for (size_t i = 0; i < T.nRows(); ++i)
+			{
+				double golden = 0.0;
+				for (size_t j = 0; j < T.nCols(); ++j)
+					golden += static_cast<double>(_T[i + j * T.nRows() + k * T.nRows() * T.nCols()]);
+				ASSERT_NEAR(golden, static_cast<double>(_matrixSum[i + k * T.nRows()]), 5e-6);
+			}
+		}
+	}
+
 	TEST_F(OpenBlasTests, BatchedKroneckerProduct)
 	{
 		unsigned nCubes = 64;
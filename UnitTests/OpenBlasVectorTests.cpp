@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 
 #include <Vector.h>
+#include <VectorCollection.h>
 
 #include <algorithm>
 
@@ -60,18 +61,19 @@ namespace clt
 		cl::oblas::vec v = cl::oblas::vec::RandomGaussian(10, 1234);
 
 		auto _v1 = v.Get();
+		const auto _v0 = _v1;
 
 		cl::oblas::vec::RandomShuffle(v, 1273);
 		auto _v2 = v.Get();
 		auto _v3 = v.Get();
 
+		// a permutation of the input, but not the identity
+		ASSERT_NE(_v0, _v3);
+
 		std::sort(_v1.begin(), _v1.end());
 		std::sort(_v2.begin(), _v2.end());
 		for (size_t i = 0; i < _v2.size(); ++i)
-		{
 			ASSERT_DOUBLE_EQ(_v1[i], _v2[i]);
-			ASSERT_NE(_v1[i], _v3[i]) << i;
-		}
 	}
 
 	TEST_F(OpenBlasVectorTests, RandomShufflePair)
@@ -81,6 +83,8 @@ namespace clt
 
 		auto _u1 = v.Get();
 		auto _v1 = v.Get();
+		const auto _u0 = _u1;
+		const auto _v0 = _v1;
 
 		cl::oblas::vec::RandomShufflePair(u, v, 1273);
 		auto _u2 = u.Get();
@@ -88,6 +92,10 @@ namespace clt
 		auto _v2 = v.Get();
 		auto _v3 = v.Get();
 
+		// permutations of the inputs, but not the identity
+		ASSERT_NE(_u0, _u3);
+		ASSERT_NE(_v0, _v3);
+
 		std::sort(_v1.begin(), _v1.end());
 		std::sort(_v2.begin(), _v2.end());
 		std::sort(_u1.begin(), _u1.end());
@@ -96,8 +104,6 @@ namespace clt
 		{
 			ASSERT_DOUBLE_EQ(_u1[i], _u2[i]);
 			ASSERT_DOUBLE_EQ(_v1[i], _v2[i]);
-			ASSERT_NE(_u1[i], _u3[i]);
-			ASSERT_NE(_v1[i], _v3[i]);
 
 			// check permutation used the same indices
 			unsigned j = 0;
@@ -139,4 +145,35 @@ namespace clt
 			normCpu += x * x;
 		ASSERT_NEAR(normCpu, norm * norm, 1e-6);
 	}
+
+	TEST_F(OpenBlasVectorTests, Sort)
+	{
+		cl::oblas::vec v = cl::oblas::vec::RandomGaussian(10007, 1234);
+		auto _v = v.Get();
+
+		const cl::oblas::ivec indices = v.ArgSort();
+		const auto _indices = indices.Get();
+
+		v.Sort();
+		const auto _sorted = v.Get();
+		std::sort(_v.begin(), _v.end());
+		ASSERT_EQ(_v, _sorted);
+
+		const auto _unsorted = cl::oblas::vec::RandomGaussian(10007, 1234).Get();
+		for (size_t i = 0; i < _v.size(); ++i)
+			ASSERT_EQ(_sorted[i], _unsorted[static_cast<size_t>(_indices[i])]);
+
+		cl::oblas::dvec u(std::vector<double>({ 0.5, -2.0, 7.0, 3.0, 7.0 }));
+		cl::oblas::dvec values(2u);
+		cl::oblas::ivec topIndices(2u);
+		u.TopK(values, topIndices);
+		ASSERT_EQ(std::vector<double>({ 7.0, 7.0 }), values.Get());
+		ASSERT_EQ(std::vector<int>({ 2, 4 }), topIndices.Get());
+		ASSERT_EQ(std::vector<double>({ -2.0, 0.5, 3.0 }), u.TopK(3, false).Get());
+
+		cl::VectorCollection<MemorySpace::OpenBlas, MathDomain::Int> collection({ 3, 4 });
+		collection.Get().ReadFrom(std::vector<int>({ 3, 1, 2, 9, 7, -1, 0 }));
+		collection.Sort(false);
+		ASSERT_EQ(std::vector<int>({ 3, 2, 1, 9, 7, 0, -1 }), collection.Get().Get());
+	}
 }	 // namespace clt